@@ -123,6 +123,42 @@ void AliCFContainer::Fill(const Double_t *var, Int_t istep, Double_t weight)
   fGrid[istep]->Fill(var,weight);
 }
 
+//____________________________________________________________________
+void AliCFContainer::FillSteps(const Double_t *var, Int_t nSteps, const Int_t *steps, Double_t weight)
+{
+  //
+  // Fills the grids of the nSteps selection steps in steps for a set of values
+  // of the input variables, with a given weight (by default w=1).
+  // All the steps share the same binning: the bins are found once
+  // (grids with errors are filled with the values, see AliCFGridSparse::FillBins())
+  //
+  if (nSteps<=0) return;
+  for (Int_t i=0; i<nSteps; i++) {
+    if(steps[i] >= fNStep || steps[i] < 0){
+      AliError("Non-existent selection step, grids were not filled");
+      return;
+    }
+  }
+  Int_t *bin = new Int_t[GetNVar()];
+  fGrid[steps[0]]->FindBins(var,bin);
+  for (Int_t i=0; i<nSteps; i++) fGrid[steps[i]]->FillBins(bin,var,weight);
+  delete [] bin;
+}
+
+//____________________________________________________________________
+void AliCFContainer::FillN(Int_t n, const Double_t *var, Int_t istep, const Double_t *weight)
+{
+  //
+  // Fills the grid at selection step istep with n entries,
+  // see AliCFGridSparse::FillN()
+  //
+  if(istep >= fNStep || istep < 0){
+    AliError("Non-existent selection step, grid was not filled");
+    return;
+  }
+  fGrid[istep]->FillN(n,var,weight);
+}
+
 //____________________________________________________________________
 TH1* AliCFContainer::Project(Int_t istep, Int_t ivar1, Int_t ivar2, Int_t ivar3) const
 {
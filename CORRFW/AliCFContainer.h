@@ -62,6 +62,8 @@ class AliCFContainer : public AliCFFrame
   virtual Int_t GetNStep() const {return fNStep;};
   virtual void  SetNStep(Int_t nStep) {fNStep=nStep;}
   virtual void  Fill(const Double_t *var, Int_t istep, Double_t weight=1.) ;
+  virtual void  FillSteps(const Double_t *var, Int_t nSteps, const Int_t *steps, Double_t weight=1.) ;
+  virtual void  FillN(Int_t n, const Double_t *var, Int_t istep, const Double_t *weight=0x0) ;
 
   virtual Float_t  GetOverFlows (Int_t var,Int_t istep,Bool_t excl=kFALSE) const;
   virtual Float_t  GetUnderFlows(Int_t var,Int_t istep,Bool_t excl=kFALSE) const ;
@@ -131,6 +131,111 @@ void AliCFGridSparse::Fill(const Double_t *var, Double_t weight)
   fData->Fill(var,weight);
 }
 
+//____________________________________________________________________
+void AliCFGridSparse::FillN(Int_t n, const Double_t *var, const Double_t *weight)
+{
+  //
+  // Fill the grid with n entries at once.
+  // var holds the values of the input variables entry after entry (n*GetNVar() values),
+  // weight the n weights (w=1 for all entries if null).
+  // The bins are found with the axis tables taken once for all the entries,
+  // then filled as in Fill()
+  // With errors (SumW2) THnBase::Fill() is used, it also sums w*x and w*x*x per axis
+  //
+  if (n<=0) return;
+  const Int_t nVar = GetNVar();
+  if (fData->GetCalculateErrors()) {
+    for (Int_t i=0; i<n; i++) fData->Fill(&var[i*nVar],(weight ? weight[i] : 1.));
+    return;
+  }
+  Int_t    *nBins = new Int_t[nVar];
+  Double_t *xMin  = new Double_t[nVar];
+  Double_t *xMax  = new Double_t[nVar];
+  const Double_t **edges = new const Double_t*[nVar];
+  Int_t    *bin   = new Int_t[nVar];
+  GetAxisTables(nBins,xMin,xMax,edges);
+
+  for (Int_t i=0; i<n; i++) {
+    LookupBins(1,&var[i*nVar],bin,nBins,xMin,xMax,edges);
+    fData->FillBin(fData->GetBin(bin,kTRUE),(weight ? weight[i] : 1.));
+  }
+
+  delete [] nBins;
+  delete [] xMin;
+  delete [] xMax;
+  delete [] edges;
+  delete [] bin;
+}
+
+//____________________________________________________________________
+void AliCFGridSparse::FillBins(const Int_t *bin, const Double_t *var, Double_t weight)
+{
+  //
+  // Fill the grid at the bin coordinates found with FindBins() for the values var,
+  // with weight (by default w=1)
+  // With errors (SumW2) the values are filled with THnBase::Fill(), which also
+  // sums w*x and w*x*x per axis, so that projections have the same mean and RMS as with Fill()
+  //
+  if (fData->GetCalculateErrors()) fData->Fill(var,weight);
+  else fData->FillBin(fData->GetBin(bin,kTRUE),weight);
+}
+
+//____________________________________________________________________
+void AliCFGridSparse::FindBins(const Double_t *var, Int_t *bin) const
+{
+  //
+  // Bin coordinates (including under- and overflows) of a set of values of the input variables.
+  // The same coordinates can be used to fill several grids with the same binning, see FillBins()
+  //
+  const Int_t nVar = GetNVar();
+  Int_t    *nBins = new Int_t[nVar];
+  Double_t *xMin  = new Double_t[nVar];
+  Double_t *xMax  = new Double_t[nVar];
+  const Double_t **edges = new const Double_t*[nVar];
+  GetAxisTables(nBins,xMin,xMax,edges);
+  LookupBins(1,var,bin,nBins,xMin,xMax,edges);
+  delete [] nBins;
+  delete [] xMin;
+  delete [] xMax;
+  delete [] edges;
+}
+
+//____________________________________________________________________
+void AliCFGridSparse::GetAxisTables(Int_t *nBins, Double_t *xMin, Double_t *xMax, const Double_t **edges) const
+{
+  //
+  // Number of bins, limits and bin edges (null for uniform binning) of each axis
+  //
+  for (Int_t iVar=0; iVar<GetNVar(); iVar++) {
+    const TAxis *axis = fData->GetAxis(iVar);
+    nBins[iVar] = axis->GetNbins();
+    xMin[iVar]  = axis->GetXmin();
+    xMax[iVar]  = axis->GetXmax();
+    edges[iVar] = (axis->GetXbins()->GetSize() ? axis->GetXbins()->GetArray() : 0x0);
+  }
+}
+
+//____________________________________________________________________
+void AliCFGridSparse::LookupBins(Int_t n, const Double_t *var, Int_t *bin, const Int_t *nBins,
+                                 const Double_t *xMin, const Double_t *xMax, const Double_t **edges) const
+{
+  //
+  // Bin coordinates of n entries, using the axis tables of GetAxisTables().
+  // Same arithmetic as TAxis::FindBin, so that the bins are the same as in Fill()
+  //
+  const Int_t nVar = GetNVar();
+  for (Int_t i=0; i<n; i++) {
+    for (Int_t iVar=0; iVar<nVar; iVar++) {
+      const Double_t x = var[i*nVar+iVar];
+      Int_t &b = bin[i*nVar+iVar];
+      if (x < xMin[iVar])         b = 0;
+      else if (!(x < xMax[iVar])) b = nBins[iVar]+1;
+      else if (!edges[iVar])      b = 1 + Int_t(nBins[iVar]*(x-xMin[iVar])/(xMax[iVar]-xMin[iVar]));
+      else                        b = 1 + TMath::BinarySearch(nBins[iVar]+1,edges[iVar],x);
+    }
+  }
+}
+
 //___________________________________________________________________
 AliCFGridSparse* AliCFGridSparse::MakeSlice(Int_t nVars, const Int_t* vars, const Double_t* varMin, const Double_t* varMax, Bool_t useBins) const
 {
@@ -149,18 +254,25 @@ AliCFGridSparse* AliCFGridSparse::MakeSlice(Int_t nVars, const Int_t* vars, cons
   // create new grid sparse
   AliCFGridSparse* out = new AliCFGridSparse(fName,fTitle,nVars,bins);
 
-  //set the range in the THnSparse to project
-  THnSparse* clone = ((THnSparse*)fData->Clone());
+  //set the range in the THnSparse to project, the ranges are restored after the projection
+  //instead of projecting a clone of the whole grid
+  Int_t  *first    = new Int_t[GetNVar()];
+  Int_t  *last     = new Int_t[GetNVar()];
+  Bool_t *hasRange = new Bool_t[GetNVar()];
+  SaveAxisRanges(first,last,hasRange);
   if (varMin && varMax) {
     for (Int_t iAxis=0; iAxis<GetNVar(); iAxis++) {
-      SetAxisRange(clone->GetAxis(iAxis),varMin[iAxis],varMax[iAxis],useBins);
+      SetAxisRange(fData->GetAxis(iAxis),varMin[iAxis],varMax[iAxis],useBins);
     }
   }
   else AliInfo("Keeping same axis ranges");
 
-  out->SetGrid(clone->Projection(nVars,vars));
+  out->SetGrid(fData->Projection(nVars,vars));
+  RestoreAxisRanges(first,last,hasRange);
   delete [] bins;
-  delete clone;
+  delete [] first;
+  delete [] last;
+  delete [] hasRange;
   return out;
 }
 
@@ -261,10 +373,7 @@ void AliCFGridSparse::SetElement(Long_t index, Float_t val)
   //
   // Sets grid element value
   //
-  Int_t* bin = new Int_t[GetNVar()];
-  fData->GetBinContent(index,bin); //affects the bin coordinates
-  SetElement(bin,val);
-  delete [] bin ;
+  fData->SetBinContent((Long64_t)index,val);
 }
 
 //____________________________________________________________________
@@ -294,10 +403,7 @@ void AliCFGridSparse::SetElementError(Long_t index, Float_t val)
   //
   // Sets grid element iel error to val (linear indexing) in AliCFFrame
   //
-  Int_t *bin = new Int_t[GetNVar()];
-  fData->GetBinContent(index,bin);
-  SetElementError(bin,val);
-  delete [] bin;
+  fData->SetBinError2((Long64_t)index,val*val);
 }
 
 //____________________________________________________________________
@@ -401,11 +507,9 @@ void AliCFGridSparse::Multiply(const AliCFGridSparse* aGrid1, const AliCFGridSpa
   if(!fSumW2  && (aGrid1->GetSumW2() || aGrid2->GetSumW2())) SumW2();
 
   fData->Reset();
-  THnSparse *h1 = aGrid1->GetGrid();
-  THnSparse *h2 = aGrid2->GetGrid();
-  h2->Multiply(h1);
-  h2->Scale(c1*c2);
-  fData->Add(h2);
+  fData->Add(aGrid2->GetGrid());
+  fData->Multiply(aGrid1->GetGrid());
+  fData->Scale(c1*c2);
 }
 
 //____________________________________________________________________
@@ -422,9 +526,7 @@ void AliCFGridSparse::Divide(const AliCFGridSparse* aGrid, Double_t c)
   
   if (!fSumW2  && aGrid->GetSumW2()) SumW2();
 
-  THnSparse *h1 = aGrid->GetGrid();
-  THnSparse *h2 = (THnSparse*)fData->Clone();
-  fData->Divide(h2,h1);
+  fData->Divide(aGrid->GetGrid());
   fData->Scale(c);
 }
 
@@ -473,14 +575,14 @@ void AliCFGridSparse::Scale(Long_t index, const Double_t *fact)
   //scale content of a certain cell by (positive) fact (with error)
   //
 
-  if (GetElement(index)==0 || fact[0]==0) return;
-
   Double_t in[2], out[2];
-  in[0]=GetElement(index);
-  in[1]=GetElementError(index);
+  in[0]=fData->GetBinContent((Long64_t)index);
+  if (in[0]==0 || fact[0]==0) return;
+
+  in[1]=fData->GetBinError((Long64_t)index);
   GetScaledValues(fact,in,out);
-  SetElement(index,out[0]);
-  if (fSumW2) SetElementError(index,out[1]);
+  fData->SetBinContent((Long64_t)index,out[0]);
+  if (fSumW2) fData->SetBinError2((Long64_t)index,out[1]*out[1]);
 }
 //____________________________________________________________________
 void AliCFGridSparse::Scale(const Int_t *bin, const Double_t *fact)
@@ -519,10 +621,17 @@ void AliCFGridSparse::Scale(const Double_t* fact)
 {
   //
   //scale contents of the whole grid by fact
+  //single pass over the filled bins, addressed by their index in the THnSparse
   //
 
-  for (Long_t iel=0; iel<GetNFilledBins(); iel++) {
-    Scale(iel,fact);
+  if (fact[0]==0) return;
+  const Long64_t nFilled = fData->GetNbins();
+  const Double_t relErr2 = fact[1]*fact[1]/fact[0]/fact[0];
+  for (Long64_t iel=0; iel<nFilled; iel++) {
+    const Double_t val = fData->GetBinContent(iel);
+    if (val==0) continue;
+    fData->SetBinContent(iel,val*fact[0]);
+    if (fSumW2) fData->SetBinError2(iel,(fData->GetBinError2(iel)/val/val+relErr2)*val*fact[0]*val*fact[0]);
   }
 }
 //____________________________________________________________________
@@ -621,7 +730,20 @@ TH1* AliCFGridSparse::Slice(Int_t iVar1, Int_t iVar2, Int_t iVar3, const Double_
   // If useBins=true, varMin and varMax are taken as bin numbers
   // if varmin or varmax point to null, all the range is taken, including over- and underflows
 
-  THnSparse* clone = (THnSparse*)fData->Clone();
+  if (iVar1 >= GetNVar() || iVar1 < 0 ||
+      iVar2 >= GetNVar() || (iVar3>=0 && iVar2 < 0) ||
+      iVar3 >= GetNVar()) {
+    AliError("Non-existent variable, return NULL");
+    return 0x0;
+  }
+
+  //the ranges are set on the grid itself and restored after the projection,
+  //instead of projecting a clone of the whole grid
+  Int_t  *first    = new Int_t[GetNVar()];
+  Int_t  *last     = new Int_t[GetNVar()];
+  Bool_t *hasRange = new Bool_t[GetNVar()];
+  SaveAxisRanges(first,last,hasRange);
+  THnSparse* clone = fData;
   if (varMin != 0x0 && varMax != 0x0) {
     for (Int_t iAxis=0; iAxis<GetNVar(); iAxis++) SetAxisRange(clone->GetAxis(iAxis),varMin[iAxis],varMax[iAxis],useBins);
   }
@@ -633,10 +755,6 @@ TH1* AliCFGridSparse::Slice(Int_t iVar1, Int_t iVar2, Int_t iVar3, const Double_
 
   if (iVar3<0) {
     if (iVar2<0) {
-      if (iVar1 >= GetNVar() || iVar1 < 0 ) {
-	AliError("Non-existent variable, return NULL");
-	return 0x0;
-      }
       projection = (TH1D*)clone->Projection(iVar1); 
       projection->SetTitle(Form("%s_proj-%s",GetTitle(),GetVarTitle(iVar1)));
       for (Int_t iBin=1; iBin<=projection->GetNbinsX(); iBin++) {
@@ -646,11 +764,6 @@ TH1* AliCFGridSparse::Slice(Int_t iVar1, Int_t iVar2, Int_t iVar3, const Double_
       }
     }
     else {
-      if (iVar1 >= GetNVar() || iVar1 < 0 ||
-	  iVar2 >= GetNVar() || iVar2 < 0 ) {
-	AliError("Non-existent variable, return NULL");
-	return 0x0;
-      }
       projection = (TH2D*)clone->Projection(iVar2,iVar1); 
       for (Int_t iBin=1; iBin<=projection->GetNbinsX(); iBin++) {
         Int_t origBin = GetAxis(iVar1)->GetFirst()+iBin-1;
@@ -665,12 +778,6 @@ TH1* AliCFGridSparse::Slice(Int_t iVar1, Int_t iVar2, Int_t iVar3, const Double_
     }
   }
   else {
-    if (iVar1 >= GetNVar() || iVar1 < 0 ||
-	iVar2 >= GetNVar() || iVar2 < 0 ||
-	iVar3 >= GetNVar() || iVar3 < 0 ) {
-      AliError("Non-existent variable, return NULL");
-      return 0x0;
-    }
     projection = (TH3D*)clone->Projection(iVar1,iVar2,iVar3); 
     for (Int_t iBin=1; iBin<=projection->GetNbinsX(); iBin++) {
       Int_t origBin = GetAxis(iVar1)->GetFirst()+iBin-1;
@@ -692,7 +799,10 @@ TH1* AliCFGridSparse::Slice(Int_t iVar1, Int_t iVar2, Int_t iVar3, const Double_
   projection->SetName (name .Data());
   projection->SetTitle(title.Data());
 
-  delete clone;
+  RestoreAxisRanges(first,last,hasRange);
+  delete [] first;
+  delete [] last;
+  delete [] hasRange;
   return projection ;
 }
 
@@ -707,6 +817,31 @@ void AliCFGridSparse::SetAxisRange(TAxis* axis, Double_t min, Double_t max, Bool
   //axis->SetBit(TAxis::kAxisRange); // uncomment when ROOT TAxis is fixed
 }
 
+//____________________________________________________________________
+void AliCFGridSparse::SaveAxisRanges(Int_t *first, Int_t *last, Bool_t *hasRange) const {
+  //
+  // save the current range of every axis
+  //
+  for (Int_t iAxis=0; iAxis<GetNVar(); iAxis++) {
+    TAxis *axis = fData->GetAxis(iAxis);
+    first[iAxis]    = axis->GetFirst();
+    last[iAxis]     = axis->GetLast();
+    hasRange[iAxis] = axis->TestBit(TAxis::kAxisRange);
+  }
+}
+
+//____________________________________________________________________
+void AliCFGridSparse::RestoreAxisRanges(const Int_t *first, const Int_t *last, const Bool_t *hasRange) const {
+  //
+  // restore the ranges saved with SaveAxisRanges()
+  //
+  for (Int_t iAxis=0; iAxis<GetNVar(); iAxis++) {
+    TAxis *axis = fData->GetAxis(iAxis);
+    axis->SetRange(first[iAxis],last[iAxis]);
+    axis->SetBit(TAxis::kAxisRange,hasRange[iAxis]);
+  }
+}
+
 //____________________________________________________________________
 void AliCFGridSparse::SetRangeUser(Int_t iVar, Double_t varMin, Double_t varMax, Bool_t useBins) const {
   //
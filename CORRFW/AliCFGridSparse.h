@@ -56,6 +56,9 @@ class AliCFGridSparse : public AliCFFrame
   //virtual Int_t      GetBinIndex(Int_t ivar, Int_t ind) const ;
 
   virtual void    Fill(const Double_t *var, Double_t weight=1.);
+  virtual void    FillN(Int_t n, const Double_t *var, const Double_t *weight=0x0);
+  virtual void    FillBins(const Int_t *bin, const Double_t *var, Double_t weight=1.);
+  virtual void    FindBins(const Double_t *var, Int_t *bin) const;
   virtual Float_t GetEntries()const;
   virtual Float_t GetElement(Long_t iel)               const; 
   virtual Float_t GetElement(const Int_t *bin)         const; 
@@ -115,6 +118,10 @@ class AliCFGridSparse : public AliCFFrame
 
   //protected functions
   void     GetScaledValues(const Double_t *fact, const Double_t *in, Double_t *out) const;
+  void     GetAxisTables(Int_t *nBins, Double_t *xMin, Double_t *xMax, const Double_t **edges) const;
+  void     LookupBins(Int_t n, const Double_t *var, Int_t *bin, const Int_t *nBins, const Double_t *xMin, const Double_t *xMax, const Double_t **edges) const;
+  void     SaveAxisRanges(Int_t *first, Int_t *last, Bool_t *hasRange) const;
+  void     RestoreAxisRanges(const Int_t *first, const Int_t *last, const Bool_t *hasRange) const;
   void     SetAxisRange(TAxis* axis, Double_t min, Double_t max, Bool_t useBins) const;
   void     GetProjectionName (TString& s,Int_t var0, Int_t var1=-1, Int_t var2=-1) const;
   void     GetProjectionTitle(TString& s,Int_t var0, Int_t var1=-1, Int_t var2=-1) const;
@@ -104,7 +104,16 @@ AliAnalysisTaskSE(),
   fHOutNTEPRes(0),
   fHOutPTPsi(0),
   fHOutDiff(0),
-  fHOutleadPTPsi(0)
+  fHOutleadPTPsi(0),
+  fTrackPhi(),
+  fTrackPt(),
+  fTrackEta(),
+  fTrackCharge(),
+  fTrackID(),
+  fTrackPhiWeight(),
+  fTrackWeight(),
+  fTrackQx(),
+  fTrackQy()
 {
   // Default constructor
   AliInfo("Event Plane Selection enabled.");
@@ -155,7 +164,16 @@ AliEPSelectionTask::AliEPSelectionTask(const char *name):
   fHOutNTEPRes(0),
   fHOutPTPsi(0),
   fHOutDiff(0),
-  fHOutleadPTPsi(0)
+  fHOutleadPTPsi(0),
+  fTrackPhi(),
+  fTrackPt(),
+  fTrackEta(),
+  fTrackCharge(),
+  fTrackID(),
+  fTrackPhiWeight(),
+  fTrackWeight(),
+  fTrackQx(),
+  fTrackQy()
 {
   // Default constructor
   AliInfo("Event Plane Selection enabled.");
@@ -250,6 +268,7 @@ void AliEPSelectionTask::UserExec(Option_t */*option*/)
 //   fRunNumber = -15;
 
   AliEventplane *esdEP;
+  TVector2 qq;
   TVector2 qq1;
   TVector2 qq2;
   Double_t fRP = 0.; // monte carlo reaction plane angle
@@ -294,11 +313,11 @@ void AliEPSelectionTask::UserExec(Option_t */*option*/)
 
       if (nt>4){
 
-	// qvector full event
-	fQVector = new TVector2(GetQ(esdEP,tracklist));
+	// qvector full event and subevents, in one pass over the tracks
+	FillTrackArrays(tracklist);
+	ComputeQVectors(esdEP, nt, qq, qq1, qq2);
+	fQVector = new TVector2(qq);
 	fEventplaneQ = fQVector->Phi()/2;
-	// q vector subevents
-	GetQsub(qq1, qq2, tracklist, esdEP);
 	fQsub1 = new TVector2(qq1);
 	fQsub2 = new TVector2(qq2);
 	fQsubRes = (fQsub1->Phi()/2 - fQsub2->Phi()/2);
@@ -314,16 +333,13 @@ void AliEPSelectionTask::UserExec(Option_t */*option*/)
 
 	if (fUseMCRP) fHOutDiff->Fill(fEventplaneQ, fRP);
 
-	for (int iter = 0; iter<nt;iter++){
-	  AliESDtrack* track = dynamic_cast<AliESDtrack*> (tracklist->At(iter));
-	  if (track) {
-	    float delta = track->Phi()-fEventplaneQ;
-	    while (delta < 0) delta += TMath::Pi();
-	    while (delta > TMath::Pi()) delta -= TMath::Pi();
-	    fHOutPTPsi->Fill(track->Pt(),delta);
-	    fHOutPhi->Fill(track->Phi());
-	    fHOutPhiCorr->Fill(track->Phi(),GetPhiWeight(track));
-          }
+	for (UInt_t iter = 0; iter<fTrackPhi.size();iter++){
+	  float delta = fTrackPhi[iter]-fEventplaneQ;
+	  while (delta < 0) delta += TMath::Pi();
+	  while (delta > TMath::Pi()) delta -= TMath::Pi();
+	  fHOutPTPsi->Fill(fTrackPt[iter],delta);
+	  fHOutPhi->Fill(fTrackPhi[iter]);
+	  fHOutPhiCorr->Fill(fTrackPhi[iter],fTrackPhiWeight[iter]);
 	}
 
 	AliESDtrack* trmax = esd->GetTrack(0);
@@ -388,11 +404,11 @@ void AliEPSelectionTask::UserExec(Option_t */*option*/)
 
       if (NT>4){
 
-	// qvector full event
-	fQVector = new TVector2(GetQ(esdEP,tracklist));
+	// qvector full event and subevents, in one pass over the tracks
+	FillTrackArrays(tracklist);
+	ComputeQVectors(esdEP, NT, qq, qq1, qq2);
+	fQVector = new TVector2(qq);
 	fEventplaneQ = fQVector->Phi()/2;
-	// q vector subevents
-	GetQsub(qq1, qq2, tracklist, esdEP);
 	fQsub1 = new TVector2(qq1);
 	fQsub2 = new TVector2(qq2);
 	fQsubRes = (fQsub1->Phi()/2 - fQsub2->Phi()/2);
@@ -408,16 +424,13 @@ void AliEPSelectionTask::UserExec(Option_t */*option*/)
 
 	if (fUseMCRP) fHOutDiff->Fill(fEventplaneQ, fRP);
 
-	for (int iter = 0; iter<NT;iter++){
-	  AliAODTrack* track = dynamic_cast<AliAODTrack*> (tracklist->At(iter));
-	  if (track) {
-	    float delta = track->Phi()-fEventplaneQ;
-	    while (delta < 0) delta += TMath::Pi();
-	    while (delta > TMath::Pi()) delta -= TMath::Pi();
-	    fHOutPTPsi->Fill(track->Pt(),delta);
-	    fHOutPhi->Fill(track->Phi());
-	    fHOutPhiCorr->Fill(track->Phi(),GetPhiWeight(track));
-	  }
+	for (UInt_t iter = 0; iter<fTrackPhi.size();iter++){
+	  float delta = fTrackPhi[iter]-fEventplaneQ;
+	  while (delta < 0) delta += TMath::Pi();
+	  while (delta > TMath::Pi()) delta -= TMath::Pi();
+	  fHOutPTPsi->Fill(fTrackPt[iter],delta);
+	  fHOutPhi->Fill(fTrackPhi[iter]);
+	  fHOutPhiCorr->Fill(fTrackPhi[iter],fTrackPhiWeight[iter]);
 	}
 
 	AliAODTrack* trmax = dynamic_cast<AliAODTrack*>(aod->GetTrack(0));
@@ -453,170 +466,165 @@ void AliEPSelectionTask::Terminate(Option_t */*option*/)
 TVector2 AliEPSelectionTask::GetQ(AliEventplane* EP, TObjArray* tracklist)
 {
   // Get the Q vector
+  TVector2 mQ, mQsub1, mQsub2;
+  FillTrackArrays(tracklist);
+  ComputeQVectors(EP, tracklist->GetEntries(), mQ, mQsub1, mQsub2);
+  return mQ;
+}
+
+  //________________________________________________________________________
+void AliEPSelectionTask::GetQsub(TVector2 &Q1, TVector2 &Q2, TObjArray* tracklist,AliEventplane* EP)
+{
+  // Get Qsub
   TVector2 mQ;
-  float mQx=0, mQy=0;
-  AliVTrack* track;
-  Double_t weight;
-  Int_t idtemp = -1;
-  // get recentering values
-  Double_t mean[2], rms[2];
-  Recenter(0, mean);
-  Recenter(1, rms);
+  FillTrackArrays(tracklist);
+  ComputeQVectors(EP, tracklist->GetEntries(), mQ, Q1, Q2);
+}
 
-  int nt = tracklist->GetEntries();
+//__________________________________________________________________________
+void AliEPSelectionTask::FillTrackArrays(TObjArray* tracklist)
+{
+  // Copy phi, pT, eta, charge, ID and weights of the tracks of the list into
+  // contiguous arrays: one cast and one phi weight table lookup per track
+  fTrackPhi.clear();
+  fTrackPt.clear();
+  fTrackEta.clear();
+  fTrackCharge.clear();
+  fTrackID.clear();
+  fTrackPhiWeight.clear();
+  fTrackWeight.clear();
+
+  // phi distribution used for the weights, see SelectPhiDist
+  const Bool_t singleDist = (fPeriod.CompareTo("LHC10h")==0 || fUserphidist);
+  const Bool_t chargeEtaDist = (!singleDist && fPeriod.CompareTo("LHC11h")==0);
+  const Bool_t negativeID = ((fAnalysisInput.CompareTo("AOD")==0) && (fAODfilterbit == 128));
 
+  int nt = tracklist->GetEntries();
   for (int i=0; i<nt; i++){
-    weight = 1;
-    track = dynamic_cast<AliVTrack*> (tracklist->At(i));
-    if (track) {
-      weight = GetWeight(track);
-    if (fSaveTrackContribution){
-      idtemp = track->GetID();
-      if ((fAnalysisInput.CompareTo("AOD")==0) && (fAODfilterbit == 128)) idtemp = idtemp*(-1) - 1;
-      EP->GetQContributionXArray()->AddAt(weight*cos(2*track->Phi())/rms[0],idtemp);
-      EP->GetQContributionYArray()->AddAt(weight*sin(2*track->Phi())/rms[1],idtemp);
-     }
-     mQx += (weight*cos(2*track->Phi())/rms[0]);
-     mQy += (weight*sin(2*track->Phi())/rms[1]);
+    AliVTrack* track = dynamic_cast<AliVTrack*> (tracklist->At(i));
+    if (!track) continue;
+    Double_t phi = track->Phi();
+    Double_t pt = track->Pt();
+    Double_t eta = track->Eta();
+    Short_t cha = track->Charge();
+    Int_t idtemp = track->GetID();
+    if (negativeID) idtemp = idtemp*(-1) - 1;
+
+    Double_t phiweight = 1;
+    if (fUsePhiWeight) {
+      Int_t idist = -1;
+      if (singleDist) idist = 0;
+      else if (chargeEtaDist && cha != 0 && eta != 0.) idist = (cha < 0 ? 0 : 1) + (eta < 0. ? 0 : 2);
+      if (idist >= 0 && !fPhiWeightTable[idist].empty()) {
+        const Int_t nPhibins = fPhiWeightTable[idist].size() - 2;
+        Int_t bin = 1+TMath::FloorNint(phi*nPhibins/TMath::TwoPi());
+        if (bin < 0) bin = 0;
+        if (bin > nPhibins+1) bin = nPhibins+1;
+        phiweight = fPhiWeightTable[idist][bin];
+      }
     }
+    Double_t ptweight = 1;
+    if (fUsePtWeight) {
+      if (pt<2) ptweight = pt;
+      else ptweight = 2;
+    }
+
+    fTrackPhi.push_back(phi);
+    fTrackPt.push_back(pt);
+    fTrackEta.push_back(eta);
+    fTrackCharge.push_back(cha);
+    fTrackID.push_back(idtemp);
+    fTrackPhiWeight.push_back(phiweight);
+    fTrackWeight.push_back(ptweight*phiweight);
   }
-  mQ.Set(mQx-(mean[0]/rms[0]), mQy-(mean[1]/rms[1]));
-  return mQ;
 }
 
-  //________________________________________________________________________
-void AliEPSelectionTask::GetQsub(TVector2 &Q1, TVector2 &Q2, TObjArray* tracklist,AliEventplane* EP)
+//__________________________________________________________________________
+void AliEPSelectionTask::ComputeQVectors(AliEventplane* EP, Int_t nt, TVector2& Q, TVector2& Q1, TVector2& Q2)
 {
-  // Get Qsub
-  TVector2 mQ[2];
-  float mQx1=0, mQy1=0, mQx2=0, mQy2=0;
-  Double_t weight;
+  // Q vector of the full event and of the two subevents from the track arrays of FillTrackArrays.
+  // nt is the number of entries of the track list, which sets the size of the random subevents.
+  // The cos and sin terms of all tracks are computed first in a loop without branches,
+  // then the sums are done in a single pass for the full event and the subevents.
+  float mQx=0, mQy=0, mQx1=0, mQy1=0, mQx2=0, mQy2=0;
   // get recentering values
   Double_t mean[2], rms[2];
   Recenter(0, mean);
   Recenter(1, rms);
 
-  AliVTrack* track;
-  TRandom2 rn = 0;
+  const Int_t ntracks = fTrackPhi.size();
+  fTrackQx.resize(ntracks);
+  fTrackQy.resize(ntracks);
+  for (Int_t i=0; i<ntracks; i++){
+    fTrackQx[i] = fTrackWeight[i]*cos(2*fTrackPhi[i])/rms[0];
+    fTrackQy[i] = fTrackWeight[i]*sin(2*fTrackPhi[i])/rms[1];
+  }
 
-  int nt = tracklist->GetEntries();
+  const Bool_t validSplit = (fSplitMethod == AliEPSelectionTask::kRandom ||
+                             fSplitMethod == AliEPSelectionTask::kEta ||
+                             fSplitMethod == AliEPSelectionTask::kCharge);
+  if (!validSplit) printf("plane resolution determination method not available!\n\n ");
+
+  TRandom2 rn = 0;
   int trackcounter1=0, trackcounter2=0;
-  int idtemp = 0;
 
-  if (fSplitMethod == AliEPSelectionTask::kRandom){
+  for (Int_t i=0; i<ntracks; i++){
+    const Double_t qx = fTrackQx[i];
+    const Double_t qy = fTrackQy[i];
+    const Int_t idtemp = fTrackID[i];
 
-    for (Int_t i = 0; i < nt; i++) {
-      weight = 1;
-      track = dynamic_cast<AliVTrack*> (tracklist->At(i));
-      if (!track) continue;
-      weight = GetWeight(track);
-      idtemp = track->GetID();
-      if ((fAnalysisInput.CompareTo("AOD")==0) && (fAODfilterbit == 128)) idtemp = idtemp*(-1) - 1;
+    mQx += qx;
+    mQy += qy;
+    if (fSaveTrackContribution){
+      EP->GetQContributionXArray()->AddAt(qx,idtemp);
+      EP->GetQContributionYArray()->AddAt(qy,idtemp);
+    }
 
-      // This loop splits the track set into 2 random subsets
+    // subevent of the track: 1, 2 or none (0)
+    Int_t sub = 0;
+    if (fSplitMethod == AliEPSelectionTask::kRandom){
+      // splits the track set into 2 random subsets
       if( trackcounter1 < int(nt/2.) && trackcounter2 < int(nt/2.)){
         float random = rn.Rndm();
-        if(random < .5){
-          mQx1 += (weight*cos(2*track->Phi())/rms[0]);
-          mQy1 += (weight*sin(2*track->Phi())/rms[1]);
-          if (fSaveTrackContribution){
-            EP->GetQContributionXArraysub1()->AddAt(weight*cos(2*track->Phi())/rms[0],idtemp);
-            EP->GetQContributionYArraysub1()->AddAt(weight*sin(2*track->Phi())/rms[1],idtemp);
-          }
-          trackcounter1++;
-        }
-        else {
-          mQx2 += (weight*cos(2*track->Phi())/rms[0]);
-          mQy2 += (weight*sin(2*track->Phi())/rms[1]);
-          if (fSaveTrackContribution){
-            EP->GetQContributionXArraysub2()->AddAt(weight*cos(2*track->Phi())/rms[0],idtemp);
-            EP->GetQContributionYArraysub2()->AddAt(weight*sin(2*track->Phi())/rms[1],idtemp);
-          }
-          trackcounter2++;
-        }
-      }
-      else if( trackcounter1 >= int(nt/2.)){
-        mQx2 += (weight*cos(2*track->Phi())/rms[0]);
-        mQy2 += (weight*sin(2*track->Phi())/rms[1]);
-        if (fSaveTrackContribution){
-          EP->GetQContributionXArraysub2()->AddAt(weight*cos(2*track->Phi())/rms[0],idtemp);
-          EP->GetQContributionYArraysub2()->AddAt(weight*sin(2*track->Phi())/rms[1],idtemp);
-        }
-        trackcounter2++;
-      }
-      else {
-        mQx1 += (weight*cos(2*track->Phi())/rms[0]);
-        mQy1 += (weight*sin(2*track->Phi())/rms[1]);
-        if (fSaveTrackContribution){
-          EP->GetQContributionXArraysub1()->AddAt(weight*cos(2*track->Phi())/rms[0],idtemp);
-          EP->GetQContributionYArraysub1()->AddAt(weight*sin(2*track->Phi())/rms[1],idtemp);
-        }
-        trackcounter1++;
+        sub = (random < .5) ? 1 : 2;
       }
+      else if( trackcounter1 >= int(nt/2.)) sub = 2;
+      else sub = 1;
+      if (sub == 1) trackcounter1++;
+      else trackcounter2++;
     }
-  } else if (fSplitMethod == AliEPSelectionTask::kEta) {
-
-    for (Int_t i = 0; i < nt; i++) {
-      weight = 1;
-      track = dynamic_cast<AliVTrack*> (tracklist->At(i));
-      if (!track) continue;
-      weight = GetWeight(track);
-      Double_t eta = track->Eta();
-      idtemp = track->GetID();
-      if ((fAnalysisInput.CompareTo("AOD")==0) && (fAODfilterbit == 128)) idtemp = idtemp*(-1) - 1;
-
-      if (eta > fEtaGap/2.) {
-        mQx1 += (weight*cos(2*track->Phi())/rms[0]);
-        mQy1 += (weight*sin(2*track->Phi())/rms[1]);
-        if (fSaveTrackContribution){
-          EP->GetQContributionXArraysub1()->AddAt(weight*cos(2*track->Phi())/rms[0],idtemp);
-          EP->GetQContributionYArraysub1()->AddAt(weight*sin(2*track->Phi())/rms[1],idtemp);
-        }
-      } else if (eta < -1.*fEtaGap/2.) {
-        mQx2 += (weight*cos(2*track->Phi())/rms[0]);
-        mQy2 += (weight*sin(2*track->Phi())/rms[1]);
-        if (fSaveTrackContribution){
-          EP->GetQContributionXArraysub2()->AddAt(weight*cos(2*track->Phi())/rms[0],idtemp);
-          EP->GetQContributionYArraysub2()->AddAt(weight*sin(2*track->Phi())/rms[1],idtemp);
-        }
+    else if (fSplitMethod == AliEPSelectionTask::kEta){
+      if (fTrackEta[i] > fEtaGap/2.) sub = 1;
+      else if (fTrackEta[i] < -1.*fEtaGap/2.) sub = 2;
+    }
+    else if (fSplitMethod == AliEPSelectionTask::kCharge){
+      if (fTrackCharge[i] > 0) sub = 1;
+      else if (fTrackCharge[i] < 0) sub = 2;
+    }
+
+    if (sub == 1){
+      mQx1 += qx;
+      mQy1 += qy;
+      if (fSaveTrackContribution){
+        EP->GetQContributionXArraysub1()->AddAt(qx,idtemp);
+        EP->GetQContributionYArraysub1()->AddAt(qy,idtemp);
       }
     }
-  } else if (fSplitMethod == AliEPSelectionTask::kCharge) {
-
-    for (Int_t i = 0; i < nt; i++) {
-      weight = 1;
-      track = dynamic_cast<AliVTrack*> (tracklist->At(i));
-      if (!track) continue;
-      weight = GetWeight(track);
-      Short_t cha = track->Charge();
-      idtemp = track->GetID();
-      if ((fAnalysisInput.CompareTo("AOD")==0) && (fAODfilterbit == 128)) idtemp = idtemp*(-1) - 1;
-
-      if (cha > 0) {
-        mQx1 += (weight*cos(2*track->Phi())/rms[0]);
-        mQy1 += (weight*sin(2*track->Phi())/rms[1]);
-        if (fSaveTrackContribution){
-          EP->GetQContributionXArraysub1()->AddAt(weight*cos(2*track->Phi())/rms[0],idtemp);
-          EP->GetQContributionYArraysub1()->AddAt(weight*sin(2*track->Phi())/rms[1],idtemp);
-        }
-      } else if (cha < 0) {
-        mQx2 += (weight*cos(2*track->Phi())/rms[0]);
-        mQy2 += (weight*sin(2*track->Phi())/rms[1]);
-        if (fSaveTrackContribution){
-          EP->GetQContributionXArraysub2()->AddAt(weight*cos(2*track->Phi())/rms[0],idtemp);
-          EP->GetQContributionYArraysub2()->AddAt(weight*sin(2*track->Phi())/rms[1],idtemp);
-        }
+    else if (sub == 2){
+      mQx2 += qx;
+      mQy2 += qy;
+      if (fSaveTrackContribution){
+        EP->GetQContributionXArraysub2()->AddAt(qx,idtemp);
+        EP->GetQContributionYArraysub2()->AddAt(qy,idtemp);
       }
     }
-  } else {
-    printf("plane resolution determination method not available!\n\n ");
-    return;
   }
-  // apply recenetering
-  mQ[0].Set(mQx1-(mean[0]/rms[0]), mQy1-(mean[1]/rms[1]));
-  mQ[1].Set(mQx2-(mean[0]/rms[0]), mQy2-(mean[1]/rms[1]));
-  Q1 = mQ[0];
-  Q2 = mQ[1];
+
+  // apply recentering
+  Q.Set(mQx-(mean[0]/rms[0]), mQy-(mean[1]/rms[1]));
+  if (!validSplit) return;
+  Q1.Set(mQx1-(mean[0]/rms[0]), mQy1-(mean[1]/rms[1]));
+  Q2.Set(mQx2-(mean[0]/rms[0]), mQy2-(mean[1]/rms[1]));
 }
 
 //________________________________________________________________________
@@ -814,6 +822,25 @@ void AliEPSelectionTask::SetPhiDist()
   AliInfo("No Phi-weights available. All Phi weights set to 1");
   SetUsePhiWeight(kFALSE);
   }
+  SetPhiWeightTables();
+}
+
+//__________________________________________________________________________
+void AliEPSelectionTask::SetPhiWeightTables()
+{
+  // Phi weight of each bin of the phi distributions, as computed by GetPhiWeight,
+  // so that the weight of a track is a table lookup
+  for (Int_t i = 0; i < 4; i++) {
+    fPhiWeightTable[i].clear();
+    if (!fPhiDist[i]) continue;
+    Double_t nParticles = fPhiDist[i]->Integral();
+    Double_t nPhibins = fPhiDist[i]->GetNbinsX();
+    fPhiWeightTable[i].assign(fPhiDist[i]->GetNbinsX()+2, 1.);
+    for (Int_t bin = 0; bin <= fPhiDist[i]->GetNbinsX()+1; bin++) {
+      Double_t PhiDistValue = fPhiDist[i]->GetBinContent(bin);
+      if (PhiDistValue > 0) fPhiWeightTable[i][bin] = nParticles/nPhibins/PhiDistValue;
+    }
+  }
 }
 
 //__________________________________________________________________________
@@ -9,6 +9,8 @@
 //   author: Alberica Toia, Johanna Gramling
 //*****************************************************
 
+#include <vector>
+
 #include "AliAnalysisTaskSE.h"
 
 class TFile;
@@ -72,6 +74,9 @@ class AliEPSelectionTask : public AliAnalysisTaskSE {
   TObjArray* GetAODTracksAndMaxID(AliAODEvent* aod, Int_t& maxid);
   void SetOADBandPeriod();
   TH1F* SelectPhiDist(AliVTrack *track);
+  void SetPhiWeightTables();
+  void FillTrackArrays(TObjArray* tracklist);
+  void ComputeQVectors(AliEventplane* EP, Int_t nt, TVector2& Q, TVector2& Q1, TVector2& Q2);
   TObjArray* GetTracksForLHC11h(AliESDEvent* esd);
 
   TString  fAnalysisInput; 		// "ESD", "AOD"
@@ -119,7 +124,20 @@ class AliEPSelectionTask : public AliAnalysisTaskSE {
   TH2F*	 fHOutDiff;			//! control histogram: Difference of MC RP and EP - only filled if fUseMCRP is true!
   TH2F*  fHOutleadPTPsi;		//! control histogram: emission angle of leading pT track vs EP angle
 
-  ClassDef(AliEPSelectionTask,4); 
+  std::vector<Double_t> fPhiWeightTable[4]; //! phi weights of fPhiDist, indexed by bin (under- and overflow included)
+
+  // tracks of the event, filled once by FillTrackArrays
+  std::vector<Double_t> fTrackPhi;	//! phi
+  std::vector<Double_t> fTrackPt;	//! pT
+  std::vector<Double_t> fTrackEta;	//! eta
+  std::vector<Short_t>  fTrackCharge;	//! charge
+  std::vector<Int_t>    fTrackID;	//! index in the Q contribution arrays
+  std::vector<Double_t> fTrackPhiWeight;	//! phi weight
+  std::vector<Double_t> fTrackWeight;	//! total (pT times phi) weight
+  std::vector<Double_t> fTrackQx;	//! weighted cos(2 phi), divided by the rms of Qx
+  std::vector<Double_t> fTrackQy;	//! weighted sin(2 phi), divided by the rms of Qy
+
+  ClassDef(AliEPSelectionTask,5); 
 };
 
 #endif
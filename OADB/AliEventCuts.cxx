@@ -1,9 +1,9 @@
 #include "AliEventCuts.h"
+#include "AliEventCutsMultiplicity.h"
 
 #include <algorithm>
 #include <array>
 using std::array;
-#include <memory>
 #include <vector>
 using std::vector;
 
@@ -16,7 +16,6 @@ using std::vector;
 #include <AliAnalysisManager.h>
 #include <AliAODMCParticle.h>
 #include <AliCentrality.h>
-#include <AliESDtrackCuts.h>
 #include <AliInputEventHandler.h>
 #include <AliMCEventHandler.h>
 #include <AliMultSelection.h>
@@ -335,78 +334,10 @@ string AliEventCuts::GetCentralityEstimator (unsigned int estimator) const {
 
 
 void AliEventCuts::ComputeTrackMultiplicity(AliVEvent *ev) {
-  AliEventCutsContainer* tmp_cont = static_cast<AliEventCutsContainer*>(ev->FindListObject("AliEventCutsContainer"));
-  if (tmp_cont) {
-    unsigned long evid = ((unsigned long)(ev->GetBunchCrossNumber()) << 32) + ev->GetTimeStamp();
-    fNewEvent = (tmp_cont->fEventId != evid);
-    tmp_cont->fEventId = evid;
-    //if (fNewEvent) ::Info("AliEventCuts::AcceptEvent","New event. %Lu", evid);
-    //else ::Info("AliEventCuts::AcceptEvent","Old event. %Lu", evid);
-
-    if (!fNewEvent) {
-      fContainer = *tmp_cont;
-      return;
-    }
-  } else tmp_cont = new AliEventCutsContainer;
-
-  bool isAOD = false;
-  if (dynamic_cast<AliAODEvent*>(ev))
-    isAOD = true;
-  else if (!dynamic_cast<AliESDEvent*>(ev))
-    AliFatal("I don't find the AOD event nor the ESD one, aborting.");
-
-  std::unique_ptr<AliESDtrackCuts> FB32cuts{AliESDtrackCuts::GetStandardITSTPCTrackCuts2011()};
-  std::unique_ptr<AliESDtrackCuts> TPConlyCuts{AliESDtrackCuts::GetStandardTPCOnlyTrackCuts()};
-
-  const int nTracks = ev->GetNumberOfTracks();
-  tmp_cont->fMultESD = (isAOD) ? ((AliAODHeader*)ev->GetHeader())->GetNumberOfESDTracks() : dynamic_cast<AliESDEvent*>(ev)->GetNumberOfTracks();
-  tmp_cont->fMultTrkFB32 = 0;
-  tmp_cont->fMultTrkFB32Acc = 0;
-  tmp_cont->fMultTrkFB32TOF = 0;
-  tmp_cont->fMultTrkTPC = 0;
-  for (int it = 0; it < nTracks; it++) {
-    if (isAOD) {
-      AliAODTrack* trk = (AliAODTrack*)ev->GetTrack(it);
-      if (!trk) continue;
-      if (trk->TestFilterBit(32)) {
-        tmp_cont->fMultTrkFB32++;
-        if ( TMath::Abs(trk->GetTOFsignalDz()) <= 10. && trk->GetTOFsignal() >= 12000. && trk->GetTOFsignal() <= 25000.)
-          tmp_cont->fMultTrkFB32TOF++;
-        if ((fabs(trk->Eta()) < 0.8) && (trk->GetTPCNcls() >= 70) && (trk->Pt() >= 0.2) && (trk->Pt() < 50))
-          tmp_cont->fMultTrkFB32Acc++;
-      }
-      if (trk->TestFilterBit(128))
-        tmp_cont->fMultTrkTPC++;
-    } else {
-      AliESDtrack* esdTrack = (AliESDtrack*)ev->GetTrack(it);
-      if (!esdTrack) continue;
-
-      if (FB32cuts->AcceptTrack(esdTrack)) {
-        tmp_cont->fMultTrkFB32++;
-        if (TMath::Abs(esdTrack->GetTOFsignalDz()) <= 10 && esdTrack->GetTOFsignal() >= 12000 && esdTrack->GetTOFsignal() <= 25000)
-          tmp_cont->fMultTrkFB32TOF++;
-
-        if ((TMath::Abs(esdTrack->Eta()) < 0.8) && (esdTrack->GetTPCNcls() > 70) && (esdTrack->Pt() > 0.2) && (esdTrack->Pt() < 50))
-          tmp_cont->fMultTrkFB32Acc++;
-      }
-
-      /// TPC only tracks, with the same cuts of the filter bit 128
-      AliESDtrack tpcParam;
-      if (!esdTrack->FillTPCOnlyTrack(tpcParam)) continue;
-      if (!TPConlyCuts->AcceptTrack(&tpcParam)) continue;
-      if (tpcParam.Pt() > 0.) {
-        // only constrain tracks above threshold
-        AliExternalTrackParam exParam;
-        // take the B-field from the ESD, no 3D fieldMap available at this point
-        bool relate = false;
-        relate = tpcParam.RelateToVertexTPC((AliESDVertex*)ev->GetPrimaryVertexSPD(),ev->GetMagneticField(),kVeryBig, &exParam);
-        if(!relate) continue;
-      }
-      tmp_cont->fMultTrkTPC++;
-    }
-  }
-  ev->AddObject(tmp_cont);
-  fContainer = *tmp_cont;
+  /// The counters are computed once per event by the multiplicity service and shared by all the instances
+  AliEventCutsMultiplicity *service = AliEventCutsMultiplicity::Instance();
+  fContainer = service->GetCounters(ev);
+  fNewEvent = service->IsNewEvent();
 }
 
 void AliEventCuts::SetupRun2pp() {
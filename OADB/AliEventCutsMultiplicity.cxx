@@ -0,0 +1,181 @@
+#include "AliEventCutsMultiplicity.h"
+
+#include <algorithm>
+
+#include <TMath.h>
+#include <RVersion.h>
+#if defined(R__USE_IMT) && ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0)
+#include <ROOT/TSeq.hxx>
+#include <ROOT/TThreadExecutor.hxx>
+#endif
+
+#include <AliAnalysisManager.h>
+#include <AliAODEvent.h>
+#include <AliAODHeader.h>
+#include <AliAODTrack.h>
+#include <AliESDEvent.h>
+#include <AliESDtrack.h>
+#include <AliESDtrackCuts.h>
+#include <AliESDVertex.h>
+#include <AliExternalTrackParam.h>
+#include <AliLog.h>
+
+ClassImp(AliEventCutsMultiplicity);
+
+/// Private constructor: use Instance()
+///
+AliEventCutsMultiplicity::AliEventCutsMultiplicity() : TObject(),
+  fCounters{},
+  fEvent{nullptr},
+  fEventNumber{-1},
+  fNewEvent{true},
+  fNThreads{1},
+  fFB32cuts{},
+  fTPConlyCuts{}
+{
+}
+
+AliEventCutsMultiplicity::~AliEventCutsMultiplicity() {
+  for (auto cuts : fFB32cuts) delete cuts;
+  for (auto cuts : fTPConlyCuts) delete cuts;
+}
+
+/// Instance shared by all the users in the process
+///
+AliEventCutsMultiplicity* AliEventCutsMultiplicity::Instance() {
+  static AliEventCutsMultiplicity *instance = nullptr;
+  if (!instance) instance = new AliEventCutsMultiplicity;
+  return instance;
+}
+
+/// Build the track cuts, one set for each thread. The sets are kept for the following events.
+///
+void AliEventCutsMultiplicity::BuildCuts(unsigned int nSets) {
+  while (fFB32cuts.size() < nSets) {
+    fFB32cuts.push_back(AliESDtrackCuts::GetStandardITSTPCTrackCuts2011());
+    fTPConlyCuts.push_back(AliESDtrackCuts::GetStandardTPCOnlyTrackCuts());
+  }
+}
+
+/// Counters of the event, computed on the first request for this event
+///
+const AliEventCutsContainer& AliEventCutsMultiplicity::GetCounters(AliVEvent *ev) {
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  const int evnumber = (mgr) ? mgr->GetNcalls() : -1;
+  const unsigned long evid = ((unsigned long)(ev->GetBunchCrossNumber()) << 32) + ev->GetTimeStamp();
+  fNewEvent = (ev != fEvent || evnumber != fEventNumber || evid != fCounters.fEventId);
+  if (!fNewEvent) return fCounters;
+
+  AliAODEvent *aod = dynamic_cast<AliAODEvent*>(ev);
+  AliESDEvent *esd = (aod) ? nullptr : dynamic_cast<AliESDEvent*>(ev);
+  if (!aod && !esd)
+    AliFatal("I don't find the AOD event nor the ESD one, aborting.");
+
+  const int nTracks = ev->GetNumberOfTracks();
+  Counters cnt{0,0,0,0};
+  if (aod) {
+    CountAOD(aod, 0, nTracks, cnt);
+  } else {
+    const AliESDVertex *spd = esd->GetPrimaryVertexSPD();
+    const int nThreads = (fNThreads > 1 && nTracks > fNThreads) ? fNThreads : 1;
+    BuildCuts(nThreads);
+    bool done = false;
+#if defined(R__USE_IMT) && ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0)
+    if (nThreads > 1) {
+      /// Each chunk of tracks is counted by one task with its own set of track cuts
+      std::vector<Counters> partial(nThreads, Counters{0,0,0,0});
+      const int chunk = (nTracks + nThreads - 1) / nThreads;
+      ROOT::TThreadExecutor pool(nThreads);
+      pool.Foreach([&](int iChunk) {
+        CountESD(esd, spd, iChunk * chunk, std::min(nTracks, (iChunk + 1) * chunk), iChunk, partial[iChunk]);
+      }, ROOT::TSeqI(nThreads));
+      for (auto &part : partial) {
+        cnt.fFB32 += part.fFB32;
+        cnt.fFB32Acc += part.fFB32Acc;
+        cnt.fFB32TOF += part.fFB32TOF;
+        cnt.fTPC += part.fTPC;
+      }
+      done = true;
+    }
+#endif
+    if (!done) CountESD(esd, spd, 0, nTracks, 0, cnt);
+  }
+
+  fCounters.fEventId = evid;
+  fCounters.fMultESD = (aod) ? ((AliAODHeader*)aod->GetHeader())->GetNumberOfESDTracks() : esd->GetNumberOfTracks();
+  fCounters.fMultTrkFB32 = cnt.fFB32;
+  fCounters.fMultTrkFB32Acc = cnt.fFB32Acc;
+  fCounters.fMultTrkFB32TOF = cnt.fFB32TOF;
+  fCounters.fMultTrkTPC = cnt.fTPC;
+  fEvent = ev;
+  fEventNumber = evnumber;
+
+  /// Publish the counters in the event for the tasks looking for them there
+  AliEventCutsContainer *cont = static_cast<AliEventCutsContainer*>(ev->FindListObject("AliEventCutsContainer"));
+  if (!cont) {
+    cont = new AliEventCutsContainer;
+    ev->AddObject(cont);
+  }
+  *cont = fCounters;
+  return fCounters;
+}
+
+/// Count the AOD tracks in [first,last) using the filter bits
+///
+void AliEventCutsMultiplicity::CountAOD(AliAODEvent *ev, int first, int last, Counters &cnt) const {
+  for (int it = first; it < last; it++) {
+    AliAODTrack* trk = (AliAODTrack*)ev->GetTrack(it);
+    if (!trk) continue;
+    if (trk->TestFilterBit(32)) {
+      cnt.fFB32++;
+      if ( TMath::Abs(trk->GetTOFsignalDz()) <= 10. && trk->GetTOFsignal() >= 12000. && trk->GetTOFsignal() <= 25000.)
+        cnt.fFB32TOF++;
+      if ((fabs(trk->Eta()) < 0.8) && (trk->GetTPCNcls() >= 70) && (trk->Pt() >= 0.2) && (trk->Pt() < 50))
+        cnt.fFB32Acc++;
+    }
+    if (trk->TestFilterBit(128))
+      cnt.fTPC++;
+  }
+}
+
+/// Count the ESD tracks in [first,last) with the track cuts of the given set.
+/// The refit and TPC cluster requirements of the cuts are checked first, so that most of the
+/// rejected tracks skip the full AcceptTrack evaluation and the TPC only track constrained to the SPD vertex.
+///
+void AliEventCutsMultiplicity::CountESD(AliESDEvent *ev, const AliESDVertex *spd, int first, int last, unsigned int set, Counters &cnt) const {
+  AliESDtrackCuts *fb32cuts = fFB32cuts[set];
+  AliESDtrackCuts *tpcCuts = fTPConlyCuts[set];
+  const double bField = ev->GetMagneticField();
+  const int minTPCclsFB32 = fb32cuts->GetMinNClusterTPC();
+  const int minTPCclsTPConly = tpcCuts->GetMinNClusterTPC();
+  const ULong_t fb32status = (fb32cuts->GetRequireTPCRefit() ? AliESDtrack::kTPCrefit : 0) |
+    (fb32cuts->GetRequireITSRefit() ? AliESDtrack::kITSrefit : 0);
+
+  for (int it = first; it < last; it++) {
+    AliESDtrack* esdTrack = ev->GetTrack(it);
+    if (!esdTrack) continue;
+    const int nTPCcls = esdTrack->GetTPCNcls();
+
+    if ((esdTrack->GetStatus() & fb32status) == fb32status && nTPCcls >= minTPCclsFB32 && fb32cuts->AcceptTrack(esdTrack)) {
+      cnt.fFB32++;
+      if (TMath::Abs(esdTrack->GetTOFsignalDz()) <= 10 && esdTrack->GetTOFsignal() >= 12000 && esdTrack->GetTOFsignal() <= 25000)
+        cnt.fFB32TOF++;
+
+      if ((TMath::Abs(esdTrack->Eta()) < 0.8) && (nTPCcls > 70) && (esdTrack->Pt() > 0.2) && (esdTrack->Pt() < 50))
+        cnt.fFB32Acc++;
+    }
+
+    /// TPC only tracks, with the same cuts of the filter bit 128
+    if (nTPCcls < minTPCclsTPConly) continue;
+    AliESDtrack tpcParam;
+    if (!esdTrack->FillTPCOnlyTrack(tpcParam)) continue;
+    if (!tpcCuts->AcceptTrack(&tpcParam)) continue;
+    if (tpcParam.Pt() > 0.) {
+      // only constrain tracks above threshold
+      AliExternalTrackParam exParam;
+      // take the B-field from the ESD, no 3D fieldMap available at this point
+      if (!tpcParam.RelateToVertexTPC(spd,bField,kVeryBig,&exParam)) continue;
+    }
+    cnt.fTPC++;
+  }
+}
@@ -0,0 +1,59 @@
+#ifndef _AliEventCutsMultiplicity_h_
+#define _AliEventCutsMultiplicity_h_
+
+#include <TObject.h>
+#include <vector>
+
+#include "AliEventCuts.h"
+
+class AliAODEvent;
+class AliESDEvent;
+class AliESDtrackCuts;
+class AliESDVertex;
+class AliVEvent;
+
+/// Track multiplicity counters used by the correlation cuts of AliEventCuts.
+///
+/// One instance per process (see Instance()) owns the ESD track cuts, built on the first ESD event
+/// and kept afterwards, and evaluates all the counters of an event in a single pass over the tracks.
+/// The counters are cached until the event changes: every AliEventCuts instance and any other task
+/// asking for the same event share them. They are also published in the event as AliEventCutsContainer.
+class AliEventCutsMultiplicity : public TObject {
+  public:
+    virtual ~AliEventCutsMultiplicity();
+    static AliEventCutsMultiplicity* Instance();
+
+    const AliEventCutsContainer& GetCounters(AliVEvent *ev);
+    bool          IsNewEvent() const { return fNewEvent; }
+
+    void          SetNumberOfThreads(int n) { fNThreads = n; }
+    int           GetNumberOfThreads() const { return fNThreads; }
+
+  private:
+    AliEventCutsMultiplicity();
+    AliEventCutsMultiplicity(const AliEventCutsMultiplicity& copy);
+    AliEventCutsMultiplicity& operator=(const AliEventCutsMultiplicity& copy);
+
+    struct Counters {
+      int fFB32;
+      int fFB32Acc;
+      int fFB32TOF;
+      int fTPC;
+    };
+
+    void          BuildCuts(unsigned int nSets);
+    void          CountAOD(AliAODEvent *ev, int first, int last, Counters &cnt) const;
+    void          CountESD(AliESDEvent *ev, const AliESDVertex *spd, int first, int last, unsigned int set, Counters &cnt) const;
+
+    AliEventCutsContainer fCounters;              //!<! Counters of the current event
+    const AliVEvent* fEvent;                      //!<! Event the counters were computed for
+    int           fEventNumber;                   //!<! Analysis manager event number the counters were computed for
+    bool          fNewEvent;                      //!<! True if the last call to GetCounters computed the counters
+    int           fNThreads;                      ///<  Number of threads used to count the ESD tracks (needs ROOT with imt)
+    std::vector<AliESDtrackCuts*> fFB32cuts;      //!<! ITS-TPC 2011 cuts (filter bit 32), one copy per thread
+    std::vector<AliESDtrackCuts*> fTPConlyCuts;   //!<! TPC only cuts (filter bit 128), one copy per thread
+
+    ClassDef(AliEventCutsMultiplicity,1)
+};
+
+#endif
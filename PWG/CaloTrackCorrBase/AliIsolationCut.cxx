@@ -54,7 +54,14 @@ fFracIsThresh(1),
 fIsTMClusterInConeRejected(1),
 fDistMinToTrigger(-1.),
 fMomentum(),
-fTrackVector()
+fTrackVector(),
+fNSortedConeParticles(0),
+fSortedConeR(),
+fSortedConePtSum(),
+fSortedConePtLead(),
+fConeParticleR(),
+fConeParticlePt(),
+fConeParticleIndex()
 {
   InitParameters();
 }
@@ -765,24 +772,7 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
   coneptsum = coneptsumCluster + coneptsumTrack;
   
   // *Now*, just check the leading particle in the cone if the threshold is passed
-  if(ptLead > fPtThreshold && ptLead < fPtThresholdMax)  n = 1;
-  
-  //if fPtFraction*ptC<fPtThreshold then consider the fPtThreshold directly
-  if(fFracIsThresh)
-  {
-    if( fPtFraction*ptC < fPtThreshold )
-    {
-      if( ptLead > fPtThreshold )    nfrac = 1 ;
-    }
-    else
-    {
-      if( ptLead > fPtFraction*ptC ) nfrac = 1;
-    }
-  }
-  else
-  {
-    if( ptLead > fPtFraction*ptC ) nfrac = 1;
-  }
+  GetNAboveThresholds(ptC, ptLead, n, nfrac);
   
   //-------------------------------------------------------------------
   // Check isolation, depending on selected isolation criteria requested
@@ -878,6 +868,249 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
   }
 }
 
+//________________________________________________________________________________
+/// Check if the leading particle in cone passes the pT threshold and
+/// the pT fraction with respect to the candidate.
+///
+/// \param ptC: pT of the candidate.
+/// \param ptLead: pT of the leading cluster or track in cone.
+/// \param n: 1 if leading particle above pT threshold, output.
+/// \param nfrac: 1 if leading particle above pT fraction threshold, output.
+//________________________________________________________________________________
+void AliIsolationCut::GetNAboveThresholds(Float_t ptC, Float_t ptLead, Int_t & n, Int_t & nfrac) const
+{
+  n     = 0;
+  nfrac = 0;
+  
+  if(ptLead > fPtThreshold && ptLead < fPtThresholdMax)  n = 1;
+  
+  //if fPtFraction*ptC<fPtThreshold then consider the fPtThreshold directly
+  if(fFracIsThresh)
+  {
+    if( fPtFraction*ptC < fPtThreshold )
+    {
+      if( ptLead > fPtThreshold )    nfrac = 1 ;
+    }
+    else
+    {
+      if( ptLead > fPtFraction*ptC ) nfrac = 1;
+    }
+  }
+  else
+  {
+    if( ptLead > fPtFraction*ptC ) nfrac = 1;
+  }
+}
+
+//________________________________________________________________________________
+/// Fill the list of tracks and clusters that would be considered by MakeIsolationCut()
+/// for the candidate in any cone size: same selection of particles (candidate daughters
+/// and track matched clusters removed, minimum distance to trigger, same hemisphere),
+/// sorted by increasing distance to the candidate, with cumulated pT sum and leading pT.
+/// The cone pT sum and leading pT for any cone size are then obtained with
+/// GetSortedConeSumAndLeading() without looping again on the particles.
+///
+/// \param plCTS: List of tracks.
+/// \param plNe: List of clusters.
+/// \param reader: pointer to AliCaloTrackReader. Needed to access event info.
+/// \param pid: pointer to AliCaloPID. Needed to reject matched clusters in isolation cone.
+/// \param pCandidate: Kinematics of candidate particle for isolation.
+//________________________________________________________________________________
+void AliIsolationCut::MakeSortedConeParticleList(TObjArray * plCTS,
+                                                  TObjArray * plNe,
+                                                  AliCaloTrackReader * reader,
+                                                  AliCaloPID * pid,
+                                                  AliAODPWG4ParticleCorrelation  *pCandidate)
+{
+  Float_t phiC  = pCandidate->Phi() ;
+  if ( phiC < 0 ) phiC+=TMath::TwoPi();
+  Float_t etaC  = pCandidate->Eta() ;
+  
+  Float_t pt     = -100. ;
+  Float_t eta    = -100. ;
+  Float_t phi    = -100. ;
+  Float_t rad    = -100. ;
+  
+  fNSortedConeParticles = 0;
+  
+  Int_t nMax = 0;
+  if(plCTS && fPartInCone != kOnlyNeutral ) nMax += plCTS->GetEntriesFast();
+  if(plNe  && fPartInCone != kOnlyCharged ) nMax += plNe ->GetEntriesFast();
+  
+  if(fConeParticleR.GetSize() < nMax)
+  {
+    fConeParticleR    .Set(nMax);
+    fConeParticlePt   .Set(nMax);
+    fConeParticleIndex.Set(nMax);
+    fSortedConeR      .Set(nMax);
+    fSortedConePtSum  .Set(nMax);
+    fSortedConePtLead .Set(nMax);
+  }
+  
+  Int_t npart = 0;
+  
+  // Tracks
+  if(plCTS && fPartInCone != kOnlyNeutral)
+  {
+    for(Int_t ipr = 0;ipr < plCTS->GetEntriesFast() ; ipr ++ )
+    {
+      AliVTrack* track = dynamic_cast<AliVTrack*>(plCTS->At(ipr)) ;
+      
+      if(track)
+      {
+        if ( pCandidate->GetDetectorTag() == AliFiducialCut::kCTS )
+        {
+          Int_t  trackID   = reader->GetTrackID(track) ;
+          Bool_t contained = kFALSE;
+          
+          for(Int_t i = 0; i < 4; i++)
+          {
+            if( trackID == pCandidate->GetTrackLabel(i) ) contained = kTRUE;
+          }
+          
+          if ( contained ) continue ;
+        }
+        
+        fTrackVector.SetXYZ(track->Px(),track->Py(),track->Pz());
+        pt  = fTrackVector.Pt();
+        eta = fTrackVector.Eta();
+        phi = fTrackVector.Phi() ;
+      }
+      else
+      {// Mixed event stored in AliAODPWG4Particles
+        AliAODPWG4Particle * trackmix = dynamic_cast<AliAODPWG4Particle*>(plCTS->At(ipr)) ;
+        if(!trackmix)
+        {
+          AliWarning("Wrong track data type, continue");
+          continue;
+        }
+        
+        pt  = trackmix->Pt();
+        eta = trackmix->Eta();
+        phi = trackmix->Phi() ;
+      }
+      
+      if ( phi < 0 ) phi+=TMath::TwoPi();
+      
+      rad = Radius(etaC, phiC, eta, phi);
+      
+      if(rad < fDistMinToTrigger) continue ;
+      
+      if(TMath::Abs(phi-phiC) > TMath::PiOver2()) continue ;
+      
+      fConeParticleR [npart] = rad;
+      fConeParticlePt[npart] = pt;
+      npart++;
+    }// charged particle loop
+  }//Tracks
+  
+  // Clusters
+  if(plNe && fPartInCone != kOnlyCharged)
+  {
+    for(Int_t ipr = 0;ipr < plNe->GetEntriesFast() ; ipr ++ )
+    {
+      AliVCluster * calo = dynamic_cast<AliVCluster *>(plNe->At(ipr)) ;
+      
+      if(calo)
+      {
+        Int_t evtIndex = 0 ;
+        if (reader->GetMixedEvent())
+          evtIndex=reader->GetMixedEvent()->EventIndexForCaloCluster(calo->GetID()) ;
+        
+        if(calo->GetID() == pCandidate->GetCaloLabel(0) ||
+           calo->GetID() == pCandidate->GetCaloLabel(1)   ) continue ;
+        
+        if(fIsTMClusterInConeRejected)
+        {
+          if( fPartInCone == kNeutralAndCharged &&
+             pid->IsTrackMatched(calo,reader->GetCaloUtils(),reader->GetInputEvent()) ) continue ;
+        }
+        
+        calo->GetMomentum(fMomentum,reader->GetVertex(evtIndex)) ;
+        
+        pt  = fMomentum.Pt()  ;
+        eta = fMomentum.Eta() ;
+        phi = fMomentum.Phi() ;
+      }
+      else
+      {// Mixed event stored in AliAODPWG4Particles
+        AliAODPWG4Particle * calomix = dynamic_cast<AliAODPWG4Particle*>(plNe->At(ipr)) ;
+        if(!calomix)
+        {
+          AliWarning("Wrong calo data type, continue");
+          continue;
+        }
+        
+        pt  = calomix->Pt();
+        eta = calomix->Eta();
+        phi = calomix->Phi() ;
+      }
+      
+      if( phi < 0 ) phi+=TMath::TwoPi();
+      
+      rad = Radius(etaC, phiC, eta, phi);
+      
+      if(rad < fDistMinToTrigger) continue ;
+      
+      if(TMath::Abs(phi-phiC)>TMath::PiOver2()) continue ;
+      
+      fConeParticleR [npart] = rad;
+      fConeParticlePt[npart] = pt;
+      npart++;
+    }// neutral particle loop
+  }//neutrals
+  
+  if(npart == 0) return;
+  
+  // Sort by increasing distance and accumulate
+  TMath::Sort(npart, fConeParticleR.GetArray(), fConeParticleIndex.GetArray(), kFALSE);
+  
+  Float_t ptSum  = 0;
+  Float_t ptLead = 0;
+  for(Int_t i = 0; i < npart; i++)
+  {
+    Int_t ipart = fConeParticleIndex[i];
+    
+    ptSum += fConeParticlePt[ipart];
+    if( ptLead < fConeParticlePt[ipart] ) ptLead = fConeParticlePt[ipart];
+    
+    fSortedConeR     [i] = fConeParticleR[ipart];
+    fSortedConePtSum [i] = ptSum;
+    fSortedConePtLead[i] = ptLead;
+  }
+  
+  fNSortedConeParticles = npart;
+  
+  AliDebug(1,Form("Candidate pT %2.2f, eta %2.2f, phi %2.2f, %d particles in hemisphere",
+                  pCandidate->Pt(), etaC, phiC*TMath::RadToDeg(), npart));
+}
+
+//________________________________________________________________________________
+/// Get the pT sum and leading pT of the particles inside a cone of the given size,
+/// from the list filled in MakeSortedConeParticleList(). Same particles as counted
+/// in MakeIsolationCut() with fConeSize = coneSize.
+///
+/// \param coneSize: Radius of the cone.
+/// \param ptSum: total momentum energy in cone (track+cluster), output.
+/// \param ptLead: momentum of leading cluster or track in cone, output.
+//________________________________________________________________________________
+void AliIsolationCut::GetSortedConeSumAndLeading(Float_t coneSize, Float_t & ptSum, Float_t & ptLead) const
+{
+  ptSum  = 0;
+  ptLead = 0;
+  
+  if(fNSortedConeParticles <= 0) return;
+  
+  // Number of particles with R < coneSize
+  Int_t nInCone = TMath::BinarySearch(fNSortedConeParticles, fSortedConeR.GetArray(), coneSize) + 1;
+  while( nInCone > 0 && fSortedConeR[nInCone-1] >= coneSize ) nInCone--;
+  
+  if(nInCone == 0) return;
+  
+  ptSum  = fSortedConePtSum [nInCone-1];
+  ptLead = fSortedConePtLead[nInCone-1];
+}
+
 //_____________________________________________________
 /// Print some relevant parameters set for the analysis.
 //_____________________________________________________
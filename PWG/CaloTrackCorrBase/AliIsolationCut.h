@@ -22,6 +22,8 @@
 #include <TObject.h>
 class TObjArray ;
 #include <TLorentzVector.h>
+#include <TArrayF.h>
+#include <TArrayI.h>
 
 // --- ANALYSIS system ---
 class AliAODPWG4ParticleCorrelation ;
@@ -59,6 +61,17 @@ class AliIsolationCut : public TObject {
                               AliAODPWG4ParticleCorrelation  * pCandidate, TString aodObjArrayName,
                               Int_t &n, Int_t & nfrac, Float_t &ptSum, Float_t &ptLead, Bool_t & isolated) ;
 
+  // Several cones analysis, particles sorted by distance to candidate
+  
+  void       MakeSortedConeParticleList(TObjArray * plCTS, TObjArray * plNe,
+                                        AliCaloTrackReader * reader,
+                                        AliCaloPID * pid,
+                                        AliAODPWG4ParticleCorrelation  * pCandidate) ;
+  
+  void       GetSortedConeSumAndLeading(Float_t coneSize, Float_t &ptSum, Float_t &ptLead) const ;
+  
+  void       GetNAboveThresholds(Float_t ptC, Float_t ptLead, Int_t &n, Int_t & nfrac) const ;
+  
   void       Print(const Option_t * opt) const ;
 
   Float_t    Radius(Float_t etaCandidate, Float_t phiCandidate, Float_t eta, Float_t phi) const ;
@@ -140,6 +153,20 @@ class AliIsolationCut : public TObject {
 
   TVector3   fTrackVector;       //!<! Track moment, temporal object.
 
+  Int_t      fNSortedConeParticles; //!<! Number of entries in sorted cone particle arrays.
+  
+  TArrayF    fSortedConeR;       //!<! Distance to candidate of particles in candidate hemisphere, increasing order.
+  
+  TArrayF    fSortedConePtSum;   //!<! Sum of pT of particles up to this distance to candidate.
+  
+  TArrayF    fSortedConePtLead;  //!<! Leading pT of particles up to this distance to candidate.
+  
+  TArrayF    fConeParticleR;     //!<! Distance to candidate, unsorted, temporal array.
+  
+  TArrayF    fConeParticlePt;    //!<! pT of particles, unsorted, temporal array.
+  
+  TArrayI    fConeParticleIndex; //!<! Sorting index, temporal array.
+
   /// Copy constructor not implemented.
   AliIsolationCut(              const AliIsolationCut & g) ;
 
@@ -147,7 +174,7 @@ class AliIsolationCut : public TObject {
   AliIsolationCut & operator = (const AliIsolationCut & g) ; 
 
   /// \cond CLASSIMP
-  ClassDef(AliIsolationCut,11) ;
+  ClassDef(AliIsolationCut,12) ;
   /// \endcond
 
 } ;
@@ -26,6 +26,7 @@
 #include "AliStack.h"
 #include "AliGenPythiaEventHeader.h"
 #include "AliAODMCParticle.h"
+#include "AliMCGenealogy.h"
 #include "AliLog.h"
 
 /// \cond CLASSIMP
@@ -67,6 +68,74 @@ Int_t AliMCAnalysisUtils::CheckCommonAncestor(Int_t index1, Int_t index2,
                                               Int_t & ancPDG, Int_t & ancStatus, 
                                               TLorentzVector & momentum, TVector3 & prodVertex) 
 {  
+  Int_t ancLabel = -1;
+  
+  // Event genealogy index shared with other tasks, built once per event
+  const AliMCGenealogy * genealogy = 0;
+  if(index1 != index2)
+  {
+    if(reader->ReadAODMCParticles()) genealogy = AliMCGenealogy::GetEventGenealogy(reader->GetAODMCParticles());
+    else                             genealogy = AliMCGenealogy::GetEventGenealogy(reader->GetStack());
+  }
+  
+  if(genealogy)
+  {
+    if(reader->ReadAODMCParticles() && (index1 < 0 || index2 < 0)) return -1;
+    
+    ancLabel = genealogy->GetCommonAncestor(index1, index2);
+  }
+  else
+  {
+    ancLabel = CheckCommonAncestorLabel(index1, index2, reader);
+    
+    if(ancLabel < -1) return -1;
+  }
+  
+  if(ancLabel > -1)
+  {
+    if(reader->ReadAODMCParticles())
+    {
+      AliAODMCParticle * mom = (AliAODMCParticle *) reader->GetAODMCParticles()->At(ancLabel);
+      
+      if (mom)
+      {
+        ancPDG    = mom->GetPdgCode();
+        ancStatus = mom->GetStatus();
+        momentum.SetPxPyPzE(mom->Px(),mom->Py(),mom->Pz(),mom->E());
+        prodVertex.SetXYZ(mom->Xv(),mom->Yv(),mom->Zv());
+      }
+    }
+    else
+    {
+      TParticle * mom = (reader->GetStack())->Particle(ancLabel);
+      
+      if (mom)
+      {
+        ancPDG    = mom->GetPdgCode();
+        ancStatus = mom->GetStatusCode();
+        mom->Momentum(momentum);
+        prodVertex.SetXYZ(mom->Vx(),mom->Vy(),mom->Vz());
+      }
+    }
+  }
+  else
+  {
+    ancPDG    = -10000;
+    ancStatus = -10000;
+    momentum.SetXYZT(0,0,0,0);
+    prodVertex.SetXYZ(-10,-10,-10);
+  }
+  
+  return ancLabel;
+}
+
+//_____________________________________________________________________________________________
+/// Walk up the mothers of the 2 labels when no genealogy index is available.
+/// \return label of the first common ancestor, -1 if none, -2 for negative AOD labels.
+//_____________________________________________________________________________________________
+Int_t AliMCAnalysisUtils::CheckCommonAncestorLabel(Int_t index1, Int_t index2, 
+                                                   const AliCaloTrackReader* reader) const
+{
   Int_t label1[100];
   Int_t label2[100];
   label1[0]= index1;
@@ -87,7 +156,7 @@ Int_t AliMCAnalysisUtils::CheckCommonAncestor(Int_t index1, Int_t index2,
       TClonesArray * mcparticles = reader->GetAODMCParticles();
       
       Int_t label=label1[0];
-      if(label < 0) return -1;
+      if(label < 0) return -2;
       
       while(label > -1 && counter1 < 99)
       {
@@ -103,7 +172,7 @@ Int_t AliMCAnalysisUtils::CheckCommonAncestor(Int_t index1, Int_t index2,
      
       //printf("Org label2=%d,\n",label2[0]);
       label=label2[0];
-      if(label < 0) return -1;
+      if(label < 0) return -2;
       
       while(label > -1 && counter2 < 99)
       {
@@ -167,31 +236,6 @@ Int_t AliMCAnalysisUtils::CheckCommonAncestor(Int_t index1, Int_t index2,
         ancLabel = label1[c1];
         commonparents++;
         
-        if(reader->ReadAODMCParticles())
-        {
-          AliAODMCParticle * mom = (AliAODMCParticle *) reader->GetAODMCParticles()->At(label1[c1]);
-          
-          if (mom)
-          {
-            ancPDG    = mom->GetPdgCode();
-            ancStatus = mom->GetStatus();
-            momentum.SetPxPyPzE(mom->Px(),mom->Py(),mom->Pz(),mom->E());
-            prodVertex.SetXYZ(mom->Xv(),mom->Yv(),mom->Zv());
-          }
-        }
-        else
-        {
-          TParticle * mom = (reader->GetStack())->Particle(label1[c1]);
-          
-          if (mom)
-          {
-            ancPDG    = mom->GetPdgCode();
-            ancStatus = mom->GetStatusCode();
-            mom->Momentum(momentum);
-            prodVertex.SetXYZ(mom->Vx(),mom->Vy(),mom->Vz());
-          }
-        }
-        
         //First ancestor found, end the loops
         counter1=0;
         counter2=0;
@@ -199,14 +243,6 @@ Int_t AliMCAnalysisUtils::CheckCommonAncestor(Int_t index1, Int_t index2,
     }//second cluster loop
   }//first cluster loop
   
-  if(ancLabel < 0)
-  {
-    ancPDG    = -10000;
-    ancStatus = -10000;
-    momentum.SetXYZT(0,0,0,0);
-    prodVertex.SetXYZ(-10,-10,-10);
-  }
-  
   return ancLabel;
 }
 
@@ -284,6 +320,10 @@ Int_t AliMCAnalysisUtils::CheckOrigin(Int_t label, const AliCaloTrackReader* rea
 /// entity (track, cluster, etc) for which we want to know something 
 /// about its heritage, but one can also use it directly with stack 
 /// particles not connected to reconstructed entities.
+///
+/// The mother walks here still read the stack and do not use AliMCGenealogy:
+/// they stop on the status code and, in the AOD version, on the
+/// (physical) primary flags, which the index does not keep.
 //__________________________________________________________________________________________
 Int_t AliMCAnalysisUtils::CheckOriginInStack(const Int_t *labels, Int_t nlabels,
                                              AliStack* stack, const TObjArray* arrayCluster)
@@ -32,6 +32,7 @@
 #include <TVirtualMC.h>
 #include <TPDGCode.h>
 #include <TDatabasePDG.h>
+#include <TRandom3.h>
 #include "AliGenCocktailEventHeader.h"
 
 #include "AliGenCocktailEntry.h"
@@ -64,7 +65,9 @@ AliGenEMCocktail::AliGenEMCocktail()
   fV2Systematic(AliGenEMlib::kNoV2Sys),
   fForceConv(kFALSE),
   fSelectedParticles(kGenHadrons),
-  fRandomPsi(kFALSE)
+  fRandomPsi(kFALSE),
+  fSourceSeed(0),
+  fSourceRandom(0)
 {
   // Constructor
 }
@@ -73,6 +76,7 @@ AliGenEMCocktail::AliGenEMCocktail()
 AliGenEMCocktail::~AliGenEMCocktail()
 {
   // Destructor
+  delete fSourceRandom;
 }
 
 //_________________________________________________________________________
@@ -458,6 +462,24 @@ void AliGenEMCocktail::Init()
   }
 }
 
+//-------------------------------------------------------------------
+void AliGenEMCocktail::CreateSourceRandom()
+{
+  // One random stream per source, with a seed depending only on
+  // fSourceSeed and on the position of the source in the cocktail
+  delete fSourceRandom;
+  fSourceRandom = new TObjArray();
+  fSourceRandom->SetOwner(kTRUE);
+  Int_t nSources = fEntries ? fEntries->GetEntries() : 0;
+  for (Int_t i=0; i<nSources; i++) {
+    // TRandom3 with seed 0 would take a time dependent seed
+    UInt_t seed = fSourceSeed*(UInt_t)kGENs + (UInt_t)i + 1;
+    if (!seed) seed = 1;
+    fSourceRandom->Add(new TRandom3(seed));
+    AliInfo(Form("source %d uses random seed %u",i,seed));
+  }
+}
+
 //_________________________________________________________________________
 void AliGenEMCocktail::Generate()
 {
@@ -487,6 +509,9 @@ void AliGenEMCocktail::Generate()
     Rndm(&evPlane,1);
     evPlane*=2.*TMath::Pi();
   }
+  if (fSourceSeed && (!fSourceRandom || fSourceRandom->GetEntriesFast()!=fEntries->GetEntries()))
+    CreateSourceRandom();
+  Int_t isource = 0;
   while((entry = (AliGenCocktailEntry*)next())) {
     gen = entry->Generator();
     gen->SetVertex(fVertex.At(0), fVertex.At(1), fVertex.At(2));
@@ -496,9 +521,20 @@ void AliGenEMCocktail::Generate()
       if (igen == 1) entry->SetFirst(0);		
       else  entry->SetFirst((partArray->GetEntriesFast())+1);
       gen->SetEventPlane(evPlane);
-      gen->Generate();
+      if (fSourceSeed) {
+        // the parametrisations of AliGenParam sample through gRandom, the source stream replaces it for this source
+        // (mother kinematics only, the decayer draws from its own stream)
+        TRandom *random = gRandom;
+        TRandom *sourceRandom = (TRandom*)fSourceRandom->At(isource);
+        gen->SetRandom(sourceRandom);
+        gRandom = sourceRandom;
+        gen->Generate();
+        gRandom = random;
+      }
+      else gen->Generate();
       entry->SetLast(partArray->GetEntriesFast());
     }
+    isource++;
   }  
   next.Reset();
 
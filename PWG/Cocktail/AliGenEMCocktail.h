@@ -16,6 +16,7 @@
 
 
 class AliGenCocktailEntry;
+class TObjArray;
 
 class AliGenEMCocktail : public AliGenCocktail
 {
@@ -51,6 +52,13 @@ public:
   void    SetForceGammaConversion(Bool_t force=kTRUE)     { fForceConv=force   ;}
   void    SetHeaviestHadron(ParticleGenerator_t part);
   void    SetRandomEventPlane(void){fRandomPsi=kTRUE;} //Switch on random Event-by-event enent plane smearing (off by default)   
+  // Give each source its own random stream, seeded from seed and the position of the source in the cocktail:
+  // the generated mothers (multiplicity and kinematics) of a source do not depend on the other selected sources,
+  // and independent blocks of events can be produced in separate jobs with different seeds (0, the default, uses
+  // gRandom for all sources). The decayer keeps its own random stream, shared by all sources, so the decay products
+  // still depend on which sources were generated before
+  void    SetSourceSeed(UInt_t seed)             { fSourceSeed=seed ;}
+  UInt_t  GetSourceSeed()                const  { return fSourceSeed ;}
   
   //***********************************************************************************************
   // This function allows to select the particle which should be procude based on 1 Integer value
@@ -76,6 +84,7 @@ private:
   AliGenEMCocktail & operator=(const AliGenEMCocktail &cocktail); 
 
   void AddSource2Generator(Char_t *nameReso, AliGenParam* const genReso);
+  void CreateSourceRandom();
   
   AliDecayer*      fDecayer;        // External decayer
   Decay_t       fDecayMode;    // decay mode in which resonances are forced to decay, default: kAll
@@ -97,8 +106,10 @@ private:
 
   Bool_t        fRandomPsi; //Turn on random event plane distribution
 
+  UInt_t        fSourceSeed;     // seed of the per-source random streams, 0: all sources use gRandom
+  TObjArray*    fSourceRandom;   //! random stream of each source, in the order of the cocktail entries
 
-  ClassDef(AliGenEMCocktail,3)       // cocktail for EM physics
+  ClassDef(AliGenEMCocktail,4)       // cocktail for EM physics
 };
 
 #endif
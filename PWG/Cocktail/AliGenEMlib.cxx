@@ -45,6 +45,8 @@ Int_t AliGenEMlib::fgSelectedPtParamOmega=AliGenEMlib::kOmegaParampp;
 Int_t AliGenEMlib::fgSelectedPtParamPhi=AliGenEMlib::kPhiParampp;
 Int_t AliGenEMlib::fgSelectedCentrality=AliGenEMlib::kpp; 
 Int_t AliGenEMlib::fgSelectedV2Systematic=AliGenEMlib::kNoV2Sys;
+Double_t AliGenEMlib::fgMtScalNorm[16]={0.};
+Int_t AliGenEMlib::fgMtScalNormSelection[3]={-1,-1,-1};
 
 Double_t AliGenEMlib::CrossOverLc(double a, double b, double x){
   if(x<b-a/2) return 1.0;
@@ -1646,35 +1648,53 @@ Double_t AliGenEMlib::MtScal(Double_t pt, Int_t np)
   Double_t scaledPt = sqrt(pt*pt + fgkHM[np]*fgkHM[np] - fgkHM[0]*fgkHM[0]);
   Double_t scaledYield = PtPizero(&scaledPt, (Double_t*) 0);
 
-  //     VALUE MESON/PI AT 5 GeV/c
-  Double_t NormPt = 5.;
-  Double_t scaledNormPt = sqrt(NormPt*NormPt + fgkHM[np]*fgkHM[np] - fgkHM[0]*fgkHM[0]);
+  return MtScalNorm(np)*(pt/scaledPt)*scaledYield;
+}
 
-  Int_t selectedCol;
-  switch (fgSelectedCollisionsSystem){
-    case kpp900GeV:
-      selectedCol=0;
-      break;
-    case kpp2760GeV:
-      selectedCol=0;
-      break;
-    case kpp7TeV:
-      selectedCol=0;
-      break;
-    case kpPb:
-      selectedCol=1;
-      break;
-    case kPbPb:
-      selectedCol=2;
-      break;
-    default:
-      selectedCol=0;
-      printf("<AliGenEMlib::MtScal> no collision system has been given\n");
-  }
- 
-  Double_t norm = fgkMtFactor[selectedCol][np] * (PtPizero(&NormPt, (Double_t*) 0) / PtPizero(&scaledNormPt, (Double_t*) 0));
+Double_t AliGenEMlib::MtScalNorm(Int_t np)
+{
+  // Normalisation of the mt scaled Pt distribution of particle np,
+  // meson/pi ratio at 5 GeV/c. It does not depend on pt: it is computed
+  // once for the selected collision system, pizero parameterisation and
+  // centrality instead of with two more pizero evaluations per call.
 
-  return norm*(pt/scaledPt)*scaledYield;
+  if (fgMtScalNormSelection[0]!=fgSelectedCollisionsSystem ||
+      fgMtScalNormSelection[1]!=fgSelectedPtParamPi0 ||
+      fgMtScalNormSelection[2]!=fgSelectedCentrality) {
+    Int_t selectedCol;
+    switch (fgSelectedCollisionsSystem){
+      case kpp900GeV:
+        selectedCol=0;
+        break;
+      case kpp2760GeV:
+        selectedCol=0;
+        break;
+      case kpp7TeV:
+        selectedCol=0;
+        break;
+      case kpPb:
+        selectedCol=1;
+        break;
+      case kPbPb:
+        selectedCol=2;
+        break;
+      default:
+        selectedCol=0;
+        printf("<AliGenEMlib::MtScal> no collision system has been given\n");
+    }
+
+    //     VALUE MESON/PI AT 5 GeV/c
+    Double_t NormPt = 5.;
+    Double_t pizeroNormPt = PtPizero(&NormPt, (Double_t*) 0);
+    for (Int_t ip=0; ip<16; ip++) {
+      Double_t scaledNormPt = sqrt(NormPt*NormPt + fgkHM[ip]*fgkHM[ip] - fgkHM[0]*fgkHM[0]);
+      fgMtScalNorm[ip] = fgkMtFactor[selectedCol][ip] * (pizeroNormPt / PtPizero(&scaledNormPt, (Double_t*) 0));
+    }
+    fgMtScalNormSelection[0]=fgSelectedCollisionsSystem;
+    fgMtScalNormSelection[1]=fgSelectedPtParamPi0;
+    fgMtScalNormSelection[2]=fgSelectedCentrality;
+  }
+  return fgMtScalNorm[np];
 }
 
 Double_t AliGenEMlib::KEtScal(Double_t pt, Int_t np, Int_t nq)
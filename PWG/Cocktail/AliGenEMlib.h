@@ -86,6 +86,9 @@ public:
   static Int_t fgSelectedCentrality; // selected Centrality
   static Int_t fgSelectedV2Systematic; // selected v2 systematics, usefully values: -1,0,1
 
+  static Double_t fgMtScalNorm[16];        // cached pt independent normalisation of MtScal, per particle
+  static Int_t fgMtScalNormSelection[3];   // collision system, pi0 parameter and centrality of the cached normalisation
+
 
   static Double_t PtModifiedHagedornThermal(Double_t pt, 
                                             Double_t c, 
@@ -278,6 +281,7 @@ public:
   //static Double_t PtFlat(const Double_t *px, const Double_t *dummy);
   static Double_t YFlat(Double_t y);
   static Double_t MtScal(Double_t pt, Int_t np);
+  static Double_t MtScalNorm(Int_t np);
   static Double_t V2Param(const Double_t *px, const Double_t *param);
   static Double_t V2Flat(const Double_t *px, const Double_t *param);
   static Double_t KEtScal(Double_t pt, Int_t np, Int_t nq=2);
@@ -129,7 +129,7 @@ AliVCluster* AliClusterContainer::GetAcceptCluster(Int_t i) const
   if (!vc) return 0;
 
   UInt_t rejectionReason = 0;
-  if (AcceptCluster(vc, rejectionReason))
+  if (IsAcceptedEntry(i, rejectionReason))
     return vc;
   else {
     AliDebug(2,"Cluster not accepted.");
@@ -387,13 +387,7 @@ Bool_t AliClusterContainer::ApplyClusterCuts(const AliVCluster* clus, UInt_t &re
  */
 Int_t AliClusterContainer::GetNAcceptedClusters() const
 {
-  UInt_t rejectionReason = 0;
-  Int_t nClus = 0;
-  for(int iclust = 0; iclust < this->fClArray->GetEntries(); ++iclust){
-    AliVCluster *clust = this->GetCluster(iclust);
-    if(this->AcceptCluster(clust, rejectionReason)) nClus++;
-  }
-  return nClus;
+  return GetNAcceptEntries();
 }
 
 /**
@@ -424,6 +418,7 @@ void AliClusterContainer::SetClusUserDefEnergyCut(Int_t t, Double_t cut)
   else {
     fMinE = cut;
   }
+  InvalidateAcceptanceCache();
 }
 
 /**
@@ -62,21 +62,21 @@ class AliClusterContainer : public AliEmcalContainer {
   AliVCluster                *GetNextCluster();
   Int_t                       GetNClusters()                         const { return GetNEntries();   }
   Int_t                       GetNAcceptedClusters()                 const;
-  void                        SetClusTimeCut(Double_t min, Double_t max)   { fClusTimeCutLow  = min ; fClusTimeCutUp = max ; }
-  void                        SetMinMCLabel(Int_t s)                       { fMinMCLabel      = s   ; }
-  void                        SetMaxMCLabel(Int_t s)                       { fMaxMCLabel      = s   ; }
+  void                        SetClusTimeCut(Double_t min, Double_t max)   { fClusTimeCutLow  = min ; fClusTimeCutUp = max ; InvalidateAcceptanceCache(); }
+  void                        SetMinMCLabel(Int_t s)                       { fMinMCLabel      = s   ; InvalidateAcceptanceCache(); }
+  void                        SetMaxMCLabel(Int_t s)                       { fMaxMCLabel      = s   ; InvalidateAcceptanceCache(); }
   void                        SetMCLabelRange(Int_t min, Int_t max)        { SetMinMCLabel(min)     ; SetMaxMCLabel(max)    ; }
-  void                        SetExoticCut(Bool_t e)                       { fExoticCut       = e   ; }
-  void                        SetIncludePHOS(Bool_t b)                     { fIncludePHOS = b       ; }
-  void                        SetPhosMinNcells(Int_t n)                    { fPhosMinNcells = n; }
-  void                        SetPhosMinM02(Double_t m)                    { fPhosMinM02 = m; }
+  void                        SetExoticCut(Bool_t e)                       { fExoticCut       = e   ; InvalidateAcceptanceCache(); }
+  void                        SetIncludePHOS(Bool_t b)                     { fIncludePHOS = b       ; InvalidateAcceptanceCache(); }
+  void                        SetPhosMinNcells(Int_t n)                    { fPhosMinNcells = n; InvalidateAcceptanceCache(); }
+  void                        SetPhosMinM02(Double_t m)                    { fPhosMinM02 = m; InvalidateAcceptanceCache(); }
   void                        SetArray(const AliVEvent * event);
   void                        SetClusUserDefEnergyCut(Int_t t, Double_t cut);
   Double_t                    GetClusUserDefEnergyCut(Int_t t) const;
 
   void                        SetClusNonLinCorrEnergyCut(Double_t cut)                     { SetClusUserDefEnergyCut(AliVCluster::kNonLinCorr, cut); }
   void                        SetClusHadCorrEnergyCut(Double_t cut)                        { SetClusUserDefEnergyCut(AliVCluster::kHadCorr, cut)   ; }
-  void                        SetDefaultClusterEnergy(Int_t d)                             { fDefaultClusterEnergy = d                             ; }
+  void                        SetDefaultClusterEnergy(Int_t d)                             { fDefaultClusterEnergy = d ; InvalidateAcceptanceCache(); }
 
   Int_t                       GetDefaultClusterEnergy() const                              { return fDefaultClusterEnergy                          ; }
 
@@ -0,0 +1,276 @@
+/**************************************************************************
+ * Copyright(c) 1998-2017, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+#include <algorithm>
+
+#include <RVersion.h>
+#include <TMath.h>
+#include <TVector2.h>
+#include <TVector3.h>
+#if defined(R__USE_IMT) && ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0)
+#include <ROOT/TSeq.hxx>
+#include <ROOT/TThreadExecutor.hxx>
+#endif
+
+#include "AliVCluster.h"
+#include "AliVTrack.h"
+
+#include "AliEmcalClusTrackMatchIndex.h"
+
+/// \cond CLASSIMP
+ClassImp(AliEmcalClusTrackMatchIndex)
+/// \endcond
+
+namespace {
+  /// Maximum number of cells along each direction: for very small matching distances
+  /// the cells are made larger than the distance instead of multiplying them
+  const Int_t kMaxCells = 1000;
+  /// Relative margin on the cell size, against rounding at the cell edges
+  const Double_t kCellMargin = 1e-6;
+}
+
+/**
+ * Default constructor
+ */
+AliEmcalClusTrackMatchIndex::AliEmcalClusTrackMatchIndex() :
+  TObject(),
+  fMaxDistance(0.1),
+  fNThreads(1),
+  fClusEta(),
+  fClusPhi(),
+  fTrackEta(),
+  fTrackPhi(),
+  fEtaMin(0),
+  fEtaCellSize(1),
+  fPhiCellSize(TMath::TwoPi()),
+  fNEtaCells(0),
+  fNPhiCells(0),
+  fCellFirst(),
+  fCellClusters(),
+  fMatches()
+{
+}
+
+/**
+ * Remove the clusters, tracks and matches of the previous event.
+ * The memory is kept for the next event.
+ */
+void AliEmcalClusTrackMatchIndex::Reset()
+{
+  fClusEta.clear();
+  fClusPhi.clear();
+  fTrackEta.clear();
+  fTrackPhi.clear();
+  fCellFirst.clear();
+  fCellClusters.clear();
+  fMatches.clear();
+  fNEtaCells = 0;
+  fNPhiCells = 0;
+}
+
+/**
+ * Add a cluster, at the eta and phi of its position
+ * @param cluster Cluster
+ */
+void AliEmcalClusTrackMatchIndex::AddCluster(const AliVCluster *cluster)
+{
+  Float_t pos[3] = {0};
+  cluster->GetPosition(pos);
+  TVector3 cpos(pos);
+  AddCluster(cpos.Eta(), cpos.Phi());
+}
+
+/**
+ * Add a cluster
+ * @param eta Cluster eta
+ * @param phi Cluster phi
+ */
+void AliEmcalClusTrackMatchIndex::AddCluster(Double_t eta, Double_t phi)
+{
+  fClusEta.push_back(eta);
+  fClusPhi.push_back(phi);
+}
+
+/**
+ * Add a track, at its eta and phi on the EMCal surface
+ * @param track Track
+ */
+void AliEmcalClusTrackMatchIndex::AddTrack(const AliVTrack *track)
+{
+  AddTrack(track->GetTrackEtaOnEMCal(), track->GetTrackPhiOnEMCal());
+}
+
+/**
+ * Add a track
+ * @param eta Track eta on EMCal
+ * @param phi Track phi on EMCal
+ */
+void AliEmcalClusTrackMatchIndex::AddTrack(Double_t eta, Double_t phi)
+{
+  fTrackEta.push_back(eta);
+  fTrackPhi.push_back(phi);
+}
+
+/**
+ * Eta cell of an eta value. Values outside of the cells and of their
+ * direct neighbours are returned as -2, they cannot match any cluster.
+ * @param eta Eta
+ * @return Cell index, can be -1 or fNEtaCells for the neighbours of the cells
+ */
+Int_t AliEmcalClusTrackMatchIndex::GetEtaCell(Double_t eta) const
+{
+  Double_t x = (eta - fEtaMin) / fEtaCellSize;
+  if (!(x >= -1 && x < fNEtaCells + 1)) return -2;
+  return TMath::FloorNint(x);
+}
+
+/**
+ * Phi cell of a phi value
+ * @param phi Phi
+ * @return Cell index
+ */
+Int_t AliEmcalClusTrackMatchIndex::GetPhiCell(Double_t phi) const
+{
+  Int_t cell = Int_t(TVector2::Phi_0_2pi(phi) / fPhiCellSize);
+  if (cell >= fNPhiCells) cell = fNPhiCells - 1;
+  if (cell < 0) cell = 0;
+  return cell;
+}
+
+/**
+ * Bin the clusters in eta-phi cells of at least the matching distance
+ */
+void AliEmcalClusTrackMatchIndex::BuildCells()
+{
+  const Int_t nClus = fClusEta.size();
+  fCellFirst.clear();
+  fCellClusters.clear();
+  fNEtaCells = 0;
+  fNPhiCells = 0;
+  if (nClus == 0) return;
+
+  Double_t etaMax = fClusEta[0];
+  fEtaMin = fClusEta[0];
+  for (Int_t i = 1; i < nClus; i++) {
+    if (fClusEta[i] < fEtaMin) fEtaMin = fClusEta[i];
+    if (fClusEta[i] > etaMax) etaMax = fClusEta[i];
+  }
+
+  // A zero distance only matches identical positions: a single cell, as without index
+  const Double_t maxd = TMath::Abs(fMaxDistance) * (1 + kCellMargin);
+  if (maxd > 0) {
+    fEtaCellSize = TMath::Max(maxd, (etaMax - fEtaMin) / kMaxCells);
+    fNEtaCells = TMath::FloorNint((etaMax - fEtaMin) / fEtaCellSize) + 1;
+    fNPhiCells = TMath::Min(kMaxCells, TMath::Max(1, TMath::FloorNint(TMath::TwoPi() / maxd)));
+  }
+  else {
+    fEtaCellSize = (etaMax - fEtaMin) + 1;
+    fNEtaCells = 1;
+    fNPhiCells = 1;
+  }
+  fPhiCellSize = TMath::TwoPi() / fNPhiCells;
+
+  // Counting sort of the clusters by cell, keeping their order within a cell
+  std::vector<Int_t> cellOfCluster(nClus);
+  fCellFirst.assign(fNEtaCells * fNPhiCells + 1, 0);
+  for (Int_t i = 0; i < nClus; i++) {
+    Int_t ieta = GetEtaCell(fClusEta[i]);
+    if (ieta < 0) ieta = 0;
+    if (ieta >= fNEtaCells) ieta = fNEtaCells - 1;
+    cellOfCluster[i] = ieta * fNPhiCells + GetPhiCell(fClusPhi[i]);
+    fCellFirst[cellOfCluster[i] + 1]++;
+  }
+  for (UInt_t icell = 1; icell < fCellFirst.size(); icell++) fCellFirst[icell] += fCellFirst[icell - 1];
+  fCellClusters.resize(nClus);
+  std::vector<Int_t> next(fCellFirst.begin(), fCellFirst.end() - 1);
+  for (Int_t i = 0; i < nClus; i++) fCellClusters[next[cellOfCluster[i]]++] = i;
+}
+
+/**
+ * Match the tracks in [first,last) with the clusters of the neighbouring cells
+ * @param first First track
+ * @param last Track after the last one
+ * @param matches Matches are appended here, ordered by track and cluster
+ * @param candidates Work space for the clusters to check
+ */
+void AliEmcalClusTrackMatchIndex::MatchTracks(Int_t first, Int_t last, std::vector<Match> &matches, std::vector<Int_t> &candidates) const
+{
+  const Double_t maxd2 = fMaxDistance * fMaxDistance;
+
+  for (Int_t itrack = first; itrack < last; itrack++) {
+    const Int_t ieta = GetEtaCell(fTrackEta[itrack]);
+    if (ieta == -2) continue;
+    const Int_t iphi = GetPhiCell(fTrackPhi[itrack]);
+
+    candidates.clear();
+    for (Int_t jeta = TMath::Max(0, ieta - 1); jeta <= TMath::Min(fNEtaCells - 1, ieta + 1); jeta++) {
+      for (Int_t k = -1; k <= 1; k++) {
+        // with less than 3 phi cells, all of them are neighbours
+        if (fNPhiCells < 3 && k >= fNPhiCells - 1) break;
+        const Int_t jphi = fNPhiCells < 3 ? k + 1 : (iphi + k + fNPhiCells) % fNPhiCells;
+        const Int_t cell = jeta * fNPhiCells + jphi;
+        candidates.insert(candidates.end(), fCellClusters.begin() + fCellFirst[cell], fCellClusters.begin() + fCellFirst[cell + 1]);
+      }
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    for (UInt_t i = 0; i < candidates.size(); i++) {
+      const Int_t icluster = candidates[i];
+      Match m;
+      m.fTrack = itrack;
+      m.fCluster = icluster;
+      m.fDEta = fTrackEta[itrack] - fClusEta[icluster];
+      m.fDPhi = TVector2::Phi_mpi_pi(fTrackPhi[itrack] - fClusPhi[icluster]);
+      const Double_t d2 = m.fDEta * m.fDEta + m.fDPhi * m.fDPhi;
+      if (d2 > maxd2) continue;
+      m.fDist = TMath::Sqrt(d2);
+      matches.push_back(m);
+    }
+  }
+}
+
+/**
+ * Find all track-cluster pairs within the maximum distance
+ * @return Number of matches
+ */
+Int_t AliEmcalClusTrackMatchIndex::FindMatches()
+{
+  fMatches.clear();
+  BuildCells();
+  const Int_t nTracks = fTrackEta.size();
+  if (fClusEta.empty() || nTracks == 0) return 0;
+
+  Bool_t done = kFALSE;
+#if defined(R__USE_IMT) && ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0)
+  const Int_t nThreads = (fNThreads > 1 && nTracks > fNThreads) ? fNThreads : 1;
+  if (nThreads > 1) {
+    // Each chunk of tracks is matched by one task, the chunks are then joined in order
+    std::vector<std::vector<Match> > partial(nThreads);
+    const Int_t chunk = (nTracks + nThreads - 1) / nThreads;
+    ROOT::TThreadExecutor pool(nThreads);
+    pool.Foreach([&](Int_t iChunk) {
+      std::vector<Int_t> candidates;
+      MatchTracks(iChunk * chunk, TMath::Min(nTracks, (iChunk + 1) * chunk), partial[iChunk], candidates);
+    }, ROOT::TSeqI(nThreads));
+    for (Int_t iChunk = 0; iChunk < nThreads; iChunk++) fMatches.insert(fMatches.end(), partial[iChunk].begin(), partial[iChunk].end());
+    done = kTRUE;
+  }
+#endif
+  if (!done) {
+    std::vector<Int_t> candidates;
+    MatchTracks(0, nTracks, fMatches, candidates);
+  }
+
+  return fMatches.size();
+}
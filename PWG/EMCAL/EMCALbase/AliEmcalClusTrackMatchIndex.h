@@ -0,0 +1,106 @@
+#ifndef ALIEMCALCLUSTRACKMATCHINDEX_H
+#define ALIEMCALCLUSTRACKMATCHINDEX_H
+/* Copyright(c) 1998-2017, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include <vector>
+
+#include <TObject.h>
+
+class AliVCluster;
+class AliVTrack;
+
+/**
+ * \class AliEmcalClusTrackMatchIndex
+ * \brief Eta-phi binned index of clusters to find the tracks matched to them
+ *
+ * The clusters are binned in eta-phi cells not smaller than the matching distance,
+ * so that each track only looks at the clusters of its own cell and of the 8 neighbouring
+ * cells, instead of at all clusters of the event. The eta and phi of the clusters and of
+ * the tracks on the EMCal surface are computed once per object, the differences are the
+ * same as the ones of AliAnalysisTaskEmcal::GetEtaPhiDiff().
+ *
+ * Usage, once per event:
+ * ~~~{.cxx}
+ * index.SetMaxDistance(0.1);
+ * index.Reset();
+ * for (...) index.AddCluster(cluster);
+ * for (...) index.AddTrack(track);
+ * index.FindMatches();
+ * for (UInt_t i = 0; i < index.GetNMatches(); i++) {
+ *   const AliEmcalClusTrackMatchIndex::Match &m = index.GetMatch(i);
+ *   ...
+ * }
+ * ~~~
+ * The matches are ordered by track, then by cluster, in the order in which they were added,
+ * which is the order a loop over all tracks and all clusters would give. This does not depend on
+ * the number of threads (see SetNThreads(), needs ROOT with imt).
+ *
+ * \ingroup EMCALCOREFW
+ */
+class AliEmcalClusTrackMatchIndex : public TObject {
+ public:
+
+  /// A matched track-cluster pair
+  struct Match {
+    Int_t    fTrack;     ///< Index of the track, in the order of AddTrack()
+    Int_t    fCluster;   ///< Index of the cluster, in the order of AddCluster()
+    Double_t fDEta;      ///< Track eta on EMCal minus cluster eta
+    Double_t fDPhi;      ///< Track phi on EMCal minus cluster phi, in [-pi,pi]
+    Double_t fDist;      ///< Distance in the eta-phi plane
+  };
+
+  AliEmcalClusTrackMatchIndex();
+  virtual ~AliEmcalClusTrackMatchIndex() {}
+
+  void                 SetMaxDistance(Double_t d)         { fMaxDistance = d; }
+  void                 SetNThreads(Int_t n)               { fNThreads    = n; }
+  Double_t             GetMaxDistance()             const { return fMaxDistance; }
+  Int_t                GetNThreads()                const { return fNThreads; }
+
+  void                 Reset();
+  void                 AddCluster(const AliVCluster *cluster);
+  void                 AddCluster(Double_t eta, Double_t phi);
+  void                 AddTrack(const AliVTrack *track);
+  void                 AddTrack(Double_t eta, Double_t phi);
+  Int_t                FindMatches();
+
+  Int_t                GetNClusters()               const { return fClusEta.size(); }
+  Int_t                GetNTracks()                 const { return fTrackEta.size(); }
+  UInt_t               GetNMatches()                const { return fMatches.size(); }
+  const Match         &GetMatch(UInt_t i)           const { return fMatches[i]; }
+
+ protected:
+  void                 BuildCells();
+  void                 MatchTracks(Int_t first, Int_t last, std::vector<Match> &matches, std::vector<Int_t> &candidates) const;
+  Int_t                GetEtaCell(Double_t eta)     const;
+  Int_t                GetPhiCell(Double_t phi)     const;
+
+  Double_t             fMaxDistance;      ///< Maximum distance in the eta-phi plane of a matched pair
+  Int_t                fNThreads;         ///< Number of threads used to match the tracks
+
+  std::vector<Double_t> fClusEta;         //!<! Cluster eta
+  std::vector<Double_t> fClusPhi;         //!<! Cluster phi
+  std::vector<Double_t> fTrackEta;        //!<! Track eta on EMCal
+  std::vector<Double_t> fTrackPhi;        //!<! Track phi on EMCal
+
+  Double_t             fEtaMin;           //!<! Lower edge of the first eta cell
+  Double_t             fEtaCellSize;      //!<! Width of the eta cells
+  Double_t             fPhiCellSize;      //!<! Width of the phi cells
+  Int_t                fNEtaCells;        //!<! Number of eta cells
+  Int_t                fNPhiCells;        //!<! Number of phi cells, covering [0,2pi)
+  std::vector<Int_t>   fCellFirst;        //!<! First entry of each cell in fCellClusters
+  std::vector<Int_t>   fCellClusters;     //!<! Cluster indices grouped by cell, in increasing order within a cell
+
+  std::vector<Match>   fMatches;          //!<! Matches of the last FindMatches()
+
+ private:
+  AliEmcalClusTrackMatchIndex(const AliEmcalClusTrackMatchIndex&);            // not implemented
+  AliEmcalClusTrackMatchIndex &operator=(const AliEmcalClusTrackMatchIndex&); // not implemented
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalClusTrackMatchIndex, 1);
+  /// \endcond
+};
+
+#endif
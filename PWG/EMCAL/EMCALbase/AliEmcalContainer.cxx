@@ -55,6 +55,13 @@ AliEmcalContainer::AliEmcalContainer():
   fCurrentID(0),
   fLabelMap(0),
   fLoadedClass(0),
+  fUseAcceptanceCache(kTRUE),
+  fEventDriven(kFALSE),
+  fAcceptanceCacheValid(kFALSE),
+  fNAcceptedEntries(0),
+  fAcceptFlags(),
+  fRejectionReasons(),
+  fAcceptedIndices(),
   fClassName()
 {
   fVertex[0] = 0;
@@ -92,6 +99,13 @@ AliEmcalContainer::AliEmcalContainer(const char *name):
   fCurrentID(0),
   fLabelMap(0),
   fLoadedClass(0),
+  fUseAcceptanceCache(kTRUE),
+  fEventDriven(kFALSE),
+  fAcceptanceCacheValid(kFALSE),
+  fNAcceptedEntries(0),
+  fAcceptFlags(),
+  fRejectionReasons(),
+  fAcceptedIndices(),
   fClassName()
 {
   fVertex[0] = 0;
@@ -132,6 +146,8 @@ void AliEmcalContainer::SetClassName(const char *clname)
  */
 void AliEmcalContainer::SetArray(const AliVEvent *event)
 {
+  fAcceptanceCacheValid = kFALSE;
+
   // Handling of default containers
   if(fClArrayName == "usedefault"){
     fClArrayName = GetDefaultArrayName(event);
@@ -177,11 +193,76 @@ void AliEmcalContainer::SetArray(const AliVEvent *event)
   fLabelMap = dynamic_cast<AliNamedArrayI*>(event->FindListObject(fClArrayName + "_Map"));
 }
 
+/**
+ * Preparation for the next event: the acceptance cache is
+ * invalidated. Calling this function at each event enables
+ * the acceptance cache (see IsAcceptedEntry).
+ */
+void AliEmcalContainer::NextEvent()
+{
+  fEventDriven = kTRUE;
+  fAcceptanceCacheValid = kFALSE;
+}
+
+/**
+ * Run the selection on all entries of the container and store
+ * the result, the rejection reason and the list of accepted indices.
+ * The cache is valid until the next call of NextEvent or SetArray, or until
+ * one of the cut setters of the container (or of the derived containers) is called.
+ */
+void AliEmcalContainer::BuildAcceptanceCache() const
+{
+  Int_t n = GetNEntries();
+  fAcceptFlags.Set(n);
+  fRejectionReasons.Set(n);
+  fAcceptedIndices.Set(n);
+  fNAcceptedEntries = 0;
+  for (Int_t index = 0; index < n; index++) {
+    UInt_t rejectionReason = 0;
+    Bool_t accepted = AcceptObject(index, rejectionReason);
+    fAcceptFlags[index] = accepted;
+    fRejectionReasons[index] = rejectionReason;
+    if (accepted) fAcceptedIndices[fNAcceptedEntries++] = index;
+  }
+  fAcceptanceCacheValid = kTRUE;
+}
+
+/**
+ * Check whether the acceptance cache can be used and build it
+ * if it is not up to date (new event or different number of entries).
+ * @return True if the acceptance cache can be used
+ */
+Bool_t AliEmcalContainer::UpdateAcceptanceCache() const
+{
+  if (!fUseAcceptanceCache || !fEventDriven) return kFALSE;
+  if (!fAcceptanceCacheValid || fAcceptFlags.GetSize() != GetNEntries()) BuildAcceptanceCache();
+  return kTRUE;
+}
+
+/**
+ * Selection of the entry with index i. If the container is event-driven
+ * (NextEvent is called at each event) and the acceptance cache is enabled,
+ * the selection of all entries is performed once per event and the stored
+ * result is returned. Otherwise AcceptObject is called.
+ * @param[in] i Index of the entry
+ * @param[out] rejectionReason Bitmap for reason why object is rejected
+ * @return True if the entry is accepted, false otherwise
+ */
+Bool_t AliEmcalContainer::IsAcceptedEntry(Int_t i, UInt_t &rejectionReason) const
+{
+  if (i < 0 || i >= GetNEntries() || !UpdateAcceptanceCache()) return AcceptObject(i, rejectionReason);
+
+  rejectionReason |= fRejectionReasons[i];
+  return fAcceptFlags[i];
+}
+
 /**
  * Count accepted entries in the container
  * @return Number of accepted events in the container
  */
 Int_t AliEmcalContainer::GetNAcceptEntries() const{
+  if (UpdateAcceptanceCache()) return fNAcceptedEntries;
+
   Int_t result = 0;
   for(int index = 0; index < GetNEntries(); index++){
     UInt_t rejectionReason = 0;
@@ -190,6 +271,26 @@ Int_t AliEmcalContainer::GetNAcceptEntries() const{
   return result;
 }
 
+/**
+ * Fill the indices of the accepted entries in the container
+ * @param[out] indices Array with the indices of the accepted entries
+ */
+void AliEmcalContainer::GetAcceptedIndices(TArrayI &indices) const
+{
+  if (UpdateAcceptanceCache()) {
+    indices.Set(fNAcceptedEntries, fAcceptedIndices.GetArray());
+    return;
+  }
+
+  indices.Set(GetNEntries());
+  Int_t acceptCounter = 0;
+  for(int index = 0; index < GetNEntries(); index++){
+    UInt_t rejectionReason = 0;
+    if(AcceptObject(index, rejectionReason)) indices[acceptCounter++] = index;
+  }
+  indices.Set(acceptCounter);
+}
+
 /**
  * Get the index in the container from a given label
  * @param lab Label to check
@@ -13,6 +13,8 @@ class AliVParticle;
 
 #include <TNamed.h>
 #include <TClonesArray.h>
+#include <TArrayI.h>
+#include <TArrayC.h>
 
 #if !(defined(__CINT__) || defined(__MAKECINT__))
 typedef EMCALIterableContainer::AliEmcalIterableContainerT<TObject, EMCALIterableContainer::operator_star_object<TObject> > AliEmcalIterableContainer;
@@ -148,27 +150,32 @@ class AliEmcalContainer : public TObject {
   virtual Bool_t              AcceptObject(Int_t i, UInt_t &rejectionReason) const = 0;
   virtual Bool_t              AcceptObject(const TObject* obj, UInt_t &rejectionReason) const = 0;
   Int_t                       GetNAcceptEntries() const;
+  Bool_t                      IsAcceptedEntry(Int_t i, UInt_t &rejectionReason) const;
+  void                        GetAcceptedIndices(TArrayI &indices) const;
+  void                        SetUseAcceptanceCache(Bool_t b)       { fUseAcceptanceCache = b; fAcceptanceCacheValid = kFALSE; }
+  Bool_t                      GetUseAcceptanceCache()         const { return fUseAcceptanceCache        ; }
+  void                        InvalidateAcceptanceCache()           { fAcceptanceCacheValid = kFALSE    ; }
   void                        ResetCurrentID(Int_t i=-1)            { fCurrentID = i                    ; }
   virtual void                SetArray(const AliVEvent *event);
   void                        SetArrayName(const char *n)           { fClArrayName = n                  ; }
-  void                        SetBitMap(UInt_t m)                   { fBitMap = m                       ; }
+  void                        SetBitMap(UInt_t m)                   { fBitMap = m                       ; InvalidateAcceptanceCache(); }
   void                        SetIsParticleLevel(Bool_t b)          { fIsParticleLevel = b              ; }
   void                        SortArray()                           { fClArray->Sort()                  ; }
 
   TClass*                     GetLoadedClass()                      { return fLoadedClass               ; }
-  virtual void                NextEvent() {;}
-  void                        SetMinMCLabel(Int_t s)                            { fMinMCLabel      = s   ; }
-  void                        SetMaxMCLabel(Int_t s)                            { fMaxMCLabel      = s   ; }
+  virtual void                NextEvent();
+  void                        SetMinMCLabel(Int_t s)                            { fMinMCLabel      = s   ; InvalidateAcceptanceCache(); }
+  void                        SetMaxMCLabel(Int_t s)                            { fMaxMCLabel      = s   ; InvalidateAcceptanceCache(); }
   void                        SetMCLabelRange(Int_t min, Int_t max)             { SetMinMCLabel(min)     ; SetMaxMCLabel(max)    ; }
-  void                        SetELimits(Double_t min, Double_t max)    { fMinE   = min ; fMaxE   = max ; }
-  void                        SetMinE(Double_t min)                     { fMinE   = min ; }
-  void                        SetMaxE(Double_t max)                     { fMaxE   = max ; }
-  void                        SetPtLimits(Double_t min, Double_t max)   { fMinPt  = min ; fMaxPt  = max ; }
-  void                        SetMinPt(Double_t min)                    { fMinPt  = min ; }
-  void                        SetMaxPt(Double_t max)                    { fMaxPt  = max ; }
-  void                        SetEtaLimits(Double_t min, Double_t max)  { fMaxEta = max ; fMinEta = min ; }
-  void                        SetPhiLimits(Double_t min, Double_t max)  { fMaxPhi = max ; fMinPhi = min ; }
-  void                        SetMassHypothesis(Double_t m)             { fMassHypothesis         = m   ; }
+  void                        SetELimits(Double_t min, Double_t max)    { fMinE   = min ; fMaxE   = max ; InvalidateAcceptanceCache(); }
+  void                        SetMinE(Double_t min)                     { fMinE   = min ; InvalidateAcceptanceCache(); }
+  void                        SetMaxE(Double_t max)                     { fMaxE   = max ; InvalidateAcceptanceCache(); }
+  void                        SetPtLimits(Double_t min, Double_t max)   { fMinPt  = min ; fMaxPt  = max ; InvalidateAcceptanceCache(); }
+  void                        SetMinPt(Double_t min)                    { fMinPt  = min ; InvalidateAcceptanceCache(); }
+  void                        SetMaxPt(Double_t max)                    { fMaxPt  = max ; InvalidateAcceptanceCache(); }
+  void                        SetEtaLimits(Double_t min, Double_t max)  { fMaxEta = max ; fMinEta = min ; InvalidateAcceptanceCache(); }
+  void                        SetPhiLimits(Double_t min, Double_t max)  { fMaxPhi = max ; fMinPhi = min ; InvalidateAcceptanceCache(); }
+  void                        SetMassHypothesis(Double_t m)             { fMassHypothesis         = m   ; InvalidateAcceptanceCache(); }
   void                        SetClassName(const char *clname);
   void                        SetIsEmbedding(Bool_t b)                  { fIsEmbedding = b ; }
   Bool_t                      GetIsEmbedding() const                    { return fIsEmbedding; }
@@ -199,6 +206,9 @@ class AliEmcalContainer : public TObject {
    */
   virtual TString             GetDefaultArrayName(const AliVEvent * const ev) const { return ""; }
 
+  void                        BuildAcceptanceCache() const;
+  Bool_t                      UpdateAcceptanceCache() const;
+
   TString                     fName;                    ///< object name
   TString                     fClArrayName;             ///< name of branch
   TString                     fBaseClassName;           ///< name of the base class that this container can handle
@@ -221,6 +231,13 @@ class AliEmcalContainer : public TObject {
   AliNamedArrayI             *fLabelMap;                //!<! Label-Index map
   Double_t                    fVertex[3];               //!<! event vertex array
   TClass                     *fLoadedClass;             //!<! Class of the objects contained in the TClonesArray
+  Bool_t                      fUseAcceptanceCache;      ///< Cache the selection of all entries once per event
+  Bool_t                      fEventDriven;             //!<! NextEvent is called by the owner at each event, the acceptance cache can be used
+  mutable Bool_t              fAcceptanceCacheValid;    //!<! Acceptance cache is up to date for the current event
+  mutable Int_t               fNAcceptedEntries;        //!<! Number of accepted entries in the current event
+  mutable TArrayC             fAcceptFlags;             //!<! Selection result for each entry in the current event
+  mutable TArrayI             fRejectionReasons;        //!<! Rejection reason for each entry in the current event
+  mutable TArrayI             fAcceptedIndices;         //!<! Indices of the accepted entries in the current event
 
  private:
   TString                     fClassName;               ///< name of the class in the TClonesArray
@@ -229,7 +246,7 @@ class AliEmcalContainer : public TObject {
   AliEmcalContainer& operator=(const AliEmcalContainer& other); // assignment
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalContainer,9);
+  ClassDef(AliEmcalContainer,10);
   /// \endcond
 };
 #endif
@@ -327,17 +327,13 @@ T *AliEmcalIterableContainerT<T, STAR>::operator[](int index) const {
 
 /**
  * Build list of accepted indices inside the container.
- * For this all objects inside the container are checked
- * for being accepted or not.
+ * The list is taken from the acceptance cache of the container
+ * if available, otherwise all objects inside the container are
+ * checked for being accepted or not.
  */
 template <typename T, typename STAR>
 void AliEmcalIterableContainerT<T, STAR>::BuildAcceptIndices(){
-  fAcceptIndices.Set(fkContainer->GetNAcceptEntries());
-  int acceptCounter = 0;
-  for(int index = 0; index < fkContainer->GetNEntries(); index++){
-    UInt_t rejectionReason = 0;
-    if(fkContainer->AcceptObject(index, rejectionReason)) fAcceptIndices[acceptCounter++] = index;
-  }
+  fkContainer->GetAcceptedIndices(fAcceptIndices);
 }
 
 ///////////////////////////////////////////////////////////////////////
@@ -47,7 +47,7 @@ class AliMCParticleContainer : public AliParticleContainer {
   virtual AliVParticle       *GetNextAcceptParticle()                         { return GetNextAcceptMCParticle()  ; }
   virtual AliVParticle       *GetNextParticle()                               { return GetNextMCParticle()        ; }
 
-  void                        SetMCFlag(UInt_t m)                             { fMCFlag          = m ; }
+  void                        SetMCFlag(UInt_t m)                             { fMCFlag          = m ; InvalidateAcceptanceCache(); }
   void                        SelectPhysicalPrimaries(Bool_t s)               { if (s) fMCFlag |=  AliAODMCParticle::kPhysicalPrim ;   }
 
   const char*                 GetTitle() const;
@@ -114,7 +114,7 @@ AliVParticle* AliParticleContainer::GetAcceptParticle(Int_t i) const
 {
   UInt_t rejectionReason = 0;
   if (i == -1) i = fCurrentID;
-  if (AcceptParticle(i, rejectionReason)) {
+  if (IsAcceptedEntry(i, rejectionReason)) {
       return GetParticle(i);
   }
   else {
@@ -416,12 +416,7 @@ Bool_t AliParticleContainer::ApplyKinematicCuts(const AliTLorentzVector& mom, UI
  */
 Int_t AliParticleContainer::GetNAcceptedParticles() const
 {
-  Int_t nPart = 0;
-  for(int ipart = 0; ipart < this->GetNParticles(); ipart++){
-    UInt_t rejectionReason = 0;
-    if(this->AcceptParticle(ipart, rejectionReason)) nPart++;
-  }
-  return nPart;
+  return GetNAcceptEntries();
 }
 
 /**
@@ -71,10 +71,10 @@ class AliParticleContainer : public AliEmcalContainer {
   virtual Bool_t              GetNextAcceptMomentum(TLorentzVector &mom);
   Int_t                       GetNParticles()                           const   {return GetNEntries();}
   Int_t                       GetNAcceptedParticles()                   const;
-  void                        SetMinDistanceTPCSectorEdge(Double_t min)         { fMinDistanceTPCSectorEdge = min; }
-  void                        SetCharge(EChargeCut_t c)                         { fChargeCut = c       ; }
+  void                        SetMinDistanceTPCSectorEdge(Double_t min)         { fMinDistanceTPCSectorEdge = min; InvalidateAcceptanceCache(); }
+  void                        SetCharge(EChargeCut_t c)                         { fChargeCut = c       ; InvalidateAcceptanceCache(); }
   void                        SelectHIJING(Bool_t s)                            { if (s) fGeneratorIndex = 0; else fGeneratorIndex = -1; }
-  void                        SetGeneratorIndex(Short_t i)                      { fGeneratorIndex = i  ; }
+  void                        SetGeneratorIndex(Short_t i)                      { fGeneratorIndex = i  ; InvalidateAcceptanceCache(); }
   void                        SetArray(const AliVEvent * event);
 
   const char*                 GetTitle() const;
@@ -151,6 +151,8 @@ void AliTrackContainer::SetArray(const AliVEvent *event)
  */
 void AliTrackContainer::NextEvent()
 {
+  AliParticleContainer::NextEvent();
+
   fTrackTypes.Reset(kUndefined);
   if (fEmcalTrackSelection) {
     fFilteredTracks = fEmcalTrackSelection->GetAcceptedTracks(fClArray);
@@ -207,9 +209,9 @@ AliVTrack* AliTrackContainer::GetTrack(Int_t i) const
  */
 AliVTrack* AliTrackContainer::GetAcceptTrack(Int_t i) const
 {
-  UInt_t rejectionReason;
+  UInt_t rejectionReason = 0;
   if (i == -1) i = fCurrentID;
-  if (AcceptTrack(i, rejectionReason)) {
+  if (IsAcceptedEntry(i, rejectionReason)) {
       return GetTrack(i);
   }
   else {
@@ -526,6 +528,7 @@ void AliTrackContainer::AddTrackCuts(AliVCuts *cuts)
     fListOfCuts->SetOwner(true);
   }
   fListOfCuts->Add(cuts);
+  InvalidateAcceptanceCache();
 }
 
 /**
@@ -13,6 +13,7 @@
 #pragma link C++ class AliEmcalContainerUtils+;
 #pragma link C++ class AliEmcalDownscaleFactorsOCDB+;
 #pragma link C++ class AliEmcalAODFilterBitCuts+;
+#pragma link C++ class AliEmcalClusTrackMatchIndex+;
 #pragma link C++ class AliEmcalESDTrackCutsGenerator+;
 #pragma link C++ class AliEmcalParticle+;
 #pragma link C++ class AliEmcalPhysicsSelection+;
@@ -37,7 +37,8 @@ AliEmcalClusTrackMatcherTask::AliEmcalClusTrackMatcherTask() :
   fNEmcalTracks(0),
   fNEmcalClusters(0),
   fHistMatchEtaAll(0),
-  fHistMatchPhiAll(0)
+  fHistMatchPhiAll(0),
+  fMatchIndex()
 {
   // Constructor.
 
@@ -67,7 +68,8 @@ AliEmcalClusTrackMatcherTask::AliEmcalClusTrackMatcherTask(const char *name, Boo
   fNEmcalTracks(0),
   fNEmcalClusters(0),
   fHistMatchEtaAll(0),
-  fHistMatchPhiAll(0)
+  fHistMatchPhiAll(0),
+  fMatchIndex()
 {
   // Standard constructor.
 
@@ -280,45 +282,53 @@ void AliEmcalClusTrackMatcherTask::GenerateEmcalParticles()
 void AliEmcalClusTrackMatcherTask::DoMatching() 
 {
   // Set the links between tracks and clusters.
+  // The clusters are binned in eta-phi, each track is only compared with the clusters
+  // in the neighbouring cells. The matches come in the order of a loop over tracks and clusters.
 
-  const Double_t maxd2 = fMaxDistance*fMaxDistance;
-
+  fMatchIndex.SetMaxDistance(fMaxDistance);
+  fMatchIndex.Reset();
+  for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
+    fMatchIndex.AddCluster(emcalCluster->GetCluster());
+  }
   for (Int_t itrack = 0; itrack < fNEmcalTracks; itrack++) {
+    AliEmcalParticle* emcalTrack = static_cast<AliEmcalParticle*>(fEmcalTracks->At(itrack));
+    fMatchIndex.AddTrack(emcalTrack->GetTrack());
+  }
+  fMatchIndex.FindMatches();
+
+  for (UInt_t imatch = 0; imatch < fMatchIndex.GetNMatches(); imatch++) {
+    const AliEmcalClusTrackMatchIndex::Match &match = fMatchIndex.GetMatch(imatch);
+    const Int_t itrack = match.fTrack;
+    const Int_t icluster = match.fCluster;
     AliEmcalParticle* emcalTrack = static_cast<AliEmcalParticle*>(fEmcalTracks->At(itrack));
     AliVTrack* track = emcalTrack->GetTrack();
+    AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
+    AliVCluster* cluster = emcalCluster->GetCluster();
 
-    for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
-      AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
-      AliVCluster* cluster = emcalCluster->GetCluster();
-
-      Double_t deta = 999;
-      Double_t dphi = 999;
-      GetEtaPhiDiff(track, cluster, dphi, deta);
-      Double_t d2 = deta * deta + dphi * dphi;
-      if (d2 > maxd2) continue;
-
-      Double_t d = TMath::Sqrt(d2);
-      emcalCluster->AddMatchedObj(itrack, d);
-      emcalTrack->AddMatchedObj(icluster, d);
-      AliDebug(2, Form("Now matching cluster E = %.3f, pT = %.3f, eta = %.3f, phi = %.3f "
-          "with track pT = %.3f, eta = %.3f, phi = %.3f"
-          "Track eta, phi on EMCal = %.3f, %.3f, d = %.3f",
-          cluster->GetNonLinCorrEnergy(), emcalCluster->Pt(), emcalCluster->Eta(), emcalCluster->Phi(),
-          emcalTrack->Pt(), emcalTrack->Eta(), emcalTrack->Phi(),
-          track->GetTrackEtaOnEMCal(), track->GetTrackPhiOnEMCal(), d));
-
-      if (fCreateHisto) {
-        Int_t mombin = GetMomBin(track->P());
-        Int_t centbinch = fCentBin;
-        if (track->Charge() < 0) centbinch += fNcentBins;
-        Int_t etabin = 0;
-        if(track->Eta() > 0) etabin = 1;
-
-        fHistMatchEta[centbinch][mombin][etabin]->Fill(deta);
-        fHistMatchPhi[centbinch][mombin][etabin]->Fill(dphi);
-        fHistMatchEtaAll->Fill(deta);
-        fHistMatchPhiAll->Fill(dphi);
-      }
+    Double_t deta = match.fDEta;
+    Double_t dphi = match.fDPhi;
+    Double_t d = match.fDist;
+    emcalCluster->AddMatchedObj(itrack, d);
+    emcalTrack->AddMatchedObj(icluster, d);
+    AliDebug(2, Form("Now matching cluster E = %.3f, pT = %.3f, eta = %.3f, phi = %.3f "
+        "with track pT = %.3f, eta = %.3f, phi = %.3f"
+        "Track eta, phi on EMCal = %.3f, %.3f, d = %.3f",
+        cluster->GetNonLinCorrEnergy(), emcalCluster->Pt(), emcalCluster->Eta(), emcalCluster->Phi(),
+        emcalTrack->Pt(), emcalTrack->Eta(), emcalTrack->Phi(),
+        track->GetTrackEtaOnEMCal(), track->GetTrackPhiOnEMCal(), d));
+
+    if (fCreateHisto) {
+      Int_t mombin = GetMomBin(track->P());
+      Int_t centbinch = fCentBin;
+      if (track->Charge() < 0) centbinch += fNcentBins;
+      Int_t etabin = 0;
+      if(track->Eta() > 0) etabin = 1;
+
+      fHistMatchEta[centbinch][mombin][etabin]->Fill(deta);
+      fHistMatchPhi[centbinch][mombin][etabin]->Fill(dphi);
+      fHistMatchEtaAll->Fill(deta);
+      fHistMatchPhiAll->Fill(dphi);
     }
   }
 }
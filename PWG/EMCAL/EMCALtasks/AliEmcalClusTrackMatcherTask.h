@@ -2,6 +2,7 @@
 #define ALIEMCALCLUSTRACKMATCHERTASK_H
 
 #include "AliAnalysisTaskEmcal.h"
+#include "AliEmcalClusTrackMatchIndex.h"
 
 class AliEmcalClusTrackMatcherTask : public AliAnalysisTaskEmcal {
  public:
@@ -17,6 +18,7 @@ class AliEmcalClusTrackMatcherTask : public AliAnalysisTaskEmcal {
   void          SetAttachEmcalParticles(Bool_t b) { fAttachEmcalParticles  = b; }
   void          SetUpdateTracks(Bool_t b)         { fUpdateTracks          = b; }
   void          SetUpdateClusters(Bool_t b)       { fUpdateClusters        = b; }
+  void          SetNMatchingThreads(Int_t n)      { fMatchIndex.SetNThreads(n); }
 
  protected:
   void          ExecOnce();
@@ -46,11 +48,12 @@ class AliEmcalClusTrackMatcherTask : public AliAnalysisTaskEmcal {
   TH1          *fHistMatchPhiAll;       //!dphi distribution
   TH1          *fHistMatchEta[10][9][2]; //!deta distribution
   TH1          *fHistMatchPhi[10][9][2]; //!dphi distribution
+  AliEmcalClusTrackMatchIndex fMatchIndex; // eta-phi index of the clusters used for the matching
   
  private:
   AliEmcalClusTrackMatcherTask(const AliEmcalClusTrackMatcherTask&);            // not implemented
   AliEmcalClusTrackMatcherTask &operator=(const AliEmcalClusTrackMatcherTask&); // not implemented
 
-  ClassDef(AliEmcalClusTrackMatcherTask, 8) // Cluster-Track matching task
+  ClassDef(AliEmcalClusTrackMatcherTask, 9) // Cluster-Track matching task
 };
 #endif
@@ -636,10 +636,7 @@ void AliHadCorrTask::DoMatchedTracksLoop(Int_t icluster,
 
       if (fCreateHisto) {
         if (fHadCorr > 1) {
-          Double_t dphi = 0;
-          Double_t deta = 0;
-          GetEtaPhiDiff(track, cluster, dphi, deta);
-          Double_t dR = TMath::Sqrt(dphi*dphi + deta*deta);
+          Double_t dR = TMath::Sqrt(phidiff*phidiff + etadiff*etadiff);
           Double_t energyclus = cluster->GetNonLinCorrEnergy();
           fHistMatchdRvsEP[fCentBin]->Fill(dR, energyclus / mom);
         }
@@ -767,10 +764,7 @@ Double_t AliHadCorrTask::ApplyHadCorrOneTrack(Int_t icluster, Double_t hadCorr)
     fHistMatchEtaPhiAll->Fill(dEtaMin, dPhiMin);
     
     if (mom > 0) {
-      Double_t etadiff = 0;
-      Double_t phidiff = 0;
-      GetEtaPhiDiff(track, cluster, phidiff, etadiff);
-      Double_t dRmin = TMath::Sqrt(etadiff*etadiff + phidiff*phidiff);
+      Double_t dRmin = TMath::Sqrt(dEtaMin*dEtaMin + dPhiMin*dPhiMin);
       fHistMatchEvsP[fCentBin]->Fill(energyclus, energyclus / mom);
       fHistEoPCent->Fill(fCent, energyclus / mom);
       fHistMatchdRvsEP[fCentBin]->Fill(dRmin, energyclus / mom);
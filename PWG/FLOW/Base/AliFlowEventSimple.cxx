@@ -82,6 +82,17 @@ AliFlowEventSimple::AliFlowEventSimple():
   fRun(-1),
   fZNCM(0.),
   fZNAM(0.),
+  fUseQVectorCache(kFALSE),
+  fTrackArraysFilled(kFALSE),
+  fNArrayTracks(0),
+  fArrPhi(),
+  fArrPt(),
+  fArrEta(),
+  fArrWeight(),
+  fArrMask(),
+  fQCacheKeys(),
+  fQCacheWeights(),
+  fQCacheVectors(),
   fNumberOfPOItypes(2),
   fNumberOfPOIs(NULL)
 {
@@ -136,6 +147,17 @@ AliFlowEventSimple::AliFlowEventSimple( Int_t n,
   fRun(-1),
   fZNCM(0.),
   fZNAM(0.),
+  fUseQVectorCache(kFALSE),
+  fTrackArraysFilled(kFALSE),
+  fNArrayTracks(0),
+  fArrPhi(),
+  fArrPt(),
+  fArrEta(),
+  fArrWeight(),
+  fArrMask(),
+  fQCacheKeys(),
+  fQCacheWeights(),
+  fQCacheVectors(),
   fNumberOfPOItypes(2),
   fNumberOfPOIs(new Int_t[fNumberOfPOItypes])
 {
@@ -194,6 +216,17 @@ AliFlowEventSimple::AliFlowEventSimple(const AliFlowEventSimple& anEvent):
   fZNAQ(anEvent.fZNAQ),
   fZNCM(anEvent.fZNCM),
   fZNAM(anEvent.fZNAM),
+  fUseQVectorCache(anEvent.fUseQVectorCache),
+  fTrackArraysFilled(kFALSE),
+  fNArrayTracks(0),
+  fArrPhi(),
+  fArrPt(),
+  fArrEta(),
+  fArrWeight(),
+  fArrMask(),
+  fQCacheKeys(),
+  fQCacheWeights(),
+  fQCacheVectors(),
   fNumberOfPOItypes(anEvent.fNumberOfPOItypes),
   fNumberOfPOIs(new Int_t[fNumberOfPOItypes])
 {
@@ -278,6 +311,8 @@ AliFlowEventSimple& AliFlowEventSimple::operator=(const AliFlowEventSimple& anEv
   fZNAQ = anEvent.fZNAQ;
   fZNCM = anEvent.fZNCM;
   fZNAM = anEvent.fZNAM;
+  fUseQVectorCache = anEvent.fUseQVectorCache;
+  InvalidateQVectorCache();
   for(Int_t i(0); i < 3; i++) {
     fVtxPos[i] = anEvent.fVtxPos[i];
   }
@@ -447,6 +482,7 @@ void AliFlowEventSimple::TrackAdded()
 {
   //book keeping after a new track has been added
   fNumberOfTracks++;
+  InvalidateQVectorCache();
   if (fShuffledIndexes)
   {
     delete [] fShuffledIndexes;
@@ -473,6 +509,8 @@ AliFlowVector AliFlowEventSimple::GetQ( Int_t n,
                                         Bool_t useEtaWeights )
 {
   // calculate Q-vector in harmonic n without weights (default harmonic n=2)
+  if (fUseQVectorCache) return GetCachedQ(n,1,-1,weightsList,usePhiWeights,usePtWeights,useEtaWeights);
+
   Double_t dQX = 0.;
   Double_t dQY = 0.;
   AliFlowVector vQ;
@@ -592,6 +630,12 @@ void AliFlowEventSimple::Get2Qsub( AliFlowVector* Qarray,
 {
 
   // calculate Q-vector in harmonic n without weights (default harmonic n=2)
+  if (fUseQVectorCache)
+  {
+    for (Int_t s=0; s<2; s++) Qarray[s] = GetCachedQ(n,1,s,weightsList,usePhiWeights,usePtWeights,useEtaWeights);
+    return;
+  }
+
   Double_t dQX = 0.;
   Double_t dQY = 0.;
 
@@ -728,6 +772,183 @@ void AliFlowEventSimple::Get2Qsub( AliFlowVector* Qarray,
 
 }
 
+//-----------------------------------------------------------------------
+void AliFlowEventSimple::InvalidateQVectorCache()
+{
+  //forget the cached Q-vectors and track arrays, the storage is kept
+  fTrackArraysFilled = kFALSE;
+  fQCacheKeys.clear();
+  fQCacheWeights.clear();
+  fQCacheVectors.clear();
+}
+
+//-----------------------------------------------------------------------
+void AliFlowEventSimple::FillTrackArrays()
+{
+  //copy phi, pt, eta, weight and the RP/POI/subevent tags of the tracks
+  //into flat arrays, the arrays only grow so they are reused event by event
+  if (fTrackArraysFilled) return;
+  if (fArrPhi.GetSize() < fNumberOfTracks)
+  {
+    fArrPhi.Set(fNumberOfTracks);
+    fArrPt.Set(fNumberOfTracks);
+    fArrEta.Set(fNumberOfTracks);
+    fArrWeight.Set(fNumberOfTracks);
+    fArrMask.Set(fNumberOfTracks);
+  }
+  fNArrayTracks = 0;
+  for (Int_t i=0; i<fNumberOfTracks; i++)
+  {
+    AliFlowTrackSimple* pTrack = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
+    if (!pTrack)
+    {
+      cerr << "no particle!!!"<<endl;
+      continue;
+    }
+    Int_t mask = 0;
+    if (pTrack->InRPSelection()) mask |= kArrRP;
+    if (pTrack->InPOISelection()) mask |= kArrPOI;
+    if (pTrack->InSubevent(0)) mask |= kArrSub0;
+    if (pTrack->InSubevent(1)) mask |= kArrSub1;
+    fArrPhi[fNArrayTracks] = pTrack->Phi();
+    fArrPt[fNArrayTracks] = pTrack->Pt();
+    fArrEta[fNArrayTracks] = pTrack->Eta();
+    fArrWeight[fNArrayTracks] = pTrack->Weight();
+    fArrMask[fNArrayTracks] = mask;
+    fNArrayTracks++;
+  }
+  fTrackArraysFilled = kTRUE;
+}
+
+//-----------------------------------------------------------------------
+AliFlowVector AliFlowEventSimple::GetCachedQ( Int_t n,
+                                              Int_t p,
+                                              Int_t subevent,
+                                              TList *weightsList,
+                                              Bool_t usePhiWeights,
+                                              Bool_t usePtWeights,
+                                              Bool_t useEtaWeights )
+{
+  // Q-vector of the RPs Q_{n,p} = sum_i w_i^p exp(i n phi_i), for all RPs
+  // (subevent=-1, as GetQ()) or for the RPs of subevent 0 or 1 (as Get2Qsub());
+  // the result is cached until the tracks are changed
+  Int_t weightFlags = 0;
+  if (weightsList)
+  {
+    if (usePhiWeights) weightFlags |= 1;
+    if (usePtWeights) weightFlags |= 2;
+    if (useEtaWeights) weightFlags |= 4;
+  }
+  ULong64_t key = ((ULong64_t)(UShort_t)n) | ((ULong64_t)(UShort_t)p << 16) |
+                  ((ULong64_t)(UChar_t)(subevent+1) << 32) | ((ULong64_t)weightFlags << 40);
+  TList *weightsKey = weightFlags ? weightsList : NULL;
+  for (UInt_t i=0; i<fQCacheKeys.size(); i++)
+  {
+    if (fQCacheKeys[i]==key && fQCacheWeights[i]==weightsKey) return fQCacheVectors[i];
+  }
+
+  AliFlowVector vQ = ComputeQ(n,p,subevent,weightsKey,usePhiWeights,usePtWeights,useEtaWeights);
+  fQCacheKeys.push_back(key);
+  fQCacheWeights.push_back(weightsKey);
+  fQCacheVectors.push_back(vQ);
+  return vQ;
+}
+
+//-----------------------------------------------------------------------
+AliFlowVector AliFlowEventSimple::ComputeQ( Int_t n,
+                                            Int_t p,
+                                            Int_t subevent,
+                                            TList *weightsList,
+                                            Bool_t usePhiWeights,
+                                            Bool_t usePtWeights,
+                                            Bool_t useEtaWeights )
+{
+  // Q-vector from the flat track arrays, the weights are applied as in
+  // GetQ() and Get2Qsub() (for the subevents phi is taken at the center
+  // of the bin of the phi weights)
+  FillTrackArrays();
+
+  Int_t nBinsPhi = 0;
+  Double_t dBinWidthPt = 0.;
+  Double_t dPtMin = 0.;
+  Double_t dBinWidthEta = 0.;
+  Double_t dEtaMin = 0.;
+
+  TH1F *phiWeights = NULL;
+  TH1D *ptWeights  = NULL;
+  TH1D *etaWeights = NULL;
+
+  if(weightsList)
+  {
+    if(usePhiWeights)
+    {
+      TString phiWeightsName = "phi_weights";
+      if (subevent>=0) phiWeightsName += Form("_sub%d",subevent);
+      phiWeights = dynamic_cast<TH1F *>(weightsList->FindObject(phiWeightsName.Data()));
+      if(phiWeights) nBinsPhi = phiWeights->GetNbinsX();
+    }
+    if(usePtWeights)
+    {
+      ptWeights = dynamic_cast<TH1D *>(weightsList->FindObject("pt_weights"));
+      if(ptWeights)
+      {
+        dBinWidthPt = ptWeights->GetBinWidth(1); // assuming that all bins have the same width
+        dPtMin = (ptWeights->GetXaxis())->GetXmin();
+      }
+    }
+    if(useEtaWeights)
+    {
+      etaWeights = dynamic_cast<TH1D *>(weightsList->FindObject("eta_weights"));
+      if(etaWeights)
+      {
+        dBinWidthEta = etaWeights->GetBinWidth(1); // assuming that all bins have the same width
+        dEtaMin = (etaWeights->GetXaxis())->GetXmin();
+      }
+    }
+  } // end of if(weightsList)
+
+  Int_t mask = kArrRP;
+  if (subevent==0) mask |= kArrSub0;
+  else if (subevent==1) mask |= kArrSub1;
+
+  Double_t dQX = 0.;
+  Double_t dQY = 0.;
+  Double_t sumOfWeights = 0.;
+  for (Int_t i=0; i<fNArrayTracks; i++)
+  {
+    if ((fArrMask[i] & mask) != mask) continue;
+    Double_t dPhi = fArrPhi[i];
+    Double_t dWeight = fArrWeight[i];
+    if(phiWeights && nBinsPhi)
+    {
+      Int_t phiBin = 1+(Int_t)(TMath::Floor(dPhi*nBinsPhi/TMath::TwoPi()));
+      dWeight *= phiWeights->GetBinContent(phiBin);
+      if (subevent>=0) dPhi = phiWeights->GetBinCenter(phiBin);
+    }
+    if(ptWeights && dBinWidthPt)
+    {
+      dWeight *= ptWeights->GetBinContent(1+(Int_t)(TMath::Floor((fArrPt[i]-dPtMin)/dBinWidthPt)));
+    }
+    if(etaWeights && dBinWidthEta)
+    {
+      dWeight *= etaWeights->GetBinContent(1+(Int_t)(TMath::Floor((fArrEta[i]-dEtaMin)/dBinWidthEta)));
+    }
+    if (p!=1) dWeight = TMath::Power(dWeight,p);
+
+    dQX += dWeight*TMath::Cos(n*dPhi);
+    dQY += dWeight*TMath::Sin(n*dPhi);
+    sumOfWeights += dWeight;
+  }
+
+  AliFlowVector vQ;
+  vQ.Set(dQX,dQY);
+  vQ.SetMult(sumOfWeights);
+  vQ.SetHarmonic(n);
+  vQ.SetPOItype(AliFlowTrackSimple::kRP);
+  vQ.SetSubeventNumber(subevent);
+  return vQ;
+}
+
 //------------------------------------------------------------------------------
 
 void AliFlowEventSimple::GetZDC2Qsub(AliFlowVector* Qarray)
@@ -868,6 +1089,17 @@ AliFlowEventSimple::AliFlowEventSimple( TTree* inputTree,
   fRun(-1),
   fZNCM(0.),
   fZNAM(0.),
+  fUseQVectorCache(kFALSE),
+  fTrackArraysFilled(kFALSE),
+  fNArrayTracks(0),
+  fArrPhi(),
+  fArrPt(),
+  fArrEta(),
+  fArrWeight(),
+  fArrMask(),
+  fQCacheKeys(),
+  fQCacheWeights(),
+  fQCacheVectors(),
   fNumberOfPOItypes(2),
   fNumberOfPOIs(new Int_t[fNumberOfPOItypes])
 {
@@ -973,6 +1205,7 @@ void AliFlowEventSimple::TagSubeventsInEta( Double_t etaMinA,
     if (eta >= etaMinA && eta <= etaMaxA) track->SetForSubevent(0);
     if (eta >= etaMinB && eta <= etaMaxB) track->SetForSubevent(1);
   }
+  InvalidateQVectorCache();
 }
 
 //_____________________________________________________________________________
@@ -988,6 +1221,7 @@ void AliFlowEventSimple::TagSubeventsByCharge()
     if (charge<0) track->SetForSubevent(0);
     if (charge>0) track->SetForSubevent(1);
   }
+  InvalidateQVectorCache();
 }
 
 //_____________________________________________________________________________
@@ -1148,6 +1382,7 @@ void AliFlowEventSimple::TagRP( const AliFlowTrackSimpleCuts* cuts )
     }
     track->SetForRPSelection(pass);
   }
+  InvalidateQVectorCache();
 }
 
 //_____________________________________________________________________________
@@ -1170,6 +1405,7 @@ void AliFlowEventSimple::TagPOI( const AliFlowTrackSimpleCuts* cuts, Int_t poiTy
     }
     track->Tag(poiType,pass);
   }
+  InvalidateQVectorCache();
 }
 
 //_____________________________________________________________________________
@@ -1202,6 +1438,7 @@ void AliFlowEventSimple::DefineDeadZone( Double_t etaMin,
       track->ResetPOItype();
     }
   }
+  InvalidateQVectorCache();
 }
 
 //_____________________________________________________________________________
@@ -1219,6 +1456,7 @@ Int_t AliFlowEventSimple::CleanUpDeadTracks()
   fTrackCollection->Compress(); //clean up empty slots
   fNumberOfTracks-=ncleaned; //update number of tracks
   delete [] fShuffledIndexes; fShuffledIndexes=NULL;
+  InvalidateQVectorCache();
   return ncleaned;
 }
 
@@ -1258,4 +1496,5 @@ void AliFlowEventSimple::ClearFast()
   fAfterBurnerPrecision = 0.001;
   fUserModified = kFALSE;
   delete [] fShuffledIndexes; fShuffledIndexes=NULL;
+  InvalidateQVectorCache();
 }
@@ -16,9 +16,12 @@
 #ifndef ALIFLOWEVENTSIMPLE_H
 #define ALIFLOWEVENTSIMPLE_H
 
+#include <vector>
 #include "TObject.h"
 #include "TParameter.h"
 #include "TMath.h"
+#include "TArrayD.h"
+#include "TArrayI.h"
 #include "AliFlowVector.h"
 class TTree;
 class TF1;
@@ -82,7 +85,7 @@ class AliFlowEventSimple: public TObject {
   Bool_t   IsSetMCReactionPlaneAngle() const        { return fMCReactionPlaneAngleIsSet; }
   void     SetAfterBurnerPrecision(Double_t p)      { fAfterBurnerPrecision=p; }
   Double_t GetAfterBurnerPrecision() const          { return fAfterBurnerPrecision; }
-  void     SetUserModified(Bool_t s=kTRUE)          { fUserModified=s; }
+  void     SetUserModified(Bool_t s=kTRUE)          { fUserModified=s; InvalidateQVectorCache(); }
   Bool_t   IsUserModified() const                   { return fUserModified; }
   void     SetShuffleTracks(Bool_t b)               {fShuffleTracks=b;}
   void     ShuffleTracks();
@@ -119,6 +122,14 @@ class AliFlowEventSimple: public TObject {
  
   virtual AliFlowVector GetQ(Int_t n=2, TList *weightsList=NULL, Bool_t usePhiWeights=kFALSE, Bool_t usePtWeights=kFALSE, Bool_t useEtaWeights=kFALSE);
   virtual void Get2Qsub(AliFlowVector* Qarray, Int_t n=2, TList *weightsList=NULL, Bool_t usePhiWeights=kFALSE, Bool_t usePtWeights=kFALSE, Bool_t useEtaWeights=kFALSE);
+  // Q-vectors shared by all the flow methods: if enabled GetQ() and Get2Qsub() are
+  // computed once per event from flat track arrays. The cache is reset by the methods
+  // of this class changing the tracks; call InvalidateQVectorCache() after changing
+  // tracks obtained with GetTrack()
+  void     SetUseQVectorCache(Bool_t b=kTRUE)       { fUseQVectorCache=b; InvalidateQVectorCache(); }
+  Bool_t   GetUseQVectorCache() const               { return fUseQVectorCache; }
+  void     InvalidateQVectorCache();
+  AliFlowVector GetCachedQ(Int_t n=2, Int_t p=1, Int_t subevent=-1, TList *weightsList=NULL, Bool_t usePhiWeights=kFALSE, Bool_t usePtWeights=kFALSE, Bool_t useEtaWeights=kFALSE);
   virtual void GetZDC2Qsub(AliFlowVector* Qarray);
   virtual void SetZDC2Qsub(Double_t* QVC, Double_t MC, Double_t* QVA, Double_t MA);
   // begin test methods for LHC15o VZERO calibration, do not use
@@ -150,6 +161,10 @@ class AliFlowEventSimple: public TObject {
                          Double_t phiMax=TMath::TwoPi(),
                          Double_t etaMin=-1.0,
                          Double_t etaMax= 1.0 );
+  void FillTrackArrays();
+  AliFlowVector ComputeQ(Int_t n, Int_t p, Int_t subevent, TList *weightsList, Bool_t usePhiWeights, Bool_t usePtWeights, Bool_t useEtaWeights);
+
+  enum TrackArrayBits {kArrRP=BIT(0), kArrPOI=BIT(1), kArrSub0=BIT(2), kArrSub1=BIT(3)};
 
   //data members
   TObjArray*              fTrackCollection;           //-> collection of tracks
@@ -189,12 +204,23 @@ class AliFlowEventSimple: public TObject {
   Double_t                fZNCM;                      // total energy from ZNC-C
   Double_t                fZNAM;                      // total energy from ZNC-A
   Double_t                fVtxPos[3];                 // Primary vertex position (x,y,z)
+  Bool_t                  fUseQVectorCache;           // compute GetQ() and Get2Qsub() once per event
+  Bool_t                  fTrackArraysFilled;         //! flat track arrays are up to date
+  Int_t                   fNArrayTracks;              //! number of tracks in the flat arrays
+  TArrayD                 fArrPhi;                    //! phi of the tracks (storage kept between events)
+  TArrayD                 fArrPt;                     //! pt of the tracks
+  TArrayD                 fArrEta;                    //! eta of the tracks
+  TArrayD                 fArrWeight;                 //! weight of the tracks
+  TArrayI                 fArrMask;                   //! RP/POI/subevent bits of the tracks
+  std::vector<ULong64_t>  fQCacheKeys;                //! harmonic, power, subevent and weight flags of the cached Q-vectors
+  std::vector<TList*>     fQCacheWeights;             //! weights list of the cached Q-vectors
+  std::vector<AliFlowVector> fQCacheVectors;          //! cached Q-vectors
  
  private:
   Int_t                   fNumberOfPOItypes;    // how many different flow particle types do we have? (RP,POI,POI_2,...)
   Int_t*                  fNumberOfPOIs;          //[fNumberOfPOItypes] number of tracks that have passed the POI selection
 
-  ClassDef(AliFlowEventSimple,6)
+  ClassDef(AliFlowEventSimple,7)
 };
 
 #endif
@@ -137,6 +137,7 @@ AliAnalysisTaskFlowEvent::AliAnalysisTaskFlowEvent() :
   fDifferentialV2(0),
   fFlowEvent(NULL),
   fShuffleTracks(kFALSE),
+  fUseQVectorCache(kFALSE),
   fMyTRandom3(NULL)
 {
   // Constructor
@@ -198,6 +199,7 @@ AliAnalysisTaskFlowEvent::AliAnalysisTaskFlowEvent(const char *name, TString RPt
   fDifferentialV2(0),
   fFlowEvent(NULL),
   fShuffleTracks(kFALSE),
+  fUseQVectorCache(kFALSE),
   fMyTRandom3(NULL)
 {
   // Constructor
@@ -569,6 +571,9 @@ void AliAnalysisTaskFlowEvent::UserExec(Option_t *)
   //do we want to serve shullfed tracks to everybody?
   fFlowEvent->SetShuffleTracks(fShuffleTracks);
 
+  //compute the Q-vectors once for all the flow methods
+  fFlowEvent->SetUseQVectorCache(fUseQVectorCache);
+
   // associate the mother particles to their daughters in the flow event (if any)
   fFlowEvent->FindDaughters();
 
@@ -74,6 +74,7 @@ class AliAnalysisTaskFlowEvent : public AliAnalysisTaskSE {
   Bool_t        GetQAOn()   const         {return fQAon; }
 
   void          SetShuffleTracks(Bool_t b)  {fShuffleTracks=b;}
+  void          SetUseQVectorCache(Bool_t b=kTRUE) {fUseQVectorCache=b;}
 
   // setters for common constants
   void SetNbinsMult( Int_t i ) { fNbinsMult = i; }
@@ -180,11 +181,12 @@ class AliAnalysisTaskFlowEvent : public AliAnalysisTaskSE {
 
   AliFlowEvent* fFlowEvent; //flowevent
   Bool_t fShuffleTracks;    //serve the tracks shuffled
+  Bool_t fUseQVectorCache;  //share the Q-vectors of the flow event between the flow methods
     
   TRandom3* fMyTRandom3;     // TRandom3 generator
   // end afterburner
   
-  ClassDef(AliAnalysisTaskFlowEvent, 1); // example of analysis
+  ClassDef(AliAnalysisTaskFlowEvent, 2); // example of analysis
 };
 
 #endif
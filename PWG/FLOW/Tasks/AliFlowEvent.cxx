@@ -852,6 +852,7 @@ void AliFlowEvent::FindDaughters(Bool_t keepDaughtersInRPselection)
       }
     }
   }
+  InvalidateQVectorCache();
 }
 
 //-----------------------------------------------------------------------
@@ -1022,6 +1023,7 @@ void AliFlowEvent::InsertTrack(AliFlowTrack *track) {
   {
     fMothersCollection->Add(pTrack);
   }
+  InvalidateQVectorCache();
   return;
 }
 
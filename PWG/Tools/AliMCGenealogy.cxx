@@ -0,0 +1,344 @@
+// $Id$
+//
+// Per-event index of the mother-daughter relations of the MC particles.
+//
+// The mother labels and pdg codes are copied once per event from the
+// AOD MC array, the MC event or the kinematics stack into flat arrays,
+// together with the daughter lists, the depth of each particle and the
+// origin tags of its ancestors. Mothers outside of the container are
+// kept as given but end the genealogy. Each particle also carries one jump
+// pointer (skew-binary scheme): level ancestor and common ancestor
+// queries then take O(log n) steps, with O(n) memory and build time.
+//
+// The origin tags follow the conventions of AliVertexingHFUtils::CheckOrigin:
+// the ancestors are collected walking up the mother labels while they
+// are larger than 0, stopping at a missing particle.
+//
+// GetEventGenealogy() returns an index shared by all users within the
+// same event of the analysis manager, built on the first request.
+
+#include <TClonesArray.h>
+#include <TMath.h>
+#include <TParticle.h>
+
+#include "AliAODMCParticle.h"
+#include "AliAnalysisManager.h"
+#include "AliMCEvent.h"
+#include "AliStack.h"
+#include "AliVParticle.h"
+
+#include "AliMCGenealogy.h"
+
+ClassImp(AliMCGenealogy)
+
+//________________________________________________________________________
+AliMCGenealogy::AliMCGenealogy() :
+  TObject(),
+  fSource(0),
+  fEvent(-1),
+  fParent(),
+  fPdg(),
+  fDepth(),
+  fRoot(),
+  fJump(),
+  fOrigin(),
+  fFirstDaughter(),
+  fDaughters()
+{
+  // Default constructor.
+
+}
+
+//________________________________________________________________________
+void AliMCGenealogy::Reset()
+{
+  // Clear the index.
+
+  fSource = 0;
+  fEvent = -1;
+  fParent.clear();
+  fPdg.clear();
+  fDepth.clear();
+  fRoot.clear();
+  fJump.clear();
+  fOrigin.clear();
+  fFirstDaughter.assign(1, 0);
+  fDaughters.clear();
+}
+
+//________________________________________________________________________
+Bool_t AliMCGenealogy::Build(const TClonesArray *mcArray)
+{
+  // Build the index from the AOD MC particles.
+
+  Reset();
+  if (!mcArray) return kFALSE;
+
+  const Int_t n = mcArray->GetEntriesFast();
+  fParent.resize(n);
+  fPdg.resize(n);
+  for (Int_t i = 0; i < n; i++) {
+    AliAODMCParticle *part = dynamic_cast<AliAODMCParticle*>(mcArray->At(i));
+    fParent[i] = part ? part->GetMother() : -1;
+    fPdg[i] = part ? part->GetPdgCode() : 0;
+  }
+
+  Index();
+  return kTRUE;
+}
+
+//________________________________________________________________________
+Bool_t AliMCGenealogy::Build(AliMCEvent *mcEvent)
+{
+  // Build the index from the MC event.
+
+  Reset();
+  if (!mcEvent) return kFALSE;
+
+  const Int_t n = mcEvent->GetNumberOfTracks();
+  fParent.resize(n);
+  fPdg.resize(n);
+  for (Int_t i = 0; i < n; i++) {
+    AliVParticle *part = mcEvent->GetTrack(i);
+    fParent[i] = part ? part->GetMother() : -1;
+    fPdg[i] = part ? part->PdgCode() : 0;
+  }
+
+  Index();
+  return kTRUE;
+}
+
+//________________________________________________________________________
+Bool_t AliMCGenealogy::Build(AliStack *stack)
+{
+  // Build the index from the kinematics stack.
+
+  Reset();
+  if (!stack) return kFALSE;
+
+  const Int_t n = stack->GetNtrack();
+  fParent.resize(n);
+  fPdg.resize(n);
+  for (Int_t i = 0; i < n; i++) {
+    TParticle *part = stack->Particle(i);
+    fParent[i] = part ? part->GetFirstMother() : -1;
+    fPdg[i] = part ? part->GetPdgCode() : 0;
+  }
+
+  Index();
+  return kTRUE;
+}
+
+//________________________________________________________________________
+void AliMCGenealogy::Index()
+{
+  // Fill depth, root, jump pointers, origin tags and daughter lists from the mother labels.
+
+  const Int_t n = fParent.size();
+  fDepth.assign(n, -1);
+  fRoot.resize(n);
+  fJump.resize(n);
+  fOrigin.resize(n);
+
+  // mothers are not guaranteed to precede their daughters:
+  // walk up to the first indexed ancestor, then index the path downwards
+  std::vector<Int_t> path;
+  for (Int_t i = 0; i < n; i++) {
+    if (fDepth[i] >= 0) continue;
+
+    path.clear();
+    Int_t v = i;
+    while (v >= 0 && fDepth[v] == -1) {
+      fDepth[v] = -2;
+      path.push_back(v);
+      v = IsValid(fParent[v]) ? fParent[v] : -1;
+    }
+    if (v >= 0 && fDepth[v] == -2) fParent[path.back()] = -1; // mother loop, cut it
+
+    for (Int_t k = path.size() - 1; k >= 0; k--) {
+      const Int_t u = path[k];
+      const Int_t p = IsValid(fParent[u]) ? fParent[u] : -1;
+      if (p < 0) {
+        fDepth[u] = 0;
+        fRoot[u] = u;
+        fJump[u] = u;
+        fOrigin[u] = 0;
+      }
+      else {
+        fDepth[u] = fDepth[p] + 1;
+        fRoot[u] = fRoot[p];
+        const Int_t j = fJump[p];
+        fJump[u] = (fDepth[p] - fDepth[j] == fDepth[j] - fDepth[fJump[j]]) ? fJump[j] : p;
+        fOrigin[u] = p > 0 ? (GetOwnTags(fPdg[p]) | fOrigin[p]) : 0;
+      }
+    }
+  }
+
+  fFirstDaughter.assign(n + 1, 0);
+  for (Int_t i = 0; i < n; i++) {
+    if (IsValid(fParent[i])) fFirstDaughter[fParent[i] + 1]++;
+  }
+  for (Int_t i = 0; i < n; i++) fFirstDaughter[i + 1] += fFirstDaughter[i];
+  fDaughters.resize(fFirstDaughter[n]);
+  std::vector<Int_t> next(fFirstDaughter.begin(), fFirstDaughter.end() - 1);
+  for (Int_t i = 0; i < n; i++) {
+    if (IsValid(fParent[i])) fDaughters[next[fParent[i]]++] = i;
+  }
+}
+
+//________________________________________________________________________
+UInt_t AliMCGenealogy::GetOwnTags(Int_t pdg)
+{
+  // Origin tags contributed by a particle with this pdg code.
+
+  const Int_t abspdg = TMath::Abs(pdg);
+  UInt_t tags = 0;
+  if ((abspdg > 400 && abspdg < 500) || (abspdg > 4000 && abspdg < 5000)) tags |= kFromCharmHadron;
+  if ((abspdg > 500 && abspdg < 600) || (abspdg > 5000 && abspdg < 6000)) tags |= kFromBeautyHadron;
+  if (abspdg == 4 || abspdg == 5) tags |= kFromHeavyQuark;
+  return tags;
+}
+
+//________________________________________________________________________
+Int_t AliMCGenealogy::GetAncestorAtDepth(Int_t label, Int_t depth) const
+{
+  // Ancestor of the particle at the given depth, -1 if none.
+
+  if (!IsValid(label) || depth < 0 || depth > fDepth[label]) return -1;
+
+  Int_t v = label;
+  while (fDepth[v] > depth) {
+    if (fDepth[fJump[v]] >= depth) v = fJump[v];
+    else v = fParent[v];
+  }
+  return v;
+}
+
+//________________________________________________________________________
+Int_t AliMCGenealogy::GetAncestorWithPdg(Int_t label, Int_t pdg) const
+{
+  // First particle with this pdg code walking up from the particle itself, -1 if none.
+
+  if (!IsValid(label)) return -1;
+
+  for (Int_t v = label; IsValid(v); v = fParent[v]) {
+    if (fPdg[v] == pdg) return v;
+  }
+  return -1;
+}
+
+//________________________________________________________________________
+Int_t AliMCGenealogy::GetCommonAncestor(Int_t label1, Int_t label2) const
+{
+  // Closest common ancestor of the two particles, a particle being its own ancestor.
+  // Returns -1 if the particles belong to different trees.
+
+  if (!IsValid(label1) || !IsValid(label2)) return -1;
+  if (fRoot[label1] != fRoot[label2]) return -1;
+
+  Int_t a = label1;
+  Int_t b = label2;
+  if (fDepth[a] > fDepth[b]) a = GetAncestorAtDepth(a, fDepth[b]);
+  else if (fDepth[b] > fDepth[a]) b = GetAncestorAtDepth(b, fDepth[a]);
+
+  // at equal depth the jump pointers also point to equal depths
+  while (a != b) {
+    if (fJump[a] != fJump[b]) {
+      a = fJump[a];
+      b = fJump[b];
+    }
+    else {
+      a = fParent[a];
+      b = fParent[b];
+    }
+  }
+  return a;
+}
+
+//________________________________________________________________________
+Bool_t AliMCGenealogy::IsAncestor(Int_t ancestor, Int_t label) const
+{
+  // Whether ancestor is an ancestor of the particle or the particle itself.
+
+  if (!IsValid(ancestor) || !IsValid(label)) return kFALSE;
+  return GetAncestorAtDepth(label, fDepth[ancestor]) == ancestor;
+}
+
+//________________________________________________________________________
+Int_t AliMCGenealogy::GetHFOrigin(Int_t label, Bool_t searchUpToQuark) const
+{
+  // Heavy flavour origin as in AliVertexingHFUtils::CheckOrigin:
+  // 5 from beauty, 4 from charm, 0 if no heavy quark was found and searchUpToQuark is set.
+
+  const UInt_t tags = GetOriginTags(label);
+  if (searchUpToQuark && !(tags & kFromHeavyQuark)) return 0;
+  if (tags & kFromBeautyHadron) return 5;
+  return 4;
+}
+
+//________________________________________________________________________
+AliMCGenealogy *AliMCGenealogy::GetShared(const TObject *source)
+{
+  // Shared index, reset when the source or the event of the analysis manager changed.
+  // Returns 0 without analysis manager.
+
+  static AliMCGenealogy *shared = 0;
+
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  if (!mgr || !source) return 0;
+
+  if (!shared) shared = new AliMCGenealogy();
+  if (shared->fSource != source || shared->fEvent != mgr->GetNcalls()) {
+    shared->Reset();
+    shared->fEvent = mgr->GetNcalls();
+  }
+  return shared;
+}
+
+//________________________________________________________________________
+AliMCGenealogy *AliMCGenealogy::GetEventGenealogy(const TClonesArray *mcArray)
+{
+  // Index of the AOD MC particles of the current event, 0 if not available.
+
+  AliMCGenealogy *genealogy = GetShared(mcArray);
+  if (!genealogy) return 0;
+  if (genealogy->fSource == mcArray) return genealogy;
+
+  Int_t event = genealogy->fEvent;
+  if (!genealogy->Build(mcArray)) return 0;
+  genealogy->fSource = mcArray;
+  genealogy->fEvent = event;
+  return genealogy;
+}
+
+//________________________________________________________________________
+AliMCGenealogy *AliMCGenealogy::GetEventGenealogy(AliMCEvent *mcEvent)
+{
+  // Index of the particles of the MC event of the current event, 0 if not available.
+
+  AliMCGenealogy *genealogy = GetShared(mcEvent);
+  if (!genealogy) return 0;
+  if (genealogy->fSource == mcEvent) return genealogy;
+
+  Int_t event = genealogy->fEvent;
+  if (!genealogy->Build(mcEvent)) return 0;
+  genealogy->fSource = mcEvent;
+  genealogy->fEvent = event;
+  return genealogy;
+}
+
+//________________________________________________________________________
+AliMCGenealogy *AliMCGenealogy::GetEventGenealogy(AliStack *stack)
+{
+  // Index of the kinematics stack of the current event, 0 if not available.
+
+  AliMCGenealogy *genealogy = GetShared(stack);
+  if (!genealogy) return 0;
+  if (genealogy->fSource == stack) return genealogy;
+
+  Int_t event = genealogy->fEvent;
+  if (!genealogy->Build(stack)) return 0;
+  genealogy->fSource = stack;
+  genealogy->fEvent = event;
+  return genealogy;
+}
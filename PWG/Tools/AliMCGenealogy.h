@@ -0,0 +1,71 @@
+#ifndef ALIMCGENEALOGY_H
+#define ALIMCGENEALOGY_H
+
+// $Id$
+
+#include <vector>
+
+#include <TObject.h>
+
+class TClonesArray;
+class AliMCEvent;
+class AliStack;
+
+class AliMCGenealogy : public TObject {
+ public:
+  enum EOriginTag {
+    kFromCharmHadron  = BIT(0),  // an ancestor is a charm hadron
+    kFromBeautyHadron = BIT(1),  // an ancestor is a beauty hadron
+    kFromHeavyQuark   = BIT(2)   // an ancestor is a c or b quark
+  };
+
+  AliMCGenealogy();
+  virtual ~AliMCGenealogy() {}
+
+  Bool_t                 Build(const TClonesArray *mcArray);
+  Bool_t                 Build(AliMCEvent *mcEvent);
+  Bool_t                 Build(AliStack *stack);
+  void                   Reset();
+
+  Int_t                  GetNParticles() const                          { return fParent.size();                                  }
+  Bool_t                 IsValid(Int_t label) const                     { return label >= 0 && label < (Int_t)fParent.size();     }
+  Int_t                  GetMother(Int_t label) const                   { return IsValid(label) ? fParent[label] : -1;            }
+  Int_t                  GetPdgCode(Int_t label) const                  { return IsValid(label) ? fPdg[label] : 0;                }
+  Int_t                  GetDepth(Int_t label) const                    { return IsValid(label) ? fDepth[label] : -1;             }
+  Int_t                  GetNDaughters(Int_t label) const               { return IsValid(label) ? fFirstDaughter[label+1] - fFirstDaughter[label] : 0; }
+  Int_t                  GetDaughter(Int_t label, Int_t i) const        { return fDaughters[fFirstDaughter[label] + i];           }
+  UInt_t                 GetOriginTags(Int_t label) const               { return IsValid(label) ? fOrigin[label] : 0;             }
+
+  Int_t                  GetAncestorAtDepth(Int_t label, Int_t depth) const;
+  Int_t                  GetAncestorWithPdg(Int_t label, Int_t pdg) const;
+  Int_t                  GetCommonAncestor(Int_t label1, Int_t label2) const;
+  Bool_t                 IsAncestor(Int_t ancestor, Int_t label) const;
+  Int_t                  GetHFOrigin(Int_t label, Bool_t searchUpToQuark = kTRUE) const;
+
+  static AliMCGenealogy *GetEventGenealogy(const TClonesArray *mcArray);
+  static AliMCGenealogy *GetEventGenealogy(AliMCEvent *mcEvent);
+  static AliMCGenealogy *GetEventGenealogy(AliStack *stack);
+
+ protected:
+  void                   Index();
+  static UInt_t          GetOwnTags(Int_t pdg);
+  static AliMCGenealogy *GetShared(const TObject *source);
+
+  const TObject         *fSource;                        //!particle container the index was built from
+  Int_t                  fEvent;                         //!analysis manager event the index was built for
+  std::vector<Int_t>     fParent;                        //!label of the mother as given by the particle
+  std::vector<Int_t>     fPdg;                           //!pdg code, 0 for missing particles
+  std::vector<Int_t>     fDepth;                         //!number of generations above the particle
+  std::vector<Int_t>     fRoot;                          //!label of the root of the particle tree
+  std::vector<Int_t>     fJump;                          //!skew-binary jump pointer to an ancestor
+  std::vector<UInt_t>    fOrigin;                        //!origin tags of the ancestors, see EOriginTag
+  std::vector<Int_t>     fFirstDaughter;                 //!first entry of each particle in fDaughters
+  std::vector<Int_t>     fDaughters;                     //!daughter labels grouped by mother
+
+ private:
+  AliMCGenealogy(const AliMCGenealogy&);                 // not implemented
+  AliMCGenealogy& operator=(const AliMCGenealogy&);      // not implemented
+
+  ClassDef(AliMCGenealogy, 1); // Per-event index of the MC mother-daughter relations
+};
+#endif
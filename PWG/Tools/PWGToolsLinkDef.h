@@ -10,6 +10,7 @@
 #pragma link C++ class AliCanvas+;
 #pragma link C++ class AliHelperPID+;
 #pragma link C++ class AliLatexTable+;
+#pragma link C++ class AliMCGenealogy+;
 #pragma link C++ class AliNamedArrayI+;
 #pragma link C++ class AliNamedString+;
 #pragma link C++ class AliPWGFunc+;
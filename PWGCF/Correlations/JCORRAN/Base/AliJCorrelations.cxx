@@ -446,9 +446,9 @@ void AliJCorrelations::FillDeltaEtaHistograms(fillType fTyp, int ZBin)
   
   if( fNearSide ){ //one could check the phiGapBin, but in the pi/2 <1.6 and thus phiGap is always>-1
     if( fTyp == 0 ) {
-      fhistos->fhDEtaNear[fCentralityBin][ZBin][fPhiGapBinNear][fpttBin][fptaBin]->Fill( fDeltaEta , fGeometricAcceptanceCorrection * fTrackPairEfficiency );
+      fhistos->fhDEtaNear.At(fCentralityBin,ZBin,fPhiGapBinNear,fpttBin,fptaBin)->Fill( fDeltaEta , fGeometricAcceptanceCorrection * fTrackPairEfficiency );
     } else {
-      fhistos->fhDEtaNearM[fCentralityBin][ZBin][fPhiGapBinNear][fpttBin][fptaBin]->Fill( fDeltaEta , fGeometricAcceptanceCorrection * fTrackPairEfficiency );
+      fhistos->fhDEtaNearM.At(fCentralityBin,ZBin,fPhiGapBinNear,fpttBin,fptaBin)->Fill( fDeltaEta , fGeometricAcceptanceCorrection * fTrackPairEfficiency );
       fhistos->fhDetaNearMixAcceptance[fCentralityBin][fpttBin][fptaBin]->Fill( fDeltaEta, fTrackPairEfficiency);
     }
   } else {
@@ -475,8 +475,8 @@ void AliJCorrelations::FillDeltaPhiHistograms(fillType fTyp)
   // When hists are filled for thresholds they are not properly normalized and need to be subtracted
   // This induced improper errors - subtraction of not-independent entries
   
-  fhistos->fhDphiAssoc[fTyp][fCentralityBin][fEtaGapBin][fpttBin][fptaBin]->Fill( fDeltaPhi/kJPi , fGeometricAcceptanceCorrection * fTrackPairEfficiency);
-  if(fXlongBin>=0 && fNearSide3D) fhistos->fhDphiAssocXEbin[fTyp][fCentralityBin][fEtaGapBin][fpttBin][fXlongBin]->Fill( fDeltaPhi/kJPi , fGeometricAcceptanceCorrection3D * fTrackPairEfficiency);
+  fhistos->fhDphiAssoc.At(fTyp,fCentralityBin,fEtaGapBin,fpttBin,fptaBin)->Fill( fDeltaPhi/kJPi , fGeometricAcceptanceCorrection * fTrackPairEfficiency);
+  if(fXlongBin>=0 && fNearSide3D) fhistos->fhDphiAssocXEbin.At(fTyp,fCentralityBin,fEtaGapBin,fpttBin,fXlongBin)->Fill( fDeltaPhi/kJPi , fGeometricAcceptanceCorrection3D * fTrackPairEfficiency);
   
   if(fIsIsolatedTrigger) fhistos->fhDphiAssocIsolTrigg[fTyp][fCentralityBin][fpttBin][fptaBin]->Fill( fDeltaPhi/kJPi , fGeometricAcceptanceCorrection * fTrackPairEfficiency); //FK//
 }
@@ -488,12 +488,12 @@ void AliJCorrelations::FillDeltaEtaDeltaPhiHistograms(fillType fTyp, int zBin)
   
   // Fill the histogram in pTa bins
   if(fNearSide){
-    fhistos->fhDphiDetaPta[fTyp][fCentralityBin][zBin][fpttBin][fptaBin]->Fill(fDeltaEta, fDeltaPhiPiPi, fTrackPairEfficiency);
+    fhistos->fhDphiDetaPta.At(fTyp,fCentralityBin,zBin,fpttBin,fptaBin)->Fill(fDeltaEta, fDeltaPhiPiPi, fTrackPairEfficiency);
   }
   
   // Fill the histogram in xlong bins
   if(fNearSide3D && fXlongBin >= 0){
-    fhistos->fhDphiDetaXlong[fTyp][fCentralityBin][zBin][fpttBin][fXlongBin]->Fill(fDeltaEta, fDeltaPhiPiPi, fTrackPairEfficiency);
+    fhistos->fhDphiDetaXlong.At(fTyp,fCentralityBin,zBin,fpttBin,fXlongBin)->Fill(fDeltaEta, fDeltaPhiPiPi, fTrackPairEfficiency);
   }
   
 }
@@ -385,14 +385,6 @@ void AliJFFlucAnalysis::UserExec(Option_t *) {
 		Fill_QA_plot( fEta_min, fEta_max );
 		DEBUG(3, "QA Plot filled");
 
-		enum{kSubA, kSubB, kNSub};
-		enum{kMin, kMax};
-		enum{kReal, kImg, kNPhase};
-		Double_t Eta_config[kNSub][2];
-		Eta_config[kSubA][kMin] = fEta_min;  // 0.4 min for SubA 
-		Eta_config[kSubA][kMax] = fEta_max;  // 0.8 max for SubA
-		Eta_config[kSubB][kMin] = -1*fEta_max; // -0.8  min for SubB
-		Eta_config[kSubB][kMax] = -1*fEta_min; // -0.4  max for SubB
 
 		// use complex variable instead of doulbe Qn // 
 		TComplex QnA[kNH];
@@ -405,9 +397,10 @@ void AliJFFlucAnalysis::UserExec(Option_t *) {
 				QnB_star[ih] = TComplex(0,0);			
 		}
 		//--------------- Calculate Qn--------------------
+		CalculateQnTable(); // one track loop for all sub-events, pt bins and harmonics
 		for(int ih=0; ih<kNH; ih++){
-				QnA[ih] = CalculateQnSP( Eta_config[kSubA][kMin], Eta_config[kSubA][kMax], ih);
-				QnB[ih] = CalculateQnSP( Eta_config[kSubB][kMin], Eta_config[kSubB][kMax], ih);
+				QnA[ih] = GetQnTable( kSubA, N_ptbins, ih);
+				QnB[ih] = GetQnTable( kSubB, N_ptbins, ih);
 //				fh_Qvector[fCBin][0][ih]->Fill( QnA[ih].Theta() );
 //				fh_Qvector[fCBin][1][ih]->Fill( QnB[ih].Theta() );	
 				QnB_star[ih] = TComplex::Conjugate ( QnB[ih] ) ;
@@ -540,35 +533,24 @@ void AliJFFlucAnalysis::UserExec(Option_t *) {
 
 		if(IsSCptdep == kTRUE){
 				const int SCNH =6; // 0, 1, 2(v2), 3(v3), 4(v4), 5(v5)
-				Double_t ptbin_borders[N_ptbins+1] = {0.2, 0.4, 0.6, 0.8, 1.0, 1.25, 1.5, 2.0, 5.0};
-				//init
-				TComplex QnA_pt[SCNH][N_ptbins];
-				TComplex QnB_pt[SCNH][N_ptbins];
-				TComplex QnB_pt_star[SCNH][N_ptbins];
-				for(int ih=2; ih<SCNH; ih++){
-						for(int ipt=0; ipt<N_ptbins; ipt++){
-								QnA_pt[ih][ipt] = TComplex(0,0);
-								QnB_pt[ih][ipt] = TComplex(0,0);
-								QnB_pt_star[ih][ipt] = TComplex(0,0);
-						}
-				}	
+				// higher harmonics (up to v8) are needed for the self-correlation terms below
+				TComplex QnA_pt[kNH][N_ptbins];
+				TComplex QnB_pt[kNH][N_ptbins];
+				TComplex QnB_pt_star[kNH][N_ptbins];
 
-				// calculate Qn for each pt bins	
-				for(int ih=2; ih<SCNH; ih++){
+				// read Qn for each pt bins from the table
+				for(int ih=2; ih<kNH; ih++){
 						for(int ipt=0; ipt<N_ptbins; ipt++){
-								Double_t pt_bin_min = ptbin_borders[ipt];
-								Double_t pt_bin_max = ptbin_borders[ipt+1]; 
-								Double_t QAReal=Get_Qn_Real_pt( Eta_config[kSubA][0], Eta_config[kSubA][1], ih, ipt, pt_bin_min, pt_bin_max);
-								Double_t QAImag=Get_Qn_Img_pt(  Eta_config[kSubA][0], Eta_config[kSubA][1], ih, ipt, pt_bin_min, pt_bin_max);
-
-								Double_t QBReal=Get_Qn_Real_pt( Eta_config[kSubB][0], Eta_config[kSubB][1], ih, ipt, pt_bin_min, pt_bin_max);
-								Double_t QBImag=Get_Qn_Img_pt(  Eta_config[kSubB][0], Eta_config[kSubB][1], ih, ipt, pt_bin_min, pt_bin_max);
-
-								QnA_pt[ih][ipt]= TComplex(QAReal, QAImag);
-								QnB_pt[ih][ipt]= TComplex(QBReal, QBImag);
+								QnA_pt[ih][ipt] = GetQnTable( kSubA, ipt, ih);
+								QnB_pt[ih][ipt] = GetQnTable( kSubB, ipt, ih);
 								QnB_pt_star[ih][ipt] = TComplex::Conjugate( QnB_pt[ih][ipt] ) ; 
 						}
-				}		
+				}
+				for(int ipt=0; ipt<N_ptbins; ipt++){
+						// NSubTracks_pt is indexed by eta side: 0 for eta- (SubB), 1 for eta+ (SubA)
+						NSubTracks_pt[0][ipt] = fQnWeight[kSubB][ipt];
+						NSubTracks_pt[1][ipt] = fQnWeight[kSubA][ipt];
+				}
 
 				for(int ipt=0; ipt<N_ptbins; ipt++){
 						for(int ih=2; ih<SCNH; ih++){
@@ -730,30 +712,91 @@ void AliJFFlucAnalysis::Fill_QA_plot( Double_t eta1, Double_t eta2 )
 		fh_TrkQA_TPCvsGlob->Fill( fGlbtrks, fTPCtrks);
 }
 //________________________________________________________________________
-TComplex AliJFFlucAnalysis::CalculateQnSP( Double_t eta1, Double_t eta2, int harmonics)
+void AliJFFlucAnalysis::CalculateQnTable()
 {
-		int ih=harmonics;
-		TComplex Qn = TComplex(0,0);
-		Double_t Sub_Ntrk = 0; // number of Tracks * effCorr * phi modulation factor 
+		// Fill Q-vectors of both SP sub-events for all harmonics, pt-integrated
+		// and per pt bin (if IsSCptdep), in a single loop over the tracks.
+		// The track weight is evaluated once per track and cos/sin(n*phi) are
+		// built by angle addition from cos/sin(phi).
+		static const Double_t ptbin_borders[N_ptbins+1] = {0.2, 0.4, 0.6, 0.8, 1.0, 1.25, 1.5, 2.0, 5.0};
+		for(int isub=0; isub<kNSub; isub++){
+				for(int ipt=0; ipt<=N_ptbins; ipt++){
+						fQnWeight[isub][ipt] = 0;
+						for(int ih=0; ih<kNH; ih++){
+								fQnRe[isub][ipt][ih] = 0;
+								fQnIm[isub][ipt][ih] = 0;
+						}
+				}
+		}
+		Double_t cosn[kNH];
+		Double_t sinn[kNH];
 		Long64_t ntracks = fInputList->GetEntriesFast();
 		for(Long64_t it=0; it< ntracks; it++){
 				AliJBaseTrack *itrack = (AliJBaseTrack*)fInputList->At(it); // load track
-				Double_t pt = itrack->Pt();
 				Double_t eta = itrack->Eta();
-				Double_t phi = itrack->Phi();
-				if( eta < eta1 || eta > eta2) continue; // eta cut
+				// SubA: fEta_min < eta < fEta_max, SubB: -fEta_max < eta < -fEta_min
+				// SP eta windows are inclusive, pt dep ones exclusive
+				Double_t etaMin[kNSub] = { fEta_min, -1*fEta_max };
+				Double_t etaMax[kNSub] = { fEta_max, -1*fEta_min };
+				Bool_t inSub[kNSub];
+				Bool_t inSubPt[kNSub];
+				for(int isub=0; isub<kNSub; isub++){
+						inSub[isub] = eta >= etaMin[isub] && eta <= etaMax[isub];
+						inSubPt[isub] = IsSCptdep == kTRUE && eta > etaMin[isub] && eta < etaMax[isub];
+				}
+				if( !inSub[kSubA] && !inSub[kSubB] ) continue;
 
+				Double_t pt = itrack->Pt();
+				int ipt = -1;
+				if( inSubPt[kSubA] || inSubPt[kSubB] ){
+						ipt = TMath::BinarySearch( N_ptbins+1, ptbin_borders, pt );
+						if( ipt < 0 || ipt >= N_ptbins || !(pt > ptbin_borders[ipt] && pt < ptbin_borders[ipt+1]) ) ipt = -1;
+				}
+
+				Double_t phi = itrack->Phi();
 				Double_t phi_module_corr = 1;
-				int isub = -1;
-				if( eta < 0 ) isub = 0;
-				if( eta > 0 ) isub = 1;
-				if( IsPhiModule == kTRUE){ phi_module_corr = h_phi_module[fCBin][isub]->GetBinContent( (h_phi_module[fCBin][isub]->GetXaxis()->FindBin( phi ) )  );}
+				int isubModule = -1;
+				if( eta < 0 ) isubModule = 0;
+				if( eta > 0 ) isubModule = 1;
+				if( IsPhiModule == kTRUE && isubModule >= 0 ){
+						phi_module_corr = h_phi_module[fCBin][isubModule]->GetBinContent( (h_phi_module[fCBin][isubModule]->GetXaxis()->FindBin( phi ) ) );
+				}
 				Double_t effCorr = fEfficiency->GetCorrection( pt, fEffFilterBit, fCent );
+				Double_t w = 1./effCorr * phi_module_corr;
+
+				// cos/sin(n*phi) by recurrence
+				Double_t c1 = TMath::Cos(phi);
+				Double_t s1 = TMath::Sin(phi);
+				cosn[0] = 1; sinn[0] = 0;
+				for(int ih=1; ih<kNH; ih++){
+						cosn[ih] = cosn[ih-1]*c1 - sinn[ih-1]*s1;
+						sinn[ih] = sinn[ih-1]*c1 + cosn[ih-1]*s1;
+				}
 
-				Qn += TComplex( 1./effCorr * phi_module_corr * TMath::Cos(ih*phi), 1./effCorr * phi_module_corr * TMath::Sin(ih*phi) );
-				Sub_Ntrk += 1./effCorr * phi_module_corr ; 
+				for(int isub=0; isub<kNSub; isub++){
+						if( !inSub[isub] ) continue;
+						fQnWeight[isub][N_ptbins] += w;
+						for(int ih=0; ih<kNH; ih++){
+								fQnRe[isub][N_ptbins][ih] += w*cosn[ih];
+								fQnIm[isub][N_ptbins][ih] += w*sinn[ih];
+						}
+						if( ipt < 0 || !inSubPt[isub] ) continue;
+						fQnWeight[isub][ipt] += w;
+						for(int ih=0; ih<kNH; ih++){
+								fQnRe[isub][ipt][ih] += w*cosn[ih];
+								fQnIm[isub][ipt][ih] += w*sinn[ih];
+						}
+				}
 		}
-		if( ih !=0) Qn /= Sub_Ntrk; // Use Qn[0] as total number of tracks(*eff)
+}
+//________________________________________________________________________
+TComplex AliJFFlucAnalysis::GetQnTable( int isub, int ipt, int harmonics)
+{
+		// Normalized Q-vector from the table filled by CalculateQnTable.
+		// pt-integrated Qn[0] is kept unnormalized as total number of tracks(*eff)
+		int ih = harmonics;
+		TComplex Qn = TComplex( fQnRe[isub][ipt][ih], fQnIm[isub][ipt][ih] );
+		if( ih != 0 || ipt != N_ptbins ) Qn /= fQnWeight[isub][ipt];
 		return Qn;
 }
 ///________________________________________________________________________
@@ -768,77 +811,6 @@ Double_t AliJFFlucAnalysis::Get_QC_Vn(Double_t QnA_real, Double_t QnA_img, Doubl
 		Double_t QC_Vn = TMath::Sqrt(QAB_real);
 		return QC_Vn; 
 }
-//________________________________________________________________________
-Double_t AliJFFlucAnalysis::Get_Qn_Real_pt(Double_t eta1, Double_t eta2, int harmonics, int ptbin, Double_t pt_min, Double_t pt_max)
-{
-		if( eta1 > eta2) cout << "ERROR eta1 should be smaller than eta2!!!" << endl;
-		int nh = harmonics;
-		Double_t Qn_real = 0;
-		Double_t Sub_Ntrk =0;
-
-		Long64_t ntracks = fInputList->GetEntriesFast();
-		for( Long64_t it=0; it< ntracks; it++){
-				AliJBaseTrack *itrack = (AliJBaseTrack*)fInputList->At(it); // load track
-				Double_t eta = itrack->Eta();
-				Double_t pt = itrack->Pt();
-				if( pt > pt_min && pt < pt_max){
-						if( eta>eta1 &&  eta<eta2 ){ 
-								int isub = -1;
-								if( eta < 0 ) isub = 0;
-								if( eta > 0 ) isub = 1;
-								Double_t phi = itrack->Phi();
-								Double_t phi_module_corr =1; 
-								if( IsPhiModule == kTRUE){
-										phi_module_corr=
-												h_phi_module[fCBin][isub]->GetBinContent( (h_phi_module[fCBin][isub]->GetXaxis()->FindBin( phi )) );
-								}
-								Double_t pt = itrack->Pt();
-								Double_t effCorr = fEfficiency->GetCorrection( pt, fEffFilterBit, fCent);
-								Qn_real += 1.0 / effCorr * phi_module_corr * TMath::Cos( nh * phi);
-								Sub_Ntrk = Sub_Ntrk + 1.0 / effCorr * phi_module_corr;
-						}
-				}
-		}
-		Qn_real /= Sub_Ntrk;
-		int iside = 0; // eta - 
-		if (eta1 > 0 ) iside = 1; // eta +
-		NSubTracks_pt[iside][ptbin] = Sub_Ntrk; // it will be overwrite for each harmonics but should be same.		
-
-		return Qn_real; 
-}
-//________________________________________________________________________
-Double_t AliJFFlucAnalysis::Get_Qn_Img_pt(Double_t eta1, Double_t eta2, int harmonics, int ptbin, Double_t pt_min, Double_t pt_max)
-{
-		int nh = harmonics;
-		Double_t Qn_img = 0;
-		Double_t Sub_Ntrk =0;
-
-		Long64_t ntracks = fInputList->GetEntriesFast();
-		for( Long64_t it=0; it< ntracks; it++){
-				AliJBaseTrack *itrack = (AliJBaseTrack*)fInputList->At(it); // load track
-				Double_t eta = itrack->Eta();
-				Double_t pt = itrack->Pt();
-				if(pt>pt_min && pt<pt_max){
-						if( eta > eta1 && eta < eta2 ){ 
-								int isub = -1;
-								if( eta < 0 ) isub = 0;
-								if( eta > 0 ) isub = 1;
-								Double_t phi = itrack->Phi();
-								Double_t phi_module_corr =1; 
-								if( IsPhiModule == kTRUE){
-										phi_module_corr=
-												h_phi_module[fCBin][isub]->GetBinContent( (h_phi_module[fCBin][isub]->GetXaxis()->FindBin( phi )) );
-								}
-								Double_t pt = itrack->Pt();
-								Double_t effCorr = fEfficiency->GetCorrection( pt, fEffFilterBit, fCent);
-								Qn_img += 1./ effCorr * phi_module_corr * TMath::Sin( nh * phi);
-								Sub_Ntrk = Sub_Ntrk + 1./ effCorr * phi_module_corr; 
-						}
-				}
-		}
-		Qn_img /= Sub_Ntrk;
-		return Qn_img; 
-}
 ///________________________________________________________________________
 /* new Function for QC method
    Please see Generic Framwork from Ante 
@@ -56,10 +56,9 @@ class AliJFFlucAnalysis : public AliAnalysisTaskSE {
 
 		inline void DEBUG(int level, TString msg){if(level<fDebugLevel) std::cout<<level<<"\t"<<msg<<endl;};
 
-		TComplex CalculateQnSP( double eta1, double eta2, int harmonics);
+		void CalculateQnTable(); // single track loop filling all (sub, ptbin, harmonic) Q-vectors
+		TComplex GetQnTable( int isub, int ipt, int harmonics);
 
-		double Get_Qn_Real_pt(double eta1, double eta2, int harmonics, int ipt, double pt_min, double pt_max);
-		double Get_Qn_Img_pt(double eta1, double eta2, int harmonics, int ipt, double pt_min, double pt_max);
 		double Get_QC_Vn( double QnA_real, double QnA_img, double QnB_real, double QnB_img);
 		void Fill_QA_plot(double eta1, double eta2 );
 
@@ -79,6 +78,7 @@ class AliJFFlucAnalysis : public AliAnalysisTaskSE {
 	private:
 		enum{kH0, kH1, kH2, kH3, kH4, kH5, kH6, kH7, kH8, kNH}; //harmonics // do we need vn up to v8? .. yes we need..
 		enum{kK0, kK1, kK2, kK3, kK4, nKL}; // order // do we really need vn^8 
+		enum{kSubA, kSubB, kNSub}; // eta sub-events for SP method
 
 //		TDirectory           *fOutput;     // Output
 		Long64_t AnaEntry; 
@@ -152,6 +152,11 @@ class AliJFFlucAnalysis : public AliAnalysisTaskSE {
 		AliJBin fBin_Nptbins;//!
 		AliJTH1D fh_SC_ptdep_4corr;//! // for < vn^2 vm^2 >
 		AliJTH1D fh_SC_ptdep_2corr;//!  // for < vn^2 >
+		// Q-vector table filled in one track loop by CalculateQnTable
+		// ipt = N_ptbins holds the pt-integrated SP Q-vectors
+		Double_t fQnRe[kNSub][N_ptbins+1][kNH];//!
+		Double_t fQnIm[kNSub][N_ptbins+1][kNH];//!
+		Double_t fQnWeight[kNSub][N_ptbins+1];//! // sum of track weights (effCorr, phi modulation)
 		// additinal variables for SC with QC
 		AliJTH1D fh_SC_with_QC_4corr;//! // for <vn^2 vm^2>
 		AliJTH1D fh_SC_with_QC_2corr;//! // for <vn^2>
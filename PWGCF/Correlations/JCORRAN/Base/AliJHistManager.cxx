@@ -254,6 +254,21 @@ void* AliJArrayBase::GetItem(){
     return item;
 }
 //_____________________________________________________
+int AliJArrayBase::GlobalIndex( const int * index ){
+    for( int i=0;i<Dimension();i++ )
+        if( OutOfSize( index[i], i ) ) JERROR( Form("wrong Index %d of %dth in ",index[i], i)+fName );
+    return fAlg->GlobalIndex( index );
+}
+//_____________________________________________________
+void* AliJArrayBase::GetItemAt( const int * index ){
+    void ** rawItem = fAlg->GetRawItemAt( GlobalIndex( index ) );
+    if( *rawItem ) return *rawItem;
+    // first access : build with the full index, then it is cached in the array
+    for( int i=0;i<Dimension();i++ ) SetIndex( index[i], i );
+    BuildItem();
+    return *rawItem;
+}
+//_____________________________________________________
 void* AliJArrayBase::GetSingleItem(){
     if(fMode == kSingle )return GetItem();
     JERROR("This is not single array");
@@ -400,7 +415,11 @@ AliJTH1::AliJTH1():
     fSubDirectory(NULL),
     fHMG(NULL),
     fTemplate(NULL),
-    fBins(0)
+    fBins(0),
+    fNCells(0),
+    fTensorW(0),
+    fTensorW2(0),
+    fTensorEntries(0)
 {
     // default constructor
     fName="AliJTH1";
@@ -412,7 +431,11 @@ AliJTH1::AliJTH1(TString config, AliJHistManager * hmg):
     fSubDirectory(NULL),
     fHMG(NULL),
     fTemplate(NULL),
-    fBins(0)
+    fBins(0),
+    fNCells(0),
+    fTensorW(0),
+    fTensorW2(0),
+    fTensorEntries(0)
 {
     // constructor
     std::vector<TString> t = Tokenize(config, " \t,");
@@ -441,7 +464,11 @@ AliJTH1::AliJTH1(const AliJTH1& obj) :
     fSubDirectory(obj.fSubDirectory),
     fHMG(obj.fHMG),
     fTemplate(obj.fTemplate),
-    fBins(obj.fBins)
+    fBins(obj.fBins),
+    fNCells(obj.fNCells),
+    fTensorW(obj.fTensorW),
+    fTensorW2(obj.fTensorW2),
+    fTensorEntries(obj.fTensorEntries)
 {
   // copy constructor TODO: proper handling of pointer data members
 }
@@ -485,6 +512,7 @@ int AliJTH1::AddDim(TString v) {
 }
 //_____________________________________________________
 Int_t AliJTH1::Write(){
+    FlushTensor();
     TDirectory *owd = (TDirectory*) gDirectory;
     InitIterator();
     void * item;
@@ -618,6 +646,58 @@ void * AliJTH1::BuildItem(){
     return (void*)item;
 }
 //_____________________________________________________
+void AliJTH1::EnableTensor(){
+    // Keep the bin contents of all histograms in one dense buffer.
+    // Fill with FillTensor( GlobalIndexOf(...), x ) and call FlushTensor()
+    // before the histograms are written or merged.
+    if( IsTensorEnabled() ) return;
+    if( !fTemplate ) { JERROR("No template for the tensor of "+fName); }
+    if( fTemplate->InheritsFrom(TProfile::Class()) ) { JERROR("Tensor is not supported for profiles : "+fName); }
+    fNCells = fTemplate->GetNcells();
+    fTensorW.assign( GetEntries()*fNCells, 0 );
+    fTensorW2.assign( GetEntries()*fNCells, 0 );
+    fTensorEntries.assign( GetEntries(), 0 );
+}
+//_____________________________________________________
+void AliJTH1::FlushTensor(){
+    // Add the tensor to the histograms and reset it.
+    // Only histograms with entries are built.
+    if( !IsTensorEnabled() ) return;
+    for( int iG=0;iG<GetEntries();iG++ ){
+        if( fTensorEntries[iG] == 0 ) continue;
+        int pos = iG;
+        fAlg->SetPosition( &pos ); // set index to build the histogram
+        TH1 * h = static_cast<TH1*>(GetItem());
+        TArrayD * sumw2 = h->GetSumw2();
+        bool hasSumw2 = sumw2 && sumw2->GetSize() == fNCells;
+        double * w = &fTensorW[iG*fNCells];
+        double * w2 = &fTensorW2[iG*fNCells];
+        for( int bin=0;bin<fNCells;bin++ ){
+            if( w[bin] == 0 && w2[bin] == 0 ) continue;
+            h->AddBinContent( bin, w[bin] );
+            if( hasSumw2 ) (*sumw2)[bin] += w2[bin];
+            w[bin] = 0;
+            w2[bin] = 0;
+        }
+        double entries = h->GetEntries() + fTensorEntries[iG];
+        h->ResetStats();
+        h->SetEntries( entries );
+        fTensorEntries[iG] = 0;
+    }
+}
+//_____________________________________________________
+void AliJTH1::AddTensor( AliJTH1 & obj ){
+    // Element-wise sum of the tensors of two arrays with the same binning
+    if( !IsTensorEnabled() || fTensorW.size() != obj.fTensorW.size() ) {
+        JERROR("Incompatible tensor in "+fName);
+    }
+    for( UInt_t i=0;i<fTensorW.size();i++ ){
+        fTensorW[i] += obj.fTensorW[i];
+        fTensorW2[i] += obj.fTensorW2[i];
+    }
+    for( UInt_t i=0;i<fTensorEntries.size();i++ ) fTensorEntries[i] += obj.fTensorEntries[i];
+}
+//_____________________________________________________
 bool AliJTH1::IsLoadMode(){
     return fHMG->IsLoadMode();
 }
@@ -157,6 +157,8 @@ class AliJArrayBase : public AliJNamed{
 
         void * GetItem();
         void * GetSingleItem();
+        void * GetItemAt( const int * index ); // direct access with a full index, no player
+        int  GlobalIndex( const int * index );
 
         ///void LockBin(bool is=true){}//TODO
         //bool IsBinLocked(){ return fIsBinLocked; }
@@ -215,6 +217,8 @@ class AliJArrayAlgorithm {
         virtual bool IsCurrentPosition(void * pos)=0;
         virtual void SetPosition(void * pos )=0;
         virtual void DeletePosition( void * pos ) =0;
+        virtual int GlobalIndex( const int * index )=0;
+        virtual void ** GetRawItemAt( int iG )=0;
     protected:
         AliJArrayBase * fCMD;
 };
@@ -228,6 +232,12 @@ class AliJArrayAlgorithmSimple : public AliJArrayAlgorithm {
         virtual ~AliJArrayAlgorithmSimple();
         virtual int BuildArray();
         int  GlobalIndex();
+        virtual int GlobalIndex( const int * index ){
+            int iG = 0;
+            for( int i=0;i<Dimension();i++ ) iG+= index[i]*fDimFactor[i];
+            return iG;
+        }
+        virtual void ** GetRawItemAt( int iG ){ return &fArray[iG]; }
         void ReverseIndex(int iG );
         virtual void * GetItem();
         virtual void SetItem(void * item);
@@ -288,6 +298,21 @@ class AliJTH1 : public AliJArrayBase{
         void    SetTemplate(TH1* h);
         TH1*    GetTemplatePtr(){ return fTemplate; }
 
+        // Dense tensor backend : bin contents of all histograms of the array
+        // in one buffer, moved to the histograms with FlushTensor()
+        void    EnableTensor();
+        bool    IsTensorEnabled(){ return fNCells > 0; }
+        void    FillTensor( int iG, double x, double w=1. ){
+            int bin = fTemplate->FindFixBin(x);
+            AddTensor( iG, bin, w );
+        }
+        void    FillTensor( int iG, double x, double y, double w ){
+            int bin = fTemplate->FindFixBin(x,y);
+            AddTensor( iG, bin, w );
+        }
+        void    FlushTensor();
+        void    AddTensor( AliJTH1 & obj );
+
 
 
     protected:
@@ -297,6 +322,17 @@ class AliJTH1 : public AliJArrayBase{
         AliJHistManager *fHMG;
         TH1             *fTemplate;
         std::vector<AliJBin*>  fBins;
+        int              fNCells;               // number of cells per histogram in the tensor, 0 : disabled
+        std::vector<double>  fTensorW;          // sum of weights  [histogram][cell]
+        std::vector<double>  fTensorW2;         // sum of weights^2 [histogram][cell]
+        std::vector<double>  fTensorEntries;    // entries [histogram]
+    private:
+        void    AddTensor( int iG, int bin, double w ){
+            int i = iG*fNCells+bin;
+            fTensorW[i] += w;
+            fTensorW2[i] += w*w;
+            fTensorEntries[iG] += 1;
+        }
 };
 //////////////////////////////////////////////////////////////////////////
 //                                                                      //
@@ -317,6 +353,19 @@ class AliJTH1Derived : public AliJTH1 {
         AliJTH1DerivedPlayer<T> & operator[](int i){ fPlayer.Init();fPlayer[i];return fPlayer; }
         T * operator->(){ return static_cast<T*>(GetSingleItem()); }
         operator T*(){ return static_cast<T*>(GetSingleItem()); }
+
+        // Resolved access : the histogram pointer for a full index, built once
+        // and cached in the array. Same as h[i0][i1]... without the player.
+        T * At( int i0, int i1=-1, int i2=-1, int i3=-1, int i4=-1, int i5=-1 ){
+            if( Dimension() > 6 ) JERROR("At() supports up to 6 dimensions in "+fName);
+            int index[6] = { i0, i1, i2, i3, i4, i5 };
+            return static_cast<T*>(GetItemAt(index));
+        }
+        int GlobalIndexOf( int i0, int i1=-1, int i2=-1, int i3=-1, int i4=-1, int i5=-1 ){
+            if( Dimension() > 6 ) JERROR("GlobalIndexOf() supports up to 6 dimensions in "+fName);
+            int index[6] = { i0, i1, i2, i3, i4, i5 };
+            return GlobalIndex(index);
+        }
         // Virtual from AliJArrayBase
 
         // Virtual from AliJTH1
@@ -94,7 +94,8 @@ AliFemtoEventReaderAOD::AliFemtoEventReaderAOD():
   fIsKaonAnalysis(kFALSE),
   fIsProtonAnalysis(kFALSE),
   fIsPionAnalysis(kFALSE),
-  fIsElectronAnalysis(kFALSE)
+  fIsElectronAnalysis(kFALSE),
+  fGlobalTrackIndex()
 {
   // default constructor
   fAllTrue.ResetAllBits(kTRUE);
@@ -148,7 +149,8 @@ AliFemtoEventReaderAOD::AliFemtoEventReaderAOD(const AliFemtoEventReaderAOD &aRe
   fIsKaonAnalysis(aReader.fIsKaonAnalysis),
   fIsProtonAnalysis(aReader.fIsProtonAnalysis),
   fIsPionAnalysis(aReader.fIsPionAnalysis),
-  fIsElectronAnalysis(aReader.fIsElectronAnalysis)
+  fIsElectronAnalysis(aReader.fIsElectronAnalysis),
+  fGlobalTrackIndex()
 
 {
   // copy constructor
@@ -426,20 +428,12 @@ AliFemtoEvent *AliFemtoEventReaderAOD::CopyAODtoFemtoEvent()
   int realnofTracks = 0; // number of track which we use in a analysis
   int tracksPrim = 0;
 
-  // 'labels' maps a track's id to the track's index in the Event
-  // i.e. labels[Event->GetTrack(x)->GetID()] == x
-  std::map<int, int> labels;
+  // For TPC Only tracks the PID information is copied from the global tracks,
+  // found by ID in fGlobalTrackIndex
+  const bool tpcOnly = (fFilterBit == (1 << 7) || fFilterMask == 128);
+  if (tpcOnly) FillGlobalTrackIndex(nofTracks);
 
-  // looking for global tracks and saving their numbers to copy from them PID information to TPC-only tracks in the main loop over tracks
-  for (int i = 0; i < nofTracks; i++) {
-    const AliAODTrack *aodtrack = dynamic_cast<const AliAODTrack *>(fEvent->GetTrack(i));
-    assert(aodtrack && "Not a standard AOD");
-    if (!aodtrack->TestFilterBit(fFilterBit)) {
-      // Skip TPC-only tracks
-      if (aodtrack->GetID() < 0) continue;
-      labels[aodtrack->GetID()] = i;
-    }
-  }
+  const bool selectMCSpecies = (mcP && (fIsKaonAnalysis || fIsProtonAnalysis || fIsPionAnalysis || fIsElectronAnalysis));
 
   int tNormMult = 0;
   for (int i = 0; i < nofTracks; i++) {
@@ -470,16 +464,22 @@ AliFemtoEvent *AliFemtoEventReaderAOD::CopyAODtoFemtoEvent()
               tNormMult++;
     }
 
-    AliFemtoTrack *trackCopy = CopyAODtoFemtoTrack(aodtrack);
-
-    // copying PID information from the correspondent track
-    //  const AliAODTrack *aodtrackpid = fEvent->GetTrack(labels[-1-fEvent->GetTrack(i)->GetID()]);
+    // Special MC analysis: the other species are rejected before building the femto track
+    if (selectMCSpecies && !AcceptMCParticleSpecies(aodtrack, mcP)) {
+      continue;
+    }
 
+    AliFemtoTrack *trackCopy = CopyAODtoFemtoTrack(aodtrack);
 
-    // For TPC Only tracks we have to copy PID information from corresponding global tracks
-    const Int_t pid_track_id = (fFilterBit == (1 << 7) || fFilterMask == 128)
-                             ? labels[-1 - fEvent->GetTrack(i)->GetID()]
-                             : i;
+    // For TPC Only tracks we have to copy PID information from corresponding global tracks,
+    // tracks without one take it from the first track of the event
+    Int_t pid_track_id = i;
+    if (tpcOnly) {
+      const int globalID = -1 - aodtrack->GetID();
+      pid_track_id = (globalID >= 0 && globalID < (int) fGlobalTrackIndex.size())
+                   ? fGlobalTrackIndex[globalID]
+                   : 0;
+    }
     AliAODTrack *aodtrackpid = dynamic_cast<AliAODTrack *>(fEvent->GetTrack(pid_track_id));
     assert(aodtrackpid && "Not a standard AOD");
 
@@ -1650,6 +1650,42 @@ void AliFemtoEventReaderAOD::SetUseMultiplicity(EstEventMult aType)
   fEstEventMult = aType;
 }
 
+void AliFemtoEventReaderAOD::FillGlobalTrackIndex(int nofTracks)
+{
+  // Index in the event of the global tracks, by track ID.
+  // The IDs without global track point to the first track of the event.
+  fGlobalTrackIndex.clear();
+  for (int i = 0; i < nofTracks; i++) {
+    const AliAODTrack *aodtrack = dynamic_cast<const AliAODTrack *>(fEvent->GetTrack(i));
+    assert(aodtrack && "Not a standard AOD");
+    if (aodtrack->TestFilterBit(fFilterBit)) continue;
+    // Skip TPC-only tracks
+    const int id = aodtrack->GetID();
+    if (id < 0) continue;
+    if (id >= (int) fGlobalTrackIndex.size()) fGlobalTrackIndex.resize(id + 1, 0);
+    fGlobalTrackIndex[id] = i;
+  }
+}
+
+bool AliFemtoEventReaderAOD::AcceptMCParticleSpecies(const AliAODTrack *aodtrack, TClonesArray *mcP) const
+{
+  // Special MC analysis for pi,K,p,e selected by PDG code: the same selection
+  // as on the hidden information of the femto track, from the MC particle
+  const Int_t track_label = aodtrack->GetLabel();
+  const AliAODMCParticle *tPart = (track_label > -1)
+                                ? (AliAODMCParticle *)mcP->At(track_label)
+                                : NULL;
+  if (!tPart) return false;
+
+  const Int_t pdg = TMath::Abs(tPart->GetPdgCode());
+  if (fIsKaonAnalysis && pdg != 321) return false;
+  if (fIsProtonAnalysis && pdg != 2212) return false;
+  if (fIsPionAnalysis && pdg != 211) return false;
+  if (fIsElectronAnalysis && pdg != 11) return false;
+
+  return tPart->P() > 0;
+}
+
 AliAODMCParticle *AliFemtoEventReaderAOD::GetParticleWithLabel(TClonesArray *mcP, Int_t aLabel)
 {
   if (aLabel < 0) return NULL;
@@ -131,6 +131,8 @@ protected:
 private:
 
   AliAODMCParticle *GetParticleWithLabel(TClonesArray *mcP, Int_t aLabel);
+  void FillGlobalTrackIndex(int nofTracks);
+  bool AcceptMCParticleSpecies(const AliAODTrack *aodtrack, TClonesArray *mcP) const;
 
   string fInputFile;       ///< name of input file with AOD filenames
   TChain *fTree;           ///< AOD tree
@@ -164,10 +166,12 @@ private:
   Bool_t fIsElectronAnalysis; // e+e- are taken (for gamma cut tuning)
   //Special MC analysis for pi,K,p,e slected by PDG code <--
 
+  std::vector<int> fGlobalTrackIndex; //!<! Index in the event of the global track with a given ID, reused from event to event
+
 
 #ifdef __ROOT__
   /// \cond CLASSIMP
-  ClassDef(AliFemtoEventReaderAOD, 12);
+  ClassDef(AliFemtoEventReaderAOD, 13);
   /// \endcond
 #endif
 
@@ -45,6 +45,7 @@
 #include <TParticle.h>
 #include <TMCProcess.h>
 
+#include "AliMCGenealogy.h"
 #include "AliDielectronSignalMC.h"
 #include "AliDielectronMC.h"
 
@@ -596,6 +597,20 @@ Int_t AliDielectronMC::GetLabelMotherWithPdg(const AliVParticle *particle1, cons
   //
   // test if mother of particle 1 and 2 has pdgCode pdgMother and is the same;
   //
+  const AliMCGenealogy *genealogy=GetGenealogy();
+  if (genealogy){
+    // same checks as the ESD and AOD versions, on the flat arrays of the index
+    Int_t lblPart1 = TMath::Abs(particle1->GetLabel());
+    Int_t lblPart2 = TMath::Abs(particle2->GetLabel());
+    if (!genealogy->IsValid(lblPart1) || !genealogy->IsValid(lblPart2)) return -1;
+    Int_t lblMother1 = genealogy->GetMother(lblPart1);
+    if (!genealogy->IsValid(lblMother1)) return -1;
+    if (lblMother1!=genealogy->GetMother(lblPart2)) return -1;
+    if (TMath::Abs(genealogy->GetPdgCode(lblPart1))!=11) return -1;
+    if (genealogy->GetPdgCode(lblPart1)!=-genealogy->GetPdgCode(lblPart2)) return -1;
+    if (genealogy->GetPdgCode(lblMother1)!=pdgMother) return -1;
+    return lblMother1;
+  }
   if (fAnaType==kESD){
   if (!fMCEvent) return -1;
   return GetLabelMotherWithPdgESD(particle1, particle2, pdgMother);
@@ -697,6 +712,17 @@ void AliDielectronMC::GetDaughters(const TObject *mother, AliVParticle* &d1, Ali
 }
 
 
+//________________________________________________________________________________
+const AliMCGenealogy* AliDielectronMC::GetGenealogy() const {
+  //
+  //  Genealogy index of the current MC event, shared with other tasks and built once per event
+  //  0 if not available
+  //
+  if (fAnaType==kAOD && fMcArray) return AliMCGenealogy::GetEventGenealogy(fMcArray);
+  if (fAnaType==kESD && fMCEvent) return AliMCGenealogy::GetEventGenealogy(fMCEvent);
+  return 0x0;
+}
+
 //________________________________________________________________________________
 Int_t AliDielectronMC::GetMothersLabel(Int_t daughterLabel) const {
   //
@@ -1532,6 +1558,21 @@ Bool_t AliDielectronMC::CheckStackParticle(Int_t labelPart, Int_t requiredPDG) c
   // Check the stack of a particle and exclude if there is a certain pdg code found
   //
   Bool_t result = kTRUE;
+  const AliMCGenealogy *genealogy=GetGenealogy();
+  if (genealogy){
+    // same walk on the flat arrays of the index
+    if (labelPart<0) return result;
+    Int_t labelMother = genealogy->GetMother(labelPart);
+    Int_t motherPDG = (labelMother>=0) ? genealogy->GetPdgCode(labelMother):0;
+    Int_t i = 0;
+    while(TMath::Abs(motherPDG) > 10 && labelMother > -1 && result && i<10){
+      result = ComparePDG(motherPDG, requiredPDG, kTRUE, kTRUE);
+      labelMother = genealogy->GetMother(labelMother);
+      motherPDG = (labelMother>=0) ? genealogy->GetPdgCode(labelMother):0;
+      i++;
+    }
+    return result;
+  }
   Int_t labelMother = GetMothersLabel(labelPart);
   Int_t motherPDG = GetPdgFromLabel(labelMother);
   Int_t i = 0;
@@ -1629,6 +1670,12 @@ Int_t AliDielectronMC::IsJpsiPrimary(const AliVParticle * particle)
  Int_t labelMoth=-1;
  Int_t pdgCode;
 
+ // the origin tags of the index collect the same ancestors (mother labels > 0)
+ const AliMCGenealogy *genealogy=GetGenealogy();
+ if (genealogy && genealogy->IsValid(particle->GetLabel())) {
+   return (genealogy->GetOriginTags(particle->GetLabel()) & AliMCGenealogy::kFromBeautyHadron) ? 1:0;
+ }
+
  if (particle->IsA()==AliMCParticle::Class()){
      labelMoth = (static_cast<const AliMCParticle*>(particle))->GetMother();
      while(labelMoth>0){
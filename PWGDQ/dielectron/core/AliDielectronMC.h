@@ -26,6 +26,7 @@ class TParticle;
 class AliMCParticle;
 class AliAODMCParticle;
 class AliAODMCHeader;
+class AliMCGenealogy;
 
 #include "AliDielectronSignalMC.h"
 #include "AliDielectronPair.h"
@@ -71,6 +72,7 @@ public:
   Bool_t IsMCTruth(Int_t label, AliDielectronSignalMC* signalMC, Int_t branch) const;
   Int_t GetMothersLabel(Int_t daughterLabel) const;
   Int_t GetPdgFromLabel(Int_t label) const;
+  const AliMCGenealogy* GetGenealogy() const;
 
   Bool_t IsPhysicalPrimary(Int_t label) const;  // checks if a particle is physical primary
   Bool_t CheckGEANTProcess(Int_t label, TMCProcess process) const;
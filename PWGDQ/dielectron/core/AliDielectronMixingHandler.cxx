@@ -27,7 +27,15 @@ Detailed description
 
 #include <TVectorD.h>
 #include <TH1.h>
+#include <TProfile.h>
+#include <TProfile2D.h>
+#include <THnBase.h>
 #include <TAxis.h>
+#include <TMath.h>
+#include <TVector2.h>
+#include <TRandom.h>
+#include <TDatabasePDG.h>
+#include <THashList.h>
 
 #include <AliLog.h>
 #include <AliVTrack.h>
@@ -36,6 +44,7 @@ Detailed description
 #include "AliDielectronHelper.h"
 #include "AliDielectronHistos.h"
 #include "AliDielectronEvent.h"
+#include "AliDielectronVarCuts.h"
 
 #include "AliDielectronMixingHandler.h"
 
@@ -50,13 +59,22 @@ AliDielectronMixingHandler::AliDielectronMixingHandler() :
   fMixIncomplete(kTRUE),
   fMoveToSameVertex(kFALSE),
   fSkipFirstEvt(kFALSE),
-  fPID(0x0)
+  fCompactMixing(kFALSE),
+  fNLegVars(0),
+  fPID(0x0),
+  fBinEdges(),
+  fAxisFirst(),
+  fCompactPools(),
+  fCompactStatus(-1),
+  fLegVarMap(AliDielectronVarManager::kNMaxValues),
+  fKernel()
 {
   //
   // Default Constructor
   //
   for (Int_t i=0; i<kMaxCuts; ++i){
     fEventCuts[i]=0;
+    fLegVars[i]=0;
   }
   fAxes.SetOwner(kTRUE);
 }
@@ -71,13 +89,22 @@ AliDielectronMixingHandler::AliDielectronMixingHandler(const char* name, const c
   fMixIncomplete(kTRUE),
   fMoveToSameVertex(kFALSE),
   fSkipFirstEvt(kFALSE),
-  fPID(0x0)
+  fCompactMixing(kFALSE),
+  fNLegVars(0),
+  fPID(0x0),
+  fBinEdges(),
+  fAxisFirst(),
+  fCompactPools(),
+  fCompactStatus(-1),
+  fLegVarMap(AliDielectronVarManager::kNMaxValues),
+  fKernel()
 {
   //
   // Named Constructor
   //
   for (Int_t i=0; i<kMaxCuts; ++i){
     fEventCuts[i]=0;
+    fLegVars[i]=0;
   }
   fAxes.SetOwner(kTRUE);
 }
@@ -148,6 +175,21 @@ void AliDielectronMixingHandler::AddVariable(AliDielectronVarManager::ValueTypes
   fAxes.Add(bins);
 }
 
+//________________________________________________________________
+void AliDielectronMixingHandler::AddLegVariable(AliDielectronVarManager::ValueTypes type)
+{
+  //
+  // Add a leg variable to be stored in the compact pools,
+  // the compact pools always keep the leg momenta and charges
+  //
+
+  // limit number of variables to kMaxCuts
+  if (fNLegVars>=kMaxCuts) return;
+
+  fLegVars[fNLegVars++]=(UShort_t)type;
+  fCompactStatus=-1;
+}
+
 //______________________________________________
 void AliDielectronMixingHandler::Fill(const AliVEvent *ev, AliDielectron *diele)
 {
@@ -158,8 +200,10 @@ void AliDielectronMixingHandler::Fill(const AliVEvent *ev, AliDielectron *diele)
   //check if there are tracks available
   if (diele->GetTrackArray(0)->GetEntriesFast()==0 && diele->GetTrackArray(1)->GetEntriesFast()==0) return;
 
+  //bin description only for debugging
   TString dim;
-  Int_t bin=FindBin(AliDielectronVarManager::GetData(),&dim);
+  TString *pdim=(AliLog::GetDebugLevel("",ClassName())>=5) ? &dim : 0x0;
+  Int_t bin=FindBin(AliDielectronVarManager::GetData(),pdim);
 
   //add mixing bin to event data
   AliDielectronVarManager::SetValue(AliDielectronVarManager::kMixingBin,bin);
@@ -169,6 +213,18 @@ void AliDielectronMixingHandler::Fill(const AliVEvent *ev, AliDielectron *diele)
     return;
   }
 
+  //compact pools if the configuration allows for them
+  if (fCompactMixing){
+    if (fCompactStatus<0){
+      fCompactStatus=CheckCompactMixing(diele);
+      for (Int_t ivar=0; ivar<fNLegVars; ++ivar) fLegVarMap.SetBitNumber(fLegVars[ivar],kTRUE);
+    }
+    if (fCompactStatus>0){
+      FillCompact(bin,diele);
+      return;
+    }
+  }
+
   // get mixing pool, create it if it does not yet exist.
   TClonesArray *poolp=static_cast<TClonesArray*>(fArrPools.At(bin));
 
@@ -357,6 +413,323 @@ void AliDielectronMixingHandler::DoMixing(TClonesArray &pool, AliDielectron *die
   AliDielectronVarManager::SetEventData(values);
 }
 
+//______________________________________________
+Bool_t AliDielectronMixingHandler::CheckCompactMixing(AliDielectron *diele) const
+{
+  //
+  // check whether the compact pools can be used with the configuration of 'diele'
+  // the compact mixing provides the pair kinematics only, no pair objects are created:
+  // pair prefilters, histogram arrays, CF managers, debug trees and moving the tracks to the
+  // same vertex are not supported, pair cuts have to be AliDielectronVarCuts and the pair
+  // histograms of the mixed event classes may only use the pair variables filled by DoCompactMixing.
+  // The leg histograms may only use the leg kinematics and the variables added with AddLegVariable.
+  //
+
+  if (diele->fPairPreFilter1.GetCuts()->GetEntries()>0 || diele->fPairPreFilter2.GetCuts()->GetEntries()>0 ||
+      diele->fHistoArray || diele->fCfManagerPair || diele->fDebugTree || fMoveToSameVertex){
+    AliWarning("Configuration not supported by the compact mixing, using the standard mixing");
+    return kFALSE;
+  }
+
+  //variables available in the compact mixing, the event variables are always available
+  TBits available(AliDielectronVarManager::kNMaxValues);
+  const Int_t pairVars[]={AliDielectronVarManager::kPx, AliDielectronVarManager::kPy, AliDielectronVarManager::kPz,
+                          AliDielectronVarManager::kPt, AliDielectronVarManager::kPtSq, AliDielectronVarManager::kP,
+                          AliDielectronVarManager::kOneOverPt, AliDielectronVarManager::kPhi, AliDielectronVarManager::kTheta,
+                          AliDielectronVarManager::kEta, AliDielectronVarManager::kY, AliDielectronVarManager::kE,
+                          AliDielectronVarManager::kM, AliDielectronVarManager::kCharge, AliDielectronVarManager::kPdgCode,
+                          AliDielectronVarManager::kRndm, AliDielectronVarManager::kPairType, AliDielectronVarManager::kOpeningAngle,
+                          AliDielectronVarManager::kDeltaEta, AliDielectronVarManager::kDeltaPhi};
+  for (UInt_t i=0; i<sizeof(pairVars)/sizeof(Int_t); ++i) available.SetBitNumber(pairVars[i],kTRUE);
+  for (Int_t i=AliDielectronVarManager::kPairMax; i<AliDielectronVarManager::kNMaxValues; ++i) available.SetBitNumber(i,kTRUE);
+
+  //variables of the legs stored in the compact pools
+  TBits legAvailable(AliDielectronVarManager::kNMaxValues);
+  const Int_t legVars[]={AliDielectronVarManager::kPx, AliDielectronVarManager::kPy, AliDielectronVarManager::kPz,
+                         AliDielectronVarManager::kPt, AliDielectronVarManager::kPtSq, AliDielectronVarManager::kP,
+                         AliDielectronVarManager::kOneOverPt, AliDielectronVarManager::kPhi, AliDielectronVarManager::kTheta,
+                         AliDielectronVarManager::kEta, AliDielectronVarManager::kCharge};
+  for (UInt_t i=0; i<sizeof(legVars)/sizeof(Int_t); ++i) legAvailable.SetBitNumber(legVars[i],kTRUE);
+  for (Int_t ivar=0; ivar<fNLegVars; ++ivar) legAvailable.SetBitNumber(fLegVars[ivar],kTRUE);
+  for (Int_t i=AliDielectronVarManager::kPairMax; i<AliDielectronVarManager::kNMaxValues; ++i) legAvailable.SetBitNumber(i,kTRUE);
+
+  TIter nextCut(diele->fPairFilter.GetCuts());
+  TObject *o=0x0;
+  while ( (o=nextCut()) ){
+    AliDielectronVarCuts *cut=dynamic_cast<AliDielectronVarCuts*>(o);
+    if (!cut || cut->GetCutOnMCtruth()){
+      AliWarning(Form("Pair cut '%s' not supported by the compact mixing, using the standard mixing",o->GetName()));
+      return kFALSE;
+    }
+    const TBits *used=cut->GetUsedVars();
+    for (UInt_t ivar=used->FirstSetBit(); ivar<used->GetNbits(); ivar=used->FirstSetBit(ivar+1)){
+      if (available.TestBitNumber(ivar)) continue;
+      AliWarning(Form("Pair cut '%s' uses %s, not available in the compact mixing, using the standard mixing",
+                      o->GetName(),AliDielectronVarManager::GetValueName(ivar)));
+      return kFALSE;
+    }
+  }
+
+  //histograms of the mixed event pair and leg classes
+  if (!diele->fHistos) return kTRUE;
+  const THashList *histos=diele->fHistos->GetHistogramList();
+  const Int_t types[4]={AliDielectron::kEv1PEv2P, AliDielectron::kEv1MEv2P, AliDielectron::kEv1PEv2M, AliDielectron::kEv1MEv2M};
+  for (Int_t itype=0; itype<4; ++itype){
+    for (Int_t ileg=0; ileg<2; ++ileg){
+      TString histClass=Form("%s_%s",(ileg==0) ? "Pair" : "Track_Legs",AliDielectron::PairClassName(types[itype]));
+      const Int_t missing=FindMissingVariable(histos->FindObject(histClass.Data()), (ileg==0) ? available : legAvailable);
+      if (missing<0) continue;
+      AliWarning(Form("Histogram class '%s' uses %s, not available in the compact mixing, using the standard mixing",
+                      histClass.Data(),AliDielectronVarManager::GetValueName(missing)));
+      return kFALSE;
+    }
+  }
+
+  return kTRUE;
+}
+
+//______________________________________________
+Int_t AliDielectronMixingHandler::FindMissingVariable(const TObject *histClass, const TBits &available) const
+{
+  //
+  // first variable used by the histograms of 'histClass' which is not in 'available', -1 if there is none.
+  // The variables are the ones stored in the axes and the unique ID (profile or weight variable)
+  // by AliDielectronHistos
+  //
+
+  const THashList *list=dynamic_cast<const THashList*>(histClass);
+  if (!list) return -1;
+
+  TIter nextHist(list);
+  TObject *obj=0x0;
+  while ( (obj=nextHist()) ){
+    const UInt_t id=obj->GetUniqueID();
+    if (id==(UInt_t)AliDielectronHistos::kNoAutoFill) continue;
+
+    UInt_t vars[21]={0};
+    Int_t nVars=0;
+    if (obj->InheritsFrom(TH1::Class())){
+      const TH1 *hist=static_cast<const TH1*>(obj);
+      const Int_t dim=hist->GetDimension();
+      vars[nVars++]=hist->GetXaxis()->GetUniqueID();
+      //profiles store their variable in the next axis
+      if (dim>=2 || hist->InheritsFrom(TProfile::Class())) vars[nVars++]=hist->GetYaxis()->GetUniqueID();
+      if (dim>=3 || hist->InheritsFrom(TProfile2D::Class())) vars[nVars++]=hist->GetZaxis()->GetUniqueID();
+    }
+    else if (obj->InheritsFrom(THnBase::Class())){
+      const THnBase *hist=static_cast<const THnBase*>(obj);
+      for (Int_t it=0; it<hist->GetNdimensions() && it<20; ++it) vars[nVars++]=hist->GetAxis(it)->GetUniqueID();
+    }
+    else continue;
+    vars[nVars++]=id;
+
+    for (Int_t ivar=0; ivar<nVars; ++ivar){
+      if (vars[ivar]>=(UInt_t)AliDielectronVarManager::kNMaxValues) continue; // kNoWeights, kNoProfile
+      if (!available.TestBitNumber(vars[ivar])) return vars[ivar];
+    }
+  }
+  return -1;
+}
+
+//______________________________________________
+void AliDielectronMixingHandler::FillCompact(Int_t bin, AliDielectron *diele)
+{
+  //
+  // mix with the compact pool of 'bin' and store the legs of this event in it
+  //
+
+  if (fCompactPools.size()==0) fCompactPools.resize(GetNumberOfBins());
+  CompactPool &pool=fCompactPools[bin];
+  if (pool.fFirst.size()==0) pool.fFirst.push_back(0);
+
+  // do mixing
+  if (pool.fFirst.size()>1) DoCompactMixing(pool,diele);
+
+  // drop the oldest event if the pool is full
+  if ((Int_t)pool.fFirst.size()>fDepth){
+    const Int_t nLegs=pool.fFirst[1];
+    pool.fPx.erase(pool.fPx.begin(),pool.fPx.begin()+nLegs);
+    pool.fPy.erase(pool.fPy.begin(),pool.fPy.begin()+nLegs);
+    pool.fPz.erase(pool.fPz.begin(),pool.fPz.begin()+nLegs);
+    pool.fValues.erase(pool.fValues.begin(),pool.fValues.begin()+nLegs*fNLegVars);
+    pool.fFirst.erase(pool.fFirst.begin());
+    pool.fNPos.erase(pool.fNPos.begin());
+    for (UInt_t iev=0; iev<pool.fFirst.size(); ++iev) pool.fFirst[iev]-=nLegs;
+  }
+
+  // store the positive, then the negative legs
+  Double_t values[AliDielectronVarManager::kNMaxValues];
+  if (fNLegVars>0) AliDielectronVarManager::SetFillMap(&fLegVarMap);
+  for (Int_t iarr=0; iarr<2; ++iarr){
+    const TObjArray &arr=diele->fTracks[iarr];
+    for (Int_t itrack=0; itrack<arr.GetEntriesFast(); ++itrack){
+      const AliVTrack *track=static_cast<const AliVTrack*>(arr.UncheckedAt(itrack));
+      pool.fPx.push_back(track->Px());
+      pool.fPy.push_back(track->Py());
+      pool.fPz.push_back(track->Pz());
+      if (fNLegVars==0) continue;
+      AliDielectronVarManager::Fill(track,values);
+      for (Int_t ivar=0; ivar<fNLegVars; ++ivar) pool.fValues.push_back(values[fLegVars[ivar]]);
+    }
+  }
+  if (fNLegVars>0) AliDielectronVarManager::SetFillMap(diele->fUsedVars);
+  pool.fNPos.push_back(diele->fTracks[0].GetEntriesFast());
+  pool.fFirst.push_back(pool.fPx.size());
+}
+
+//______________________________________________
+void AliDielectronMixingHandler::DoCompactMixing(const CompactPool &pool, AliDielectron *diele)
+{
+  //
+  // pair the legs of the current event with the legs stored in the compact pool
+  // and fill the pair (and leg) histograms of the mixed event pair types directly.
+  // The combinations follow DoMixing; the pair momentum is the sum of the leg momenta,
+  // as for the pair objects without vertex fit.
+  //
+
+  if (!diele->fHistos) return;
+  const THashList *histos=diele->fHistos->GetHistogramList();
+
+  // combinations as in DoMixing: sign of the leg of the current event, sign of the stored leg, pair type
+  // ev1- ev2+ is common for all mixing types, for kOSonly and kOSandLS ev1+ ev2- uses the same pair type
+  const Int_t comb[5][3]={{-1,+1,AliDielectron::kEv1MEv2P},{+1,+1,AliDielectron::kEv1PEv2P},
+                          {-1,-1,AliDielectron::kEv1MEv2M},{+1,-1,AliDielectron::kEv1PEv2M},
+                          {+1,-1,AliDielectron::kEv1MEv2P}};
+  const Bool_t useComb[5]={kTRUE, fMixType!=kOSonly, fMixType!=kOSonly, fMixType==kAll, fMixType!=kAll};
+
+  const Double_t m1=TDatabasePDG::Instance()->GetParticle(diele->fPdgLeg1)->Mass();
+  const Double_t m2=TDatabasePDG::Instance()->GetParticle(diele->fPdgLeg2)->Mass();
+
+  //event data of the current event
+  Double_t values[AliDielectronVarManager::kNMaxValues]={0};
+  Double_t legValues[AliDielectronVarManager::kNMaxValues]={0};
+  for (Int_t i=AliDielectronVarManager::kPairMax; i<AliDielectronVarManager::kNMaxValues; ++i){
+    values[i]=AliDielectronVarManager::GetValue((AliDielectronVarManager::ValueTypes)i);
+    legValues[i]=values[i];
+  }
+
+  TList *pairCuts=diele->fPairFilter.GetCuts();
+  const Int_t nCuts=pairCuts->GetEntries();
+  const Int_t nStored=pool.fFirst.back();
+  const Int_t nEvents=pool.fFirst.size()-1;
+
+  //legs already filled in the leg histograms, per pair type
+  const Int_t nCurrent=diele->fTracks[0].GetEntriesFast()+diele->fTracks[1].GetEntriesFast();
+  std::vector<Char_t> filledCurrent[AliDielectron::kEv1PMRot+1];
+  std::vector<Char_t> filledStored[AliDielectron::kEv1PMRot+1];
+
+  for (Int_t icomb=0; icomb<5; ++icomb){
+    if (!useComb[icomb]) continue;
+    const Int_t type=comb[icomb][2];
+    TString pairClass=Form("Pair_%s",AliDielectron::PairClassName(type));
+    TString legClass=Form("Track_Legs_%s",AliDielectron::PairClassName(type));
+    const Bool_t fillPair=histos->FindObject(pairClass.Data())!=0x0;
+    const Bool_t fillLeg=histos->FindObject(legClass.Data())!=0x0;
+    if (!fillPair && !fillLeg) continue;
+    if (fillLeg && filledCurrent[type].size()==0){
+      filledCurrent[type].assign(nCurrent,0);
+      filledStored[type].assign(nStored,0);
+    }
+
+    const TObjArray &legs1=diele->fTracks[comb[icomb][0]>0 ? 0 : 1];
+    const Int_t offset1=(comb[icomb][0]>0) ? 0 : diele->fTracks[0].GetEntriesFast();
+    for (Int_t itrack=0; itrack<legs1.GetEntriesFast(); ++itrack){
+      const AliVTrack *track=static_cast<const AliVTrack*>(legs1.UncheckedAt(itrack));
+      const Double_t p1x=track->Px(), p1y=track->Py(), p1z=track->Pz();
+      const Double_t p1=TMath::Sqrt(p1x*p1x+p1y*p1y+p1z*p1z);
+      const Double_t pt1=TMath::Sqrt(p1x*p1x+p1y*p1y);
+      const Double_t e1=TMath::Sqrt(p1*p1+m1*m1);
+      const Double_t eta1=(pt1>0.) ? TMath::ASinH(p1z/pt1) : 0.;
+
+      for (Int_t iev=0; iev<nEvents; ++iev){
+        const Int_t first=pool.fFirst[iev] + ((comb[icomb][1]>0) ? 0 : pool.fNPos[iev]);
+        const Int_t last=(comb[icomb][1]>0) ? pool.fFirst[iev]+pool.fNPos[iev] : pool.fFirst[iev+1];
+        const Int_t n=last-first;
+        if (n<=0) continue;
+
+        //pair kinematics for all stored legs
+        fKernel.resize(6*n);
+        Double_t *kpx=&fKernel[0], *kpy=kpx+n, *kpz=kpy+n, *ke=kpz+n, *km2=ke+n, *kdot=km2+n;
+        const Float_t *p2x=&pool.fPx[first], *p2y=&pool.fPy[first], *p2z=&pool.fPz[first];
+        for (Int_t j=0; j<n; ++j){
+          const Double_t e2=TMath::Sqrt(p2x[j]*p2x[j]+p2y[j]*p2y[j]+p2z[j]*p2z[j]+m2*m2);
+          kpx[j]=p1x+p2x[j];
+          kpy[j]=p1y+p2y[j];
+          kpz[j]=p1z+p2z[j];
+          ke[j]=e1+e2;
+          kdot[j]=p1x*p2x[j]+p1y*p2y[j]+p1z*p2z[j];
+          km2[j]=m1*m1+m2*m2+2.*(e1*e2-kdot[j]);
+        }
+
+        for (Int_t j=0; j<n; ++j){
+          const Double_t pt2=kpx[j]*kpx[j]+kpy[j]*kpy[j];
+          const Double_t pt=TMath::Sqrt(pt2);
+          const Double_t p=TMath::Sqrt(pt2+kpz[j]*kpz[j]);
+          const Double_t l2x=p2x[j], l2y=p2y[j], l2z=p2z[j];
+          const Double_t legPt2=TMath::Sqrt(l2x*l2x+l2y*l2y);
+          const Double_t legP2=TMath::Sqrt(legPt2*legPt2+l2z*l2z);
+
+          values[AliDielectronVarManager::kPx]        = kpx[j];
+          values[AliDielectronVarManager::kPy]        = kpy[j];
+          values[AliDielectronVarManager::kPz]        = kpz[j];
+          values[AliDielectronVarManager::kPt]        = pt;
+          values[AliDielectronVarManager::kPtSq]      = pt2;
+          values[AliDielectronVarManager::kP]         = p;
+          values[AliDielectronVarManager::kOneOverPt] = (pt>1.0e-3 ? 1./pt : 0.0);
+          values[AliDielectronVarManager::kPhi]       = TVector2::Phi_0_2pi(TMath::ATan2(kpy[j],kpx[j]));
+          values[AliDielectronVarManager::kTheta]     = kpz[j]!=0 ? TMath::ATan(pt/kpz[j]) : 0.;
+          values[AliDielectronVarManager::kEta]       = (pt>0.) ? TMath::ASinH(kpz[j]/pt) : 0.;
+          values[AliDielectronVarManager::kY]         = (km2[j]>0.) ? 0.5*TMath::Log((ke[j]+kpz[j])/(ke[j]-kpz[j])) : -1111.;
+          values[AliDielectronVarManager::kE]         = ke[j];
+          values[AliDielectronVarManager::kM]         = (km2[j]>0.) ? TMath::Sqrt(km2[j]) : 0.;
+          values[AliDielectronVarManager::kCharge]    = comb[icomb][0]+comb[icomb][1];
+          values[AliDielectronVarManager::kPdgCode]   = 0;
+          values[AliDielectronVarManager::kRndm]      = gRandom->Rndm();
+          values[AliDielectronVarManager::kPairType]  = type;
+          values[AliDielectronVarManager::kOpeningAngle] = (p1>0. && legP2>0.) ? TMath::ACos(TMath::Max(-1.,TMath::Min(1.,kdot[j]/(p1*legP2)))) : 0.;
+          values[AliDielectronVarManager::kDeltaEta]  = TMath::Abs(eta1-((legPt2>0.) ? TMath::ASinH(l2z/legPt2) : 0.));
+          values[AliDielectronVarManager::kDeltaPhi]  = (pt1>0. && legPt2>0.) ? TMath::ACos(TMath::Max(-1.,TMath::Min(1.,(p1x*l2x+p1y*l2y)/(pt1*legPt2)))) : 0.;
+
+          //pair cuts
+          Bool_t selected=kTRUE;
+          for (Int_t icut=0; icut<nCuts && selected; ++icut)
+            selected=static_cast<AliDielectronVarCuts*>(pairCuts->At(icut))->IsSelected(values);
+          if (!selected) continue;
+
+          if (fillPair) diele->fHistos->FillClass(pairClass.Data(), AliDielectronVarManager::kNMaxValues, values);
+          if (!fillLeg) continue;
+
+          //legs of the current event with the full track information
+          if (!filledCurrent[type][offset1+itrack]){
+            filledCurrent[type][offset1+itrack]=1;
+            AliDielectronVarManager::Fill(track, legValues);
+            diele->fHistos->FillClass(legClass.Data(), AliDielectronVarManager::kNMaxValues, legValues);
+          }
+          //stored legs with the kinematics and the stored leg variables
+          if (!filledStored[type][first+j]){
+            filledStored[type][first+j]=1;
+            Double_t storedValues[AliDielectronVarManager::kNMaxValues]={0};
+            for (Int_t i=AliDielectronVarManager::kPairMax; i<AliDielectronVarManager::kNMaxValues; ++i) storedValues[i]=values[i];
+            storedValues[AliDielectronVarManager::kPx]        = l2x;
+            storedValues[AliDielectronVarManager::kPy]        = l2y;
+            storedValues[AliDielectronVarManager::kPz]        = l2z;
+            storedValues[AliDielectronVarManager::kPt]        = legPt2;
+            storedValues[AliDielectronVarManager::kPtSq]      = legPt2*legPt2;
+            storedValues[AliDielectronVarManager::kP]         = legP2;
+            storedValues[AliDielectronVarManager::kOneOverPt] = (legPt2>1.0e-3 ? 1./legPt2 : 0.0);
+            storedValues[AliDielectronVarManager::kPhi]       = TVector2::Phi_0_2pi(TMath::ATan2(l2y,l2x));
+            storedValues[AliDielectronVarManager::kTheta]     = (legP2>0.) ? TMath::ACos(l2z/legP2) : 0.;
+            storedValues[AliDielectronVarManager::kEta]       = (legPt2>0.) ? TMath::ASinH(l2z/legPt2) : 0.;
+            storedValues[AliDielectronVarManager::kCharge]    = comb[icomb][1];
+            for (Int_t ivar=0; ivar<fNLegVars; ++ivar) storedValues[fLegVars[ivar]]=pool.fValues[(first+j)*fNLegVars+ivar];
+            diele->fHistos->FillClass(legClass.Data(), AliDielectronVarManager::kNMaxValues, storedValues);
+          }
+        }
+      }
+    }
+  }
+}
+
 //______________________________________________
 Bool_t AliDielectronMixingHandler::MixRemaining(AliDielectron */*diele*/, Int_t /*ipool*/)
 {
@@ -442,6 +815,8 @@ void AliDielectronMixingHandler::Init(const AliDielectron *diele)
     fPID=TProcessID::AddProcessID();
   }
 
+  BuildAxisTables();
+
   AliDebug(10,values.Data());
 }
 
@@ -457,6 +832,22 @@ Int_t AliDielectronMixingHandler::GetNumberOfBins() const
   return size;
 }
 
+//______________________________________________
+void AliDielectronMixingHandler::BuildAxisTables()
+{
+  //
+  // copy the bin edges of all axes into one flat table for FindBin
+  //
+  fBinEdges.clear();
+  fAxisFirst.assign(1,0);
+  for (Int_t i=0; i<fAxes.GetEntriesFast(); ++i){
+    TVectorD *bins=static_cast<TVectorD*>(fAxes.At(i));
+    const Double_t *arr=bins->GetMatrixArray();
+    fBinEdges.insert(fBinEdges.end(),arr,arr+bins->GetNrows());
+    fAxisFirst.push_back(fBinEdges.size());
+  }
+}
+
 //______________________________________________
 Int_t AliDielectronMixingHandler::FindBin(const Double_t values[], TString *dim)
 {
@@ -470,18 +861,20 @@ Int_t AliDielectronMixingHandler::FindBin(const Double_t values[], TString *dim)
     if (dim) (*dim)="single bin";
     return 0;
   }
+  if ((Int_t)fAxisFirst.size()!=fAxes.GetEntriesFast()+1) BuildAxisTables();
+
   if (dim) (*dim)="";
   Int_t sizeAdd=1;
   Int_t bin=0;
   for (Int_t i=0; i<fAxes.GetEntriesFast(); ++i){
     Double_t val=values[fEventCuts[i]];
-    TVectorD *bins=static_cast<TVectorD*>(fAxes.At(i));
-    Int_t nRows=bins->GetNrows();
-    if ( (val<(*bins)[0]) || (val>(*bins)[nRows-1]) ) {
+    const Double_t *edges=&fBinEdges[fAxisFirst[i]];
+    Int_t nRows=fAxisFirst[i+1]-fAxisFirst[i];
+    if ( (val<edges[0]) || (val>edges[nRows-1]) ) {
       return -1;
     }
 
-    Int_t pos=TMath::BinarySearch(nRows,bins->GetMatrixArray(),val);
+    Int_t pos=TMath::BinarySearch(nRows,edges,val);
     bin+=sizeAdd*pos;
     if (dim) (*dim)+=Form("%s: %f (%d); ",AliDielectronVarManager::GetValueName(fEventCuts[i]),val,pos);
     sizeAdd*=(nRows-1);
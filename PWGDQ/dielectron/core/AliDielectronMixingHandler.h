@@ -13,9 +13,12 @@
 //#                                                           #
 //#############################################################
 
+#include <vector>
+
 #include <TNamed.h>
 #include <TObjArray.h>
 #include <TClonesArray.h>
+#include <TBits.h>
 
 #include "AliDielectronVarManager.h"
 
@@ -50,11 +53,15 @@ public:
   void SetMixUncomplete(Bool_t mix) { fMixIncomplete=mix; }
   Bool_t GetMixUncomplete() const { return fMixIncomplete; }
 
-  void SetMoveToSameVertex(Bool_t move) { fMoveToSameVertex=move; }
+  void SetMoveToSameVertex(Bool_t move) { fMoveToSameVertex=move; fCompactStatus=-1; }
   Bool_t GetMoveToSameVertex() const { return fMoveToSameVertex; }
 
   void SetSkipFirstEvent(Bool_t skip) { fSkipFirstEvt=skip; }
 
+  void SetCompactMixing(Bool_t compact) { fCompactMixing=compact; fCompactStatus=-1; }
+  Bool_t GetCompactMixing() const { return fCompactMixing; }
+  void AddLegVariable(AliDielectronVarManager::ValueTypes type);
+
   Int_t GetNumberOfBins() const;
   Int_t FindBin(const Double_t values[], TString *dim=0x0);
   void Fill(const AliVEvent *ev, AliDielectron *diele);
@@ -77,15 +84,42 @@ private:
   Bool_t fMoveToSameVertex; //whether to move the mixed tracks to the same vertex position
   Bool_t fSkipFirstEvt;   //whether to skip the first event in the pool
 
+  Bool_t   fCompactMixing;          // store only the leg kinematics and pair them directly
+  UShort_t fLegVars[kMaxCuts];      // additional leg variables stored in the compact pools
+  UShort_t fNLegVars;               // number of additional leg variables
+
   TProcessID *fPID;             //! internal PID for references to buffered objects
-  
+
+  // compact pool of one mixing bin, legs of the stored events in contiguous arrays
+  // (positive legs of an event first), oldest event first
+  struct CompactPool {
+    std::vector<Float_t> fPx;       // leg momenta
+    std::vector<Float_t> fPy;
+    std::vector<Float_t> fPz;
+    std::vector<Float_t> fValues;   // fNLegVars additional variables per leg
+    std::vector<Int_t>   fFirst;    // first leg of each stored event, size nEvents+1
+    std::vector<Int_t>   fNPos;     // number of positive legs of each stored event
+  };
+
+  std::vector<Double_t>    fBinEdges;      //! bin edges of all axes
+  std::vector<Int_t>       fAxisFirst;     //! first edge of each axis in fBinEdges, size nAxes+1
+  std::vector<CompactPool> fCompactPools;  //! compact pools of the mixing bins
+  Int_t                    fCompactStatus; //! compact mixing possible with the configuration: -1 not checked
+  TBits                    fLegVarMap;     //! fill map of the additional leg variables
+  std::vector<Double_t>    fKernel;        //! pair kinematics buffer of the mixing kernel
+
   void DoMixing(TClonesArray &pool, AliDielectron *diele);
+  void BuildAxisTables();
+  Bool_t CheckCompactMixing(AliDielectron *diele) const;
+  Int_t FindMissingVariable(const TObject *histClass, const TBits &available) const;
+  void FillCompact(Int_t bin, AliDielectron *diele);
+  void DoCompactMixing(const CompactPool &pool, AliDielectron *diele);
 
   AliDielectronMixingHandler(const AliDielectronMixingHandler &c);
   AliDielectronMixingHandler &operator=(const AliDielectronMixingHandler &c);
 
   
-  ClassDef(AliDielectronMixingHandler,1)         // Dielectron MixingHandler
+  ClassDef(AliDielectronMixingHandler,2)         // Dielectron MixingHandler
 };
 
 
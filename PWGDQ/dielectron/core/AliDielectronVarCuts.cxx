@@ -117,6 +117,20 @@ Bool_t AliDielectronVarCuts::IsSelected(TObject* track)
   Double_t values[AliDielectronVarManager::kNMaxValues];
   AliDielectronVarManager::SetFillMap(fUsedVars);
   AliDielectronVarManager::Fill(track,values);
+  return IsSelected(values);
+}
+
+//________________________________________________________________________
+Bool_t AliDielectronVarCuts::IsSelected(Double_t * const values)
+{
+  //
+  // Make cut decision on already filled values
+  //
+
+  //reset
+  fSelectedCutsMask=0;
+  SetSelected(kFALSE);
+
   Double_t opResultValue = 0.;
 
   for (Int_t iCut=0; iCut<fNActiveCuts; ++iCut){
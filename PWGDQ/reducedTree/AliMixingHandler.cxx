@@ -16,6 +16,7 @@ using std::endl;
 using std::flush;
 
 #include <TMath.h>
+#include <TObjArray.h>
 #include <TTimeStamp.h>
 #include <TRandom.h>
 
@@ -31,8 +32,12 @@ AliMixingHandler::AliMixingHandler() :
   fMixingThreshold(1.0),
   fDownscaleEvents(1.0),
   fDownscaleTracks(1.0),
-  fPoolsLeg1("TClonesArray"),
-  fPoolsLeg2("TClonesArray"),
+  fPools(),
+  fHistClasses(),
+  fPairM2(),
+  fPairPx(),
+  fPairPy(),
+  fPairPz(),
   fNParallelCuts(0),
   fHistClassNames(""),
   fPoolSize(),
@@ -66,8 +71,12 @@ AliMixingHandler::AliMixingHandler(const Char_t* name, const Char_t* title) :
   fMixingThreshold(1.0),
   fDownscaleEvents(1.0),
   fDownscaleTracks(1.0),
-  fPoolsLeg1("TClonesArray"),
-  fPoolsLeg2("TClonesArray"),
+  fPools(),
+  fHistClasses(),
+  fPairM2(),
+  fPairPx(),
+  fPairPy(),
+  fPairPz(),
   fNParallelCuts(0),
   fHistClassNames(""),
   fPoolSize(),
@@ -139,8 +148,10 @@ void AliMixingHandler::Init() {
     return;
   }
   Int_t size = (fCentralityLimits.GetSize()-1)*(fEventVertexLimits.GetSize()-1)*(fEventPlaneLimits.GetSize()-1);
-  fPoolsLeg1.Expand(size); fPoolsLeg1.SetOwner(kTRUE);
-  fPoolsLeg2.Expand(size); fPoolsLeg2.SetOwner(kTRUE);
+  fPools.assign(size, MixingPool());
+  fHistClasses.resize(histClassArr->GetEntries());
+  for(Int_t i=0;i<histClassArr->GetEntries();++i) fHistClasses[i] = histClassArr->At(i)->GetName();
+  delete histClassArr;
   
   fPoolSize.Set(fNParallelCuts*size);
   for(Int_t i=0;i<fNParallelCuts*size;++i) fPoolSize[i] = 0;
@@ -169,7 +180,8 @@ void AliMixingHandler::FillEvent(TList* leg1List, TList* leg2List, Float_t* valu
   // Fill the leg1 and leg2 lists in the appropriate category, based on the event 
   // characteristics (centrality, vtxz, ep)
   //
-  if(!fIsInitialized) Init();
+  if(!fIsInitialized || fPools.empty()) Init();
+  if(fPools.empty()) return;
   if(leg1List->GetEntries()==0 && leg2List->GetEntries()==0) return;
   
   // randomly accept/reject this event in case fDownscaleEvents is used
@@ -180,31 +192,31 @@ void AliMixingHandler::FillEvent(TList* leg1List, TList* leg2List, Float_t* valu
   Int_t category = FindEventCategory(values[fCentralityVariable], values[fEventVertexVariable], values[fEventPlaneVariable]);
   if(category<0) return;   // event characteristics outside the defined ranges
   
-  TClonesArray *leg1PoolP = static_cast<TClonesArray*>(fPoolsLeg1.At(category));
-  if(!leg1PoolP) leg1PoolP = new(fPoolsLeg1[category]) TClonesArray("TList",1);
-  leg1PoolP->SetOwner(kTRUE);
-  TClonesArray *leg2PoolP=static_cast<TClonesArray*>(fPoolsLeg2.At(category));
-  if(!leg2PoolP) leg2PoolP = new(fPoolsLeg2[category]) TClonesArray("TList",1);
-  leg2PoolP->SetOwner(kTRUE);
-  
-  TClonesArray &leg1Pool=*leg1PoolP;
-  TClonesArray &leg2Pool=*leg2PoolP;
-  
-  // add the leg lists to the appropriate pools
-  TList *list1 = new(leg1Pool[leg1Pool.GetEntries()]) TList();
-  TList *list2 = new(leg2Pool[leg2Pool.GetEntries()]) TList();
-  list1->SetOwner(kTRUE); list2->SetOwner(kTRUE);
-  for(Int_t it=0; it<leg1List->GetEntries(); ++it) 
-    list1->Add(leg1List->At(it)->Clone());
-  for(Int_t it=0; it<leg2List->GetEntries(); ++it) 
-    list2->Add(leg2List->At(it)->Clone());
+  // append the legs to the columns of the pool in this category
+  MixingPool& pool = fPools[category];
+  TList* legLists[2] = {leg1List, leg2List};
+  for(Int_t ileg=0; ileg<2; ++ileg) {
+    LegColumns& legs = pool.fLeg[ileg];
+    if(pool.fFirst[ileg].empty()) pool.fFirst[ileg].push_back(0);
+    TIter nextTrack(legLists[ileg]);
+    AliReducedBaseTrack* track=0x0;
+    while((track=(AliReducedBaseTrack*)nextTrack())) {
+      legs.fPx.push_back(track->Px());
+      legs.fPy.push_back(track->Py());
+      legs.fPz.push_back(track->Pz());
+      legs.fP2.push_back(track->P()*track->P());
+      legs.fCharge.push_back(track->Charge());
+      legs.fFlags.push_back(track->GetFlags());
+    }
+    pool.fFirst[ileg].push_back(legs.fFlags.size());
+  }
     
   // increment the size of the pools in this category
   ULong_t mixingMask = IncrementPoolSizes(leg1List,leg2List,category);
   
   // if full pool(s) were found then run the event mixing
   if(mixingMask) {
-    RunEventMixing(leg1PoolP,leg2PoolP,mixingMask,type,values);
+    RunEventMixing(pool,mixingMask,type,values);
     ResetPoolSizes(mixingMask,category);
   }
 }
@@ -357,11 +369,8 @@ void AliMixingHandler::RunLeftoverMixing(Int_t type) {
   for(Int_t i=0; i<fNParallelCuts; ++i) mixingMask |= (ULong_t(1)<<i);
   Float_t values[AliReducedVarManager::kNVars];
   
-  for(Int_t icateg=0; icateg<fPoolsLeg1.GetEntries(); ++icateg) {
-    TClonesArray *leg1Pool = static_cast<TClonesArray*>(fPoolsLeg1.At(icateg));
-    TClonesArray *leg2Pool = static_cast<TClonesArray*>(fPoolsLeg2.At(icateg));
-    if(!leg1Pool) continue;
-    if(!leg2Pool) continue;
+  for(Int_t icateg=0; icateg<(Int_t)fPools.size(); ++icateg) {
+    if(fPools[icateg].GetNEvents()==0) continue;
     Int_t centBin = GetCentralityBin(icateg);
     Int_t zBin = GetEventVertexBin(icateg);
     Int_t epBin = GetEventPlaneBin(icateg);
@@ -369,206 +378,148 @@ void AliMixingHandler::RunLeftoverMixing(Int_t type) {
     values[fCentralityVariable] = 0.5*(fCentralityLimits[centBin]+fCentralityLimits[centBin+1]);
     values[fEventVertexVariable] = 0.5*(fEventVertexLimits[zBin]+fEventVertexLimits[zBin+1]);
     values[fEventPlaneVariable] = 0.5*(fEventPlaneLimits[epBin]+fEventPlaneLimits[epBin+1]);
-    RunEventMixing(leg1Pool,leg2Pool,mixingMask,type,values);
+    RunEventMixing(fPools[icateg],mixingMask,type,values);
     ResetPoolSizes(mixingMask,icateg);
   }  // end loop over categories
 }
 
 
 //_________________________________________________________________________
-void AliMixingHandler::RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2Pool, ULong_t mixingMask,
-				      Int_t type, Float_t* values) {
+void AliMixingHandler::RunEventMixing(MixingPool& pool, ULong_t mixingMask, Int_t type, Float_t* values) {
   //
   // Run event mixing
   // NOTE: The mixingMask is a bit map with bits toggled for the pools which need mixing
   //       The type is the pair candidate type. It is used in AliReducedPairInfo::CandidateType, mainly to know which mass assumption to be made for the legs
+  //       Each leg is paired with the legs of all the other events in the pool, as the event loops
+  //       over ordered event pairs (iev1,iev2), iev1!=iev2, would do. Pairs are filled for all enabled cut bits at once.
   //
-  //cout << "AliMixingHandler::RunEventMixing for mask " << flush;
-  //AliReducedVarManager::PrintBits(mixingMask,fNParallelCuts);
-  //cout << ";  (cent/vtx/ep): " << values[fCentralityVariable] << "/"
-  //     << values[fEventVertexVariable] << "/" << values[fEventPlaneVariable] << endl;
-  
-  Int_t entries = leg1Pool->GetEntries();
-  if(entries<2) return;
-  
-  TObjArray* histClassArr = fHistClassNames.Tokenize(";");
-  
-  TIter iterEv1Leg1Pool(leg1Pool);
-  TIter iterEv1Leg2Pool(leg2Pool);
-  ULong_t testFlags1 = 0;
-  ULong_t testFlags2 = 0;
-  for(Int_t iev1=0; iev1<entries; ++iev1) {                            // first event loop
-    // get the lists of leg1 and leg2 tracks for the first event
-    TList* ev1Leg1List = (TList*)iterEv1Leg1Pool();
-    TList* ev1Leg2List = (TList*)iterEv1Leg2Pool();
-    //cout << "## iev1 " << iev1 << endl;
-    
-    TIter iterEv2Leg1Pool(leg1Pool);
-    TIter iterEv2Leg2Pool(leg2Pool);
-    for(Int_t iev2=0; iev2<entries; ++iev2) {                         // second event loop 
-      TList* ev2Leg1List = (TList*)iterEv2Leg1Pool();
-      TList* ev2Leg2List = (TList*)iterEv2Leg2Pool();
-      if(iev1==iev2) continue;
-      //cout << "#### iev2 " << iev2 << endl;
-      
-      //loop over the ev1-leg1 list
-      TIter iterLeg1(ev1Leg1List);
-      AliReducedBaseTrack* ev1Leg1=0x0;
-      while((ev1Leg1=(AliReducedBaseTrack*)iterLeg1())) {
-	// check that this track has at least one common bit with the mixing mask
-	testFlags1 = mixingMask & ev1Leg1->GetFlags();
-        //cout << "###### ev1Leg1 (p/px/testFlags1): " << ev1Leg1->P() << "/" << ev1Leg1->Px() << "/";
-        //AliReducedVarManager::PrintBits(testFlags1, fNParallelCuts); cout << endl;
-	if(!testFlags1) continue;
-	
-	//loop over the ev2-leg2 list 
-	TIter iterLeg2(ev2Leg2List);
-	AliReducedBaseTrack* ev2Leg2=0x0;
-	while((ev2Leg2=(AliReducedBaseTrack*)iterLeg2())) {
-	  // check that this track has at least one common bit with the mixing mask and with ev1-leg1
-	  testFlags2 = testFlags1 & ev2Leg2->GetFlags();
-          //cout << "###### ev2Leg2 (p/px/testFlags1): " << ev2Leg2->P() << "/" << ev2Leg2->Px() << "/";
-          //AliReducedVarManager::PrintBits(testFlags2, fNParallelCuts); cout << endl;
-	  if(!testFlags2) continue;
-	  
-	  // fill cross-pairs (leg1 - leg2) for the enabled bits
-	  AliReducedVarManager::FillPairInfoME(ev1Leg1, ev2Leg2, type, values);
-          //cout << "######## cross-pair (mass): " << values[AliReducedVarManager::kMass] << endl;
-	  for(Int_t ibit=0; ibit<fNParallelCuts; ++ibit) {
-            if((testFlags2)&(ULong_t(1)<<ibit)) 
-              fHistos->FillHistClass(histClassArr->At(ibit*3+1)->GetName(), values);
-          }  
-	}  // end loop over the ev2-leg2 list
-	
-	if(!fMixLikeSign) continue;
-	// loop over the ev2-leg1 list
-	TIter iterLeg1LS(ev2Leg1List);
-	AliReducedBaseTrack* ev2Leg1=0x0;
-	while((ev2Leg1=(AliReducedBaseTrack*)iterLeg1LS())) {
-	  // check that this track has at least one common bit with the mixing mask and with ev1-leg1
-	  testFlags2 = testFlags1 & ev2Leg1->GetFlags();
-          //cout << "###### ev2Leg1 (p/px/testFlags2): " << ev2Leg1->P() << "/" << ev2Leg1->Px() << "/";
-          //AliReducedVarManager::PrintBits(testFlags2, fNParallelCuts); cout << endl;
-	  if(!testFlags2) continue;
-	  
-	  // fill like-pairs (leg1 - leg1) for the enabled bits
-	  AliReducedVarManager::FillPairInfoME(ev1Leg1, ev2Leg1, type, values);
-          //cout << "######## like-pair leg1-leg1 (mass): " << values[AliReducedVarManager::kMass] << endl;
-	  for(Int_t ibit=0; ibit<fNParallelCuts; ++ibit) {
-            if((testFlags2)&(ULong_t(1)<<ibit)) 
-              fHistos->FillHistClass(histClassArr->At(ibit*3+0)->GetName(), values);
-          }  
-	}  // end loop over the ev2-leg1 list
-      }  // end loop over the ev1-leg1 list
-      
-      if(!fMixLikeSign) continue;
-      //loop over the ev1-leg2 list
-      TIter iterLeg2(ev1Leg2List);
-      AliReducedBaseTrack* ev1Leg2=0x0;
-      while((ev1Leg2=(AliReducedBaseTrack*)iterLeg2())) {
-	// check that this track has at least one common bit with the mixing mask
-	testFlags1 = mixingMask & ev1Leg2->GetFlags();
-        //cout << "###### ev1Leg2 (p/px/testFlags1): " << ev1Leg2->P() << "/" << ev1Leg2->Px() << "/";
-        //AliReducedVarManager::PrintBits(testFlags1, fNParallelCuts); cout << endl;
-	if(!testFlags1) continue;
-	
-	//loop over the ev2-leg2 list 
-	TIter iterLeg2LS(ev2Leg2List);
-	AliReducedBaseTrack* ev2Leg2=0x0;
-	while((ev2Leg2=(AliReducedBaseTrack*)iterLeg2LS())) {
-	  // check that this track has at least one common bit with the mixing mask and with ev1-leg1
-	  testFlags2 = testFlags1 & ev2Leg2->GetFlags();
-          //cout << "###### ev2Leg2 (p/px/testFlags2): " << ev2Leg2->P() << "/" << ev2Leg2->Px() << "/";
-          //AliReducedVarManager::PrintBits(testFlags2, fNParallelCuts); cout << endl;
-	  if(!testFlags2) continue;
-	  
-	  // fill like-pairs (leg2 - leg2) for the enabled bits
-	  AliReducedVarManager::FillPairInfoME(ev1Leg2, ev2Leg2, type, values);
-          //cout << "######## like-pair leg2-leg2 (mass): " << values[AliReducedVarManager::kMass] << endl;
-	  for(Int_t ibit=0; ibit<fNParallelCuts; ++ibit) {
-            if((testFlags2)&(ULong_t(1)<<ibit)) 
-              fHistos->FillHistClass(histClassArr->At(ibit*3+2)->GetName(), values);
-          }  
-	}  // end loop over the ev2-leg2 list
-      }  // end loop over the ev1-leg2 list
-    }  // end second event loop
-  }  // end first event loop
-  
-  // unset the mixing flags --------------------------------------
-  iterEv1Leg1Pool.Reset(); 
-  iterEv1Leg2Pool.Reset();
-  //cout << "Unsetting bits for which mixing was performed" << endl;
-  for(Int_t ie1=0; ie1<entries; ++ie1) {
-    TList* leg1List = (TList*)iterEv1Leg1Pool();        
-    TIter iterLeg1(leg1List);
-    AliReducedBaseTrack* track=0x0;
-    while((track=(AliReducedBaseTrack*)iterLeg1())) {
-      //cout << "leg1 p " << track->P() << "     " << flush; 
-      //AliReducedVarManager::PrintBits(track->GetFlags(),fNParallelCuts); cout << "/" << flush;
-      testFlags1 = mixingMask & track->GetFlags();
-      if(!testFlags1) {
-	//AliReducedVarManager::PrintBits(track->GetFlags(),fNParallelCuts); cout << endl;
-	continue;
-      }
-      for(UShort_t ibit=0; ibit<fNParallelCuts; ++ibit) {
-	if((testFlags1)&(ULong_t(1)<<ibit)) 
-	  track->UnsetFlag(ibit);
-      }
-      //AliReducedVarManager::PrintBits(track->GetFlags(),fNParallelCuts); cout << endl;
-    }  // end loop over the first leg list
-    
-    TList* leg2List = (TList*)iterEv1Leg2Pool();
-    TIter iterLeg2(leg2List);
-    while((track=(AliReducedBaseTrack*)iterLeg2())) {
-      //cout << "leg2 p " << track->P() << "     " << flush; 
-      //AliReducedVarManager::PrintBits(track->GetFlags(),fNParallelCuts); cout << "/" << flush;
-      testFlags1 = mixingMask & track->GetFlags();
-      if(!testFlags1) {
-	//AliReducedVarManager::PrintBits(track->GetFlags(),fNParallelCuts); cout << endl;
-	continue;
+  if(pool.GetNEvents()<2) return;
+
+  MixLegs(pool, 0, 1, 1, mixingMask, type, values);        // cross-pairs (leg1 - leg2)
+  if(fMixLikeSign) {
+    MixLegs(pool, 0, 0, 0, mixingMask, type, values);      // like-pairs (leg1 - leg1)
+    MixLegs(pool, 1, 1, 2, mixingMask, type, values);      // like-pairs (leg2 - leg2)
+  }
+
+  CompactPool(pool, mixingMask);
+}
+
+
+//_________________________________________________________________________
+void AliMixingHandler::MixLegs(const MixingPool& pool, Int_t leg1, Int_t leg2, Int_t histClass,
+                               ULong_t mixingMask, Int_t type, Float_t* values) {
+  //
+  // Pair the legs of column leg1 with the legs of column leg2 from all the other events and
+  // fill the histogram class histClass (0: leg1-leg1, 1: leg1-leg2, 2: leg2-leg2) of the enabled cuts
+  //
+  const LegColumns& legs1 = pool.fLeg[leg1];
+  const LegColumns& legs2 = pool.fLeg[leg2];
+  const Int_t nLegs2 = legs2.fFlags.size();
+  if(nLegs2==0) return;
+  if((Int_t)fPairM2.size()<nLegs2) {
+    fPairM2.resize(nLegs2); fPairPx.resize(nLegs2); fPairPy.resize(nLegs2); fPairPz.resize(nLegs2);
+  }
+
+  Float_t m1 = 0.0; Float_t m2 = 0.0;
+  AliReducedVarManager::GetLegMassAssumption(type,m1,m2);
+  const Double_t m1Sq = m1*m1;
+  const Double_t m2Sq = m2*m2;
+
+  const Float_t* px2 = &legs2.fPx[0];
+  const Float_t* py2 = &legs2.fPy[0];
+  const Float_t* pz2 = &legs2.fPz[0];
+  const Float_t* p2Sq = &legs2.fP2[0];
+  const ULong_t* flags2 = &legs2.fFlags[0];
+  Double_t* pairM2 = &fPairM2[0];
+  Float_t* pairPx = &fPairPx[0];
+  Float_t* pairPy = &fPairPy[0];
+  Float_t* pairPz = &fPairPz[0];
+
+  const Int_t nEvents = pool.GetNEvents();
+  for(Int_t iev=0; iev<nEvents; ++iev) {
+    // the legs of this event are skipped in the second column
+    const Int_t skipBegin = pool.fFirst[leg2][iev];
+    const Int_t skipEnd = pool.fFirst[leg2][iev+1];
+
+    for(Int_t i=pool.fFirst[leg1][iev]; i<pool.fFirst[leg1][iev+1]; ++i) {
+      const ULong_t testFlags1 = mixingMask & legs1.fFlags[i];
+      if(!testFlags1) continue;
+
+      // pair kinematics with all the legs of the second column, without branches
+      const Float_t px1 = legs1.fPx[i];
+      const Float_t py1 = legs1.fPy[i];
+      const Float_t pz1 = legs1.fPz[i];
+      const Double_t e1 = TMath::Sqrt(m1Sq+legs1.fP2[i]);
+      for(Int_t j=0; j<nLegs2; ++j) {
+        pairM2[j] = m1Sq + m2Sq + 2.0*(e1*TMath::Sqrt(m2Sq+p2Sq[j]) - px1*px2[j] - py1*py2[j] - pz1*pz2[j]);
+        pairPx[j] = px1 + px2[j];
+        pairPy[j] = py1 + py2[j];
+        pairPz[j] = pz1 + pz2[j];
       }
-      for(UShort_t ibit=0; ibit<fNParallelCuts; ++ibit) {
-	if((testFlags1)&(ULong_t(1)<<ibit)) 
-	  track->UnsetFlag(ibit);
+
+      // fill the pairs which have at least one enabled cut bit in common
+      const Int_t charge1 = legs1.fCharge[i];
+      for(Int_t irange=0; irange<2; ++irange) {
+        const Int_t jBegin = (irange==0 ? 0 : skipEnd);
+        const Int_t jEnd = (irange==0 ? skipBegin : nLegs2);
+        for(Int_t j=jBegin; j<jEnd; ++j) {
+          const ULong_t testFlags2 = testFlags1 & flags2[j];
+          if(!testFlags2) continue;
+
+          const Int_t charge2 = legs2.fCharge[j];
+          Int_t pairType = 2;
+          if(charge1*charge2<0) pairType = 1;
+          else if(charge1>0)    pairType = 0;
+          AliReducedVarManager::FillPairInfoME(pairPx[j], pairPy[j], pairPz[j],
+                                               (pairM2[j]>0.0 ? TMath::Sqrt(pairM2[j]) : 0.0), pairType, type, values);
+          for(Int_t ibit=0; ibit<fNParallelCuts; ++ibit) {
+            if(testFlags2&(ULong_t(1)<<ibit))
+              fHistos->FillHistClass(fHistClasses[ibit*3+histClass].Data(), values);
+          }
+        }  // end loop over the legs of the other events
       }
-      //AliReducedVarManager::PrintBits(track->GetFlags(),fNParallelCuts); cout << endl;
-    }  // end loop over the second leg list
+    }  // end loop over the legs of this event
   }  // end loop over events
-  
-  // clean the tracks which don't have enabled mixing flags anymore
-  AliReducedBaseTrack* track=0x0;
-  // leg1 lists
-  iterEv1Leg1Pool.Reset(); TList* leg1List=0x0;
-  while((leg1List=(TList*)iterEv1Leg1Pool())) {
-    TIter iterLeg1(leg1List);
-    while((track=(AliReducedBaseTrack*)iterLeg1())) {
-      //AliReducedVarManager::PrintBits(track->GetFlags(),fNParallelCuts); cout << flush;
-      if(!track->GetFlags()) {
-         leg1List->Remove(track); delete track;
-      }
-    }
-  }  // end while
-  // leg2 lists
-  iterEv1Leg2Pool.Reset(); TList* leg2List=0x0;
-  while((leg2List=(TList*)iterEv1Leg2Pool())) {  
-    TIter iterLeg2(leg2List);
-    while((track=(AliReducedBaseTrack*)iterLeg2())) {
-      //AliReducedVarManager::PrintBits(track->GetFlags(),fNParallelCuts); cout << flush;
-      if(!track->GetFlags()) {
-         leg2List->Remove(track); delete track;
+}
+
+
+//_________________________________________________________________________
+void AliMixingHandler::CompactPool(MixingPool& pool, ULong_t mixingMask) {
+  //
+  // Unset the cut bits for which mixing was performed, remove the legs without enabled
+  // mixing bits left and the events without any legs left. The columns are compacted in place
+  //
+  const Int_t nEvents = pool.GetNEvents();
+  std::vector<Int_t> nKept[2];
+  for(Int_t ileg=0; ileg<2; ++ileg) {
+    LegColumns& legs = pool.fLeg[ileg];
+    std::vector<Int_t>& first = pool.fFirst[ileg];
+    nKept[ileg].assign(nEvents, 0);
+    Int_t n = 0;
+    for(Int_t iev=0; iev<nEvents; ++iev) {
+      for(Int_t i=first[iev]; i<first[iev+1]; ++i) {
+        const ULong_t flags = legs.fFlags[i] & ~mixingMask;
+        if(!flags) continue;
+        legs.fPx[n] = legs.fPx[i];
+        legs.fPy[n] = legs.fPy[i];
+        legs.fPz[n] = legs.fPz[i];
+        legs.fP2[n] = legs.fP2[i];
+        legs.fCharge[n] = legs.fCharge[i];
+        legs.fFlags[n] = flags;
+        ++n;
+        ++nKept[ileg][iev];
       }
     }
-  }  // end while
-  
-  // clean the events without any tracks left
-  for(Int_t i=leg1Pool->GetEntries()-1;i>=0;--i) {
-    leg1List=(TList*)leg1Pool->At(i);
-    leg2List=(TList*)leg2Pool->At(i);
-    if(leg1List->GetEntries()==0 && 
-       leg2List->GetEntries()==0) {
-       leg1Pool->RemoveAt(i); leg1Pool->Compress(); //delete leg1List;
-       leg2Pool->RemoveAt(i); leg2Pool->Compress(); //delete leg2List;
-    }
+    legs.fPx.resize(n); legs.fPy.resize(n); legs.fPz.resize(n);
+    legs.fP2.resize(n); legs.fCharge.resize(n); legs.fFlags.resize(n);
+  }
+
+  // rebuild the event offsets, skipping the events without any legs left
+  for(Int_t ileg=0; ileg<2; ++ileg) pool.fFirst[ileg].assign(1, 0);
+  for(Int_t iev=0; iev<nEvents; ++iev) {
+    if(nKept[0][iev]==0 && nKept[1][iev]==0) continue;
+    for(Int_t ileg=0; ileg<2; ++ileg)
+      pool.fFirst[ileg].push_back(pool.fFirst[ileg].back()+nKept[ileg][iev]);
   }
 }
 
@@ -626,41 +577,23 @@ void AliMixingHandler::PrintMixingLists(Int_t debugLevel) {
 	cout << endl;
 	if(debugLevel<2) continue;
 	
-	TClonesArray *leg1PoolP = static_cast<TClonesArray*>(fPoolsLeg1.At(evCategory));
-	if(!leg1PoolP) continue;
-        TClonesArray &leg1Pool=*leg1PoolP;
-	TClonesArray *leg2PoolP = static_cast<TClonesArray*>(fPoolsLeg2.At(evCategory));
-	
-        TIter iterLeg1Pool(leg1PoolP);
-	TIter iterLeg2Pool(leg2PoolP);
-	for(Int_t iev=0; iev<leg1Pool.GetEntries(); ++iev) {
-	  TList* leg1List = (TList*)iterLeg1Pool();
-	  TList* leg2List = (TList*)iterLeg2Pool();
+	const MixingPool& pool = fPools[evCategory];
+	for(Int_t iev=0; iev<pool.GetNEvents(); ++iev) {
 	  cout << "	Event #" << iev << ";  No. of tracks (leg1/leg2) :: " 
-	       << leg1List->GetEntries() << " / " << leg2List->GetEntries() << endl;
+	       << pool.fFirst[0][iev+1]-pool.fFirst[0][iev] << " / " << pool.fFirst[1][iev+1]-pool.fFirst[1][iev] << endl;
 	  if(debugLevel<3) continue;
 	  
-	  TIter iterLeg1List(leg1List);
-	  cout << "		Leg1 list" << endl;
-	  for(Int_t itrack=0; itrack<leg1List->GetEntries(); ++itrack) {
-	    track = (AliReducedBaseTrack*)iterLeg1List();
-	    cout << "		track #" << itrack << " (p/px/py/pz/charge/flags) :: "
-	         << track->P() << " / " << track->Px() << " / " 
-                 << track->Py() << " / " << track->Pz() << "/" << track->Charge() << " / " << flush;
-	    AliReducedVarManager::PrintBits(track->GetFlags(), fNParallelCuts);	 
-	    cout << endl;
-	  }  // end loop over tracks
-	  
-	  TIter iterLeg2List(leg2List);
-	  cout << "		Leg2 list" << endl;
-	  for(Int_t itrack=0; itrack<leg2List->GetEntries(); ++itrack) {
-	    track = (AliReducedBaseTrack*)iterLeg2List();
-	    cout << "		track #" << itrack << " (p/px/py/pz/charge/flags) :: "
-	         << track->P() << " / " << track->Px() << " / " 
-                 << track->Py() << " / " << track->Pz() << "/" << track->Charge() << " / " << flush;
-	    AliReducedVarManager::PrintBits(track->GetFlags(), fNParallelCuts);	 
-	    cout << endl;
-	  }  // end loop over tracks
+	  for(Int_t ileg=0; ileg<2; ++ileg) {
+	    const LegColumns& legs = pool.fLeg[ileg];
+	    cout << "		Leg" << ileg+1 << " list" << endl;
+	    for(Int_t itrack=pool.fFirst[ileg][iev]; itrack<pool.fFirst[ileg][iev+1]; ++itrack) {
+	      cout << "		track #" << itrack-pool.fFirst[ileg][iev] << " (p/px/py/pz/charge/flags) :: "
+	           << TMath::Sqrt(legs.fP2[itrack]) << " / " << legs.fPx[itrack] << " / " 
+                   << legs.fPy[itrack] << " / " << legs.fPz[itrack] << "/" << Int_t(legs.fCharge[itrack]) << " / " << flush;
+	      AliReducedVarManager::PrintBits(legs.fFlags[itrack], fNParallelCuts);	 
+	      cout << endl;
+	    }  // end loop over tracks
+	  }  // end loop over legs
 	  
 	}  // end loop over events
       }  // end loop over event plane intervals
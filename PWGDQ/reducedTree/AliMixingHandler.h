@@ -7,10 +7,11 @@
 #ifndef ALIMIXINGHANDLER_H
 #define ALIMIXINGHANDLER_H
 
+#include <vector>
+
 #include <TNamed.h>
 #include <TArrayF.h>
 #include <TArrayI.h>
-#include <TClonesArray.h>
 #include <TList.h>
 #include <TString.h>
 
@@ -68,8 +69,28 @@ private:
   Float_t fDownscaleEvents;      // random downscale adding events to the pools
   Float_t fDownscaleTracks;      // random downscale adding tracks fo the pools
   
-  TClonesArray fPoolsLeg1;         // array of pools
-  TClonesArray fPoolsLeg2;         // array of pools
+  // Pool of one event category: the legs of the stored events are kept as flat columns,
+  // the legs of event i of leg list k are the entries [fFirst[k][i],fFirst[k][i+1]) of fLeg[k]
+  struct LegColumns {
+    std::vector<Float_t> fPx;      // momentum components
+    std::vector<Float_t> fPy;
+    std::vector<Float_t> fPz;
+    std::vector<Float_t> fP2;      // squared momentum
+    std::vector<Char_t>  fCharge;  // charge
+    std::vector<ULong_t> fFlags;   // cut bits still enabled for mixing
+  };
+  struct MixingPool {
+    LegColumns fLeg[2];            // leg1 and leg2 columns
+    std::vector<Int_t> fFirst[2];  // first entry of each event in the leg columns, size nEvents+1
+    Int_t GetNEvents() const {return (fFirst[0].empty() ? 0 : fFirst[0].size()-1);}
+  };
+  
+  std::vector<MixingPool> fPools;  //! pools of the event categories
+  std::vector<TString> fHistClasses; //! histogram class names, 3 per cut
+  std::vector<Double_t> fPairM2;   //! squared mass of the pairs of one leg, scratch for the pair kernel
+  std::vector<Float_t> fPairPx;    //! pair momentum components, scratch for the pair kernel
+  std::vector<Float_t> fPairPy;    //!
+  std::vector<Float_t> fPairPz;    //!
   Int_t fNParallelCuts;            // number of parallel cuts which are run
   TString fHistClassNames;         // name of the histogram classes for each cut, separated by a semicolon ";"
   TArrayI fPoolSize;               // counters for the pool sizes
@@ -85,11 +106,13 @@ private:
   
   AliHistogramManager* fHistos;    // histogram manager
   
-  void RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2Pool, ULong_t mixingMask, Int_t type, Float_t* values);
+  void RunEventMixing(MixingPool& pool, ULong_t mixingMask, Int_t type, Float_t* values);
+  void MixLegs(const MixingPool& pool, Int_t leg1, Int_t leg2, Int_t histClass, ULong_t mixingMask, Int_t type, Float_t* values);
+  void CompactPool(MixingPool& pool, ULong_t mixingMask);
   ULong_t IncrementPoolSizes(TList* list1, TList* list2, Int_t eventCategory);
   void ResetPoolSizes(ULong_t mixingMask, Int_t category);  
   
-  ClassDef(AliMixingHandler,1);
+  ClassDef(AliMixingHandler,2);
 };
 
 #endif
@@ -1582,6 +1582,42 @@ void AliReducedVarManager::FillPairInfoME(BASETRACK* t1, BASETRACK* t2, Int_t ty
 }
 
 
+//_________________________________________________________________
+void AliReducedVarManager::FillPairInfoME(Float_t px, Float_t py, Float_t pz, Float_t mass, Int_t pairType, Int_t type, Float_t* values) {
+  //
+  // Fill pair information from the pair momentum and invariant mass computed outside,
+  // e.g. by the event mixing handler working on flat arrays of leg momenta.
+  // Fills the same variables as FillPairInfoME(track, track, type, values)
+  // pairType - 0 for ++, 1 for +- and 2 for -- pairs
+  //
+  PAIR p;
+  p.PxPyPz(px, py, pz);
+  p.CandidateId(type);
+  p.PairType(pairType);
+  values[kPairType] = pairType;
+  values[kCandidateId] = type;
+  values[kPairChisquare] = -999.;
+  
+  if(fgUsedVars[kMass]) {
+    values[kMass] = mass;
+    p.SetMass(mass);
+  }
+  
+  values[kPx] = px;
+  values[kPy] = py;
+  values[kPz] = pz;
+  if(fgUsedVars[kPt] || fgUsedVars[kPtSquared]) {
+    values[kPt] = p.Pt();
+    if(fgUsedVars[kPtSquared]) values[kPtSquared] = values[kPt]*values[kPt];
+  }
+  if(fgUsedVars[kP]) values[kP] = p.P();
+  if(fgUsedVars[kEta]) values[kEta] = p.Eta();
+  if(fgUsedVars[kRap]) values[kRap] = p.Rapidity();
+  if(fgUsedVars[kPhi]) values[kPhi] = p.Phi();
+  if(fgUsedVars[kTheta]) values[kTheta] = p.Theta();
+}
+
+
 //_________________________________________________________________
 void AliReducedVarManager::FillPairInfo(PAIR* t1, BASETRACK* t2, Int_t type, Float_t* values) {
   //
@@ -84,6 +84,7 @@ fMomDaugh1(),                     fMomDaugh2(),
 fTrackVector(),                   fProdVertex(),
 fCluster(0),                      fClustersArr(0),                          
 fIsExoticTrigger(0),              fClusterExoticity(1),
+fPerpConeR(),                     fPerpConePt(),                            fPerpConeIndex(),
 // Histograms
 fhEIso(0),                        fhPtIso(0),
 fhPtCentralityIso(0),             fhPtEventPlaneIso(0),
@@ -7745,13 +7746,71 @@ void  AliAnaParticleIsolation::MakeSeveralICAnalysis(AliAODPWG4ParticleCorrelati
   if(GetReader()->GetDataType() != AliCaloTrackReader::kMC)
     GetReader()->GetVertex(vertex);
   
-  // Loop on cone sizes
+  // Recover reference arrays with clusters and tracks
+  TObjArray * refclusters = ph->GetObjArray(GetAODObjArrayName()+"Clusters");
+  TObjArray * reftracks   = ph->GetObjArray(GetAODObjArrayName()+"Tracks");
+  
+  // Sort the particles in cone by distance to the candidate once, cone sum and
+  // leading pT for all cone sizes and thresholds are then obtained without new loops.
+  // The background subtracted method needs the UE bands, done per cone size below.
+  Bool_t sortedCone = (GetIsolationCut()->GetICMethod() != AliIsolationCut::kSumBkgSubIC);
+  if(sortedCone)
+    GetIsolationCut()->MakeSortedConeParticleList(reftracks, refclusters,
+                                                  GetReader(), GetCaloPID(), ph);
+  
+  // Distance of tracks to the perpendicular cones axis, sorted, same for all cone sizes
+  Int_t nPerp = 0;
+  Float_t maxConeSize = 0;
   for(Int_t icone = 0; icone<fNCones; icone++)
   {
-    // Recover reference arrays with clusters and tracks
-    TObjArray * refclusters = ph->GetObjArray(GetAODObjArrayName()+"Clusters");
-    TObjArray * reftracks   = ph->GetObjArray(GetAODObjArrayName()+"Tracks");
+    if(fConeSizes[icone] > maxConeSize) maxConeSize = fConeSizes[icone];
+  }
+  
+  TObjArray * trackList   = GetCTSTracks() ;
+  if(fPerpConeR.GetSize() < 2*trackList->GetEntriesFast())
+  {
+    fPerpConeR    .Set(2*trackList->GetEntriesFast());
+    fPerpConePt   .Set(2*trackList->GetEntriesFast());
+    fPerpConeIndex.Set(2*trackList->GetEntriesFast());
+  }
+  
+  for(Int_t itrack=0; itrack < trackList->GetEntriesFast(); itrack++)
+  {
+    AliVTrack* track = (AliVTrack *) trackList->At(itrack);
+    //fill the histograms at forward range
+    if(!track)
+    {
+      AliDebug(1,"Track not available?");
+      continue;
+    }
     
+    Double_t dPhi = phiC - track->Phi() + TMath::PiOver2();
+    Double_t dEta = etaC - track->Eta();
+    Double_t arg  = dPhi*dPhi + dEta*dEta;
+    Double_t pTrack = TMath::Sqrt(track->Px()*track->Px()+track->Py()*track->Py());
+    
+    if(TMath::Sqrt(arg) < maxConeSize)
+    {
+      fPerpConeR [nPerp] = TMath::Sqrt(arg);
+      fPerpConePt[nPerp] = pTrack;
+      nPerp++;
+    }
+    
+    dPhi = phiC - track->Phi() - TMath::PiOver2();
+    arg  = dPhi*dPhi + dEta*dEta;
+    if(TMath::Sqrt(arg) < maxConeSize)
+    {
+      fPerpConeR [nPerp] = TMath::Sqrt(arg);
+      fPerpConePt[nPerp] = pTrack;
+      nPerp++;
+    }
+  }
+  
+  if(nPerp > 0) TMath::Sort(nPerp, fPerpConeR.GetArray(), fPerpConeIndex.GetArray(), kFALSE);
+  
+  // Loop on cone sizes
+  for(Int_t icone = 0; icone<fNCones; icone++)
+  {
     //If too small or too large pt, skip
     if(ptC < GetMinPt() || ptC > GetMaxPt() ) continue ;
     
@@ -7770,35 +7829,14 @@ void  AliAnaParticleIsolation::MakeSeveralICAnalysis(AliAODPWG4ParticleCorrelati
     
     // Tracks in perpendicular cones
     Double_t sumptPerp = 0. ;
-    TObjArray * trackList   = GetCTSTracks() ;
-    for(Int_t itrack=0; itrack < trackList->GetEntriesFast(); itrack++)
+    for(Int_t iperp = 0; iperp < nPerp; iperp++)
     {
-      AliVTrack* track = (AliVTrack *) trackList->At(itrack);
-      //fill the histograms at forward range
-      if(!track)
-      {
-        AliDebug(1,"Track not available?");
-        continue;
-      }
+      Int_t index = fPerpConeIndex[iperp];
       
-      Double_t dPhi = phiC - track->Phi() + TMath::PiOver2();
-      Double_t dEta = etaC - track->Eta();
-      Double_t arg  = dPhi*dPhi + dEta*dEta;
-      Double_t pTrack = TMath::Sqrt(track->Px()*track->Px()+track->Py()*track->Py());
-        
-      if(TMath::Sqrt(arg) < fConeSizes[icone])
-      {
-        fhPerpPtLeadingPt[icone]->Fill(ptC, pTrack, GetEventWeight());
-        sumptPerp+=track->Pt();
-      }
+      if(fPerpConeR[index] >= fConeSizes[icone]) break;
       
-      dPhi = phiC - track->Phi() - TMath::PiOver2();
-      arg  = dPhi*dPhi + dEta*dEta;
-      if(TMath::Sqrt(arg) < fConeSizes[icone])
-      {
-        fhPerpPtLeadingPt[icone]->Fill(ptC, pTrack, GetEventWeight());
-        sumptPerp+=track->Pt();
-      }
+      fhPerpPtLeadingPt[icone]->Fill(ptC, fPerpConePt[index], GetEventWeight());
+      sumptPerp+=fPerpConePt[index];
     }
     
     fhPerpSumPtLeadingPt[icone]->Fill(ptC, sumptPerp, GetEventWeight());
@@ -7855,6 +7893,13 @@ void  AliAnaParticleIsolation::MakeSeveralICAnalysis(AliAODPWG4ParticleCorrelati
     
     ///////////////////
     
+    // Cone content does not depend on the thresholds, get it once per cone size
+    if(sortedCone)
+      GetIsolationCut()->GetSortedConeSumAndLeading(fConeSizes[icone], coneptsum, coneptlead);
+    
+    // Good cell density depends only on the cone size
+    Float_t cellDensity = GetIsolationCut()->GetCellDensity( ph, GetReader());
+    
     //Loop on pt thresholds
     for(Int_t ipt = 0; ipt < fNPtThresFrac ; ipt++)
     {
@@ -7864,11 +7909,14 @@ void  AliAnaParticleIsolation::MakeSeveralICAnalysis(AliAODPWG4ParticleCorrelati
       GetIsolationCut()->SetPtFraction(fPtFractions[ipt]) ;
       GetIsolationCut()->SetSumPtThreshold(fSumPtThresholds[ipt]);
       
-      GetIsolationCut()->MakeIsolationCut(reftracks, refclusters,
-                                          GetReader(), GetCaloPID(),
-                                          kFALSE, ph, "",
-                                          n[icone][ipt],nfrac[icone][ipt],
-                                          coneptsum, coneptlead, isolated);
+      if(sortedCone)
+        GetIsolationCut()->GetNAboveThresholds(ptC, coneptlead, n[icone][ipt], nfrac[icone][ipt]);
+      else
+        GetIsolationCut()->MakeIsolationCut(reftracks, refclusters,
+                                            GetReader(), GetCaloPID(),
+                                            kFALSE, ph, "",
+                                            n[icone][ipt],nfrac[icone][ipt],
+                                            coneptsum, coneptlead, isolated);
       
       // Normal pT threshold cut
       
@@ -7995,7 +8043,6 @@ void  AliAnaParticleIsolation::MakeSeveralICAnalysis(AliAODPWG4ParticleCorrelati
       }
       
       // density method
-      Float_t cellDensity = GetIsolationCut()->GetCellDensity( ph, GetReader());
       if(coneptsum < fSumPtThresholds[ipt]*cellDensity)
       {
         AliDebug(1,"Filling density loop");
@@ -27,6 +27,8 @@ class TH2F;
 class TH3F;
 class TList ;
 class TObjString;
+#include <TArrayF.h>
+#include <TArrayI.h>
 
 // --- ANALYSIS system ---
 #include "AliAnaCaloTrackCorrBaseClass.h"
@@ -308,6 +310,9 @@ class AliAnaParticleIsolation : public AliAnaCaloTrackCorrBaseClass {
   TObjArray  *   fClustersArr;                        //!<! Temporary ClustersArray, avoid creation per event.
   Bool_t         fIsExoticTrigger;                    //!<! Trigger cluster considered as exotic
   Float_t        fClusterExoticity;                   //!<! Temporary container or currently analyzed cluster exoticity
+  TArrayF        fPerpConeR;                          //!<! Temporary distance of tracks to perpendicular cones axis, several IC analysis.
+  TArrayF        fPerpConePt;                         //!<! Temporary pT of tracks in perpendicular cones, several IC analysis.
+  TArrayI        fPerpConeIndex;                      //!<! Temporary sorting index of tracks in perpendicular cones, several IC analysis.
 
   //Histograms  
   
@@ -848,7 +853,7 @@ class AliAnaParticleIsolation : public AliAnaCaloTrackCorrBaseClass {
   AliAnaParticleIsolation & operator = (const AliAnaParticleIsolation & iso) ;
   
   /// \cond CLASSIMP
-  ClassDef(AliAnaParticleIsolation,39) ;
+  ClassDef(AliAnaParticleIsolation,40) ;
   /// \endcond
 
 } ;
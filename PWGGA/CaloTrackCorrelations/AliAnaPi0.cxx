@@ -52,7 +52,9 @@ ClassImp(AliAnaPi0) ;
 /// Default Constructor. Initialized parameters with default values.
 //______________________________________________________
 AliAnaPi0::AliAnaPi0() : AliAnaCaloTrackCorrBaseClass(),
-fEventsList(0x0),
+fMixPools(),
+fMixPairM(),                 fMixPairPt(),                 fMixPairE(),                  fMixPairAsym(),
+fMixPairAngle(),
 fNModules(22),
 fUseAngleCut(kFALSE),        fUseAngleEDepCut(kFALSE),     fAngleCut(0),                 fAngleMaxCut(0.),
 fMultiCutAna(kFALSE),        fMultiCutAnaSim(kFALSE),      fMultiCutAnaAcc(kFALSE),
@@ -226,24 +228,7 @@ fhReSecondaryCellOutTimeWindow(0), fhMiSecondaryCellOutTimeWindow(0)
 //_____________________
 AliAnaPi0::~AliAnaPi0()
 {
-  // Remove event containers
-  
-  if(DoOwnMix() && fEventsList)
-  {
-    for(Int_t ic=0; ic<GetNCentrBin(); ic++)
-    {
-      for(Int_t iz=0; iz<GetNZvertBin(); iz++)
-      {
-        for(Int_t irp=0; irp<GetNRPBin(); irp++)
-        {
-          Int_t bin = GetEventMixBin(ic,iz,irp);
-          fEventsList[bin]->Delete() ;
-          delete fEventsList[bin] ;
-        }
-      }
-    }
-    delete[] fEventsList;
-  }
+  // Event containers are vectors, deleted with the object
 }
 
 //______________________________
@@ -785,19 +770,17 @@ TList * AliAnaPi0::GetCreateOutputObjects()
   //
   // Create mixed event containers
   //
-  fEventsList = new TList*[GetNCentrBin()*GetNZvertBin()*GetNRPBin()] ;
+  // As many slots as events kept in the previous list implementation: GetNMaxEvMix()-1
+  Int_t nSlots = GetNMaxEvMix()-1;
+  if(nSlots < 0) nSlots = 0;
   
-  for(Int_t ic=0; ic<GetNCentrBin(); ic++)
+  fMixPools.clear();
+  fMixPools.resize(GetNCentrBin()*GetNZvertBin()*GetNRPBin());
+  for(UInt_t bin = 0; bin < fMixPools.size(); bin++)
   {
-    for(Int_t iz=0; iz<GetNZvertBin(); iz++)
-    {
-      for(Int_t irp=0; irp<GetNRPBin(); irp++)
-      {
-        Int_t bin = GetEventMixBin(ic,iz,irp);
-        fEventsList[bin] = new TList() ;
-        fEventsList[bin]->SetOwner(kFALSE);
-      }
-    }
+    fMixPools[bin].fEvents.resize(nSlots);
+    fMixPools[bin].fNewest  = -1;
+    fMixPools[bin].fNStored =  0;
   }
   
   // Init the number of modules, set in the class AliCalorimeterUtils
@@ -4242,24 +4225,27 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
     // Check that the bin exists, if not (bad determination of RP, centrality or vz bin) do nothing
     if(eventbin < 0) return ;
     
-    TList * evMixList=fEventsList[eventbin] ;
-    
-    if(!evMixList)
+    if(eventbin >= (Int_t) fMixPools.size())
     {
-      AliWarning(Form("Mix event list not available, bin %d",eventbin));
+      AliWarning(Form("Mix event pool not available, bin %d",eventbin));
       return;
     }
     
-    Int_t nMixed = evMixList->GetSize() ;
-    for(Int_t ii=0; ii<nMixed; ii++)
+    MixedEventPool & pool = fMixPools[eventbin] ;
+    
+    Int_t nSlots = pool.fEvents.size() ;
+    for(Int_t ii=0; ii<pool.fNStored; ii++)
     {
-      TClonesArray* ev2= (TClonesArray*) (evMixList->At(ii));
-      Int_t nPhot2=ev2->GetEntriesFast() ;
+      // From the newest to the oldest stored event
+      const MixedEventPhotons & ev2 = pool.fEvents[(pool.fNewest-ii+nSlots)%nSlots];
+      Int_t nPhot2=ev2.GetEntries() ;
       Double_t m = -999;
       AliDebug(1,Form("Mixed event %d photon entries %d, centrality bin %d",ii, nPhot2, GetEventCentralityBin()));
       
       fhEventMixBin->Fill(eventbin, GetEventWeight()) ;
       
+      if(nPhot2 == 0) continue;
+      
       //---------------------------------
       // First loop on photons/clusters
       //---------------------------------
@@ -4277,27 +4263,35 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
         fPhotonMom1.SetPxPyPzE(p1->Px(),p1->Py(),p1->Pz(),p1->E());
         module1 = GetModuleNumber(p1);
         
+        Float_t phi1   = GetPhi(fPhotonMom1.Phi());
+        Float_t eta1   = fPhotonMom1.Eta();
+        Int_t   ncell1 = p1->GetNCells();
+        Int_t   ncell2 = p1->GetNCells();
+        
+        UInt_t pid1 = 0;
+        for(Int_t ipid=0; ipid<fNPIDBits; ipid++)
+        {
+          if(p1->IsPIDOK(ipid,AliCaloPID::kPhoton)) pid1 |= (1<<ipid);
+        }
+        
+        // Kinematics of the pairs with all the photons of the stored event at once
+        MixedPairKinematics(ev2);
+        
         //---------------------------------
         // Second loop on other mixed event photons/clusters
         //---------------------------------
         for(Int_t i2 = 0; i2 < nPhot2; i2++)
         {
-          AliAODPWG4Particle * p2 = (AliAODPWG4Particle*) (ev2->At(i2)) ;
-          
-          // Select photons within a pT range
-          if ( p2->Pt() < GetMinPt() || p2->Pt()  > GetMaxPt() ) continue ;
-          
-          // Get kinematics of second cluster and calculate those of the pair
-          fPhotonMom2.SetPxPyPzE(p2->Px(),p2->Py(),p2->Pz(),p2->E());
-          m           = (fPhotonMom1+fPhotonMom2).M() ;
-          Double_t pt = (fPhotonMom1 + fPhotonMom2).Pt();
-          Double_t a  = TMath::Abs(p1->E()-p2->E())/(p1->E()+p2->E()) ;
+          // Kinematics of the pair
+          m           = fMixPairM [i2];
+          Double_t pt = fMixPairPt[i2];
+          Double_t a  = fMixPairAsym[i2];
           
           // Check if opening angle is too large or too small compared to what is expected
-          Double_t angle   = fPhotonMom1.Angle(fPhotonMom2.Vect());
-          if(fUseAngleEDepCut && !GetNeutralMesonSelection()->IsAngleInWindow((fPhotonMom1+fPhotonMom2).E(),angle+0.05))
+          Double_t angle   = fMixPairAngle[i2];
+          if(fUseAngleEDepCut && !GetNeutralMesonSelection()->IsAngleInWindow(fMixPairE[i2],angle+0.05))
           {
-            AliDebug(2,Form("Mix pair angle %f (deg) not in E %f window",RadToDeg(angle), (fPhotonMom1+fPhotonMom2).E()));
+            AliDebug(2,Form("Mix pair angle %f (deg) not in E %f window",RadToDeg(angle), fMixPairE[i2]));
             continue;
           }
           
@@ -4307,11 +4301,15 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
             continue;
           }
           
-          AliDebug(2,Form("Mixed Event: pT: fPhotonMom1 %2.2f, fPhotonMom2 %2.2f; Pair: pT %2.2f, mass %2.3f, a %2.3f",p1->Pt(), p2->Pt(), pt,m,a));
+          AliDebug(2,Form("Mixed Event: pT: fPhotonMom1 %2.2f, fPhotonMom2 %2.2f; Pair: pT %2.2f, mass %2.3f, a %2.3f",p1->Pt(), ev2.fPt[i2], pt,m,a));
           
           // In case we want only pairs in same (super) module, check their origin.
-          module2 = GetModuleNumber(p2);
-                    
+          module2 = ev2.fModule[i2];
+          
+          UChar_t flags2 = ev2.fFlags[i2];
+          Float_t phi2   = ev2.fPhi[i2];
+          Float_t eta2   = ev2.fEta[i2];
+          
           //-------------------------------------------------------------------------------------------------
           // Fill module dependent histograms, put a cut on assymmetry on the first available cut in the array
           //-------------------------------------------------------------------------------------------------
@@ -4350,11 +4348,9 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
             }
             else
             {
-              Float_t phi1 = GetPhi(fPhotonMom1.Phi());
-              Float_t phi2 = GetPhi(fPhotonMom2.Phi());
               Bool_t etaside = 0;
-              if(   (p1->GetDetectorTag()==kEMCAL && fPhotonMom1.Eta() < 0) 
-                 || (p2->GetDetectorTag()==kEMCAL && fPhotonMom2.Eta() < 0)) etaside = 1;
+              if(   (p1->GetDetectorTag()==kEMCAL && eta1 < 0) 
+                 || ((flags2 & kMixEMCAL)         && eta2 < 0)) etaside = 1;
               
               if      (    phi1 > DegToRad(260) && phi2 > DegToRad(260) && phi1 < DegToRad(280) && phi2 < DegToRad(280))  fhMiSameSectorDCALPHOSMod[0+etaside]->Fill(pt, m, GetEventWeight());
               else if (    phi1 > DegToRad(280) && phi2 > DegToRad(280) && phi1 < DegToRad(300) && phi2 < DegToRad(300))  fhMiSameSectorDCALPHOSMod[2+etaside]->Fill(pt, m, GetEventWeight());
@@ -4378,8 +4374,6 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
             } 
             else // PHOS and DCal in same sector
             {
-              Float_t phi1 = GetPhi(fPhotonMom1.Phi());
-              Float_t phi2 = GetPhi(fPhotonMom2.Phi());
               ok=kFALSE;
               if      ( phi1 > DegToRad(260) && phi2 > DegToRad(260) && phi1 < DegToRad(280) && phi2 < DegToRad(280)) ok = kTRUE;
               else if ( phi1 > DegToRad(280) && phi2 > DegToRad(280) && phi1 < DegToRad(300) && phi2 < DegToRad(300)) ok = kTRUE;
@@ -4396,17 +4390,19 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
           // Check if one of the clusters comes from a conversion
           if(fCheckConversion)
           {
-            if     (p1->IsTagged() && p2->IsTagged()) fhMiConv2->Fill(pt, m, GetEventWeight());
-            else if(p1->IsTagged() || p2->IsTagged()) fhMiConv ->Fill(pt, m, GetEventWeight());
+            Bool_t tagged2 = (flags2 & kMixTagged);
+            if     (p1->IsTagged() && tagged2) fhMiConv2->Fill(pt, m, GetEventWeight());
+            else if(p1->IsTagged() || tagged2) fhMiConv ->Fill(pt, m, GetEventWeight());
           }
           
           //
           // Main invariant mass histograms
           // Fill histograms for different bad channel distance, centrality, assymmetry cut and pid bit
           //
+          UInt_t pidBoth = pid1 & ev2.fPID[i2];
           for(Int_t ipid=0; ipid<fNPIDBits; ipid++)
           {
-            if((p1->IsPIDOK(ipid,AliCaloPID::kPhoton)) && (p2->IsPIDOK(ipid,AliCaloPID::kPhoton)))
+            if(pidBoth & (1<<ipid))
             {
               for(Int_t iasym=0; iasym < fNAsymCuts; iasym++)
               {
@@ -4421,12 +4417,12 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
                   
                   if(fFillBadDistHisto)
                   {
-                    if(p1->DistToBad()>0 && p2->DistToBad()>0)
+                    if(p1->DistToBad()>0 && ev2.fDistToBad[i2]>0)
                     {
                       fhMi2[index]->Fill(pt, m, GetEventWeight()) ;
                       if(fMakeInvPtPlots)fhMiInvPt2[index]->Fill(pt, m, 1./pt * GetEventWeight()) ;
                       
-                      if(p1->DistToBad()>1 && p2->DistToBad()>1)
+                      if(p1->DistToBad()>1 && ev2.fDistToBad[i2]>1)
                       {
                         fhMi3[index]->Fill(pt, m, GetEventWeight()) ;
                         if(fMakeInvPtPlots)fhMiInvPt3[index]->Fill(pt, m, 1./pt * GetEventWeight()) ;
@@ -4442,9 +4438,6 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
           //-----------------------
           // Multi cuts analysis
           //-----------------------
-          Int_t  ncell1 = p1->GetNCells();
-          Int_t  ncell2 = p1->GetNCells();
-          
           if(fMultiCutAna)
           {
             // Several pt,ncell and asymmetry cuts
@@ -4456,19 +4449,14 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
                 {
                   Int_t index = ((ipt*fNCellNCuts)+icell)*fNAsymCuts + iasym;
                   
-                  if(p1->Pt() >   fPtCuts[ipt]      && p2->Pt() > fPtCuts[ipt]      &&
-                     p1->Pt() <   fPtCutsMax[ipt]   && p2->Pt() < fPtCutsMax[ipt]   &&
-                     a        <   fAsymCuts[iasym]                                  &&
+                  if(p1->Pt() >   fPtCuts[ipt]      && ev2.fPt[i2] > fPtCuts[ipt]    &&
+                     p1->Pt() <   fPtCutsMax[ipt]   && ev2.fPt[i2] < fPtCutsMax[ipt] &&
+                     a        <   fAsymCuts[iasym]                                   &&
                      ncell1   >=  fCellNCuts[icell] && ncell2   >= fCellNCuts[icell] 
                      )
                   {
-                    //printf("MI ipt %d, iasym%d, icell %d, index %d \n",ipt, iasym, icell, index);
-                    //printf("\t %p, %p\n",fhMiPtNCellAsymCuts[index],fhMiPtNCellAsymCutsOpAngle[index]);
-                    
                     fhMiPtNCellAsymCuts[index]->Fill(pt, m, GetEventWeight()) ;
                     if(fFillAngleHisto)  fhMiPtNCellAsymCutsOpAngle[index]->Fill(pt, angle, GetEventWeight()) ;
-                    
-                    //printf("ipt %d, icell%d, iasym %d, name %s\n",ipt, icell, iasym,  fhRePtNCellAsymCuts[((ipt*fNCellNCuts)+icell)*fNAsymCuts + iasym]->GetName());
                   }
                 }// pid bit cut loop
               }// icell loop
@@ -4497,55 +4485,42 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
             if( angleBin >= 0 && angleBin < fNAngleCutBins)
             {
               Float_t e1   = fPhotonMom1.E();
-              Float_t e2   = fPhotonMom2.E();
+              Float_t e2   = ev2.fE[i2];
               
               Float_t t1   = p1->GetTime();
-              Float_t t2   = p2->GetTime();
+              Float_t t2   = ev2.fTime[i2];
               
               Int_t nc1    = ncell1;
               Int_t nc2    = ncell2;
               
-              Float_t eta1 = fPhotonMom1.Eta(); 
-              Float_t eta2 = fPhotonMom2.Eta(); 
+              Float_t etaMax = eta1; 
+              Float_t etaMin = eta2; 
               
-              Float_t phi1 = GetPhi(fPhotonMom1.Phi());
-              Float_t phi2 = GetPhi(fPhotonMom2.Phi());
+              Float_t phiMax = phi1;
+              Float_t phiMin = phi2;
               
               Int_t   mod1 = module1;
               Int_t   mod2 = module2;
               
-              //              // Recover original cluster
-              //              Int_t iclus1 = -1, iclus2 = -1 ;
-              //              AliVCluster * cluster1 = FindCluster(GetEMCALClusters(),p1->GetCaloLabel(0),iclus1);
-              //              AliVCluster * cluster2 = FindCluster(GetEMCALClusters(),p2->GetCaloLabel(0),iclus2);
-              //              
-              //              Float_t maxCellFraction1 = 0, maxCellFraction2 = 0;
-              //              Int_t absIdMax1 = GetCaloUtils()->GetMaxEnergyCell(GetEMCALCells(),cluster1,maxCellFraction1);
-              //              Int_t absIdMax2 = GetCaloUtils()->GetMaxEnergyCell(GetEMCALCells(),cluster2,maxCellFraction2);
-              
               if(e2 > e1)
               {
-                e1   = fPhotonMom2.E();
-                e2   = fPhotonMom1.E();
-                
-                t1   = p2->GetTime();
-                t2   = p1->GetTime();
+                e1     = ev2.fE[i2];
+                e2     = fPhotonMom1.E();
                 
-                nc1  = ncell2;
-                nc2  = ncell1;
+                t1     = ev2.fTime[i2];
+                t2     = p1->GetTime();
                 
-                eta1 = fPhotonMom2.Eta(); 
-                eta2 = fPhotonMom1.Eta(); 
+                nc1    = ncell2;
+                nc2    = ncell1;
                 
-                phi1 = GetPhi(fPhotonMom2.Phi());
-                phi2 = GetPhi(fPhotonMom1.Phi());
+                etaMax = eta2; 
+                etaMin = eta1; 
                 
-                mod1 = module2;
-                mod2 = module1;
+                phiMax = phi2;
+                phiMin = phi1;
                 
-                //                Int_t tmp = absIdMax2;
-                //                absIdMax2 = absIdMax1;
-                //                absIdMax1 = tmp;
+                mod1   = module2;
+                mod2   = module1;
               }
               
               fhMiOpAngleBinMinClusterEPerSM[angleBin]->Fill(e2,mod2,GetEventWeight()) ; 
@@ -4562,19 +4537,8 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
               
               if(e1 > 0.01) fhMiOpAngleBinPairClusterRatioPerSM[angleBin]->Fill(e2/e1,mod1,GetEventWeight()) ;  
               
-              fhMiOpAngleBinMinClusterEtaPhi[angleBin]->Fill(eta2,phi2,GetEventWeight()) ;
-              fhMiOpAngleBinMaxClusterEtaPhi[angleBin]->Fill(eta1,phi1,GetEventWeight()) ;
-              
-              //              Int_t   icol1 = -1, icol2 = -1, icolAbs1 = -1, icolAbs2 = -1;
-              //              Int_t   irow1 = -1, irow2 = -1, irowAbs1 = -1, irowAbs2 = -1;
-              //              Int_t   iRCU1 = -1, iRCU2 = -1;
-              //              GetModuleNumberCellIndexesAbsCaloMap(absIdMax1,GetCalorimeter(), icol1, irow1, iRCU1, icolAbs1, irowAbs1);
-              //              GetModuleNumberCellIndexesAbsCaloMap(absIdMax2,GetCalorimeter(), icol2, irow2, iRCU1, icolAbs2, irowAbs2);
-              //              
-              //              fhMiOpAngleBinPairClusterAbsIdMaxCell[angleBin]->Fill(absIdMax1,absIdMax2,GetEventWeight());
-              //
-              //              fhMiColRowClusterMinOpAngleBin[angleBin]->Fill(icolAbs2,irowAbs2,GetEventWeight()) ;
-              //              fhMiOpAngleBinMaxClusterColRow[angleBin]->Fill(icolAbs1,irowAbs1,GetEventWeight()) ;
+              fhMiOpAngleBinMinClusterEtaPhi[angleBin]->Fill(etaMin,phiMin,GetEventWeight()) ;
+              fhMiOpAngleBinMaxClusterEtaPhi[angleBin]->Fill(etaMax,phiMax,GetEventWeight()) ;
             }
           }
           
@@ -4589,10 +4553,11 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
           // Check cell time content in cluster
           if ( fFillSecondaryCellTiming )
           {
-            if      ( p1->GetFiducialArea() == 0 && p2->GetFiducialArea() == 0 )
+            Bool_t out2 = (flags2 & kMixOutTimeWindow);
+            if      ( p1->GetFiducialArea() == 0 && !out2 )
               fhMiSecondaryCellInTimeWindow ->Fill(pt, m, GetEventWeight());
             
-            else if ( p1->GetFiducialArea() != 0 && p2->GetFiducialArea() != 0 )
+            else if ( p1->GetFiducialArea() != 0 &&  out2 )
               fhMiSecondaryCellOutTimeWindow->Fill(pt, m, GetEventWeight());
           }
                   
@@ -4604,31 +4569,122 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
     // Add the current event to the list of events for mixing
     //--------------------------------------------------------
     
-    //TClonesArray *currentEvent = new TClonesArray(*GetInputAODBranch());
-    TClonesArray *currentEvent = new TClonesArray(*secondLoopInputData);
+    // Add current event to buffer, replacing the oldest one when full, empty events are not stored
+    if( secondLoopInputData->GetEntriesFast() > 0 )
+      StoreEventForMixing(secondLoopInputData, pool);
     
-    // Add current event to buffer and Remove redundant events
-    if( currentEvent->GetEntriesFast() > 0 )
-    {
-      evMixList->AddFirst(currentEvent) ;
-      currentEvent=0 ; //Now list of particles belongs to buffer and it will be deleted with buffer
-      if( evMixList->GetSize() >= GetNMaxEvMix() )
-      {
-        TClonesArray * tmp = (TClonesArray*) (evMixList->Last()) ;
-        evMixList->RemoveLast() ;
-        delete tmp ;
-      }
-    }
-    else
-    { // empty event
-      delete currentEvent ;
-      currentEvent=0 ;
-    }
   }// DoOwnMix
   
   AliDebug(1,"End fill histograms");
 }
 
+//________________________________________________________________________
+/// Copy what the mixing needs of the photons of the current event into the
+/// oldest slot of the pool, or a free one. The pT range selection of the
+/// mixing is applied here, so that it is done once per stored photon.
+//________________________________________________________________________
+void AliAnaPi0::StoreEventForMixing(const TClonesArray * photons, MixedEventPool & pool)
+{
+  Int_t nSlots = pool.fEvents.size();
+  if(nSlots == 0) return;
+  
+  pool.fNewest = (pool.fNewest+1)%nSlots;
+  if(pool.fNStored < nSlots) pool.fNStored++;
+  
+  MixedEventPhotons & ev = pool.fEvents[pool.fNewest];
+  ev.fPx.clear(); ev.fPy.clear(); ev.fPz.clear(); ev.fE.clear(); ev.fPt.clear();
+  ev.fEta.clear(); ev.fPhi.clear(); ev.fTime.clear(); ev.fModule.clear();
+  ev.fDistToBad.clear(); ev.fPID.clear(); ev.fFlags.clear();
+  
+  Int_t nPhot = photons->GetEntriesFast();
+  for(Int_t i = 0; i < nPhot; i++)
+  {
+    AliAODPWG4Particle * p = (AliAODPWG4Particle*) (photons->At(i)) ;
+    
+    if ( p->Pt() < GetMinPt() || p->Pt()  > GetMaxPt() ) continue ;
+    
+    fPhotonMom2.SetPxPyPzE(p->Px(),p->Py(),p->Pz(),p->E());
+    
+    UShort_t pid = 0;
+    for(Int_t ipid=0; ipid<fNPIDBits; ipid++)
+    {
+      if(p->IsPIDOK(ipid,AliCaloPID::kPhoton)) pid |= (1<<ipid);
+    }
+    
+    UChar_t flags = 0;
+    if(p->IsTagged())                   flags |= kMixTagged;
+    if(p->GetDetectorTag() == kEMCAL)   flags |= kMixEMCAL;
+    if(p->GetFiducialArea() != 0)       flags |= kMixOutTimeWindow;
+    
+    ev.fPx       .push_back(p->Px());
+    ev.fPy       .push_back(p->Py());
+    ev.fPz       .push_back(p->Pz());
+    ev.fE        .push_back(p->E());
+    ev.fPt       .push_back(p->Pt());
+    ev.fEta      .push_back(fPhotonMom2.Eta());
+    ev.fPhi      .push_back(GetPhi(fPhotonMom2.Phi()));
+    ev.fTime     .push_back(p->GetTime());
+    ev.fModule   .push_back(GetModuleNumber(p));
+    ev.fDistToBad.push_back(p->DistToBad());
+    ev.fPID      .push_back(pid);
+    ev.fFlags    .push_back(flags);
+  }
+}
+
+//________________________________________________________________________
+/// Mass, pT, energy, asymmetry and opening angle of the pairs of the photon
+/// in fPhotonMom1 with all the photons of a stored event, in one pass over
+/// the columns of the event. Same results as TLorentzVector::M() and TVector3::Angle().
+//________________________________________________________________________
+void AliAnaPi0::MixedPairKinematics(const MixedEventPhotons & ev2)
+{
+  Int_t nPhot2 = ev2.GetEntries();
+  if((Int_t) fMixPairM.size() < nPhot2)
+  {
+    fMixPairM    .resize(nPhot2);
+    fMixPairPt   .resize(nPhot2);
+    fMixPairE    .resize(nPhot2);
+    fMixPairAsym .resize(nPhot2);
+    fMixPairAngle.resize(nPhot2);
+  }
+  
+  const Double_t px1  = fPhotonMom1.Px();
+  const Double_t py1  = fPhotonMom1.Py();
+  const Double_t pz1  = fPhotonMom1.Pz();
+  const Double_t e1   = fPhotonMom1.E();
+  const Double_t p1p1 = px1*px1 + py1*py1 + pz1*pz1;
+  
+  const Double_t * px2 = &ev2.fPx[0];
+  const Double_t * py2 = &ev2.fPy[0];
+  const Double_t * pz2 = &ev2.fPz[0];
+  const Double_t * e2  = &ev2.fE [0];
+  Double_t * mass  = &fMixPairM    [0];
+  Double_t * pt    = &fMixPairPt   [0];
+  Double_t * e     = &fMixPairE    [0];
+  Double_t * asym  = &fMixPairAsym [0];
+  Double_t * angle = &fMixPairAngle[0];
+  
+  for(Int_t i2 = 0; i2 < nPhot2; i2++)
+  {
+    Double_t px = px1 + px2[i2];
+    Double_t py = py1 + py2[i2];
+    Double_t pz = pz1 + pz2[i2];
+    e[i2]       = e1  + e2 [i2];
+    
+    Double_t m2 = e[i2]*e[i2] - (px*px + py*py + pz*pz);
+    mass[i2]    = m2 < 0 ? -TMath::Sqrt(-m2) : TMath::Sqrt(m2);
+    pt  [i2]    = TMath::Sqrt(px*px + py*py);
+    asym[i2]    = TMath::Abs(e1-e2[i2])/e[i2];
+    
+    Double_t p1p2 = px1*px2[i2] + py1*py2[i2] + pz1*pz2[i2];
+    Double_t norm = p1p1 * (px2[i2]*px2[i2] + py2[i2]*py2[i2] + pz2[i2]*pz2[i2]);
+    Double_t cosA = norm > 0 ? p1p2/TMath::Sqrt(norm) : 1.;
+    if(cosA >  1.) cosA =  1.;
+    if(cosA < -1.) cosA = -1.;
+    angle[i2]   = TMath::ACos(cosA);
+  }
+}
+
 //________________________________________________________________________
 /// It retieves the event index and checks the vertex
 ///  * in the mixed buffer returns -2 if vertex NOK
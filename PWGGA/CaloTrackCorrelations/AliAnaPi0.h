@@ -25,10 +25,12 @@
 //_________________________________________________________________________
 
 // Root
+#include <vector>
 class TList;
 class TH3F ;
 class TH2F ;
 class TObjString;
+class TClonesArray;
 
 // Analysis
 #include "AliAnaCaloTrackCorrBaseClass.h"
@@ -182,8 +184,45 @@ class AliAnaPi0 : public AliAnaCaloTrackCorrBaseClass {
 
   private:
 
-  /// Containers for photons in stored events
-  TList ** fEventsList ;               //![GetNCentrBin()*GetNZvertBin()*GetNRPBin()]
+  /// Bits of MixedEventPhotons::fFlags
+  enum mixedPhotonFlags { kMixTagged = 1, kMixEMCAL = 2, kMixOutTimeWindow = 4 } ;
+
+  /// Photons of one stored event, column-wise, with what the mixing needs of each photon.
+  /// Only photons within the pT range are kept.
+  struct MixedEventPhotons
+  {
+    std::vector<Double_t> fPx, fPy, fPz, fE, fPt ; ///< Momentum
+    std::vector<Float_t>  fEta, fPhi ;             ///< Direction, phi in [0,2pi]
+    std::vector<Float_t>  fTime ;                  ///< Cluster time
+    std::vector<Int_t>    fModule ;                ///< (Super) module number
+    std::vector<Int_t>    fDistToBad ;             ///< Distance to bad channel
+    std::vector<UShort_t> fPID ;                   ///< Bit ipid set if IsPIDOK(ipid,kPhoton)
+    std::vector<UChar_t>  fFlags ;                 ///< See mixedPhotonFlags
+    Int_t GetEntries() const { return fE.size() ; }
+  } ;
+
+  /// Ring buffer of the events stored in one centrality, vertex and reaction plane bin.
+  /// The slots keep their memory, so that storing an event does not allocate after the first ones.
+  struct MixedEventPool
+  {
+    std::vector<MixedEventPhotons> fEvents ;      ///< Slots, GetNMaxEvMix()-1 events at most
+    Int_t fNewest ;                               ///< Slot of the last stored event
+    Int_t fNStored ;                              ///< Number of stored events
+  } ;
+
+  void         StoreEventForMixing(const TClonesArray * photons, MixedEventPool & pool) ;
+
+  void         MixedPairKinematics(const MixedEventPhotons & ev2) ;
+
+  /// Containers for photons in stored events, one pool per GetEventMixBin()
+  std::vector<MixedEventPool> fMixPools ;  //!<!
+
+  /// Pair kinematics of the current photon with all photons of a stored event, see MixedPairKinematics()
+  std::vector<Double_t> fMixPairM ;        //!<! Pair mass
+  std::vector<Double_t> fMixPairPt ;       //!<! Pair pT
+  std::vector<Double_t> fMixPairE ;        //!<! Pair energy
+  std::vector<Double_t> fMixPairAsym ;     //!<! Pair energy asymmetry
+  std::vector<Double_t> fMixPairAngle ;    //!<! Pair opening angle
 
   Int_t    fNModules ;                 ///<  Number of EMCAL/PHOS modules, set as many histogras as modules 
   
@@ -598,7 +637,7 @@ class AliAnaPi0 : public AliAnaCaloTrackCorrBaseClass {
   AliAnaPi0 & operator = (const AliAnaPi0 & api0) ;
   
   /// \cond CLASSIMP
-  ClassDef(AliAnaPi0,35) ;
+  ClassDef(AliAnaPi0,36) ;
   /// \endcond
   
 } ;
@@ -24,6 +24,7 @@
 //    Markus Heide <mheide@uni-muenster.de>
 //    Markus Fasel <M.Fasel@gsi.de>
 //
+#include <TMath.h>
 #include <TObjArray.h>
 
 #include "AliAODEvent.h"
@@ -40,6 +41,7 @@
 
 #include "AliHFEV0cuts.h"
 #include "AliHFEV0info.h"
+#include "AliHFEV0pidTags.h"
 #include "AliHFEcollection.h"
 
 #include "AliHFEV0pid.h"
@@ -62,6 +64,7 @@ AliHFEV0pid::AliHFEV0pid():
   , fLambdas(NULL)
   , fAntiLambdas(NULL)
   , fIndices(NULL)
+  , fV0Table(NULL)
   , fQA(NULL)
   , fV0cuts(NULL)
   , fOutput(NULL)
@@ -90,6 +93,7 @@ AliHFEV0pid::AliHFEV0pid(const char *name):
   , fLambdas(NULL)
   , fAntiLambdas(NULL)
   , fIndices(NULL)
+  , fV0Table(NULL)
   , fQA(NULL)
   , fV0cuts(NULL)
   , fOutput(NULL)
@@ -116,6 +120,7 @@ AliHFEV0pid::AliHFEV0pid(const char *name):
   fAntiLambdas = new TObjArray();
 
   fIndices = new AliHFEV0pidTrackIndex();
+  fV0Table = new AliHFEV0pidV0Table();
   
 }
 //____________________________________________________________
@@ -137,6 +142,7 @@ AliHFEV0pid::~AliHFEV0pid(){
   if(fAntiLambdas) delete fAntiLambdas;
 
   if(fIndices) delete fIndices;
+  if(fV0Table) delete fV0Table;
   if(fV0cuts) delete fV0cuts;
 
   if(TESTBIT(fDestBits, 1)){
@@ -221,7 +227,7 @@ void AliHFEV0pid::Process(AliVEvent * const inputEvent){
   Int_t nGamma = 0, nK0s = 0, nLambda = 0, nPhi = 0;
   fInputEvent = inputEvent;
   fNtracks = fInputEvent->GetNumberOfTracks();
-  fIndices->Init(fInputEvent->GetNumberOfV0s() * 2);
+  fIndices->Init(fNtracks);
   fPrimaryVertex = new AliKFVertex(*(fInputEvent->GetPrimaryVertex()));
   if(!fPrimaryVertex) return;
   fV0cuts->SetInputEvent(fInputEvent);
@@ -233,18 +239,28 @@ void AliHFEV0pid::Process(AliVEvent * const inputEvent){
 
   //BenchmarkV0finder();
 
-  for(Int_t iv0 = 0; iv0 < fInputEvent->GetNumberOfV0s(); iv0++){
-    if(!TString(fInputEvent->IsA()->GetName()).CompareTo("AliESDEvent")){
+  Int_t nCandidates = 0;
+  if(!TString(fInputEvent->IsA()->GetName()).CompareTo("AliESDEvent")){
+    // case ESD
+    SetESDanalysis();
+    // quantities and Armenteros preselection of all V0s at once, one row per V0 candidate
+    nCandidates = FillV0Table();
+  } else {
+    // case AOD
+    SetAODanalysis();
+    fV0Table->Reset();
+    nCandidates = fInputEvent->GetNumberOfV0s();
+  }
+
+  for(Int_t icand = 0; icand < nCandidates; icand++){
+    if(IsESDanalysis()){
       // case ESD
-      SetESDanalysis();
-      AliESDv0 *esdV0 = (static_cast<AliESDEvent *>(fInputEvent))->GetV0(iv0);
-      if(!esdV0) continue;
-      if(!esdV0->GetOnFlyStatus()) continue; // Take only V0s from the On-the-fly v0 finder
-      v0status = ProcessV0(esdV0);
+      AliESDv0 *esdV0 = (static_cast<AliESDEvent *>(fInputEvent))->GetV0(fV0Table->GetV0(icand));
+      v0status = ProcessV0(esdV0, icand);
+      fV0Table->SetStatus(icand, v0status);
     } else {
       // case AOD
-      SetAODanalysis();
-      AliAODv0 *aodV0 = (static_cast<AliAODEvent *>(fInputEvent))->GetV0(iv0);
+      AliAODv0 *aodV0 = (static_cast<AliAODEvent *>(fInputEvent))->GetV0(icand);
       if(aodV0->GetOnFlyStatus()) continue; // Take only V0s from the On-the-fly v0 finder
       v0status = ProcessV0(aodV0);
       if(AliHFEV0cuts::kUndef != v0status){
@@ -257,6 +273,7 @@ void AliHFEV0pid::Process(AliVEvent * const inputEvent){
     case AliHFEV0cuts::kRecoLambda: nLambda++; break;
     };
   }
+  PublishTags();
 
   AliDebug(1, Form("Number of gammas  : %d", nGamma));
   AliDebug(1, Form("Number of K0s     : %d", nK0s));
@@ -277,7 +294,25 @@ void AliHFEV0pid::Process(AliVEvent * const inputEvent){
 //____________________________________________________________
 Int_t AliHFEV0pid::ProcessV0(TObject *v0){
   //
-  // Process single V0
+  // Process single V0 outside of Process(): the V0 is added to the V0 table
+  //
+  if(!v0)  return AliHFEV0cuts::kUndef;
+  // CHECK
+  AliESDv0* esdV0 =  dynamic_cast<AliESDv0 *>(v0);
+  if( ! esdV0 ) {
+    AliError("Unexpected v0 type.");
+    return AliHFEV0cuts::kUndef;
+  }  
+  if(!fInputEvent->GetTrack(esdV0->GetPindex()) || !fInputEvent->GetTrack(esdV0->GetNindex())) return AliHFEV0cuts::kUndef;
+  Int_t row = fV0Table->Add(-1, esdV0, fV0cuts->CheckSigns(esdV0));
+  fV0Table->Preselect(row);
+  return ProcessV0(v0, row);
+}
+
+//____________________________________________________________
+Int_t AliHFEV0pid::ProcessV0(TObject *v0, Int_t row){
+  //
+  // Process single V0, with its quantities in the given row of the V0 table
   // Apply general cut and special cuts for gamma, K0s, Lambda
   //
   if(!v0)  return AliHFEV0cuts::kUndef;
@@ -316,7 +351,7 @@ Int_t AliHFEV0pid::ProcessV0(TObject *v0){
   }
 
   // preselect the V0 candidates based on the Armenteros plot
-  Int_t id = PreselectV0(esdV0, idMC);
+  Int_t id = PreselectV0(row, idMC);
   // store the resutls
   if(AliHFEV0cuts::kRecoGamma == id && IsGammaConv(v0)){
     fQA->Fill("h_nV0s", AliHFEV0cuts::kRecoGamma);
@@ -348,22 +383,55 @@ void AliHFEV0pid::Flush(){
   fIndices->Flush();
 }
 //____________________________________________________________
-Int_t AliHFEV0pid::PreselectV0(AliESDv0 * const v0, Int_t idMC){
+Int_t AliHFEV0pid::FillV0Table(){
+  //
+  // Fill the V0 table with the V0s of the On-the-fly v0 finder with both daughters
+  // and preselect all of them based on the Armenteros plot
+  //
+  fV0Table->Reset();
+  AliESDEvent *esd = static_cast<AliESDEvent *>(fInputEvent);
+  for(Int_t iv0 = 0; iv0 < esd->GetNumberOfV0s(); iv0++){
+    AliESDv0 *esdV0 = esd->GetV0(iv0);
+    if(!esdV0) continue;
+    if(!esdV0->GetOnFlyStatus()) continue; // Take only V0s from the On-the-fly v0 finder
+    if(!esd->GetTrack(esdV0->GetPindex()) || !esd->GetTrack(esdV0->GetNindex())) continue;
+    fV0Table->Add(iv0, esdV0, fV0cuts->CheckSigns(esdV0));
+  }
+  fV0Table->Preselect();
+  return fV0Table->GetNumberOfV0s();
+}
+//____________________________________________________________
+void AliHFEV0pid::PublishTags() const {
+  //
+  // Publish the tags of the identified V0 daughters and V0s in the input event,
+  // for the other tasks of the train (see AliHFEV0pidTags)
+  //
+  AliHFEV0pidTags *tags = AliHFEV0pidTags::GetOrCreateTags(fInputEvent);
+  if(!tags) return;
+  tags->Reset(fInputEvent);
+  for(Int_t itrack = 0; itrack < fNtracks; itrack++){
+    Int_t species = fIndices->GetSpecies(itrack);
+    if(species >= 0) tags->SetTrackTag(itrack, species);
+  }
+  for(Int_t row = 0; row < fV0Table->GetNumberOfV0s(); row++){
+    tags->SetV0Tag(fV0Table->GetV0(row), fV0Table->GetStatus(row));
+  }
+}
+//____________________________________________________________
+Int_t AliHFEV0pid::PreselectV0(Int_t row, Int_t idMC){
   //
   // Based on Armenteros plot preselet the possible identity of the V0 candidate
+  // The Armenteros variables and the preselection are taken from the V0 table
   //
 
-  if(!v0) return -1;
+  if(row < 0) return -1;
 
   // momentum dependent armenteros plots
-  ArmenterosPlotMC(v0, idMC);
-
-  // comupte the armenteros variables
-  Float_t ar[2];
-  fV0cuts->Armenteros(v0, ar);
-  // for clarity
-  const Float_t alpha = ar[0];
-  const Float_t qt = ar[1];
+  ArmenterosPlotMC(row, idMC);
+
+  // the armenteros variables
+  const Float_t alpha = fV0Table->GetAlpha(row);
+  const Float_t qt = fV0Table->GetQt(row);
   //printf(" -D: Alpha: %f, QT: %f \n", alpha, qt);
 
   if(TMath::Abs(alpha) > 1) return AliHFEV0cuts::kUndef;
@@ -392,64 +460,9 @@ Int_t AliHFEV0pid::PreselectV0(AliESDv0 * const v0, Int_t idMC){
     }
   }
 
-  // Gamma cuts
-  const Double_t cutAlphaG = 0.35; 
-  const Double_t cutQTG = 0.05;
-  const Double_t cutAlphaG2[2] = {0.6, 0.8};
-  const Double_t cutQTG2 = 0.04;
-
-  // K0 cuts
-  const Float_t cutQTK0[2] = {0.1075, 0.215};
-  const Float_t cutAPK0[2] = {0.199, 0.8};   // parameters for curved QT cut
-  
-  // Lambda & A-Lambda cuts
-  const Float_t cutQTL = 0.03;
-  const Float_t cutAlphaL[2] = {0.35, 0.7};
-  const Float_t cutAlphaAL[2] = {-0.7,  -0.35};
-  const Float_t cutAPL[3] = {0.107, -0.69, 0.5};  // parameters fir curved QT cut
-
-
-  // Check for Gamma candidates
-  if(qt < cutQTG){
-    if( (TMath::Abs(alpha) < cutAlphaG) ){
-      fQA->Fill("h_AP_selected_V0s", alpha, qt);
-      return  AliHFEV0cuts::kRecoGamma;
-    }
-  }
-  // additional region - should help high pT gammas
-  if(qt < cutQTG2){
-    if( (TMath::Abs(alpha) > cutAlphaG2[0]) &&  (TMath::Abs(alpha) < cutAlphaG2[1]) ){
-      fQA->Fill("h_AP_selected_V0s", alpha, qt);
-      return  AliHFEV0cuts::kRecoGamma;
-    }
-  }
-
-
-  // Check for K0 candidates
-  Float_t q = cutAPK0[0] * TMath::Sqrt(TMath::Abs(1 - alpha*alpha/(cutAPK0[1]*cutAPK0[1])));
-  if( (qt > cutQTK0[0]) && (qt < cutQTK0[1]) && (qt > q) ){
-    fQA->Fill("h_AP_selected_V0s", alpha, qt);
-    return AliHFEV0cuts::kRecoK0;
-  }
-  
-  if( (alpha > 0) && (alpha > cutAlphaL[0])  && (alpha < cutAlphaL[1]) && (qt > cutQTL)){
-    q = cutAPL[0] * TMath::Sqrt(1 - ( (alpha + cutAPL[1]) * (alpha + cutAPL[1]))  / (cutAPL[2]*cutAPL[2]) );
-    if( qt < q  ){
-      fQA->Fill("h_AP_selected_V0s", alpha, qt);
-      return AliHFEV0cuts::kRecoLambda;
-    }
-  }
-
-  // Check for A-Lambda candidates
-  if( (alpha < 0) && (alpha > cutAlphaAL[0]) && (alpha < cutAlphaAL[1]) && (qt > cutQTL)){
-    q = cutAPL[0] * TMath::Sqrt(1 - ( (alpha - cutAPL[1]) * (alpha - cutAPL[1]) ) / (cutAPL[2]*cutAPL[2]) );
-    if( qt < q ){
-      fQA->Fill("h_AP_selected_V0s", alpha, qt);
-      return AliHFEV0cuts::kRecoLambda;
-    }
-  }
-  
-  return AliHFEV0cuts::kUndef;
+  Int_t id = fV0Table->GetPreselection(row);
+  if(AliHFEV0cuts::kUndef != id) fQA->Fill("h_AP_selected_V0s", alpha, qt);
+  return id;
 
 }
 //____________________________________________________________
@@ -774,7 +787,7 @@ void AliHFEV0pid::BenchmarkV0finder(){
   }
 }
 //____________________________________________________________
-void   AliHFEV0pid::ArmenterosPlotMC(AliESDv0 * const v0, Int_t idMC){
+void   AliHFEV0pid::ArmenterosPlotMC(Int_t row, Int_t idMC){
   //
   // Armenteros plots as a function of Mohter Momentum
   //
@@ -783,9 +796,8 @@ void   AliHFEV0pid::ArmenterosPlotMC(AliESDv0 * const v0, Int_t idMC){
   // approx log bins - over the 0.1 - 10 GeV/c
   const Float_t bins[13] = {0.1, 0.1468, 0.2154, 0.3162, 0.4642, 0.6813, 1.0, 1.4678, 2.1544, 3.1623, 4.6416, 6.8129, 10.0};
   
-  Float_t ar[2];
-  fV0cuts->Armenteros(v0, ar);
-  Float_t p = v0->P();
+  Float_t ar[2] = {fV0Table->GetAlpha(row), fV0Table->GetQt(row)};
+  Float_t p = fV0Table->GetP(row);
  
   if( (p <=  bins[0]) || (p >= bins[12])) return;
 
@@ -811,11 +823,7 @@ AliHFEV0pid::AliHFEV0pidTrackIndex::AliHFEV0pidTrackIndex():
   , fNPionsL(0)
   , fNKaons(0)
   , fNProtons(0)
-  , fIndexElectron(NULL)
-  , fIndexPionK0(NULL)
-  , fIndexPionL(NULL)
-  , fIndexKaon(NULL)
-  , fIndexProton(NULL)
+  , fSpecies()
 {
   //
   // Default Constructor
@@ -827,10 +835,6 @@ AliHFEV0pid::AliHFEV0pidTrackIndex::~AliHFEV0pidTrackIndex(){
   //
   // Destructor
   //
-  if(fIndexElectron) delete[] fIndexElectron;
-  if(fIndexPionK0) delete[] fIndexPionK0;
-  if(fIndexPionL) delete[] fIndexPionL;
-  if(fIndexProton) delete[] fIndexProton;
 }
 
 //____________________________________________________________
@@ -839,16 +843,7 @@ void AliHFEV0pid::AliHFEV0pidTrackIndex::Flush(){
   // Reset containers
   //
   
-  if(fIndexElectron) delete[] fIndexElectron;
-  fIndexElectron = NULL;
-  if(fIndexPionK0) delete[] fIndexPionK0;
-  fIndexPionK0 = NULL;
-  if(fIndexPionL) delete[] fIndexPionL;
-  fIndexPionL = NULL;
-  if(fIndexKaon) delete[] fIndexKaon;
-  fIndexKaon = NULL;
-  if(fIndexProton) delete[] fIndexProton;
-  fIndexProton = NULL;
+  fSpecies.clear();
 
   fNElectrons = 0;
   fNPionsK0 = 0;
@@ -860,12 +855,10 @@ void AliHFEV0pid::AliHFEV0pidTrackIndex::Flush(){
 //____________________________________________________________
 void AliHFEV0pid::AliHFEV0pidTrackIndex::Init(Int_t capacity){
   //
-  // Initialize container
+  // Initialize container: one entry per track index, the
+  // species of a track is found without searching
   //
-  fIndexElectron = new Int_t[capacity];
-  fIndexPionK0 = new Int_t[capacity];
-  fIndexPionL = new Int_t[capacity];
-  fIndexProton = new Int_t[capacity];
+  fSpecies.assign(capacity, -1);
 }
 
 //____________________________________________________________
@@ -873,20 +866,34 @@ void AliHFEV0pid::AliHFEV0pidTrackIndex::Add(Int_t index, Int_t species){
   //
   // Add new index to the list of identified particles
   //
+  if(index < 0) return;
   switch(species){
     case AliHFEV0cuts::kRecoElectron:
-      fIndexElectron[fNElectrons++] = index;
+      fNElectrons++;
       break;
     case AliHFEV0cuts::kRecoPionK0:
-      fIndexPionK0[fNPionsK0++] = index;
+      fNPionsK0++;
       break;
     case AliHFEV0cuts::kRecoPionL:
-      fIndexPionL[fNPionsL++] = index;
+      fNPionsL++;
       break;
     case AliHFEV0cuts::kRecoProton:
-      fIndexProton[fNProtons++] = index;
+      fNProtons++;
       break;
+    default:
+      return;
   };
+  if(index >= static_cast<Int_t>(fSpecies.size())) fSpecies.resize(index + 1, -1);
+  fSpecies[index] = species;
+}
+
+//____________________________________________________________
+Int_t AliHFEV0pid::AliHFEV0pidTrackIndex::GetSpecies(Int_t index) const {
+  //
+  // Species of the track index, -1 if not identified
+  //
+  if(index < 0 || index >= static_cast<Int_t>(fSpecies.size())) return -1;
+  return fSpecies[index];
 }
 
 //____________________________________________________________
@@ -894,36 +901,7 @@ Bool_t AliHFEV0pid::AliHFEV0pidTrackIndex::Find(Int_t index, Int_t species) cons
   //
   // Find track index in the specific sample of particles
   //
-
-  Int_t *container = NULL; Int_t n = 0;
-  switch(species){
-  case AliHFEV0cuts::kRecoElectron:
-    container = fIndexElectron;
-    n = fNElectrons;
-    break;
-  case AliHFEV0cuts::kRecoPionK0:
-    container = fIndexPionK0;
-    n = fNPionsK0;
-    break;
-  case AliHFEV0cuts::kRecoPionL:
-    container = fIndexPionL;
-    n = fNPionsL;
-    break;
-  case AliHFEV0cuts::kRecoProton:
-    container = fIndexProton;
-    n = fNProtons;
-    break;
-  }
-  if(!container) return kFALSE;
-  if(n == 0) return kFALSE;
-  Bool_t found = kFALSE;
-  for(Int_t i = 0; i < n; i++){
-    if(container[i] == index){
-      found = kTRUE;
-      break;
-    }
-  }
-  return found;
+  return species >= 0 && GetSpecies(index) == species;
 }
 
 //____________________________________________________________
@@ -931,10 +909,116 @@ Bool_t AliHFEV0pid::AliHFEV0pidTrackIndex::Find(Int_t index) const {
   // 
   // Find index in all samples
   //
-  if(Find(index, AliHFEV0cuts::kRecoElectron)) return kTRUE;
-  else if(Find(index, AliHFEV0cuts::kRecoPionK0)) return kTRUE;
-  else if(Find(index, AliHFEV0cuts::kRecoPionL)) return kTRUE;
-  else return Find(index, AliHFEV0cuts::kRecoProton);
+  return GetSpecies(index) >= 0;
+}
+
+//____________________________________________________________
+void AliHFEV0pid::AliHFEV0pidV0Table::Reset(){
+  //
+  // Remove the V0s of the previous event, the memory is kept
+  //
+  fV0.clear();
+  fAlpha.clear();
+  fQt.clear();
+  fP.clear();
+  fPreselection.clear();
+  fStatus.clear();
+}
+
+//____________________________________________________________
+Int_t AliHFEV0pid::AliHFEV0pidV0Table::Add(Int_t iv0, const AliESDv0 *v0, Bool_t sign){
+  //
+  // Add a V0 with the daughter sign check of AliHFEV0cuts::CheckSigns,
+  // compute its Armenteros variables as AliHFEV0cuts::Armenteros.
+  // Returns the row of the V0
+  //
+  Double_t mn[3] = {0,0,0};
+  Double_t mp[3] = {0,0,0};  
+  Double_t mm[3] = {0,0,0};  
+
+  if(sign){
+    v0->GetNPxPyPz(mn[0],mn[1],mn[2]); //reconstructed cartesian momentum components of negative daughter
+    v0->GetPPxPyPz(mp[0],mp[1],mp[2]); //reconstructed cartesian momentum components of positive daughter
+  }
+  else{
+    v0->GetPPxPyPz(mn[0],mn[1],mn[2]); //reconstructed cartesian momentum components of negative daughter
+    v0->GetNPxPyPz(mp[0],mp[1],mp[2]); //reconstructed cartesian momentum components of positive daughter
+  }
+  v0->GetPxPyPz(mm[0],mm[1],mm[2]); //reconstructed cartesian momentum components of mother
+
+  // longitudinal momenta of the daughters along the mother, p*cos(theta)
+  const Double_t pM = TMath::Sqrt(mm[0]*mm[0] + mm[1]*mm[1] + mm[2]*mm[2]);
+  const Double_t p2P = mp[0]*mp[0] + mp[1]*mp[1] + mp[2]*mp[2];
+  const Double_t lP = (mp[0]*mm[0] + mp[1]*mm[1] + mp[2]*mm[2])/pM;
+  const Double_t lN = (mn[0]*mm[0] + mn[1]*mm[1] + mn[2]*mm[2])/pM;
+
+  fV0.push_back(iv0);
+  fAlpha.push_back((lP - lN)/(lP + lN));
+  fQt.push_back(TMath::Sqrt(TMath::Max(p2P - lP*lP, 0.)));
+  fP.push_back(v0->P());
+  fPreselection.push_back(AliHFEV0cuts::kUndef);
+  fStatus.push_back(AliHFEV0cuts::kUndef);
+  return fV0.size() - 1;
+}
+
+//____________________________________________________________
+void AliHFEV0pid::AliHFEV0pidV0Table::Preselect(Int_t first){
+  //
+  // Armenteros preselection of the V0s from row first on
+  //
+  const Int_t n = fV0.size();
+  for(Int_t row = first; row < n; row++) fPreselection[row] = PreselectArmenteros(fAlpha[row], fQt[row]);
+}
+
+//____________________________________________________________
+Int_t AliHFEV0pid::AliHFEV0pidV0Table::PreselectArmenteros(Float_t alpha, Float_t qt){
+  //
+  // Possible identity of a V0 candidate from its position in the Armenteros plot
+  //
+  if(TMath::Abs(alpha) > 1) return AliHFEV0cuts::kUndef;
+
+  // Gamma cuts
+  const Double_t cutAlphaG = 0.35; 
+  const Double_t cutQTG = 0.05;
+  const Double_t cutAlphaG2[2] = {0.6, 0.8};
+  const Double_t cutQTG2 = 0.04;
+
+  // K0 cuts
+  const Float_t cutQTK0[2] = {0.1075, 0.215};
+  const Float_t cutAPK0[2] = {0.199, 0.8};   // parameters for curved QT cut
+  
+  // Lambda & A-Lambda cuts
+  const Float_t cutQTL = 0.03;
+  const Float_t cutAlphaL[2] = {0.35, 0.7};
+  const Float_t cutAlphaAL[2] = {-0.7,  -0.35};
+  const Float_t cutAPL[3] = {0.107, -0.69, 0.5};  // parameters fir curved QT cut
+
+
+  // Check for Gamma candidates
+  if(qt < cutQTG){
+    if( (TMath::Abs(alpha) < cutAlphaG) ) return  AliHFEV0cuts::kRecoGamma;
+  }
+  // additional region - should help high pT gammas
+  if(qt < cutQTG2){
+    if( (TMath::Abs(alpha) > cutAlphaG2[0]) &&  (TMath::Abs(alpha) < cutAlphaG2[1]) ) return  AliHFEV0cuts::kRecoGamma;
+  }
+
+  // Check for K0 candidates
+  Float_t q = cutAPK0[0] * TMath::Sqrt(TMath::Abs(1 - alpha*alpha/(cutAPK0[1]*cutAPK0[1])));
+  if( (qt > cutQTK0[0]) && (qt < cutQTK0[1]) && (qt > q) ) return AliHFEV0cuts::kRecoK0;
+  
+  if( (alpha > 0) && (alpha > cutAlphaL[0])  && (alpha < cutAlphaL[1]) && (qt > cutQTL)){
+    q = cutAPL[0] * TMath::Sqrt(1 - ( (alpha + cutAPL[1]) * (alpha + cutAPL[1]))  / (cutAPL[2]*cutAPL[2]) );
+    if( qt < q  ) return AliHFEV0cuts::kRecoLambda;
+  }
+
+  // Check for A-Lambda candidates
+  if( (alpha < 0) && (alpha > cutAlphaAL[0]) && (alpha < cutAlphaAL[1]) && (qt > cutQTL)){
+    q = cutAPL[0] * TMath::Sqrt(1 - ( (alpha - cutAPL[1]) * (alpha - cutAPL[1]) ) / (cutAPL[2]*cutAPL[2]) );
+    if( qt < q ) return AliHFEV0cuts::kRecoLambda;
+  }
+  
+  return AliHFEV0cuts::kUndef;
 }
 
 //____________________________________________________________
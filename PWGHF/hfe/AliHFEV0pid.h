@@ -24,6 +24,8 @@
 #include <TNamed.h>
 #endif
 
+#include <vector>
+
 class TObjArray;
 class TList;
 class TString;
@@ -70,9 +72,12 @@ class AliHFEV0pid : public TNamed{
       kAODanalysis = BIT(14)
 	};
 
-    Int_t PreselectV0(AliESDv0 * const v0, Int_t idMC);
+    Int_t ProcessV0(TObject *v0, Int_t row);
+    Int_t PreselectV0(Int_t row, Int_t idMC);
+    Int_t FillV0Table();
+    void  PublishTags() const;
 
-    void   ArmenterosPlotMC(AliESDv0 * const v0, Int_t idMC);
+    void   ArmenterosPlotMC(Int_t row, Int_t idMC);
     Bool_t IsGammaConv(TObject *v0);
     Bool_t IsK0s(TObject *v0);
     Bool_t IsPhi(const TObject *v0) const;
@@ -92,6 +97,7 @@ class AliHFEV0pid : public TNamed{
       void Add(Int_t index, Int_t species);
       Bool_t Find(Int_t index) const;
       Bool_t Find(Int_t index, Int_t species) const;
+      Int_t GetSpecies(Int_t index) const;
       Int_t GetNumberOfElectrons() const { return fNElectrons; };
       Int_t GetNumberOfPionsK0() const { return fNPionsK0; };
       Int_t GetNumberOfPionsL() const { return fNPionsL; };
@@ -107,11 +113,35 @@ class AliHFEV0pid : public TNamed{
       Int_t fNPionsL;           // Lumber of identified pions from Lambda
       Int_t fNKaons;            // Number of identified kaons
       Int_t fNProtons;          // Number of identified protons
-      Int_t *fIndexElectron;    // Indices of identified electrons
-      Int_t *fIndexPionK0;      // Indices of identified pions from K0s
-      Int_t *fIndexPionL;       // Indices of identified pions from Lambda
-      Int_t *fIndexKaon;        // Indices of identified kaons
-      Int_t *fIndexProton;      // Indices of identified protons
+      std::vector<Int_t> fSpecies; // Species of each track index, -1 if not identified
+    };
+
+    // Topological and kinematic quantities of the V0s of the event, one column per quantity,
+    // computed once per V0. The Armenteros preselection is evaluated over the columns.
+    class AliHFEV0pidV0Table{
+    public:
+      AliHFEV0pidV0Table() : fV0(), fAlpha(), fQt(), fP(), fPreselection(), fStatus() {};
+      ~AliHFEV0pidV0Table() {};
+      void Reset();
+      Int_t Add(Int_t iv0, const AliESDv0 *v0, Bool_t sign);
+      void Preselect(Int_t first = 0);
+      static Int_t PreselectArmenteros(Float_t alpha, Float_t qt);
+      Int_t GetNumberOfV0s() const { return fV0.size(); };
+      Int_t GetV0(Int_t row) const { return fV0[row]; };
+      Float_t GetAlpha(Int_t row) const { return fAlpha[row]; };
+      Float_t GetQt(Int_t row) const { return fQt[row]; };
+      Float_t GetP(Int_t row) const { return fP[row]; };
+      Int_t GetPreselection(Int_t row) const { return fPreselection[row]; };
+      Int_t GetStatus(Int_t row) const { return fStatus[row]; };
+      void SetStatus(Int_t row, Int_t status) { fStatus[row] = status; };
+
+    private:
+      std::vector<Int_t>   fV0;            // Index of the V0 in the event
+      std::vector<Float_t> fAlpha;         // Armenteros alpha
+      std::vector<Float_t> fQt;            // Armenteros qt
+      std::vector<Float_t> fP;             // V0 momentum
+      std::vector<Int_t>   fPreselection;  // Candidate identity from the Armenteros plot
+      std::vector<Int_t>   fStatus;        // Identity after all cuts (AliHFEV0cuts::kReco...)
     };
     AliHFEV0pid(const AliHFEV0pid &ref);
     AliHFEV0pid&operator=(const AliHFEV0pid &ref);
@@ -133,13 +163,14 @@ class AliHFEV0pid : public TNamed{
     TObjArray   *fAntiLambdas;       // for MC purposes - list of found anti lambdas
 
     AliHFEV0pidTrackIndex *fIndices; // Container for Track indices
+    AliHFEV0pidV0Table *fV0Table;    //! V0 quantities of the current event
     AliHFEcollection *fQA;           // Collection of QA histograms
     AliHFEV0cuts     *fV0cuts;       // separate class for studying and applying the V0 cuts
     TList       *fOutput;            // collection list
 
     UInt_t       fDestBits;              // logical bits for destructor
 
-    ClassDef(AliHFEV0pid, 1)          // V0 PID Class
+    ClassDef(AliHFEV0pid, 2)          // V0 PID Class
 
 };
 
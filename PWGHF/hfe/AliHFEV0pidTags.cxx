@@ -0,0 +1,134 @@
+/*************************************************************************
+* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+//
+// Tags of the V0 daughters and of the V0s identified by AliHFEV0pid
+// in the current event. AliHFEV0pid publishes them in the input event,
+// the other tasks of the train get them via
+//
+//   AliHFEV0pidTags *tags = AliHFEV0pidTags::GetTags(InputEvent());
+//   if(tags) species = tags->GetTrackTag(track->GetID());
+//
+// GetTags returns NULL if the tags were not produced for this event.
+//
+#include "AliAnalysisManager.h"
+#include "AliVEvent.h"
+
+#include "AliHFEV0pidTags.h"
+ClassImp(AliHFEV0pidTags)
+
+//____________________________________________________________
+AliHFEV0pidTags::AliHFEV0pidTags():
+  TNamed(GetDefaultName(), "V0 PID tags")
+  , fEventNumber(-1)
+  , fEventId(0)
+  , fTrackTags()
+  , fV0Tags()
+{
+  //
+  // Default constructor
+  //
+}
+
+//____________________________________________________________
+Int_t AliHFEV0pidTags::GetEventNumber(){
+  //
+  // Event number of the analysis manager, -1 without manager
+  //
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  return mgr ? mgr->GetNcalls() : -1;
+}
+
+//____________________________________________________________
+ULong64_t AliHFEV0pidTags::GetEventId(AliVEvent *ev){
+  //
+  // Global bunch crossing ID of the event
+  //
+  return (static_cast<ULong64_t>(ev->GetPeriodNumber()) << 36) |
+    (static_cast<ULong64_t>(ev->GetOrbitNumber()) << 12) |
+    static_cast<ULong64_t>(ev->GetBunchCrossNumber());
+}
+
+//____________________________________________________________
+Bool_t AliHFEV0pidTags::IsForEvent(AliVEvent *ev) const {
+  //
+  // Check whether the tags were produced for this event
+  //
+  if(!ev) return kFALSE;
+  return fEventNumber == GetEventNumber() && fEventId == GetEventId(ev) &&
+    fV0Tags.GetSize() == ev->GetNumberOfV0s();
+}
+
+//____________________________________________________________
+AliHFEV0pidTags *AliHFEV0pidTags::GetTags(AliVEvent *ev){
+  //
+  // Tags published in the event, NULL if missing or produced
+  // for a previous event
+  //
+  if(!ev) return NULL;
+  AliHFEV0pidTags *tags = dynamic_cast<AliHFEV0pidTags *>(ev->FindListObject(GetDefaultName()));
+  if(!tags || !tags->IsForEvent(ev)) return NULL;
+  return tags;
+}
+
+//____________________________________________________________
+AliHFEV0pidTags *AliHFEV0pidTags::GetOrCreateTags(AliVEvent *ev){
+  //
+  // Tags object of the event, added to the event at the first call.
+  // The content is not reset.
+  //
+  if(!ev) return NULL;
+  AliHFEV0pidTags *tags = dynamic_cast<AliHFEV0pidTags *>(ev->FindListObject(GetDefaultName()));
+  if(!tags){
+    tags = new AliHFEV0pidTags();
+    ev->AddObject(tags);
+  }
+  return tags;
+}
+
+//____________________________________________________________
+void AliHFEV0pidTags::Reset(AliVEvent *ev){
+  //
+  // Remove all tags and assign the tags to the event
+  //
+  fEventNumber = GetEventNumber();
+  fEventId = GetEventId(ev);
+  fTrackTags.Set(ev->GetNumberOfTracks());
+  fTrackTags.Reset(-1);
+  fV0Tags.Set(ev->GetNumberOfV0s());
+  fV0Tags.Reset(0);
+}
+
+//____________________________________________________________
+void AliHFEV0pidTags::SetTrackTag(Int_t trackID, Int_t species){
+  //
+  // Tag a V0 daughter
+  //
+  if(trackID < 0) return;
+  if(trackID >= fTrackTags.GetSize()){
+    Int_t oldSize = fTrackTags.GetSize();
+    fTrackTags.Set(trackID + 1);
+    for(Int_t i = oldSize; i < trackID; i++) fTrackTags[i] = -1;
+  }
+  fTrackTags[trackID] = species;
+}
+
+//____________________________________________________________
+void AliHFEV0pidTags::SetV0Tag(Int_t iv0, Int_t status){
+  //
+  // Tag a V0
+  //
+  if(iv0 < 0 || iv0 >= fV0Tags.GetSize()) return;
+  fV0Tags[iv0] = status;
+}
@@ -0,0 +1,65 @@
+/**************************************************************************
+* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+//
+// Tags of the V0 daughters and of the V0s identified by AliHFEV0pid
+// in the current event, published in the input event for the other
+// tasks of the train
+//
+#ifndef ALIHFEV0PIDTAGS_H
+#define ALIHFEV0PIDTAGS_H
+
+#ifndef ROOT_TNamed
+#include <TNamed.h>
+#endif
+
+#ifndef ROOT_TArrayI
+#include <TArrayI.h>
+#endif
+
+class AliVEvent;
+
+class AliHFEV0pidTags : public TNamed{
+  public:
+    AliHFEV0pidTags();
+    ~AliHFEV0pidTags() {};
+
+    static const char *GetDefaultName() { return "AliHFEV0pidTags"; }
+    static AliHFEV0pidTags *GetTags(AliVEvent *ev);
+    static AliHFEV0pidTags *GetOrCreateTags(AliVEvent *ev);
+
+    void  Reset(AliVEvent *ev);
+    void  SetTrackTag(Int_t trackID, Int_t species);
+    void  SetV0Tag(Int_t iv0, Int_t status);
+
+    Int_t GetTrackTag(Int_t trackID) const { return (trackID >= 0 && trackID < fTrackTags.GetSize()) ? fTrackTags[trackID] : -1; }
+    Int_t GetV0Tag(Int_t iv0) const { return (iv0 >= 0 && iv0 < fV0Tags.GetSize()) ? fV0Tags[iv0] : 0; }
+    Bool_t IsForEvent(AliVEvent *ev) const;
+
+  private:
+    AliHFEV0pidTags(const AliHFEV0pidTags &ref);
+    AliHFEV0pidTags &operator=(const AliHFEV0pidTags &ref);
+
+    static Int_t GetEventNumber();
+    static ULong64_t GetEventId(AliVEvent *ev);
+
+    Int_t     fEventNumber;      // Analysis manager event number of the tags
+    ULong64_t fEventId;          // Bunch crossing, orbit and period of the event of the tags
+    TArrayI   fTrackTags;        // Species of the V0 daughters (AliHFEV0cuts::kRecoElectron...), -1 if not tagged, by track ID
+    TArrayI   fV0Tags;           // Identity of the V0s (AliHFEV0cuts::kRecoGamma...), 0 if not identified, by V0 index
+
+    ClassDef(AliHFEV0pidTags, 1)      // V0 PID tags of the event
+};
+
+#endif
@@ -24,6 +24,7 @@
 
 #pragma link C++ class  AliHFEV0info+;
 #pragma link C++ class  AliHFEV0pid+;
+#pragma link C++ class  AliHFEV0pidTags+;
 #pragma link C++ class  AliHFEV0cuts+;
 #pragma link C++ class  AliHFEV0pidMC+;
 #pragma link C++ class  AliHFEpidQA+;
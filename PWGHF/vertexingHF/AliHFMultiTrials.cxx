@@ -22,6 +22,11 @@
 #include <TF1.h>
 #include <TLatex.h>
 #include <TFile.h>
+#include <TVectorD.h>
+#include <RVersion.h>
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0)
+#include <ROOT/TProcessExecutor.hxx>
+#endif
 #include "AliHFMassFitter.h"
 #include "AliHFMassFitterVAR.h"
 #include "AliHFMultiTrials.h"
@@ -65,6 +70,8 @@ AliHFMultiTrials::AliHFMultiTrials() :
   fUseFixSigFixMean(kTRUE),
   fSaveBkgVal(kFALSE),
   fDrawIndividualFits(kFALSE),
+  fNumOfParallelWorkers(1),
+  fUseWarmStart(kFALSE),
   fHistoRawYieldDistAll(0x0),
   fHistoRawYieldTrialAll(0x0),
   fHistoSigmaTrialAll(0x0),
@@ -186,17 +193,97 @@ Bool_t AliHFMultiTrials::CreateHistos(){
 
 }
 
+//________________________________________________________________________
+Bool_t AliHFMultiTrials::IsBkgFuncEnabled(Int_t typeb) const{
+  // check if the background function is used in the trials
+  if(typeb==kExpoBkg && !fUseExpoBkg) return kFALSE;
+  if(typeb==kLinBkg && !fUseLinBkg) return kFALSE;
+  if(typeb==kPol2Bkg && !fUsePol2Bkg) return kFALSE;
+  if(typeb==kPol3Bkg && !fUsePol3Bkg) return kFALSE;
+  if(typeb==kPol4Bkg && !fUsePol4Bkg) return kFALSE;
+  if(typeb==kPol5Bkg && !fUsePol5Bkg) return kFALSE;
+  if(typeb==kPowBkg && !fUsePowLawBkg) return kFALSE;
+  if(typeb==kPowTimesExpoBkg && !fUsePowLawTimesExpoBkg) return kFALSE;
+  return kTRUE;
+}
+
+//________________________________________________________________________
+Bool_t AliHFMultiTrials::IsFitConfEnabled(Int_t igs) const{
+  // check if the sigma/mean configuration is used in the trials
+  if (igs==kFixSigUpFreeMean && !fUseFixSigUpFreeMean) return kFALSE;
+  if (igs==kFixSigDownFreeMean && !fUseFixSigDownFreeMean) return kFALSE;
+  if (igs==kFreeSigFixMean  && !fUseFixedMeanFreeS) return kFALSE;
+  if (igs==kFreeSigFreeMean  && !fUseFreeS) return kFALSE;
+  if (igs==kFixSigFreeMean  && !fUseFixSigFreeMean) return kFALSE;
+  if (igs==kFixSigFixMean   && !fUseFixSigFixMean) return kFALSE;
+  return kTRUE;
+}
+
+//________________________________________________________________________
+Bool_t AliHFMultiTrials::IsGoodFit(const Double_t* trialRes) const{
+  // quality cuts on the fit result
+  Double_t sigma=trialRes[kSigma];
+  return (trialRes[kFitOK]>0.5 && trialRes[kChi2]>0. && sigma>0.5*fSigmaGausMC && sigma<2.0*fSigmaGausMC);
+}
+
 //________________________________________________________________________
 Bool_t AliHFMultiTrials::DoMultiTrials(TH1D* hInvMassHisto, TPad* thePad){
   // perform the multiple fits
+  // The trials are grouped in chains with the same rebin, first bin,
+  // background function and sigma/mean configuration, differing only in the
+  // fit range. The chains are independent and are fitted either serially or
+  // in parallel worker processes (the mass fitter relies on the global
+  // TMinuit and on TF1s looked up by name, so it cannot run in threads).
+  // The histograms and the ntuple are filled afterwards in the trial order.
 
   Bool_t hOK=CreateHistos();
   if(!hOK) return kFALSE;
 
+  const Int_t nChains=fNumOfRebinSteps*fNumOfFirstBinSteps*kNBkgFuncCases*kNFitConfCases;
+  std::vector<Int_t> chains;
+  for(Int_t ir=0; ir<fNumOfRebinSteps; ir++){
+    for(Int_t iFirstBin=1; iFirstBin<=fNumOfFirstBinSteps; iFirstBin++) {
+      for(Int_t typeb=0; typeb<kNBkgFuncCases; typeb++){
+        if(!IsBkgFuncEnabled(typeb)) continue;
+        for(Int_t igs=0; igs<kNFitConfCases; igs++){
+          if(!IsFitConfEnabled(igs)) continue;
+          chains.push_back(GetChainIndex(ir,iFirstBin,typeb,igs));
+        }
+      }
+    }
+  }
+
+  Int_t nWorkers=TMath::Min(fNumOfParallelWorkers,(Int_t)chains.size());
+  if(nWorkers>1 && fDrawIndividualFits && thePad){
+    printf("AliHFMultiTrials: individual fits are drawn, fits are done serially\n");
+    nWorkers=1;
+  }
+  std::vector<TVectorD*> chainResults(nChains,(TVectorD*)0x0);
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0)
+  if(nWorkers>1){
+    ROOT::TProcessExecutor pool(nWorkers);
+    std::vector<TVectorD*> poolResults=pool.Map([&](Int_t iChain){ return DoTrialChain(hInvMassHisto,iChain,0x0); },chains);
+    // results carry their chain index, independently of the order of the workers
+    for(UInt_t jc=0; jc<poolResults.size(); jc++){
+      if(!poolResults[jc]) continue;
+      Int_t iChain=TMath::Nint((*poolResults[jc])[0]);
+      chainResults[iChain]=poolResults[jc];
+    }
+  }
+#else
+  if(nWorkers>1){
+    printf("AliHFMultiTrials: parallel fits need ROOT >= 6.10, fits are done serially\n");
+    nWorkers=1;
+  }
+#endif
+  if(nWorkers<=1){
+    for(UInt_t jc=0; jc<chains.size(); jc++) chainResults[chains[jc]]=DoTrialChain(hInvMassHisto,chains[jc],thePad);
+  }
+
   Int_t itrial=0;
-  Int_t types=0;
   Int_t itrialBC=0;
   Int_t totTrials=fNumOfRebinSteps*fNumOfFirstBinSteps*fNumOfLowLimFitSteps*fNumOfUpLimFitSteps;
+  const Int_t nResPerTrial=GetNumOfResultsPerTrial();
 
   fMinYieldGlob=999999.;
   fMaxYieldGlob=0.;
@@ -205,62 +292,25 @@ Bool_t AliHFMultiTrials::DoMultiTrials(TH1D* hInvMassHisto, TPad* thePad){
   for(Int_t ir=0; ir<fNumOfRebinSteps; ir++){
     Int_t rebin=fRebinSteps[ir];
     for(Int_t iFirstBin=1; iFirstBin<=fNumOfFirstBinSteps; iFirstBin++) {
-      TH1F* hRebinned=0x0;
-      if(fNumOfFirstBinSteps==1) hRebinned=RebinHisto(hInvMassHisto,rebin,-1);
-      else hRebinned=RebinHisto(hInvMassHisto,rebin,iFirstBin);
       for(Int_t iMinMass=0; iMinMass<fNumOfLowLimFitSteps; iMinMass++){
         Double_t minMassForFit=fLowLimFitSteps[iMinMass];
-        Double_t hmin=TMath::Max(minMassForFit,hRebinned->GetBinLowEdge(2));
         for(Int_t iMaxMass=0; iMaxMass<fNumOfUpLimFitSteps; iMaxMass++){
           Double_t maxMassForFit=fUpLimFitSteps[iMaxMass];
-          Double_t hmax=TMath::Min(maxMassForFit,hRebinned->GetBinLowEdge(hRebinned->GetNbinsX()));
           ++itrial;
           for(Int_t typeb=0; typeb<kNBkgFuncCases; typeb++){
-            if(typeb==kExpoBkg && !fUseExpoBkg) continue;
-            if(typeb==kLinBkg && !fUseLinBkg) continue;
-            if(typeb==kPol2Bkg && !fUsePol2Bkg) continue;
-            if(typeb==kPol3Bkg && !fUsePol3Bkg) continue;
-            if(typeb==kPol4Bkg && !fUsePol4Bkg) continue;
-            if(typeb==kPol5Bkg && !fUsePol5Bkg) continue;
-            if(typeb==kPowBkg && !fUsePowLawBkg) continue;
-            if(typeb==kPowTimesExpoBkg && !fUsePowLawTimesExpoBkg) continue;
+            if(!IsBkgFuncEnabled(typeb)) continue;
             for(Int_t igs=0; igs<kNFitConfCases; igs++){
-              if (igs==kFixSigUpFreeMean && !fUseFixSigUpFreeMean) continue;
-              if (igs==kFixSigDownFreeMean && !fUseFixSigDownFreeMean) continue;
-              if (igs==kFreeSigFixMean  && !fUseFixedMeanFreeS) continue;
-              if (igs==kFreeSigFreeMean  && !fUseFreeS) continue;
-              if (igs==kFixSigFreeMean  && !fUseFixSigFreeMean) continue;
-              if (igs==kFixSigFixMean   && !fUseFixSigFixMean) continue;
+              if(!IsFitConfEnabled(igs)) continue;
+              TVectorD* chainRes=chainResults[GetChainIndex(ir,iFirstBin,typeb,igs)];
+              if(!chainRes){
+                printf("AliHFMultiTrials: missing result for rebin %d first bin %d bkg func %d config %d\n",rebin,iFirstBin,typeb,igs);
+                continue;
+              }
+              const Double_t* trialRes=chainRes->GetMatrixArray()+1+(iMinMass*fNumOfUpLimFitSteps+iMaxMass)*nResPerTrial;
               Int_t theCase=igs*kNBkgFuncCases+typeb;
               Int_t globBin=itrial+theCase*totTrials;
               for(Int_t j=0; j<15; j++) xnt[j]=0.;
 
-              Bool_t mustDeleteFitter = kTRUE;
-              AliHFMassFitterVAR*  fitter=0x0;
-              //if D0 Reflection
-              if(fhTemplRefl){
-                fitter=new AliHFMassFitterVAR(hRebinned,hmin,hmax,1,typeb,2);
-                fitter->SetTemplateReflections(fhTemplRefl);
-                fitter->SetFixReflOverS(fFixRefloS,kTRUE);
-              }
-              else {
-                if(typeb<=kPol2Bkg){
-                  fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,typeb,types);
-                }else if(typeb==kPowBkg){
-                  fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,4,types);
-                }else if(typeb==kPowTimesExpoBkg){
-                  fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,5,types);
-                }else{
-                  fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,6,types);
-                  if(typeb==kPol3Bkg) fitter->SetBackHighPolDegree(3);
-                  if(typeb==kPol4Bkg) fitter->SetBackHighPolDegree(4);
-                  if(typeb==kPol5Bkg) fitter->SetBackHighPolDegree(5);
-                }
-                fitter->SetReflectionSigmaFactor(0);
-              }
-              if(fFitOption==1) fitter->SetUseChi2Fit();
-              fitter->SetInitialGaussianMean(fMassD);
-              fitter->SetInitialGaussianSigma(fSigmaGausMC);
               xnt[0]=rebin;
               xnt[1]=iFirstBin;
               xnt[2]=minMassForFit;
@@ -268,95 +318,35 @@ Bool_t AliHFMultiTrials::DoMultiTrials(TH1D* hInvMassHisto, TPad* thePad){
               xnt[4]=typeb;
               xnt[6]=0;
               if(igs==kFixSigFreeMean){
-                fitter->SetFixGaussianSigma(fSigmaGausMC,kTRUE);
                 xnt[5]=1;
               }else if(igs==kFixSigUpFreeMean){
-                fitter->SetFixGaussianSigma(fSigmaGausMC*(1.+fSigmaMCVariation),kTRUE);
                 xnt[5]=2;
               }else if(igs==kFixSigDownFreeMean){
-                fitter->SetFixGaussianSigma(fSigmaGausMC*(1.-fSigmaMCVariation),kTRUE);
                 xnt[5]=3;
               }else if(igs==kFreeSigFreeMean){
                 xnt[5]=0;
               }else if(igs==kFixSigFixMean){
-                fitter->SetFixGaussianSigma(fSigmaGausMC,kTRUE);
-                fitter->SetFixGaussianMean(fMassD,kTRUE);
                 xnt[5]=1;
                 xnt[6]=1;
               }else if(igs==kFreeSigFixMean){
-                fitter->SetFixGaussianMean(fMassD,kTRUE);
                 xnt[5]=0;
                 xnt[6]=1;
               }
-              Bool_t out=kFALSE;
-              Double_t chisq=-1.;
-              Double_t sigma=0.;
-              Double_t esigma=0.;
-              Double_t pos=.0;
-              Double_t epos=.0;
-              Double_t ry=.0;
-              Double_t ery=.0;
-              Double_t significance=0.;
-              Double_t erSignif=0.;
-              Double_t bkg=0.;
-              Double_t erbkg=0.;
-              Double_t bkgBEdge=0;
-              Double_t erbkgBEdge=0;
-              TF1* fB1=0x0;
-              if(typeb<kNBkgFuncCases){
-                printf("****** START FIT OF HISTO %s WITH REBIN %d FIRST BIN %d MASS RANGE %f-%f BACKGROUND FIT FUNCTION=%d CONFIG SIGMA/MEAN=%d\n",hInvMassHisto->GetName(),rebin,iFirstBin,minMassForFit,maxMassForFit,typeb,igs);
-                out=fitter->MassFitter(0);
-                chisq=fitter->GetReducedChiSquare();
-                fitter->Significance(fnSigmaForBkgEval,significance,erSignif);
-                sigma=fitter->GetSigma();
-                pos=fitter->GetMean();
-                esigma=fitter->GetSigmaUncertainty();
-                if(esigma<0.00001) esigma=0.0001;
-                epos=fitter->GetMeanUncertainty();
-                if(epos<0.00001) epos=0.0001;
-                ry=fitter->GetRawYield();
-                ery=fitter->GetRawYieldError();
-                fB1=fitter->GetBackgroundFullRangeFunc();
-                fitter->Background(fnSigmaForBkgEval,bkg,erbkg);
-                Double_t minval = hInvMassHisto->GetXaxis()->GetBinLowEdge(hInvMassHisto->FindBin(pos-fnSigmaForBkgEval*sigma));
-                Double_t maxval = hInvMassHisto->GetXaxis()->GetBinUpEdge(hInvMassHisto->FindBin(pos+fnSigmaForBkgEval*sigma));
-                fitter->Background(minval,maxval,bkgBEdge,erbkgBEdge);
-                if(out && fDrawIndividualFits && thePad){
-                  thePad->Clear();
-                  fitter->DrawHere(thePad, fnSigmaForBkgEval);
-                  fMassFitters.push_back(fitter);
-                  mustDeleteFitter = kFALSE;
-                  for (auto format : fInvMassFitSaveAsFormats) {
-                    thePad->SaveAs(Form("FitOutput_%s_Trial%d.%s",hInvMassHisto->GetName(),globBin, format.c_str()));
-                  }
-                }
-              }
-              // else{
-              //   out=DoFitWithPol3Bkg(hRebinned,hmin,hmax,igs);
-              //   if(out && thePad){
-              // 	thePad->Clear();
-              // 	hRebinned->Draw();
-              // 	TF1* fSB=(TF1*)hRebinned->GetListOfFunctions()->FindObject("fSB");
-              // 	fB1=new TF1("fB1","[0]+[1]*x+[2]*x*x+[3]*x*x*x",hmin,hmax);
-              // 	for(Int_t j=0; j<4; j++) fB1->SetParameter(j,fSB->GetParameter(3+j));
-              // 	fB1->SetLineColor(2);
-              // 	fB1->Draw("same");
-              // 	fSB->SetLineColor(4);
-              // 	fSB->Draw("same");
-              // 	thePad->Update();
-              // 	chisq=fSB->GetChisquare()/fSB->GetNDF();;
-              // 	sigma=fSB->GetParameter(2);
-              // 	esigma=fSB->GetParError(2);
-              // 	if(esigma<0.00001) esigma=0.0001;
-              // 	pos=fSB->GetParameter(1);
-              // 	epos=fSB->GetParError(1);
-              // 	if(epos<0.00001) epos=0.0001;
-              // 	ry=fSB->GetParameter(0)/hRebinned->GetBinWidth(1);
-              // 	ery=fSB->GetParError(0)/hRebinned->GetBinWidth(1);
-              //   }
-              // }
+              Double_t chisq=trialRes[kChi2];
+              Double_t sigma=trialRes[kSigma];
+              Double_t esigma=trialRes[kErrSigma];
+              Double_t pos=trialRes[kMean];
+              Double_t epos=trialRes[kErrMean];
+              Double_t ry=trialRes[kRawYield];
+              Double_t ery=trialRes[kErrRawYield];
+              Double_t significance=trialRes[kSignif];
+              Double_t erSignif=trialRes[kErrSignif];
+              Double_t bkg=trialRes[kBkg];
+              Double_t erbkg=trialRes[kErrBkg];
+              Double_t bkgBEdge=trialRes[kBkgBinEdges];
+              Double_t erbkgBEdge=trialRes[kErrBkgBinEdges];
               xnt[7]=chisq;
-              if(out && chisq>0. && sigma>0.5*fSigmaGausMC && sigma<2.0*fSigmaGausMC){
+              if(IsGoodFit(trialRes)){
                 xnt[8]=significance;
                 xnt[9]=pos;
                 xnt[10]=epos;
@@ -403,14 +393,10 @@ Bool_t AliHFMultiTrials::DoMultiTrials(TH1D* hInvMassHisto, TPad* thePad){
                 }
 
                 for(Int_t iStepBC=0; iStepBC<fNumOfnSigmaBinCSteps; iStepBC++){
-                  Double_t minMassBC=fMassD-fnSigmaBinCSteps[iStepBC]*sigma;
-                  Double_t maxMassBC=fMassD+fnSigmaBinCSteps[iStepBC]*sigma;
-                  if(minMassBC>minMassForFit &&
-                      maxMassBC<maxMassForFit &&
-                      minMassBC>(hRebinned->GetXaxis()->GetXmin()) &&
-                      maxMassBC<(hRebinned->GetXaxis()->GetXmax())){
-                    Double_t cnts,ecnts;
-                    BinCount(hRebinned,fB1,1,minMassBC,maxMassBC,cnts,ecnts);
+                  const Double_t* bcRes=trialRes+kNFitResults+3*iStepBC;
+                  if(bcRes[0]>0.5){
+                    Double_t cnts=bcRes[1];
+                    Double_t ecnts=bcRes[2];
                     ++itrialBC;
                     fHistoRawYieldDistBinCAll->Fill(cnts);
                     fHistoRawYieldTrialBinCAll->SetBinContent(globBin,iStepBC+1,cnts);
@@ -421,18 +407,174 @@ Bool_t AliHFMultiTrials::DoMultiTrials(TH1D* hInvMassHisto, TPad* thePad){
                   }
                 }
               }
-              if (mustDeleteFitter) delete fitter;
               fNtupleMultiTrials->Fill(xnt);
             }
           }
         }
       }
-      delete hRebinned;
     }
   }
+  for(UInt_t jc=0; jc<chainResults.size(); jc++) delete chainResults[jc];
   return kTRUE;
 }
 
+//________________________________________________________________________
+TVectorD* AliHFMultiTrials::DoTrialChain(TH1D* hInvMassHisto, Int_t iChain, TPad* thePad){
+  // perform the fits of all the fit ranges for one rebin, first bin,
+  // background function and sigma/mean configuration
+  // The returned vector contains the chain index followed by the
+  // results of each trial (fit results and bin counts, see EFitResults)
+
+  Int_t igs=iChain%kNFitConfCases;
+  Int_t typeb=(iChain/kNFitConfCases)%kNBkgFuncCases;
+  Int_t iFirstBin=(iChain/(kNFitConfCases*kNBkgFuncCases))%fNumOfFirstBinSteps+1;
+  Int_t ir=iChain/(kNFitConfCases*kNBkgFuncCases*fNumOfFirstBinSteps);
+  Int_t rebin=fRebinSteps[ir];
+  Int_t types=0;
+  Int_t theCase=igs*kNBkgFuncCases+typeb;
+  Int_t totTrials=fNumOfRebinSteps*fNumOfFirstBinSteps*fNumOfLowLimFitSteps*fNumOfUpLimFitSteps;
+  const Int_t nResPerTrial=GetNumOfResultsPerTrial();
+
+  TVectorD* chainRes=new TVectorD(1+fNumOfLowLimFitSteps*fNumOfUpLimFitSteps*nResPerTrial);
+  (*chainRes)[0]=iChain;
+
+  TH1F* hRebinned=0x0;
+  if(fNumOfFirstBinSteps==1) hRebinned=RebinHisto(hInvMassHisto,rebin,-1);
+  else hRebinned=RebinHisto(hInvMassHisto,rebin,iFirstBin);
+
+  // initial values of mean and sigma, updated after each good fit with warm start
+  Double_t initMean=fMassD;
+  Double_t initSigma=fSigmaGausMC;
+
+  for(Int_t iMinMass=0; iMinMass<fNumOfLowLimFitSteps; iMinMass++){
+    Double_t minMassForFit=fLowLimFitSteps[iMinMass];
+    Double_t hmin=TMath::Max(minMassForFit,hRebinned->GetBinLowEdge(2));
+    for(Int_t iMaxMass=0; iMaxMass<fNumOfUpLimFitSteps; iMaxMass++){
+      Double_t maxMassForFit=fUpLimFitSteps[iMaxMass];
+      Double_t hmax=TMath::Min(maxMassForFit,hRebinned->GetBinLowEdge(hRebinned->GetNbinsX()));
+      Int_t itrial=((ir*fNumOfFirstBinSteps+iFirstBin-1)*fNumOfLowLimFitSteps+iMinMass)*fNumOfUpLimFitSteps+iMaxMass+1;
+      Int_t globBin=itrial+theCase*totTrials;
+      Double_t* trialRes=chainRes->GetMatrixArray()+1+(iMinMass*fNumOfUpLimFitSteps+iMaxMass)*nResPerTrial;
+
+      Bool_t mustDeleteFitter = kTRUE;
+      AliHFMassFitterVAR*  fitter=0x0;
+      //if D0 Reflection
+      if(fhTemplRefl){
+        fitter=new AliHFMassFitterVAR(hRebinned,hmin,hmax,1,typeb,2);
+        fitter->SetTemplateReflections(fhTemplRefl);
+        fitter->SetFixReflOverS(fFixRefloS,kTRUE);
+      }
+      else {
+        if(typeb<=kPol2Bkg){
+          fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,typeb,types);
+        }else if(typeb==kPowBkg){
+          fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,4,types);
+        }else if(typeb==kPowTimesExpoBkg){
+          fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,5,types);
+        }else{
+          fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,6,types);
+          if(typeb==kPol3Bkg) fitter->SetBackHighPolDegree(3);
+          if(typeb==kPol4Bkg) fitter->SetBackHighPolDegree(4);
+          if(typeb==kPol5Bkg) fitter->SetBackHighPolDegree(5);
+        }
+        fitter->SetReflectionSigmaFactor(0);
+      }
+      if(fFitOption==1) fitter->SetUseChi2Fit();
+      fitter->SetInitialGaussianMean(initMean);
+      fitter->SetInitialGaussianSigma(initSigma);
+      if(igs==kFixSigFreeMean){
+        fitter->SetFixGaussianSigma(fSigmaGausMC,kTRUE);
+      }else if(igs==kFixSigUpFreeMean){
+        fitter->SetFixGaussianSigma(fSigmaGausMC*(1.+fSigmaMCVariation),kTRUE);
+      }else if(igs==kFixSigDownFreeMean){
+        fitter->SetFixGaussianSigma(fSigmaGausMC*(1.-fSigmaMCVariation),kTRUE);
+      }else if(igs==kFixSigFixMean){
+        fitter->SetFixGaussianSigma(fSigmaGausMC,kTRUE);
+        fitter->SetFixGaussianMean(fMassD,kTRUE);
+      }else if(igs==kFreeSigFixMean){
+        fitter->SetFixGaussianMean(fMassD,kTRUE);
+      }
+      Bool_t out=kFALSE;
+      Double_t chisq=-1.;
+      Double_t sigma=0.;
+      Double_t esigma=0.;
+      Double_t pos=.0;
+      Double_t epos=.0;
+      Double_t ry=.0;
+      Double_t ery=.0;
+      Double_t significance=0.;
+      Double_t erSignif=0.;
+      Double_t bkg=0.;
+      Double_t erbkg=0.;
+      Double_t bkgBEdge=0;
+      Double_t erbkgBEdge=0;
+      TF1* fB1=0x0;
+      printf("****** START FIT OF HISTO %s WITH REBIN %d FIRST BIN %d MASS RANGE %f-%f BACKGROUND FIT FUNCTION=%d CONFIG SIGMA/MEAN=%d\n",hInvMassHisto->GetName(),rebin,iFirstBin,minMassForFit,maxMassForFit,typeb,igs);
+      out=fitter->MassFitter(0);
+      chisq=fitter->GetReducedChiSquare();
+      fitter->Significance(fnSigmaForBkgEval,significance,erSignif);
+      sigma=fitter->GetSigma();
+      pos=fitter->GetMean();
+      esigma=fitter->GetSigmaUncertainty();
+      if(esigma<0.00001) esigma=0.0001;
+      epos=fitter->GetMeanUncertainty();
+      if(epos<0.00001) epos=0.0001;
+      ry=fitter->GetRawYield();
+      ery=fitter->GetRawYieldError();
+      fB1=fitter->GetBackgroundFullRangeFunc();
+      fitter->Background(fnSigmaForBkgEval,bkg,erbkg);
+      Double_t minval = hInvMassHisto->GetXaxis()->GetBinLowEdge(hInvMassHisto->FindBin(pos-fnSigmaForBkgEval*sigma));
+      Double_t maxval = hInvMassHisto->GetXaxis()->GetBinUpEdge(hInvMassHisto->FindBin(pos+fnSigmaForBkgEval*sigma));
+      fitter->Background(minval,maxval,bkgBEdge,erbkgBEdge);
+      if(out && fDrawIndividualFits && thePad){
+        thePad->Clear();
+        fitter->DrawHere(thePad, fnSigmaForBkgEval);
+        fMassFitters.push_back(fitter);
+        mustDeleteFitter = kFALSE;
+        for (auto format : fInvMassFitSaveAsFormats) {
+          thePad->SaveAs(Form("FitOutput_%s_Trial%d.%s",hInvMassHisto->GetName(),globBin, format.c_str()));
+        }
+      }
+
+      trialRes[kFitOK]=out;
+      trialRes[kChi2]=chisq;
+      trialRes[kSignif]=significance;
+      trialRes[kErrSignif]=erSignif;
+      trialRes[kMean]=pos;
+      trialRes[kErrMean]=epos;
+      trialRes[kSigma]=sigma;
+      trialRes[kErrSigma]=esigma;
+      trialRes[kRawYield]=ry;
+      trialRes[kErrRawYield]=ery;
+      trialRes[kBkg]=bkg;
+      trialRes[kErrBkg]=erbkg;
+      trialRes[kBkgBinEdges]=bkgBEdge;
+      trialRes[kErrBkgBinEdges]=erbkgBEdge;
+      if(IsGoodFit(trialRes)){
+        for(Int_t iStepBC=0; iStepBC<fNumOfnSigmaBinCSteps; iStepBC++){
+          Double_t minMassBC=fMassD-fnSigmaBinCSteps[iStepBC]*sigma;
+          Double_t maxMassBC=fMassD+fnSigmaBinCSteps[iStepBC]*sigma;
+          if(minMassBC>minMassForFit &&
+              maxMassBC<maxMassForFit &&
+              minMassBC>(hRebinned->GetXaxis()->GetXmin()) &&
+              maxMassBC<(hRebinned->GetXaxis()->GetXmax())){
+            Double_t* bcRes=trialRes+kNFitResults+3*iStepBC;
+            BinCount(hRebinned,fB1,1,minMassBC,maxMassBC,bcRes[1],bcRes[2]);
+            bcRes[0]=1.;
+          }
+        }
+        if(fUseWarmStart){
+          initMean=pos;
+          initSigma=sigma;
+        }
+      }
+      if (mustDeleteFitter) delete fitter;
+    }
+  }
+  delete hRebinned;
+  return chainRes;
+}
+
 //________________________________________________________________________
 void AliHFMultiTrials::SaveToRoot(TString fileName, TString option) const{
   // save histos in a root file for further analysis
@@ -6,6 +6,7 @@
 #include <TNamed.h>
 #include <TString.h>
 #include <TPad.h>
+#include <TVectorDfwd.h>
 #include <set>
 #include <vector>
 
@@ -86,6 +87,11 @@ class AliHFMultiTrials : public TNamed {
 
   void SetDrawIndividualFits(Bool_t opt=kTRUE){fDrawIndividualFits=opt;}
 
+  /// number of parallel worker processes for the fits (1 = serial, needs ROOT >= 6.10)
+  void SetNumOfParallelWorkers(Int_t nw){fNumOfParallelWorkers=nw;}
+  /// start each fit from the mean and sigma of the previous good fit with the same configuration
+  void SetUseWarmStart(Bool_t opt=kTRUE){fUseWarmStart=opt;}
+
   Bool_t DoMultiTrials(TH1D* hInvMassHisto, TPad* thePad=0x0);
   void SaveToRoot(TString fileName, TString option="recreate") const;
   void DrawHistos(TCanvas* cry) const;
@@ -102,7 +108,18 @@ class AliHFMultiTrials : public TNamed {
 
  private:
 
+  /// fit results stored for each trial
+  enum EFitResults{ kFitOK, kChi2, kSignif, kErrSignif, kMean, kErrMean, kSigma, kErrSigma, kRawYield, kErrRawYield, kBkg, kErrBkg, kBkgBinEdges, kErrBkgBinEdges, kNFitResults };
+
   Bool_t CreateHistos();
+  Bool_t IsBkgFuncEnabled(Int_t typeb) const;
+  Bool_t IsFitConfEnabled(Int_t igs) const;
+  Bool_t IsGoodFit(const Double_t* trialRes) const;
+  Int_t GetChainIndex(Int_t ir, Int_t iFirstBin, Int_t typeb, Int_t igs) const {
+    return ((ir*fNumOfFirstBinSteps+iFirstBin-1)*kNBkgFuncCases+typeb)*kNFitConfCases+igs;
+  }
+  Int_t GetNumOfResultsPerTrial() const {return kNFitResults+3*fNumOfnSigmaBinCSteps;}
+  TVectorD* DoTrialChain(TH1D* hInvMassHisto, Int_t iChain, TPad* thePad);
   TH1F* RebinHisto(TH1D* hOrig, Int_t reb, Int_t firstUse) const;
   void BinCount(TH1F* h, TF1* fB, Int_t rebin, Double_t minMass, Double_t maxMass, Double_t& count, Double_t& ecount) const;
   Bool_t DoFitWithPol3Bkg(TH1F* histoToFit, Double_t  hmin, Double_t  hmax,
@@ -146,6 +163,8 @@ class AliHFMultiTrials : public TNamed {
   Bool_t fSaveBkgVal;		/// switch for saving bkg values in nsigma
 
   Bool_t fDrawIndividualFits; /// flag for drawing fits
+  Int_t fNumOfParallelWorkers; /// number of parallel worker processes for the fits
+  Bool_t fUseWarmStart;       /// flag for initialising the fit from the previous trial
 
   TH1F* fHistoRawYieldDistAll;  /// histo with yield from all trials
   TH1F* fHistoRawYieldTrialAll; /// histo with yield from all trials
@@ -180,7 +199,7 @@ class AliHFMultiTrials : public TNamed {
   std::vector<AliHFMassFitterVAR*> fMassFitters; //!<! Mass fitters
 
   /// \cond CLASSIMP
-  ClassDef(AliHFMultiTrials,5); /// class for multiple trials of invariant mass fit
+  ClassDef(AliHFMultiTrials,6); /// class for multiple trials of invariant mass fit
   /// \endcond
 };
 
@@ -0,0 +1,310 @@
+/**************************************************************************
+ * Copyright(c) 1998-2019, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+/////////////////////////////////////////////////////////////
+///
+/// Event-scoped cache of the primary vertices recomputed without
+/// the daughters of heavy-flavour candidates
+///
+/////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <TMath.h>
+#include <TString.h>
+#include "AliExternalTrackParam.h"
+#include "AliAODEvent.h"
+#include "AliAODTrack.h"
+#include "AliAODVertex.h"
+#include "AliAODRecoDecayHF.h"
+#include "AliHFPrimaryVertexCache.h"
+
+/// \cond CLASSIMP
+ClassImp(AliHFPrimaryVertexCache);
+/// \endcond
+
+AliHFPrimaryVertexCache* AliHFPrimaryVertexCache::fgInstance=0x0;
+
+//--------------------------------------------------------------------------
+AliHFPrimaryVertexCache::AliHFPrimaryVertexCache() :
+  TObject(),
+  fEvent(0x0),
+  fRunNumber(-1),
+  fPeriod(0),
+  fOrbit(0),
+  fBC(0),
+  fNTracks(-1),
+  fVtxZ(-999.),
+  fVertices(),
+  fFitSumsBuilt(kFALSE),
+  fFitSumsValid(kFALSE),
+  fNContributors(0),
+  fSumrWr(0.),
+  fContribIndex(),
+  fContrib()
+{
+  //
+  // Default Constructor
+  //
+  for(Int_t i=0; i<6; i++) fSumW[i]=0.;
+  for(Int_t i=0; i<3; i++) fSumWr[i]=0.;
+}
+//--------------------------------------------------------------------------
+AliHFPrimaryVertexCache::~AliHFPrimaryVertexCache()
+{
+  //
+  // Destructor
+  //
+  Clear();
+}
+//--------------------------------------------------------------------------
+AliHFPrimaryVertexCache* AliHFPrimaryVertexCache::Instance()
+{
+  //
+  // Instance shared by all the cut objects
+  //
+  if(!fgInstance) fgInstance=new AliHFPrimaryVertexCache();
+  return fgInstance;
+}
+//--------------------------------------------------------------------------
+void AliHFPrimaryVertexCache::Clear(Option_t *)
+{
+  //
+  // Delete the cached vertices and the fit sums
+  //
+  for(std::map<std::vector<Int_t>,AliAODVertex*>::iterator it=fVertices.begin(); it!=fVertices.end(); ++it) delete it->second;
+  fVertices.clear();
+  fContribIndex.clear();
+  fContrib.clear();
+  fFitSumsBuilt=kFALSE;
+  fFitSumsValid=kFALSE;
+  fNContributors=0;
+  fEvent=0x0;
+  return;
+}
+//--------------------------------------------------------------------------
+void AliHFPrimaryVertexCache::CheckEvent(AliAODEvent *aod)
+{
+  //
+  // Clear the cache if the event changed. The AOD event object is
+  // reused by the input handler, so the event is identified also by
+  // its header and by the primary vertex
+  //
+  AliAODVertex *vtxAOD=aod->GetPrimaryVertex();
+  Double_t vtxZ=vtxAOD ? vtxAOD->GetZ() : -999.;
+  if(aod==fEvent &&
+     aod->GetRunNumber()==fRunNumber &&
+     aod->GetPeriodNumber()==fPeriod &&
+     aod->GetOrbitNumber()==fOrbit &&
+     aod->GetBunchCrossNumber()==fBC &&
+     aod->GetNumberOfTracks()==fNTracks &&
+     vtxZ==fVtxZ) return;
+
+  Clear();
+  fEvent=aod;
+  fRunNumber=aod->GetRunNumber();
+  fPeriod=aod->GetPeriodNumber();
+  fOrbit=aod->GetOrbitNumber();
+  fBC=aod->GetBunchCrossNumber();
+  fNTracks=aod->GetNumberOfTracks();
+  fVtxZ=vtxZ;
+  return;
+}
+//--------------------------------------------------------------------------
+AliAODVertex* AliHFPrimaryVertexCache::GetVertexWithoutDaughters(AliAODRecoDecayHF *d,
+								 AliAODEvent *aod,
+								 Bool_t incremental)
+{
+  //
+  // Return the primary vertex without the daughter tracks of the candidate.
+  // The vertex is owned by the cache and valid until the event changes:
+  // the user has to set it to the candidate with SetOwnPrimaryVtx() and
+  // recalculate the impact parameters with RecalculateImpPars().
+  // If a NULL pointer is returned, the removal failed.
+  // With incremental=kTRUE the vertex is obtained from the fit sums of the
+  // primary vertex; if they cannot be built (e.g. the tracks are not flagged
+  // as used for the vertex fit) the full refit is done instead.
+  //
+
+  CheckEvent(aod);
+
+  std::vector<Int_t> key;
+  key.push_back(incremental ? 1 : 0);
+  for(Int_t i=0; i<d->GetNDaughters(); i++) {
+    AliAODTrack *t = (AliAODTrack*)d->GetDaughter(i);
+    if(!t) continue;
+    Int_t id = (Int_t)t->GetID();
+    if(id<0) continue;
+    key.push_back(id);
+  }
+  std::sort(key.begin()+1,key.end());
+
+  std::map<std::vector<Int_t>,AliAODVertex*>::const_iterator it=fVertices.find(key);
+  if(it!=fVertices.end()) return it->second;
+
+  AliAODVertex *vtx=0x0;
+  if(incremental && BuildFitSums(aod)) vtx=RemoveTracksFromFitSums(key);
+  else vtx=d->RemoveDaughtersFromPrimaryVtx(aod);
+  fVertices[key]=vtx;
+
+  return vtx;
+}
+//--------------------------------------------------------------------------
+Bool_t AliHFPrimaryVertexCache::BuildFitSums(AliAODEvent *aod)
+{
+  //
+  // Build the sums of the primary vertex fit from the tracks used in the
+  // fit, linearised at the primary vertex. Each track is a point with
+  // weight only in the plane transverse to its direction, as in
+  // AliVertexerTracks; the diamond is added if it was used as constraint.
+  // The sums are valid only if all the contributors were found.
+  //
+
+  if(fFitSumsBuilt) return fFitSumsValid;
+  fFitSumsBuilt=kTRUE;
+  fFitSumsValid=kFALSE;
+
+  AliAODVertex *vtxAOD = aod->GetPrimaryVertex();
+  if(!vtxAOD) return kFALSE;
+  TString title=vtxAOD->GetTitle();
+  if(!title.Contains("VertexerTracks")) return kFALSE;
+
+  for(Int_t i=0; i<6; i++) fSumW[i]=0.;
+  for(Int_t i=0; i<3; i++) fSumWr[i]=0.;
+  fSumrWr=0.;
+  fNContributors=0;
+
+  if(title.Contains("WithConstraint")) {
+    Float_t diamondcovxy[3];
+    aod->GetDiamondCovXY(diamondcovxy);
+    Double_t pos[3]={aod->GetDiamondX(),aod->GetDiamondY(),0.};
+    Double_t cov[6]={diamondcovxy[0],diamondcovxy[1],diamondcovxy[2],0.,0.,10.*10.};
+    Double_t w[6],wr[3],rwr;
+    if(!InvertSym3(cov,w)) return kFALSE;
+    WeightPoint(pos,w,wr,rwr);
+    for(Int_t i=0; i<6; i++) fSumW[i]+=w[i];
+    for(Int_t i=0; i<3; i++) fSumWr[i]+=wr[i];
+    fSumrWr+=rwr;
+  }
+
+  Double_t bz=aod->GetMagneticField();
+  Double_t dz[2],covdz[3],r[3];
+  for(Int_t it=0; it<aod->GetNumberOfTracks(); it++) {
+    AliAODTrack *t = dynamic_cast<AliAODTrack*>(aod->GetTrack(it));
+    if(!t || !t->GetUsedForPrimVtxFit()) continue;
+    Int_t id = (Int_t)t->GetID();
+    if(id<0) continue;
+    AliExternalTrackParam etp; etp.CopyFromVTrack(t);
+    if(!etp.PropagateToDCA(vtxAOD,bz,3.,dz,covdz)) continue;
+    Double_t syy=etp.GetSigmaY2();
+    Double_t szy=etp.GetSigmaZY();
+    Double_t szz=etp.GetSigmaZ2();
+    Double_t det=syy*szz-szy*szy;
+    if(det<=0.) continue;
+    // inverse of the (y,z) covariance in the track frame, rotated to the global frame
+    Double_t wyy=szz/det, wzy=-szy/det, wzz=syy/det;
+    Double_t sn=TMath::Sin(etp.GetAlpha());
+    Double_t cs=TMath::Cos(etp.GetAlpha());
+    etp.GetXYZ(r);
+
+    Int_t offset=(Int_t)fContrib.size();
+    fContrib.resize(offset+kNContribPars);
+    Double_t *c=&fContrib[offset];
+    c[0]=wyy*sn*sn;
+    c[1]=-wyy*sn*cs;
+    c[2]=wyy*cs*cs;
+    c[3]=-wzy*sn;
+    c[4]=wzy*cs;
+    c[5]=wzz;
+    WeightPoint(r,c,c+6,c[9]);
+    for(Int_t i=0; i<6; i++) fSumW[i]+=c[i];
+    for(Int_t i=0; i<3; i++) fSumWr[i]+=c[6+i];
+    fSumrWr+=c[9];
+    fContribIndex[id]=offset;
+    fNContributors++;
+  }
+
+  fFitSumsValid=(fNContributors>0 && fNContributors==vtxAOD->GetNContributors());
+  return fFitSumsValid;
+}
+//--------------------------------------------------------------------------
+AliAODVertex* AliHFPrimaryVertexCache::RemoveTracksFromFitSums(const std::vector<Int_t> &key) const
+{
+  //
+  // Vertex from the fit sums without the tracks in the key (the first
+  // element is the removal mode). Tracks that did not contribute to the
+  // primary vertex are ignored
+  //
+
+  Double_t sumW[6],sumWr[3];
+  for(Int_t i=0; i<6; i++) sumW[i]=fSumW[i];
+  for(Int_t i=0; i<3; i++) sumWr[i]=fSumWr[i];
+  Double_t sumrWr=fSumrWr;
+  Int_t nContributors=fNContributors;
+
+  for(UInt_t j=1; j<key.size(); j++) {
+    std::map<Int_t,Int_t>::const_iterator it=fContribIndex.find(key[j]);
+    if(it==fContribIndex.end()) continue;
+    const Double_t *c=&fContrib[it->second];
+    for(Int_t i=0; i<6; i++) sumW[i]-=c[i];
+    for(Int_t i=0; i<3; i++) sumWr[i]-=c[6+i];
+    sumrWr-=c[9];
+    nContributors--;
+  }
+  if(nContributors<=0) return 0x0;
+
+  Double_t cov[6];
+  if(!InvertSym3(sumW,cov)) return 0x0;
+  Double_t pos[3];
+  pos[0]=cov[0]*sumWr[0]+cov[1]*sumWr[1]+cov[3]*sumWr[2];
+  pos[1]=cov[1]*sumWr[0]+cov[2]*sumWr[1]+cov[4]*sumWr[2];
+  pos[2]=cov[3]*sumWr[0]+cov[4]*sumWr[1]+cov[5]*sumWr[2];
+  // chi2 at the minimum: sum(r*W*r) - x*sum(W*r)
+  Double_t chi2=sumrWr-(pos[0]*sumWr[0]+pos[1]*sumWr[1]+pos[2]*sumWr[2]);
+  Double_t ndf=2.*nContributors-3.;
+  Double_t chi2perNDF=(ndf>0.) ? chi2/ndf : -999.;
+
+  return new AliAODVertex(pos,cov,chi2perNDF);
+}
+//--------------------------------------------------------------------------
+Bool_t AliHFPrimaryVertexCache::InvertSym3(const Double_t *a,Double_t *inv)
+{
+  //
+  // Invert a symmetric 3x3 matrix stored as (xx,xy,yy,xz,yz,zz)
+  //
+  Double_t c00=a[2]*a[5]-a[4]*a[4];
+  Double_t c01=a[3]*a[4]-a[1]*a[5];
+  Double_t c02=a[1]*a[4]-a[2]*a[3];
+  Double_t det=a[0]*c00+a[1]*c01+a[3]*c02;
+  if(det<=0.) return kFALSE;
+  inv[0]=c00/det;
+  inv[1]=c01/det;
+  inv[2]=(a[0]*a[5]-a[3]*a[3])/det;
+  inv[3]=c02/det;
+  inv[4]=(a[1]*a[3]-a[0]*a[4])/det;
+  inv[5]=(a[0]*a[2]-a[1]*a[1])/det;
+  return kTRUE;
+}
+//--------------------------------------------------------------------------
+void AliHFPrimaryVertexCache::WeightPoint(const Double_t *r,const Double_t *w,Double_t *wr,Double_t &rwr)
+{
+  //
+  // W*r and r*W*r for a point r with weight matrix W (xx,xy,yy,xz,yz,zz)
+  //
+  wr[0]=w[0]*r[0]+w[1]*r[1]+w[3]*r[2];
+  wr[1]=w[1]*r[0]+w[2]*r[1]+w[4]*r[2];
+  wr[2]=w[3]*r[0]+w[4]*r[1]+w[5]*r[2];
+  rwr=r[0]*wr[0]+r[1]*wr[1]+r[2]*wr[2];
+  return;
+}
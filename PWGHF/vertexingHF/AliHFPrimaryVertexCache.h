@@ -0,0 +1,77 @@
+#ifndef ALIHFPRIMARYVERTEXCACHE_H
+#define ALIHFPRIMARYVERTEXCACHE_H
+/* Copyright(c) 1998-2019, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+///***********************************************************
+/// \class Class AliHFPrimaryVertexCache
+/// \brief event-scoped cache of the primary vertices recomputed
+/// without the daughter tracks of heavy-flavour candidates
+///
+/// The vertices are keyed by the sorted IDs of the removed tracks and
+/// are shared via Instance() by all the AliRDHFCuts objects, i.e. by
+/// all the tasks of a train. The cache is cleared when the event changes.
+/// Besides the full refit with AliVertexerTracks, the vertex can be
+/// updated incrementally: the weight sums of the primary vertex fit are
+/// built once per event from its contributors, and removing k tracks
+/// amounts to subtracting their contributions and solving a 3x3 system.
+///***********************************************************
+
+#include <TObject.h>
+#include <map>
+#include <vector>
+
+class AliAODEvent;
+class AliAODVertex;
+class AliAODRecoDecayHF;
+
+class AliHFPrimaryVertexCache : public TObject {
+
+ public:
+
+  AliHFPrimaryVertexCache();
+  virtual ~AliHFPrimaryVertexCache();
+
+  static AliHFPrimaryVertexCache* Instance();
+
+  AliAODVertex* GetVertexWithoutDaughters(AliAODRecoDecayHF *d,AliAODEvent *aod,Bool_t incremental=kFALSE);
+  virtual void Clear(Option_t *opt="");
+
+ private:
+
+  AliHFPrimaryVertexCache(const AliHFPrimaryVertexCache& source);
+  AliHFPrimaryVertexCache& operator=(const AliHFPrimaryVertexCache& source);
+
+  void CheckEvent(AliAODEvent *aod);
+  Bool_t BuildFitSums(AliAODEvent *aod);
+  AliAODVertex* RemoveTracksFromFitSums(const std::vector<Int_t> &key) const;
+  static Bool_t InvertSym3(const Double_t *a,Double_t *inv);
+  static void WeightPoint(const Double_t *r,const Double_t *w,Double_t *wr,Double_t &rwr);
+
+  enum {kNContribPars=10}; /// W (6 elements), W*r (3), r*W*r (1) per track
+
+  static AliHFPrimaryVertexCache* fgInstance; /// instance shared by all the cut objects
+
+  const AliAODEvent *fEvent; //! event of the cached vertices
+  Int_t fRunNumber;          //! run number of the cached event
+  UInt_t fPeriod;            //! period number of the cached event
+  UInt_t fOrbit;             //! orbit number of the cached event
+  UShort_t fBC;              //! bunch crossing number of the cached event
+  Int_t fNTracks;            //! number of tracks of the cached event
+  Double_t fVtxZ;            //! z of the primary vertex of the cached event
+  std::map<std::vector<Int_t>,AliAODVertex*> fVertices; //! vertices keyed by removal mode and sorted track IDs (owned)
+  Bool_t fFitSumsBuilt;      //! fit sums built for the cached event
+  Bool_t fFitSumsValid;      //! fit sums reproduce the contributors of the primary vertex
+  Int_t fNContributors;      //! number of tracks in the fit sums
+  Double_t fSumW[6];         //! sum of the weight matrices (xx,xy,yy,xz,yz,zz)
+  Double_t fSumWr[3];        //! sum of the weighted track points
+  Double_t fSumrWr;          //! sum of the weighted squared track points
+  std::map<Int_t,Int_t> fContribIndex; //! offset in fContrib of the contributors, by track ID
+  std::vector<Double_t> fContrib;      //! contributions of the tracks to the fit sums
+
+  /// \cond CLASSIMP
+  ClassDef(AliHFPrimaryVertexCache,1); /// cache of primary vertices without candidate daughters
+  /// \endcond
+};
+
+#endif
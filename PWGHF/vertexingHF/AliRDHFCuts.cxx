@@ -39,6 +39,7 @@
 #include "AliAODMCHeader.h"
 #include "AliAODMCParticle.h"
 #include "AliVertexerTracks.h"
+#include "AliHFPrimaryVertexCache.h"
 #include "AliRDHFCuts.h"
 #include "AliAnalysisManager.h"
 #include "AliAODHandler.h"
@@ -125,7 +126,9 @@ fCutGeoNcrNclLength(130.),
 fCutGeoNcrNclGeom1Pt(1.5),
 fCutGeoNcrNclFractionNcr(0.85),
 fCutGeoNcrNclFractionNcl(0.7),
-fUseV0ANDSelectionOffline(kFALSE)
+fUseV0ANDSelectionOffline(kFALSE),
+fUsePrimVtxCache(kTRUE),
+fUseIncrementalPrimVtxRemoval(kFALSE)
 {
   //
   // Default Constructor
@@ -198,7 +201,9 @@ AliRDHFCuts::AliRDHFCuts(const AliRDHFCuts &source) :
   fCutGeoNcrNclGeom1Pt(source.fCutGeoNcrNclGeom1Pt),
   fCutGeoNcrNclFractionNcr(source.fCutGeoNcrNclFractionNcr),
   fCutGeoNcrNclFractionNcl(source.fCutGeoNcrNclFractionNcl),
-  fUseV0ANDSelectionOffline(source.fUseV0ANDSelectionOffline)
+  fUseV0ANDSelectionOffline(source.fUseV0ANDSelectionOffline),
+  fUsePrimVtxCache(source.fUsePrimVtxCache),
+  fUseIncrementalPrimVtxRemoval(source.fUseIncrementalPrimVtxRemoval)
 {
   //
   // Copy constructor
@@ -298,6 +303,8 @@ AliRDHFCuts &AliRDHFCuts::operator=(const AliRDHFCuts &source)
   fCutGeoNcrNclFractionNcr=source.fCutGeoNcrNclFractionNcr;
   fCutGeoNcrNclFractionNcl=source.fCutGeoNcrNclFractionNcl;
   fUseV0ANDSelectionOffline=source.fUseV0ANDSelectionOffline;
+  fUsePrimVtxCache=source.fUsePrimVtxCache;
+  fUseIncrementalPrimVtxRemoval=source.fUseIncrementalPrimVtxRemoval;
 
   PrintAll();
 
@@ -1144,6 +1151,7 @@ void AliRDHFCuts::PrintAll() const {
   printf("Min SPD mult %d\n",fMinSPDMultiplicity);
   printf("Use PID %d  OldPid=%d\n",(Int_t)fUsePID,fPidHF ? fPidHF->GetOldPid() : -1);
   printf("Remove daughters from vtx %d\n",(Int_t)fRemoveDaughtersFromPrimary);
+  if(fRemoveDaughtersFromPrimary) printf(" -- cached vertices %d, incremental removal %d\n",(Int_t)fUsePrimVtxCache,(Int_t)fUseIncrementalPrimVtxRemoval);
   printf("Physics selection: %s\n",fUsePhysicsSelection ? "Yes" : "No");
   printf("Pileup rejection: %s\n",(fOptPileup > 0) ? "Yes" : "No");
   if(fOptPileup==1) printf(" -- Reject pileup event");
@@ -1607,6 +1615,18 @@ Bool_t AliRDHFCuts::RecalcOwnPrimaryVtx(AliAODRecoDecayHF *d,
     return 0;
   }   
 
+  if(fUsePrimVtxCache) {
+    // vertex shared with the other cut objects, owned by the cache
+    AliAODVertex *cachedvtx=AliHFPrimaryVertexCache::Instance()->GetVertexWithoutDaughters(d,aod,fUseIncrementalPrimVtxRemoval);
+    if(!cachedvtx){
+      AliDebug(2,"Removal of daughter tracks failed");
+      return kFALSE;
+    }
+    d->SetOwnPrimaryVtx(cachedvtx);
+    d->RecalculateImpPars(cachedvtx,aod);
+    return kTRUE;
+  }
+
   AliAODVertex *recvtx=d->RemoveDaughtersFromPrimaryVtx(aod);
   if(!recvtx){
     AliDebug(2,"Removal of daughter tracks failed");
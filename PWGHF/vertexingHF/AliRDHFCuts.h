@@ -214,6 +214,8 @@ class AliRDHFCuts : public AliAnalysisCuts
     fPidHF=new AliAODPidHF(*pidObj);
   }
   void SetRemoveDaughtersFromPrim(Bool_t removeDaughtersPrim) {fRemoveDaughtersFromPrimary=removeDaughtersPrim;}
+  void SetUsePrimaryVtxCache(Bool_t flag=kTRUE) {fUsePrimVtxCache=flag; return;}
+  void SetUseIncrementalPrimaryVtxRemoval(Bool_t flag=kTRUE) {fUseIncrementalPrimVtxRemoval=flag; return;}
   void SetMinPtCandidate(Double_t ptCand=-1.) {fMinPtCand=ptCand; return;}
   void SetMaxPtCandidate(Double_t ptCand=1000.) {fMaxPtCand=ptCand; return;}
   void SetMaxRapidityCandidate(Double_t ycand) {fMaxRapidityCand=ycand; return;}
@@ -456,10 +458,12 @@ class AliRDHFCuts : public AliAnalysisCuts
   Double_t fCutGeoNcrNclFractionNcr; /// 4th parameter of GeoNcrNcl cut
   Double_t fCutGeoNcrNclFractionNcl; /// 5th parameter of GeoNcrNcl cut
   Bool_t fUseV0ANDSelectionOffline; ///flag to apply V0AND selection offline
+  Bool_t fUsePrimVtxCache; /// flag to share the vertices without daughters among cut objects (AliHFPrimaryVertexCache)
+  Bool_t fUseIncrementalPrimVtxRemoval; /// flag to remove the daughters from the primary vertex fit sums instead of refitting
   
 
   /// \cond CLASSIMP    
-  ClassDef(AliRDHFCuts,40);  /// base class for cuts on AOD reconstructed heavy-flavour decays
+  ClassDef(AliRDHFCuts,41);  /// base class for cuts on AOD reconstructed heavy-flavour decays
   /// \endcond
 };
 
@@ -27,6 +27,7 @@
 #include "AliGenEventHeader.h"
 #include "AliAODMCParticle.h"
 #include "AliAODRecoDecayHF.h"
+#include "AliMCGenealogy.h"
 #include "AliVertexingHFUtils.h"
 
 /* $Id$ */
@@ -636,6 +637,11 @@ Int_t AliVertexingHFUtils::CheckOrigin(AliMCEvent* mcEvent, TParticle *mcPart, B
 //____________________________________________________________________________
 Int_t AliVertexingHFUtils::CheckOrigin(TClonesArray* arrayMC, AliAODMCParticle *mcPart, Bool_t searchUpToQuark){
   /// checking whether the mother of the particles come from a charm or a bottom quark
+  /// uses the origin tags of the event genealogy index when available
+
+  Int_t label = mcPart->GetLabel();
+  const AliMCGenealogy* genealogy = AliMCGenealogy::GetEventGenealogy(arrayMC);
+  if(genealogy && genealogy->IsValid(label) && arrayMC->At(label)==mcPart) return CheckOrigin(genealogy,label,searchUpToQuark);
 
   Int_t pdgGranma = 0;
   Int_t mother = 0;
@@ -666,6 +672,14 @@ Int_t AliVertexingHFUtils::CheckOrigin(TClonesArray* arrayMC, AliAODMCParticle *
 
 }
 //____________________________________________________________________________
+Int_t AliVertexingHFUtils::CheckOrigin(const AliMCGenealogy* genealogy, Int_t label, Bool_t searchUpToQuark){
+  /// checking whether the mother of the particle with this label come from a charm or a bottom quark
+  /// same result as the particle-based methods, from the precomputed origin tags of the index
+
+  if(!genealogy || !genealogy->IsValid(label)) return 0;
+  return genealogy->GetHFOrigin(label,searchUpToQuark);
+}
+//____________________________________________________________________________
 Double_t AliVertexingHFUtils::GetBeautyMotherPt(TClonesArray* arrayMC, AliAODMCParticle *mcPart){
   /// get the pt of the beauty hadron (feed-down case), returns negative value for prompt
 
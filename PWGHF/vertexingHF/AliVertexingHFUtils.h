@@ -22,6 +22,7 @@
 #include "AliAODRecoCascadeHF.h"
 
 class AliMCEvent;
+class AliMCGenealogy;
 class AliAODMCParticle;
 class AliAODMCHeader;
 class AliGenEventHeader;
@@ -127,6 +128,7 @@ class AliVertexingHFUtils : public TObject{
 
   static Int_t CheckOrigin(TClonesArray* arrayMC, AliAODMCParticle *mcPart, Bool_t searchUpToQuark=kTRUE);
   static Int_t CheckOrigin(AliMCEvent* mcEvent, TParticle *mcPart, Bool_t searchUpToQuark=kTRUE);
+  static Int_t CheckOrigin(const AliMCGenealogy* genealogy, Int_t label, Bool_t searchUpToQuark=kTRUE);
   static Double_t GetBeautyMotherPt(TClonesArray* arrayMC, AliAODMCParticle *mcPart);
   static Int_t CheckD0Decay(AliMCEvent* mcEvent, Int_t label, Int_t* arrayDauLab);
   static Int_t CheckD0Decay(TClonesArray* arrayMC, AliAODMCParticle *mcPart, Int_t* arrayDauLab);
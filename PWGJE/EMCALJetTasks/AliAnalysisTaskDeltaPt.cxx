@@ -10,7 +10,7 @@
 #include <TH3F.h>
 #include <TList.h>
 #include <TLorentzVector.h>
-#include <TRandom3.h>
+#include <TRandom.h>
 
 #include "AliVCluster.h"
 #include "AliVParticle.h"
@@ -21,6 +21,7 @@
 #include "AliJetContainer.h"
 #include "AliParticleContainer.h"
 #include "AliClusterContainer.h"
+#include "AliEmcalConeGrid.h"
 
 #include "AliAnalysisTaskDeltaPt.h"
 
@@ -45,6 +46,8 @@ AliAnalysisTaskDeltaPt::AliAnalysisTaskDeltaPt() :
   fEmbCaloClustersCont(0),
   fRandTracksCont(0),
   fRandCaloClustersCont(0),
+  fConeGrid(0),
+  fRandConeGrid(0),
   fHistRhovsCent(0),
   fHistRCPhiEta(0), 
   fHistRCPt(0),
@@ -115,6 +118,8 @@ AliAnalysisTaskDeltaPt::AliAnalysisTaskDeltaPt(const char *name) :
   fEmbCaloClustersCont(0),
   fRandTracksCont(0),
   fRandCaloClustersCont(0),
+  fConeGrid(0),
+  fRandConeGrid(0),
   fHistRhovsCent(0),
   fHistRCPhiEta(0), 
   fHistRCPt(0),
@@ -166,6 +171,15 @@ AliAnalysisTaskDeltaPt::AliAnalysisTaskDeltaPt(const char *name) :
   SetMakeGeneralHistograms(kTRUE);
 }
 
+//________________________________________________________________________
+AliAnalysisTaskDeltaPt::~AliAnalysisTaskDeltaPt()
+{
+  // Destructor.
+
+  delete fConeGrid;
+  delete fRandConeGrid;
+}
+
 //________________________________________________________________________
 void AliAnalysisTaskDeltaPt::AllocateHistogramArrays()
 {
@@ -452,12 +466,14 @@ Bool_t AliAnalysisTaskDeltaPt::FillHistograms()
 
   if (fTracksCont || fCaloClustersCont) {
 
+    FillConeGrid(fConeGrid, fTracksCont, fCaloClustersCont);
+
     for (Int_t i = 0; i < fRCperEvent; i++) {
       // Simple random cones
       RCpt = 0;
       RCeta = 0;
       RCphi = 0;
-      GetRandomCone(RCpt, RCeta, RCphi, fTracksCont, fCaloClustersCont, 0);
+      GetRandomCone(RCpt, RCeta, RCphi, fConeGrid, 0);
       if (RCpt > 0) {
         fHistRCPhiEta->Fill(RCeta, RCphi);
         fHistRhoVSRCPt[fCentBin]->Fill(fJetsCont->GetRhoVal() * rcArea, RCpt);
@@ -479,7 +495,7 @@ Bool_t AliAnalysisTaskDeltaPt::FillHistograms()
         RCpt = 0;
         RCeta = 0;
         RCphi = 0;
-        GetRandomCone(RCpt, RCeta, RCphi, fTracksCont, fCaloClustersCont, jet);
+        GetRandomCone(RCpt, RCeta, RCphi, fConeGrid, jet);
         if (RCpt > 0) {
           if (jet) {
             Float_t dphi = RCphi - jet->Phi();
@@ -497,7 +513,7 @@ Bool_t AliAnalysisTaskDeltaPt::FillHistograms()
           RCpt = 0;
           RCeta = 0;
           RCphi = 0;
-          GetRandomCone(RCpt, RCeta, RCphi, fTracksCont, fCaloClustersCont, jet, kTRUE);
+          GetRandomCone(RCpt, RCeta, RCphi, fConeGrid, jet, kTRUE);
 
           if (RCpt > 0) {
             if (jet) {
@@ -516,10 +532,12 @@ Bool_t AliAnalysisTaskDeltaPt::FillHistograms()
 
   // Random cones with randomized particles
   if (fRandTracksCont || fRandCaloClustersCont) {
+    FillConeGrid(fRandConeGrid, fRandTracksCont, fRandCaloClustersCont);
+
     RCpt = 0;
     RCeta = 0;
     RCphi = 0;
-    GetRandomCone(RCpt, RCeta, RCphi, fRandTracksCont, fRandCaloClustersCont, 0);
+    GetRandomCone(RCpt, RCeta, RCphi, fRandConeGrid, 0);
     if (RCpt > 0) {
       fHistRCPtRand[fCentBin]->Fill(RCpt);
       fHistDeltaPtRCRand[fCentBin]->Fill(RCpt - rcArea * fJetsCont->GetRhoVal());
@@ -581,10 +599,20 @@ AliEmcalJet* AliAnalysisTaskDeltaPt::NextEmbeddedJet(Bool_t reset)
   return jet;
 }
 
+//________________________________________________________________________
+void AliAnalysisTaskDeltaPt::FillConeGrid(AliEmcalConeGrid *grid, AliParticleContainer* tracks, AliClusterContainer* clusters)
+{
+  // Fill the eta-phi grid with the accepted tracks and clusters of the event.
+
+  grid->Reset();
+  grid->AddClusters(clusters, fVertex);
+  grid->AddParticles(tracks);
+  grid->Build();
+}
+
 //________________________________________________________________________
 void AliAnalysisTaskDeltaPt::GetRandomCone(Float_t &pt, Float_t &eta, Float_t &phi,
-    AliParticleContainer* tracks, AliClusterContainer* clusters,
-    AliEmcalJet *jet, Bool_t bPartialExclusion) const
+    const AliEmcalConeGrid *grid, AliEmcalJet *jet, Bool_t bPartialExclusion) const
 {
   // Get rigid cone.
 
@@ -592,7 +620,7 @@ void AliAnalysisTaskDeltaPt::GetRandomCone(Float_t &pt, Float_t &eta, Float_t &p
   phi = -999;
   pt = 0;
 
-  if (!tracks && !clusters)
+  if (!grid)
     return;
 
   Float_t LJeta = 999;
@@ -611,6 +639,13 @@ void AliAnalysisTaskDeltaPt::GetRandomCone(Float_t &pt, Float_t &eta, Float_t &p
   if (maxPhi > TMath::Pi() * 2) maxPhi = TMath::Pi() * 2;
   if (minPhi < 0) minPhi = 0;
 
+  Double_t prob = 0.;
+  if (bPartialExclusion) {
+    Double_t ncoll = GetNColl();
+    if (ncoll > 0)
+      prob = 1. / ncoll;
+  }
+
   Float_t dLJ = 0;
   Int_t repeats = 0;
   Bool_t reject = kTRUE;
@@ -621,17 +656,7 @@ void AliAnalysisTaskDeltaPt::GetRandomCone(Float_t &pt, Float_t &eta, Float_t &p
 
     if(bPartialExclusion) {
       reject = kFALSE;
-
-      TRandom3 rnd;
-      rnd.SetSeed(0);
-
-      Double_t ncoll = GetNColl();
-
-      Double_t prob = 0.;
-      if(ncoll>0)
-        prob = 1./ncoll;
-
-      if(rnd.Rndm()<=prob) reject = kTRUE; //reject cone
+      if(gRandom->Rndm()<=prob) reject = kTRUE; //reject cone
     }
 
     repeats++;
@@ -642,48 +667,7 @@ void AliAnalysisTaskDeltaPt::GetRandomCone(Float_t &pt, Float_t &eta, Float_t &p
     return;
   }
 
-  if (clusters) {
-    clusters->ResetCurrentID();
-    AliVCluster* cluster = clusters->GetNextAcceptCluster();
-    while (cluster) {     
-      TLorentzVector nPart;
-      cluster->GetMomentum(nPart, const_cast<Double_t*>(fVertex));
-
-      Float_t cluseta = nPart.Eta();
-      Float_t clusphi = nPart.Phi();
-
-      if (TMath::Abs(clusphi - phi) > TMath::Abs(clusphi - phi + 2 * TMath::Pi()))
-        clusphi += 2 * TMath::Pi();
-      if (TMath::Abs(clusphi - phi) > TMath::Abs(clusphi - phi - 2 * TMath::Pi()))
-        clusphi -= 2 * TMath::Pi();
-
-      Float_t d = TMath::Sqrt((cluseta - eta) * (cluseta - eta) + (clusphi - phi) * (clusphi - phi));
-      if (d <= fConeRadius) 
-        pt += nPart.Pt();
-
-      cluster = clusters->GetNextAcceptCluster();
-    }
-  }
-
-  if (tracks) {
-    tracks->ResetCurrentID();
-    AliVParticle* track = tracks->GetNextAcceptParticle(); 
-    while(track) { 
-      Float_t tracketa = track->Eta();
-      Float_t trackphi = track->Phi();
-
-      if (TMath::Abs(trackphi - phi) > TMath::Abs(trackphi - phi + 2 * TMath::Pi()))
-        trackphi += 2 * TMath::Pi();
-      if (TMath::Abs(trackphi - phi) > TMath::Abs(trackphi - phi - 2 * TMath::Pi()))
-        trackphi -= 2 * TMath::Pi();
-
-      Float_t d = TMath::Sqrt((tracketa - eta) * (tracketa - eta) + (trackphi - phi) * (trackphi - phi));
-      if (d <= fConeRadius)
-        pt += track->Pt();
-
-      track = tracks->GetNextAcceptParticle(); 
-    }
-  }
+  pt = grid->GetConePt(eta, phi, fConeRadius);
 }
 
 //________________________________________________________________________
@@ -731,6 +715,12 @@ void AliAnalysisTaskDeltaPt::ExecOnce()
   if (fMinRC2LJ < 0)
     fMinRC2LJ = fConeRadius * 1.5;
 
+  // particles farther than one radius from the cone acceptance never enter a cone
+  if (!fConeGrid)
+    fConeGrid = new AliEmcalConeGrid(fConeMinEta - fConeRadius - 0.01, fConeMaxEta + fConeRadius + 0.01, fConeRadius / 2);
+  if (!fRandConeGrid)
+    fRandConeGrid = new AliEmcalConeGrid(fConeMinEta - fConeRadius - 0.01, fConeMaxEta + fConeRadius + 0.01, fConeRadius / 2);
+
   const Float_t maxDist = TMath::Max(fConeMaxPhi - fConeMinPhi, fConeMaxEta - fConeMinEta) / 2;
   if (fMinRC2LJ > maxDist) {
     AliWarning(Form("The parameter fMinRC2LJ = %f is too large for the considered acceptance. "
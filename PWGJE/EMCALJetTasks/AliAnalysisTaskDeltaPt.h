@@ -11,6 +11,7 @@ class TH3;
 class AliJetContainer;
 class AliParticleContainer;
 class AliClusterContainer;
+class AliEmcalConeGrid;
 
 #include "AliAnalysisTaskEmcalJet.h"
 
@@ -19,7 +20,7 @@ class AliAnalysisTaskDeltaPt : public AliAnalysisTaskEmcalJet {
 
   AliAnalysisTaskDeltaPt();
   AliAnalysisTaskDeltaPt(const char *name);
-  virtual ~AliAnalysisTaskDeltaPt() {;}
+  virtual ~AliAnalysisTaskDeltaPt();
 
   void                        UserCreateOutputObjects();
 
@@ -40,7 +41,8 @@ class AliAnalysisTaskDeltaPt : public AliAnalysisTaskEmcalJet {
   AliEmcalJet*                NextEmbeddedJet(Bool_t reset=kFALSE)                                                          ;
   void                        DoEmbTrackLoop()                                                                              ;
   void                        DoEmbClusterLoop()                                                                            ;
-  void                        GetRandomCone(Float_t &pt, Float_t &eta, Float_t &phi, AliParticleContainer* tracks, AliClusterContainer* clusters,
+  void                        FillConeGrid(AliEmcalConeGrid *grid, AliParticleContainer* tracks, AliClusterContainer* clusters)        ;
+  void                        GetRandomCone(Float_t &pt, Float_t &eta, Float_t &phi, const AliEmcalConeGrid *grid,
 					    AliEmcalJet *jet = 0, Bool_t bPartialExclusion = 0) const;
   Double_t                    GetNColl() const;
 
@@ -62,6 +64,8 @@ class AliAnalysisTaskDeltaPt : public AliAnalysisTaskEmcalJet {
   AliClusterContainer        *fEmbCaloClustersCont;        //!Embedded clusters  
   AliParticleContainer       *fRandTracksCont;             //!Randomized tracks
   AliClusterContainer        *fRandCaloClustersCont;       //!Randomized clusters
+  AliEmcalConeGrid           *fConeGrid;                   //!Eta-phi grid of the tracks and clusters, for the random cones
+  AliEmcalConeGrid           *fRandConeGrid;               //!Eta-phi grid of the randomized tracks and clusters
 
   // General
   TH2                        *fHistRhovsCent;              //!Rho vs. centrality
@@ -98,6 +102,6 @@ class AliAnalysisTaskDeltaPt : public AliAnalysisTaskEmcalJet {
   AliAnalysisTaskDeltaPt(const AliAnalysisTaskDeltaPt&);            // not implemented
   AliAnalysisTaskDeltaPt &operator=(const AliAnalysisTaskDeltaPt&); // not implemented
 
-  ClassDef(AliAnalysisTaskDeltaPt, 5) // deltaPt analysis task
+  ClassDef(AliAnalysisTaskDeltaPt, 6) // deltaPt analysis task
 };
 #endif
@@ -21,7 +21,8 @@ ClassImp(AliAnalysisTaskRho)
 //________________________________________________________________________
 AliAnalysisTaskRho::AliAnalysisTaskRho() : 
   AliAnalysisTaskRhoBase("AliAnalysisTaskRho"),
-  fNExclLeadJets(0)
+  fNExclLeadJets(0),
+  fRhoVec()
 {
   // Constructor.
 }
@@ -29,7 +30,8 @@ AliAnalysisTaskRho::AliAnalysisTaskRho() :
 //________________________________________________________________________
 AliAnalysisTaskRho::AliAnalysisTaskRho(const char *name, Bool_t histo) :
   AliAnalysisTaskRhoBase(name, histo),
-  fNExclLeadJets(0)
+  fNExclLeadJets(0),
+  fRhoVec()
 {
   // Constructor.
 }
@@ -79,7 +81,8 @@ Bool_t AliAnalysisTaskRho::Run()
     }
   }
 
-  static Double_t rhovec[999];
+  if (Int_t(fRhoVec.size()) < Njets)
+    fRhoVec.resize(Njets);
   Int_t NjetAcc = 0;
 
   // push all jets within selected acceptance into stack
@@ -98,14 +101,14 @@ Bool_t AliAnalysisTaskRho::Run()
     if (!AcceptJet(jet))
       continue;
 
-    rhovec[NjetAcc] = jet->Pt() / jet->Area();
+    fRhoVec[NjetAcc] = jet->Pt() / jet->Area();
     ++NjetAcc;
   }
 
 
   if (NjetAcc > 0) {
     //find median value
-    Double_t rho = TMath::Median(NjetAcc, rhovec);
+    Double_t rho = GetMedian(fRhoVec, NjetAcc);
     fOutRho->SetVal(rho);
 
     if (fOutRhoScaled) {
@@ -18,10 +18,11 @@ class AliAnalysisTaskRho : public AliAnalysisTaskRhoBase {
   Bool_t           Run();
 
   UInt_t           fNExclLeadJets;                 // number of leading jets to be excluded from the median calculation
+  std::vector<Double_t> fRhoVec;                   //!pt/area of the accepted jets, buffer reused across events
 
   AliAnalysisTaskRho(const AliAnalysisTaskRho&);             // not implemented
   AliAnalysisTaskRho& operator=(const AliAnalysisTaskRho&);  // not implemented
   
-  ClassDef(AliAnalysisTaskRho, 10); // Rho task
+  ClassDef(AliAnalysisTaskRho, 11); // Rho task
 };
 #endif
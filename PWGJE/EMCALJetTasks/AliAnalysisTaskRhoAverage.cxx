@@ -24,7 +24,8 @@ AliAnalysisTaskRhoAverage::AliAnalysisTaskRhoAverage() :
   fRhoType(0),
   fNExclLeadPart(0),
   fUseMedian(kFALSE),
-  fTotalArea(1)
+  fTotalArea(1),
+  fRhoVec()
 {
   // Default constructor.
 }
@@ -35,7 +36,8 @@ AliAnalysisTaskRhoAverage::AliAnalysisTaskRhoAverage(const char *name, Bool_t hi
   fRhoType(0),
   fNExclLeadPart(0),
   fUseMedian(kFALSE),
-  fTotalArea(1)
+  fTotalArea(1),
+  fRhoVec()
 {
   // Constructor.
 }
@@ -45,9 +47,7 @@ Bool_t AliAnalysisTaskRhoAverage::Run()
 {
   // Run the analysis.
 
-  const Int_t NMAX = 9999;
-  static Double_t rhovec[NMAX];
-  Int_t NpartAcc = 0;
+  fRhoVec.clear();
 
   Int_t   maxPartIds[] = {0, 0};
   Float_t maxPartPts[] = {0, 0};
@@ -108,14 +108,13 @@ Bool_t AliAnalysisTaskRhoAverage::Run()
   if (tracks && (fRhoType == 0 || fRhoType == 1)) {
     AliVParticle *track = 0;
     tracks->ResetCurrentID();
-    while ((track = tracks->GetNextAcceptParticle()) && NpartAcc < NMAX) {
+    while ((track = tracks->GetNextAcceptParticle())) {
 
       // exlcuding lead particles
       if (tracks->GetCurrentID() == maxPartIds[0]-1 || tracks->GetCurrentID() == maxPartIds[1]-1)
         continue;
 
-      rhovec[NpartAcc] = track->Pt();
-      ++NpartAcc;
+      fRhoVec.push_back(track->Pt());
     }
   }
 
@@ -123,7 +122,7 @@ Bool_t AliAnalysisTaskRhoAverage::Run()
 
     AliVCluster *cluster = 0;
     clusters->ResetCurrentID();
-    while ((cluster = clusters->GetNextAcceptCluster()) && NpartAcc < NMAX) {
+    while ((cluster = clusters->GetNextAcceptCluster())) {
       // exlcuding lead particles
       if (clusters->GetCurrentID() == -maxPartIds[0]-1 || clusters->GetCurrentID() == -maxPartIds[1]-1)
         continue;
@@ -131,22 +130,19 @@ Bool_t AliAnalysisTaskRhoAverage::Run()
       TLorentzVector nPart;
       clusters->GetMomentum(nPart, clusters->GetCurrentID());
 
-      rhovec[NpartAcc] = nPart.Pt();
-      ++NpartAcc;
+      fRhoVec.push_back(nPart.Pt());
     }
   }
 
-  if (NpartAcc == NMAX) {
-    AliError(Form("%s: NpartAcc >= %d", GetName(), NMAX));
-  }
+  const Int_t NpartAcc = fRhoVec.size();
 
   Double_t rho = 0;
 
   if (NpartAcc > 0) {
     if (fUseMedian)
-      rho = TMath::Median(NpartAcc, rhovec);
+      rho = GetMedian(fRhoVec, NpartAcc);
     else
-      rho = TMath::Mean(NpartAcc, rhovec);
+      rho = TMath::Mean(NpartAcc, &fRhoVec[0]);
 
     rho *= NpartAcc / fTotalArea;
   }
@@ -24,10 +24,11 @@ class AliAnalysisTaskRhoAverage : public AliAnalysisTaskRhoBase {
   UInt_t           fNExclLeadPart ;// number of leading particles to be excluded from the median calculation
   Bool_t           fUseMedian     ;// whether or not use the median to calculate rho (mean is used if false)
   Double_t         fTotalArea     ;//!total area
+  std::vector<Double_t> fRhoVec   ;//!pt of the accepted particles, buffer reused across events
 
   AliAnalysisTaskRhoAverage(const AliAnalysisTaskRhoAverage&);             // not implemented
   AliAnalysisTaskRhoAverage& operator=(const AliAnalysisTaskRhoAverage&);  // not implemented
   
-  ClassDef(AliAnalysisTaskRhoAverage, 4); // Rho task
+  ClassDef(AliAnalysisTaskRhoAverage, 5); // Rho task
 };
 #endif
@@ -10,6 +10,8 @@ class TH2F;
 class TH3F;
 class AliRhoParameter;
 
+#include <vector>
+
 #include "AliAnalysisTaskEmcalJet.h"
 
 class AliAnalysisTaskRhoBase : public AliAnalysisTaskEmcalJet {
@@ -42,6 +44,8 @@ class AliAnalysisTaskRhoBase : public AliAnalysisTaskEmcalJet {
   virtual Double_t       GetRhoFactor(Double_t cent);
   virtual Double_t       GetScaleFactor(Double_t cent);
 
+  static Double_t        GetMedian(std::vector<Double_t> &v, Int_t n);
+
   TString                fOutRhoName;                    // name of output rho object
   TString                fOutRhoScaledName;              // name of output scaled rho object
   TString                fCompareRhoName;                // name of rho object to compare
@@ -24,7 +24,10 @@ AliAnalysisTaskRhoMass::AliAnalysisTaskRhoMass() :
   fNExclLeadJets(0),
   fJetRhoMassType(kMd),
   fPionMassClusters(kFALSE),
-  fHistMdAreavsCent(0)
+  fHistMdAreavsCent(0),
+  fRhoMassVec(),
+  fEVec(),
+  fMVec()
 {
   // Constructor.
 }
@@ -35,7 +38,10 @@ AliAnalysisTaskRhoMass::AliAnalysisTaskRhoMass(const char *name, Bool_t histo) :
   fNExclLeadJets(0),
   fJetRhoMassType(kMd),
   fPionMassClusters(kFALSE),
-  fHistMdAreavsCent(0)
+  fHistMdAreavsCent(0),
+  fRhoMassVec(),
+  fEVec(),
+  fMVec()
 {
   // Constructor.
 }
@@ -101,9 +107,11 @@ Bool_t AliAnalysisTaskRhoMass::Run()
     }
   }
 
-  static Double_t rhomvec[999];
-  static Double_t Evec[999];
-  static Double_t Mvec[999];
+  if (Int_t(fRhoMassVec.size()) < Njets) {
+    fRhoMassVec.resize(Njets);
+    fEVec.resize(Njets);
+    fMVec.resize(Njets);
+  }
   Int_t NjetAcc = 0;
 
   // push all jets within selected acceptance into stack
@@ -127,22 +135,22 @@ Bool_t AliAnalysisTaskRhoMass::Run()
     if(jet->Area()>0.) {// && (jet->M()*jet->M() + jet->Pt()*jet->Pt())>0.) {
       //rhomvec[NjetAcc] = (TMath::Sqrt(sumM*sumM + sumPt*sumPt) - sumPt ) / jet->Area();
       // rhomvec[NjetAcc] = (TMath::Sqrt(jet->M()*jet->M() + jet->Pt()*jet->Pt()) - jet->Pt() ) / jet->Area();
-      rhomvec[NjetAcc] = GetMd(jet) / jet->Area();
-      fHistMdAreavsCent->Fill(fCent,rhomvec[NjetAcc]);
-      Evec[NjetAcc] = jet->E();
-      Mvec[NjetAcc] = jet->M();
+      fRhoMassVec[NjetAcc] = GetMd(jet) / jet->Area();
+      fHistMdAreavsCent->Fill(fCent,fRhoMassVec[NjetAcc]);
+      fEVec[NjetAcc] = jet->E();
+      fMVec[NjetAcc] = jet->M();
       ++NjetAcc;
     }
   }
 
   if (NjetAcc > 0) {
     //find median value
-    Double_t rhom = TMath::Median(NjetAcc, rhomvec);
+    Double_t rhom = GetMedian(fRhoMassVec, NjetAcc);
     fOutRhoMass->SetVal(rhom);
 
     Int_t Ntracks = fTracks->GetEntries();
-    Double_t meanM = TMath::Mean(NjetAcc, Mvec);
-    Double_t meanE = TMath::Mean(NjetAcc, Evec);
+    Double_t meanM = TMath::Mean(NjetAcc, &fMVec[0]);
+    Double_t meanE = TMath::Mean(NjetAcc, &fEVec[0]);
     Double_t gamma = 0.;
     if(meanM>0.) gamma = meanE/meanM;
     fHistGammaVsNtrack->Fill(Ntracks,gamma);
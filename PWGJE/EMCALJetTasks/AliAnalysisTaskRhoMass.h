@@ -37,9 +37,13 @@ class AliAnalysisTaskRhoMass : public AliAnalysisTaskRhoMassBase {
 
   TH2F            *fHistMdAreavsCent;              //! Md/Area vs cent for all kt clusters
 
+  std::vector<Double_t> fRhoMassVec;               //!Md/area of the accepted jets, buffer reused across events
+  std::vector<Double_t> fEVec;                     //!energy of the accepted jets
+  std::vector<Double_t> fMVec;                     //!mass of the accepted jets
+
   AliAnalysisTaskRhoMass(const AliAnalysisTaskRhoMass&);             // not implemented
   AliAnalysisTaskRhoMass& operator=(const AliAnalysisTaskRhoMass&);  // not implemented
   
-  ClassDef(AliAnalysisTaskRhoMass, 2); // Rho_m task
+  ClassDef(AliAnalysisTaskRhoMass, 3); // Rho_m task
 };
 #endif
@@ -5,6 +5,8 @@
 //
 // Author: M. Verweij. Similar to AliAnalysisTaskRhoBase
 
+#include <algorithm>
+
 #include <TF1.h>
 #include <TH1F.h>
 #include <TH2F.h>
@@ -344,3 +346,21 @@ Double_t AliAnalysisTaskRhoMassBase::GetScaleFactor(Double_t cent)
     scale = fScaleFunction->Eval(cent);
   return scale;
 }
+
+//________________________________________________________________________
+Double_t AliAnalysisTaskRhoMassBase::GetMedian(std::vector<Double_t> &v, Int_t n)
+{
+  // Median of the first n entries of v, by linear-time selection.
+  // The entries are reordered.
+
+  if (n <= 0)
+    return 0;
+
+  std::vector<Double_t>::iterator mid = v.begin() + n / 2;
+  std::nth_element(v.begin(), mid, v.begin() + n);
+  Double_t median = *mid;
+  if (n % 2 == 0)
+    median = 0.5 * (median + *std::max_element(v.begin(), mid));
+
+  return median;
+}
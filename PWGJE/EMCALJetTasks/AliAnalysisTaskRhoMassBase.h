@@ -9,6 +9,8 @@ class TH1F;
 class TH2F;
 class AliRhoParameter;
 
+#include <vector>
+
 #include "AliAnalysisTaskEmcalJet.h"
 
 class AliAnalysisTaskRhoMassBase : public AliAnalysisTaskEmcalJet {
@@ -40,6 +42,8 @@ class AliAnalysisTaskRhoMassBase : public AliAnalysisTaskEmcalJet {
   virtual Double_t       GetRhoMassFactor(Double_t cent);
   virtual Double_t       GetScaleFactor(Double_t cent);
 
+  static Double_t        GetMedian(std::vector<Double_t> &v, Int_t n);
+
   TString                fOutRhoMassName;                // name of output rho mass object
   TString                fOutRhoMassScaledName;          // name of output scaled rho mass object
   TString                fCompareRhoMassName;            // name of rho mass object to compare
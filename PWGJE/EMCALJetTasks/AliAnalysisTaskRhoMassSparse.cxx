@@ -25,7 +25,10 @@ AliAnalysisTaskRhoMassSparse::AliAnalysisTaskRhoMassSparse() :
   fNExclLeadJets(0),
   fJetRhoMassType(kMd),
   fPionMassClusters(kFALSE),
-  fHistMdAreavsCent(0)
+  fHistMdAreavsCent(0),
+  fRhoMassVec(),
+  fEVec(),
+  fMVec()
 {
   // Constructor.
 }
@@ -36,7 +39,10 @@ AliAnalysisTaskRhoMassSparse::AliAnalysisTaskRhoMassSparse(const char *name, Boo
   fNExclLeadJets(0),
   fJetRhoMassType(kMd),
   fPionMassClusters(kFALSE),
-  fHistMdAreavsCent(0)
+  fHistMdAreavsCent(0),
+  fRhoMassVec(),
+  fEVec(),
+  fMVec()
 {
   // Constructor.
 }
@@ -137,9 +143,11 @@ Bool_t AliAnalysisTaskRhoMassSparse::Run()
     }
   }
 
-  static Double_t rhomvec[999];
-  static Double_t Evec[999];
-  static Double_t Mvec[999];
+  if (Int_t(fRhoMassVec.size()) < Njets) {
+    fRhoMassVec.resize(Njets);
+    fEVec.resize(Njets);
+    fMVec.resize(Njets);
+  }
   Int_t NjetAcc = 0;
   Double_t TotaljetArea=0;
   Double_t TotaljetAreaPhys=0;
@@ -194,10 +202,10 @@ Bool_t AliAnalysisTaskRhoMassSparse::Run()
     if(jet->Area()>0.) {// && (jet->M()*jet->M() + jet->Pt()*jet->Pt())>0.) {
        //rhomvec[NjetAcc] = (TMath::Sqrt(sumM*sumM + sumPt*sumPt) - sumPt ) / jet->Area();
       // rhomvec[NjetAcc] = (TMath::Sqrt(jet->M()*jet->M() + jet->Pt()*jet->Pt()) - jet->Pt() ) / jet->Area();
-      rhomvec[NjetAcc] = GetMd(jet) / jet->Area();
-      fHistMdAreavsCent->Fill(fCent,rhomvec[NjetAcc]);
-      Evec[NjetAcc] = jet->E();
-      Mvec[NjetAcc] = jet->M();
+      fRhoMassVec[NjetAcc] = GetMd(jet) / jet->Area();
+      fHistMdAreavsCent->Fill(fCent,fRhoMassVec[NjetAcc]);
+      fEVec[NjetAcc] = jet->E();
+      fMVec[NjetAcc] = jet->M();
       ++NjetAcc;
     }
   }
@@ -211,7 +219,7 @@ Bool_t AliAnalysisTaskRhoMassSparse::Run()
 
   if (NjetAcc > 0) {
     //find median value
-    Double_t rhom = TMath::Median(NjetAcc, rhomvec);
+    Double_t rhom = GetMedian(fRhoMassVec, NjetAcc);
     if(fRhoCMS){
       rhom = rhom * OccCorr;
     }
@@ -219,8 +227,8 @@ Bool_t AliAnalysisTaskRhoMassSparse::Run()
     fOutRhoMass->SetVal(rhom);
 
     Int_t Ntracks = fTracks->GetEntries();
-    Double_t meanM = TMath::Mean(NjetAcc, Mvec);
-    Double_t meanE = TMath::Mean(NjetAcc, Evec);
+    Double_t meanM = TMath::Mean(NjetAcc, &fMVec[0]);
+    Double_t meanE = TMath::Mean(NjetAcc, &fEVec[0]);
     Double_t gamma = 0.;
     if(meanM>0.) gamma = meanE/meanM;
     fHistGammaVsNtrack->Fill(Ntracks,gamma);
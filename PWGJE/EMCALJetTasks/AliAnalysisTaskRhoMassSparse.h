@@ -43,9 +43,13 @@ class AliAnalysisTaskRhoMassSparse : public AliAnalysisTaskRhoMassBase {
   TH2F            *fHistMdAreavsCent;              //! Md/Area vs cent for all kt clusters
   TH2F            *fHistOccCorrvsCent;             //!occupancy correction vs. centrality
 
+  std::vector<Double_t> fRhoMassVec;               //!Md/area of the accepted jets, buffer reused across events
+  std::vector<Double_t> fEVec;                     //!energy of the accepted jets
+  std::vector<Double_t> fMVec;                     //!mass of the accepted jets
+
   AliAnalysisTaskRhoMassSparse(const AliAnalysisTaskRhoMassSparse&);             // not implemented
   AliAnalysisTaskRhoMassSparse& operator=(const AliAnalysisTaskRhoMassSparse&);  // not implemented
   
-  ClassDef(AliAnalysisTaskRhoMassSparse, 1); // Rho_m task
+  ClassDef(AliAnalysisTaskRhoMassSparse, 2); // Rho_m task
 };
 #endif
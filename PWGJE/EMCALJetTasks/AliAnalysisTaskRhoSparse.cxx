@@ -24,7 +24,8 @@ AliAnalysisTaskRhoSparse::AliAnalysisTaskRhoSparse() :
   AliAnalysisTaskRhoBase("AliAnalysisTaskRhoSparse"),
   fNExclLeadJets(0),
   fRhoCMS(0),
-  fHistOccCorrvsCent(0)
+  fHistOccCorrvsCent(0),
+  fRhoVec()
 {
   // Constructor.
 }
@@ -34,7 +35,8 @@ AliAnalysisTaskRhoSparse::AliAnalysisTaskRhoSparse(const char *name, Bool_t hist
   AliAnalysisTaskRhoBase(name, histo),
   fNExclLeadJets(0),
   fRhoCMS(0),
-  fHistOccCorrvsCent(0)
+  fHistOccCorrvsCent(0),
+  fRhoVec()
 {
   // Constructor.
 }
@@ -126,7 +128,8 @@ Bool_t AliAnalysisTaskRhoSparse::Run()
     }
   }
 
-  static Double_t rhovec[999];
+  if (Int_t(fRhoVec.size()) < Njets)
+    fRhoVec.resize(Njets);
   Int_t NjetAcc = 0;
   Double_t TotaljetArea=0;
   Double_t TotaljetAreaPhys=0;
@@ -176,7 +179,7 @@ Bool_t AliAnalysisTaskRhoSparse::Run()
       continue;
 
     if(jet->Pt()>0.1){
-      rhovec[NjetAcc] = jet->Pt() / jet->Area();
+      fRhoVec[NjetAcc] = jet->Pt() / jet->Area();
       ++NjetAcc;
     }
   }
@@ -189,7 +192,7 @@ Bool_t AliAnalysisTaskRhoSparse::Run()
 
   if (NjetAcc > 0) {
     //find median value
-    Double_t rho = TMath::Median(NjetAcc, rhovec);
+    Double_t rho = GetMedian(fRhoVec, NjetAcc);
 
     if(fRhoCMS){
       rho = rho * OccCorr;
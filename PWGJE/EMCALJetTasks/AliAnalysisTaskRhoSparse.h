@@ -26,9 +26,11 @@ class AliAnalysisTaskRhoSparse : public AliAnalysisTaskRhoBase {
 
   TH2F            *fHistOccCorrvsCent;             //!occupancy correction vs. centrality
 
+  std::vector<Double_t> fRhoVec;                   //!pt/area of the accepted jets, buffer reused across events
+
   AliAnalysisTaskRhoSparse(const AliAnalysisTaskRhoSparse&);             // not implemented
   AliAnalysisTaskRhoSparse& operator=(const AliAnalysisTaskRhoSparse&);  // not implemented
   
-  ClassDef(AliAnalysisTaskRhoSparse, 2); // Rho task
+  ClassDef(AliAnalysisTaskRhoSparse, 3); // Rho task
 };
 #endif
@@ -0,0 +1,309 @@
+// $Id$
+//
+// Eta-phi occupancy grid of the particles of an event, with 2D prefix
+// sums of the cell pt. Cone sums are evaluated row by row: the cells
+// fully contained in the cone are taken from the prefix sums, only the
+// particles of the cells crossed by the cone edge are tested one by one,
+// with the same distance definition as the random cone of
+// AliAnalysisTaskDeltaPt. Rectangular regions of cells are evaluated in
+// constant time. Particles outside the eta range of the grid are ignored.
+//
+// Usage, once per event: Reset(), AddParticles()/AddClusters(), Build().
+
+#include <TLorentzVector.h>
+#include <TMath.h>
+#include <TVector2.h>
+
+#include "AliVCluster.h"
+#include "AliVParticle.h"
+#include "AliParticleContainer.h"
+#include "AliClusterContainer.h"
+
+#include "AliEmcalConeGrid.h"
+
+ClassImp(AliEmcalConeGrid)
+
+//________________________________________________________________________
+AliEmcalConeGrid::AliEmcalConeGrid() :
+  TObject(),
+  fEtaMin(-1),
+  fEtaMax(1),
+  fCellSize(0.1),
+  fNEta(0),
+  fNPhi(0),
+  fCellEta(0),
+  fCellPhi(0),
+  fBuilt(kFALSE),
+  fEta(),
+  fPhi(),
+  fPt(),
+  fCell(),
+  fCellFirst(),
+  fCellParticles(),
+  fPrefix()
+{
+  // Default constructor.
+}
+
+//________________________________________________________________________
+AliEmcalConeGrid::AliEmcalConeGrid(Double_t etaMin, Double_t etaMax, Double_t cellSize) :
+  TObject(),
+  fEtaMin(etaMin),
+  fEtaMax(etaMax),
+  fCellSize(cellSize),
+  fNEta(0),
+  fNPhi(0),
+  fCellEta(0),
+  fCellPhi(0),
+  fBuilt(kFALSE),
+  fEta(),
+  fPhi(),
+  fPt(),
+  fCell(),
+  fCellFirst(),
+  fCellParticles(),
+  fPrefix()
+{
+  // Standard constructor.
+}
+
+//________________________________________________________________________
+void AliEmcalConeGrid::Init()
+{
+  // Compute the binning.
+
+  if (fCellSize <= 0) fCellSize = 0.1;
+  if (fEtaMax <= fEtaMin) fEtaMax = fEtaMin + fCellSize;
+
+  fNEta = TMath::Max(1, TMath::CeilNint((fEtaMax - fEtaMin) / fCellSize));
+  fCellEta = (fEtaMax - fEtaMin) / fNEta;
+  fNPhi = TMath::Max(1, TMath::CeilNint(TMath::TwoPi() / fCellSize));
+  fCellPhi = TMath::TwoPi() / fNPhi;
+
+  Reset();
+}
+
+//________________________________________________________________________
+void AliEmcalConeGrid::Reset()
+{
+  // Remove all particles, keep the allocated memory.
+
+  fEta.clear();
+  fPhi.clear();
+  fPt.clear();
+  fCell.clear();
+  fBuilt = kFALSE;
+}
+
+//________________________________________________________________________
+void AliEmcalConeGrid::AddParticle(Float_t eta, Float_t phi, Double_t pt)
+{
+  // Add a particle; phi can be given in any 2pi range.
+
+  if (fNEta == 0) Init();
+
+  if (eta < fEtaMin || eta >= fEtaMax) return;
+
+  Double_t phiNorm = TVector2::Phi_0_2pi(phi);
+  Int_t ieta = TMath::Min(fNEta - 1, Int_t((eta - fEtaMin) / fCellEta));
+  Int_t iphi = TMath::Min(fNPhi - 1, Int_t(phiNorm / fCellPhi));
+
+  fEta.push_back(eta);
+  fPhi.push_back(phi);
+  fPt.push_back(pt);
+  fCell.push_back(ieta * fNPhi + iphi);
+  fBuilt = kFALSE;
+}
+
+//________________________________________________________________________
+void AliEmcalConeGrid::AddParticles(AliParticleContainer *tracks)
+{
+  // Add the accepted particles of a container.
+
+  if (!tracks) return;
+
+  tracks->ResetCurrentID();
+  AliVParticle* track = 0;
+  while ((track = tracks->GetNextAcceptParticle())) AddParticle(track->Eta(), track->Phi(), track->Pt());
+}
+
+//________________________________________________________________________
+void AliEmcalConeGrid::AddClusters(AliClusterContainer *clusters, const Double_t *vertex)
+{
+  // Add the accepted clusters of a container, with momentum computed w.r.t. vertex.
+
+  if (!clusters) return;
+
+  clusters->ResetCurrentID();
+  AliVCluster* cluster = 0;
+  while ((cluster = clusters->GetNextAcceptCluster())) {
+    TLorentzVector nPart;
+    cluster->GetMomentum(nPart, const_cast<Double_t*>(vertex));
+    AddParticle(nPart.Eta(), nPart.Phi(), nPart.Pt());
+  }
+}
+
+//________________________________________________________________________
+void AliEmcalConeGrid::Build()
+{
+  // Sort the particles by cell and compute the prefix sums.
+
+  if (fNEta == 0) Init();
+
+  const Int_t nCells = fNEta * fNPhi;
+  const Int_t nPart = fPt.size();
+
+  fCellFirst.assign(nCells + 1, 0);
+  for (Int_t i = 0; i < nPart; i++) fCellFirst[fCell[i] + 1]++;
+  for (Int_t c = 0; c < nCells; c++) fCellFirst[c + 1] += fCellFirst[c];
+
+  fCellParticles.resize(nPart);
+  std::vector<Int_t> fill(fCellFirst.begin(), fCellFirst.end() - 1);
+  for (Int_t i = 0; i < nPart; i++) fCellParticles[fill[fCell[i]]++] = i;
+
+  const Int_t stride = fNPhi + 1;
+  fPrefix.assign((fNEta + 1) * stride, 0.);
+  for (Int_t i = 0; i < nPart; i++) {
+    Int_t ieta = fCell[i] / fNPhi;
+    Int_t iphi = fCell[i] % fNPhi;
+    fPrefix[(ieta + 1) * stride + iphi + 1] += fPt[i];
+  }
+  for (Int_t ieta = 1; ieta <= fNEta; ieta++) {
+    for (Int_t iphi = 1; iphi <= fNPhi; iphi++) {
+      fPrefix[ieta * stride + iphi] += fPrefix[(ieta - 1) * stride + iphi] + fPrefix[ieta * stride + iphi - 1] - fPrefix[(ieta - 1) * stride + iphi - 1];
+    }
+  }
+
+  fBuilt = kTRUE;
+}
+
+//________________________________________________________________________
+Bool_t AliEmcalConeGrid::InCone(Float_t eta, Float_t phi, Float_t coneEta, Float_t conePhi, Double_t radius)
+{
+  // Distance check of AliAnalysisTaskDeltaPt::GetRandomCone.
+
+  if (TMath::Abs(phi - conePhi) > TMath::Abs(phi - conePhi + 2 * TMath::Pi()))
+    phi += 2 * TMath::Pi();
+  if (TMath::Abs(phi - conePhi) > TMath::Abs(phi - conePhi - 2 * TMath::Pi()))
+    phi -= 2 * TMath::Pi();
+
+  Float_t d = TMath::Sqrt((eta - coneEta) * (eta - coneEta) + (phi - conePhi) * (phi - conePhi));
+  return (d <= radius);
+}
+
+//________________________________________________________________________
+Double_t AliEmcalConeGrid::GetRegionPt(Int_t etaBin1, Int_t etaBin2, Int_t phiBin1, Int_t phiBin2) const
+{
+  // Sum of pt in the cells [etaBin1,etaBin2]x[phiBin1,phiBin2], 0 <= phiBin1 <= phiBin2 < fNPhi.
+
+  if (!fBuilt) {
+    Error("GetRegionPt", "Grid not built!");
+    return 0;
+  }
+
+  etaBin1 = TMath::Max(etaBin1, 0);
+  etaBin2 = TMath::Min(etaBin2, fNEta - 1);
+  phiBin1 = TMath::Max(phiBin1, 0);
+  phiBin2 = TMath::Min(phiBin2, fNPhi - 1);
+  if (etaBin1 > etaBin2 || phiBin1 > phiBin2) return 0;
+
+  const Int_t stride = fNPhi + 1;
+  return fPrefix[(etaBin2 + 1) * stride + phiBin2 + 1] - fPrefix[etaBin1 * stride + phiBin2 + 1]
+    - fPrefix[(etaBin2 + 1) * stride + phiBin1] + fPrefix[etaBin1 * stride + phiBin1];
+}
+
+//________________________________________________________________________
+Double_t AliEmcalConeGrid::GetCellsPt(Int_t etaBin, Int_t phiBin1, Int_t phiBin2) const
+{
+  // Sum of pt in a row of cells; phi bins can be outside [0, fNPhi) and are wrapped.
+
+  Int_t n = phiBin2 - phiBin1 + 1;
+  if (n <= 0) return 0;
+
+  Int_t first = ((phiBin1 % fNPhi) + fNPhi) % fNPhi;
+  if (first + n <= fNPhi) return GetRegionPt(etaBin, etaBin, first, first + n - 1);
+
+  return GetRegionPt(etaBin, etaBin, first, fNPhi - 1) + GetRegionPt(etaBin, etaBin, 0, first + n - 1 - fNPhi);
+}
+
+//________________________________________________________________________
+Double_t AliEmcalConeGrid::GetCellsPtInCone(Int_t etaBin, Int_t phiBin1, Int_t phiBin2, Float_t eta, Float_t phi, Double_t radius) const
+{
+  // Sum of pt of the particles of a row of cells that are in the cone.
+
+  Double_t pt = 0;
+  for (Int_t k = phiBin1; k <= phiBin2; k++) {
+    Int_t c = etaBin * fNPhi + ((k % fNPhi) + fNPhi) % fNPhi;
+    for (Int_t j = fCellFirst[c]; j < fCellFirst[c + 1]; j++) {
+      Int_t i = fCellParticles[j];
+      if (InCone(fEta[i], fPhi[i], eta, phi, radius)) pt += fPt[i];
+    }
+  }
+  return pt;
+}
+
+//________________________________________________________________________
+Double_t AliEmcalConeGrid::GetConePt(Float_t eta, Float_t phi, Double_t radius) const
+{
+  // Sum of pt of the particles in the cone.
+
+  if (!fBuilt) {
+    Error("GetConePt", "Grid not built!");
+    return 0;
+  }
+
+  // margin on the cell classification, well above the float precision of the distance check
+  const Double_t eps = 1e-4;
+  const Double_t rOut = radius + eps;
+  const Double_t rIn = radius - eps;
+
+  Double_t pt = 0;
+
+  // cone wider than the phi acceptance: plain loop
+  if (2 * rOut + 2 * fCellPhi >= TMath::TwoPi()) {
+    const Int_t nPart = fPt.size();
+    for (Int_t i = 0; i < nPart; i++) {
+      if (InCone(fEta[i], fPhi[i], eta, phi, radius)) pt += fPt[i];
+    }
+    return pt;
+  }
+
+  const Double_t phi0 = TVector2::Phi_0_2pi(phi);
+  Int_t row1 = TMath::Max(0, TMath::FloorNint((eta - rOut - fEtaMin) / fCellEta));
+  Int_t row2 = TMath::Min(fNEta - 1, TMath::FloorNint((eta + rOut - fEtaMin) / fCellEta));
+
+  for (Int_t row = row1; row <= row2; row++) {
+    Double_t lo = fEtaMin + row * fCellEta;
+    Double_t hi = lo + fCellEta;
+    Double_t dNear = 0;
+    if (eta < lo) dNear = lo - eta;
+    else if (eta > hi) dNear = eta - hi;
+    if (dNear > rOut) continue;
+    Double_t dFar = TMath::Max(TMath::Abs(eta - lo), TMath::Abs(eta - hi));
+
+    // cells touched by the cone
+    Double_t hOut = TMath::Sqrt(rOut * rOut - dNear * dNear);
+    Int_t kOut1 = TMath::FloorNint((phi0 - hOut) / fCellPhi);
+    Int_t kOut2 = TMath::FloorNint((phi0 + hOut) / fCellPhi);
+
+    // cells fully contained in the cone
+    Int_t kIn1 = kOut2 + 1;
+    Int_t kIn2 = kOut2;
+    if (dFar < rIn) {
+      Double_t hIn = TMath::Sqrt(rIn * rIn - dFar * dFar);
+      kIn1 = TMath::CeilNint((phi0 - hIn) / fCellPhi);
+      kIn2 = TMath::FloorNint((phi0 + hIn) / fCellPhi) - 1;
+    }
+
+    if (kIn1 <= kIn2) {
+      pt += GetCellsPt(row, kIn1, kIn2);
+      pt += GetCellsPtInCone(row, kOut1, kIn1 - 1, eta, phi, radius);
+      pt += GetCellsPtInCone(row, kIn2 + 1, kOut2, eta, phi, radius);
+    }
+    else {
+      pt += GetCellsPtInCone(row, kOut1, kOut2, eta, phi, radius);
+    }
+  }
+
+  return pt;
+}
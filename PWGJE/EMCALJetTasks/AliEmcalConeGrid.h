@@ -0,0 +1,64 @@
+#ifndef ALIEMCALCONEGRID_H
+#define ALIEMCALCONEGRID_H
+
+// $Id$
+
+#include <vector>
+
+#include <TObject.h>
+
+class AliParticleContainer;
+class AliClusterContainer;
+
+class AliEmcalConeGrid : public TObject {
+ public:
+  AliEmcalConeGrid();
+  AliEmcalConeGrid(Double_t etaMin, Double_t etaMax, Double_t cellSize);
+  virtual ~AliEmcalConeGrid() {}
+
+  void                   SetEtaRange(Double_t min, Double_t max)               { fEtaMin = min; fEtaMax = max; fNEta = 0; }
+  void                   SetCellSize(Double_t s)                               { fCellSize = s; fNEta = 0;                 }
+
+  void                   Reset();
+  void                   AddParticle(Float_t eta, Float_t phi, Double_t pt);
+  void                   AddParticles(AliParticleContainer *tracks);
+  void                   AddClusters(AliClusterContainer *clusters, const Double_t *vertex);
+  void                   Build();
+
+  Double_t               GetConePt(Float_t eta, Float_t phi, Double_t radius) const;
+  Double_t               GetRegionPt(Int_t etaBin1, Int_t etaBin2, Int_t phiBin1, Int_t phiBin2) const;
+  Int_t                  GetNEtaBins() const                                   { return fNEta;                             }
+  Int_t                  GetNPhiBins() const                                   { return fNPhi;                             }
+  Int_t                  GetNParticles() const                                 { return fPt.size();                        }
+
+  static Bool_t          InCone(Float_t eta, Float_t phi, Float_t coneEta, Float_t conePhi, Double_t radius);
+
+ protected:
+  void                   Init();
+  Double_t               GetCellsPt(Int_t etaBin, Int_t phiBin1, Int_t phiBin2) const;
+  Double_t               GetCellsPtInCone(Int_t etaBin, Int_t phiBin1, Int_t phiBin2, Float_t eta, Float_t phi, Double_t radius) const;
+
+  Double_t               fEtaMin;                        // lower eta edge of the grid
+  Double_t               fEtaMax;                        // upper eta edge of the grid
+  Double_t               fCellSize;                      // requested cell size in eta and phi
+  Int_t                  fNEta;                          //!number of eta cells
+  Int_t                  fNPhi;                          //!number of phi cells
+  Double_t               fCellEta;                       //!eta size of the cells
+  Double_t               fCellPhi;                       //!phi size of the cells
+  Bool_t                 fBuilt;                         //!prefix sums and cell lists are up to date
+
+  std::vector<Float_t>   fEta;                           //!eta of the particles
+  std::vector<Float_t>   fPhi;                           //!phi of the particles, as given
+  std::vector<Double_t>  fPt;                            //!pt of the particles
+  std::vector<Int_t>     fCell;                          //!cell of the particles
+  std::vector<Int_t>     fCellFirst;                     //!first entry of each cell in fCellParticles
+  std::vector<Int_t>     fCellParticles;                 //!particles sorted by cell
+  std::vector<Double_t>  fPrefix;                        //!2D prefix sums of the cell pt, (fNEta+1)x(fNPhi+1)
+
+ private:
+  AliEmcalConeGrid(const AliEmcalConeGrid&);             // not implemented
+  AliEmcalConeGrid& operator=(const AliEmcalConeGrid&);  // not implemented
+
+  ClassDef(AliEmcalConeGrid, 1); // Eta-phi grid for cone and region pt sums
+};
+#endif
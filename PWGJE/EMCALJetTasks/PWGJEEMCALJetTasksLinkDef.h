@@ -15,6 +15,7 @@
 #pragma link C++ class AliAnalysisTaskLocalRho+;
 #pragma link C++ class AliAnalysisTaskDeltaPt+;
 #pragma link C++ class AliAnalysisTaskScale+;
+#pragma link C++ class AliEmcalConeGrid+;
 #pragma link C++ class AliEmcalJetByJetCorrection+;
 #pragma link C++ class AliEmcalPicoTrackInGridMaker+;
 #pragma link C++ class AliJetEmbeddingTask+;
@@ -63,6 +63,7 @@ class AliESDv0;
 class AliAODv0;
 
 #include <numeric>
+#include <limits>
 
 #include <Riostream.h>
 #include "TList.h"
@@ -315,7 +316,10 @@ fTreeCascVarMVPileupFlag(kFALSE),
 fTreeCascVarOOBPileupFlag(kFALSE),
 //Histos
 fHistEventCounter(0),
-fHistCentrality(0)
+fHistCentrality(0),
+//Superlight mode cut tables
+fNV0Configurations(0),
+fNCascadeConfigurations(0)
 //------------------------------------------------
 // Tree Variables
 {
@@ -513,7 +517,10 @@ fTreeCascVarMVPileupFlag(kFALSE),
 fTreeCascVarOOBPileupFlag(kFALSE),
 //Histos
 fHistEventCounter(0),
-fHistCentrality(0)
+fHistCentrality(0),
+//Superlight mode cut tables
+fNV0Configurations(0),
+fNCascadeConfigurations(0)
 {
 
     //Re-vertex: Will only apply for cascade candidates
@@ -887,6 +894,10 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserCreateOutputObjects()
         fListCascade->SetOwner();
     }
 
+    //Superlight mode: compile the configurations into cut tables
+    CompileV0CutTable();
+    CompileCascadeCutTable();
+
     //Regular Output: Slots 1, 2, 3
     PostData(1, fListHist    );
     PostData(2, fListV0      );
@@ -1382,117 +1393,9 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserExec(Option_t *)
         // Superlight adaptive output mode
         //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
 
-        //Step 1: Sweep members of the output object TList and fill all of them as appropriate
-        Int_t lNumberOfConfigurations = fListV0->GetEntries();
-        //AliWarning(Form("[V0 Analyses] Processing different configurations (%i detected)",lNumberOfConfigurations));
-        TH3F *histoout         = 0x0;
-        AliV0Result *lV0Result = 0x0;
-        for(Int_t lcfg=0; lcfg<lNumberOfConfigurations; lcfg++){
-            lV0Result = (AliV0Result*) fListV0->At(lcfg);
-            histoout  = lV0Result->GetHistogram();
-
-            Float_t lMass = 0;
-            Float_t lRap  = 0;
-            Float_t lPDGMass = -1;
-            Float_t lNegdEdx = 100;
-            Float_t lPosdEdx = 100;
-            Float_t lBaryonMomentum = -0.5;
-
-            //========================================================================
-            //Setting up: Variable V0 CosPA
-            Float_t lV0CosPACut = lV0Result -> GetCutV0CosPA();
-            Float_t lVarV0CosPApar[5];
-            lVarV0CosPApar[0] = lV0Result->GetCutVarV0CosPAExp0Const();
-            lVarV0CosPApar[1] = lV0Result->GetCutVarV0CosPAExp0Slope();
-            lVarV0CosPApar[2] = lV0Result->GetCutVarV0CosPAExp1Const();
-            lVarV0CosPApar[3] = lV0Result->GetCutVarV0CosPAExp1Slope();
-            lVarV0CosPApar[4] = lV0Result->GetCutVarV0CosPAConst();
-            Float_t lVarV0CosPA = TMath::Cos(
-                                             lVarV0CosPApar[0]*TMath::Exp(lVarV0CosPApar[1]*fTreeVariablePt) +
-                                             lVarV0CosPApar[2]*TMath::Exp(lVarV0CosPApar[3]*fTreeVariablePt) +
-                                             lVarV0CosPApar[4]);
-            if( lV0Result->GetCutUseVarV0CosPA() ){
-                //Only use if tighter than the non-variable cut
-                if( lVarV0CosPA > lV0CosPACut ) lV0CosPACut = lVarV0CosPA;
-            }
-            //========================================================================
-
-            if ( lV0Result->GetMassHypothesis() == AliV0Result::kK0Short     ){
-                lMass    = fTreeVariableInvMassK0s;
-                lRap     = fTreeVariableRapK0Short;
-                lPDGMass = 0.497;
-                lNegdEdx = fTreeVariableNSigmasNegPion;
-                lPosdEdx = fTreeVariableNSigmasPosPion;
-            }
-            if ( lV0Result->GetMassHypothesis() == AliV0Result::kLambda      ){
-                lMass = fTreeVariableInvMassLambda;
-                lRap = fTreeVariableRapLambda;
-                lPDGMass = 1.115683;
-                lNegdEdx = fTreeVariableNSigmasNegPion;
-                lPosdEdx = fTreeVariableNSigmasPosProton;
-                lBaryonMomentum = fTreeVariablePosInnerP;
-            }
-            if ( lV0Result->GetMassHypothesis() == AliV0Result::kAntiLambda  ){
-                lMass = fTreeVariableInvMassAntiLambda;
-                lRap = fTreeVariableRapLambda;
-                lPDGMass = 1.115683;
-                lNegdEdx = fTreeVariableNSigmasNegProton;
-                lPosdEdx = fTreeVariableNSigmasPosPion;
-                lBaryonMomentum = fTreeVariableNegInnerP;
-            }
-
-            if (
-                //Check 1: Offline Vertexer
-                lOnFlyStatus == lV0Result->GetUseOnTheFly() &&
-
-                //Check 2: Basic Acceptance cuts
-                lV0Result->GetCutMinEtaTracks() < fTreeVariableNegEta && fTreeVariableNegEta < lV0Result->GetCutMaxEtaTracks() &&
-                lV0Result->GetCutMinEtaTracks() < fTreeVariablePosEta && fTreeVariablePosEta < lV0Result->GetCutMaxEtaTracks() &&
-                lRap > lV0Result->GetCutMinRapidity() &&
-                lRap < lV0Result->GetCutMaxRapidity() &&
-                
-                //Check 3: Topological Variables
-                fTreeVariableV0Radius > lV0Result->GetCutV0Radius() &&
-                fTreeVariableDcaNegToPrimVertex > lV0Result->GetCutDCANegToPV() &&
-                fTreeVariableDcaPosToPrimVertex > lV0Result->GetCutDCAPosToPV() &&
-                fTreeVariableDcaV0Daughters < lV0Result->GetCutDCAV0Daughters() &&
-                fTreeVariableV0CosineOfPointingAngle > lV0CosPACut &&
-                fTreeVariableDistOverTotMom*lPDGMass < lV0Result->GetCutProperLifetime() &&
-                fTreeVariableLeastNbrCrossedRows > lV0Result->GetCutLeastNumberOfCrossedRows() &&
-                fTreeVariableLeastRatioCrossedRowsOverFindable > lV0Result->GetCutLeastNumberOfCrossedRowsOverFindable() &&
-
-                //Check 4: Minimum momentum of baryon daughter
-                ( lV0Result->GetMassHypothesis() == AliV0Result::kK0Short || lBaryonMomentum > lV0Result->GetCutMinBaryonMomentum() ) &&
-
-                //Check 5: TPC dEdx selections
-                TMath::Abs(lNegdEdx)<lV0Result->GetCutTPCdEdx() &&
-                TMath::Abs(lPosdEdx)<lV0Result->GetCutTPCdEdx() &&
-
-                //Check 6: Armenteros-Podolanski space cut (for K0Short analysis)
-                ( ( lV0Result->GetCutArmenteros() == kFALSE || lV0Result->GetMassHypothesis() != AliV0Result::kK0Short ) || ( fTreeVariablePtArmV0*5>TMath::Abs(fTreeVariableAlphaV0) ) ) &&
-
-                //Check 7: kITSrefit track selection if requested
-                (
-                 ( (fTreeVariableNegTrackStatus & AliESDtrack::kITSrefit) &&
-                  (fTreeVariablePosTrackStatus & AliESDtrack::kITSrefit) )
-                 ||
-                 !lV0Result->GetCutUseITSRefitTracks()
-                 )&&
-
-                //Check 8: Max Chi2/Clusters if not absurd
-                ( lV0Result->GetCutMaxChi2PerCluster()>1e+3 ||
-                 fTreeVariableMaxChi2PerCluster < lV0Result->GetCutMaxChi2PerCluster()
-                 ) &&
-                //Check 9: Min Track Length if positive
-                ( lV0Result->GetCutMinTrackLength()<0 || //this is a bit paranoid...
-                 fTreeVariableMinTrackLength > lV0Result->GetCutMinTrackLength()
-                 )
-                )
-            {
-                //This satisfies all my conditionals! Fill histogram
-                histoout -> Fill ( fCentrality, fTreeVariablePt, lMass );
-            }
-        }
+        //Step 1: Test the candidate against all configurations of the V0 cut table
+        //and fill the histograms of the configurations it passes
+        FillV0Configurations(lOnFlyStatus);
         //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
         // End Superlight adaptive output mode
         //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
@@ -2075,222 +1978,9 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserExec(Option_t *)
         // Superlight adaptive output mode
         //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
 
-        //Step 1: Sweep members of the output object TList and fill all of them as appropriate
-        Int_t lNumberOfConfigurationsCascade = fListCascade->GetEntries();
-        //AliWarning(Form("[Cascade Analyses] Processing different configurations (%i detected)",lNumberOfConfigurationsCascade));
-        TH3F *histoout         = 0x0;
-        AliCascadeResult *lCascadeResult = 0x0;
-        for(Int_t lcfg=0; lcfg<lNumberOfConfigurationsCascade; lcfg++){
-            lCascadeResult = (AliCascadeResult*) fListCascade->At(lcfg);
-            histoout  = lCascadeResult->GetHistogram();
-
-            Float_t lMass = 0;
-            Float_t lRap  = 0;
-            Float_t lPDGMass = -1;
-            Float_t lNegdEdx = 100;
-            Float_t lPosdEdx = 100;
-            Float_t lBachdEdx = 100;
-            Short_t  lCharge = -2;
-            Float_t lprpx, lprpy, lprpz, lpipx, lpipy, lpipz;
-            lpipx = fTreeCascVarBachPx;
-            lpipy = fTreeCascVarBachPy;
-            lpipz = fTreeCascVarBachPz;
-
-            //For parametric V0 Mass selection
-            Float_t lExpV0Mass =
-            fLambdaMassMean[0]+
-            fLambdaMassMean[1]*TMath::Exp(fLambdaMassMean[2]*lV0Pt)+
-            fLambdaMassMean[3]*TMath::Exp(fLambdaMassMean[4]*lV0Pt);
-
-            Float_t lExpV0Sigma =
-            fLambdaMassSigma[0]+fLambdaMassSigma[1]*lV0Pt+
-            fLambdaMassSigma[2]*TMath::Exp(fLambdaMassSigma[3]*lV0Pt);
-
-            //========================================================================
-            //Setting up: Variable Cascade CosPA
-            Float_t lCascCosPACut = lCascadeResult -> GetCutCascCosPA();
-            Float_t lVarCascCosPApar[5];
-            lVarCascCosPApar[0] = lCascadeResult->GetCutVarCascCosPAExp0Const();
-            lVarCascCosPApar[1] = lCascadeResult->GetCutVarCascCosPAExp0Slope();
-            lVarCascCosPApar[2] = lCascadeResult->GetCutVarCascCosPAExp1Const();
-            lVarCascCosPApar[3] = lCascadeResult->GetCutVarCascCosPAExp1Slope();
-            lVarCascCosPApar[4] = lCascadeResult->GetCutVarCascCosPAConst();
-            Float_t lVarCascCosPA = TMath::Cos(
-                lVarCascCosPApar[0]*TMath::Exp(lVarCascCosPApar[1]*fTreeCascVarPt) +
-                lVarCascCosPApar[2]*TMath::Exp(lVarCascCosPApar[3]*fTreeCascVarPt) +
-                lVarCascCosPApar[4]);
-            if( lCascadeResult->GetCutUseVarCascCosPA() ){
-                //Only use if tighter than the non-variable cut
-                if( lVarCascCosPA > lCascCosPACut ) lCascCosPACut = lVarCascCosPA;
-            }
-            //========================================================================
-
-            //========================================================================
-            //Setting up: Variable V0 CosPA
-            Float_t lV0CosPACut = lCascadeResult -> GetCutV0CosPA();
-            Float_t lVarV0CosPApar[5];
-            lVarV0CosPApar[0] = lCascadeResult->GetCutVarV0CosPAExp0Const();
-            lVarV0CosPApar[1] = lCascadeResult->GetCutVarV0CosPAExp0Slope();
-            lVarV0CosPApar[2] = lCascadeResult->GetCutVarV0CosPAExp1Const();
-            lVarV0CosPApar[3] = lCascadeResult->GetCutVarV0CosPAExp1Slope();
-            lVarV0CosPApar[4] = lCascadeResult->GetCutVarV0CosPAConst();
-            Float_t lVarV0CosPA = TMath::Cos(
-                                               lVarV0CosPApar[0]*TMath::Exp(lVarV0CosPApar[1]*fTreeCascVarPt) +
-                                               lVarV0CosPApar[2]*TMath::Exp(lVarV0CosPApar[3]*fTreeCascVarPt) +
-                                               lVarV0CosPApar[4]);
-            if( lCascadeResult->GetCutUseVarV0CosPA() ){
-                //Only use if tighter than the non-variable cut
-                if( lVarV0CosPA > lV0CosPACut ) lV0CosPACut = lVarV0CosPA;
-            }
-            //========================================================================
-
-            //========================================================================
-            //Setting up: Variable BB CosPA
-            Float_t lBBCosPACut = lCascadeResult -> GetCutBachBaryonCosPA();
-            Float_t lVarBBCosPApar[5];
-            lVarBBCosPApar[0] = lCascadeResult->GetCutVarBBCosPAExp0Const();
-            lVarBBCosPApar[1] = lCascadeResult->GetCutVarBBCosPAExp0Slope();
-            lVarBBCosPApar[2] = lCascadeResult->GetCutVarBBCosPAExp1Const();
-            lVarBBCosPApar[3] = lCascadeResult->GetCutVarBBCosPAExp1Slope();
-            lVarBBCosPApar[4] = lCascadeResult->GetCutVarBBCosPAConst();
-            Float_t lVarBBCosPA = TMath::Cos(
-                                             lVarBBCosPApar[0]*TMath::Exp(lVarBBCosPApar[1]*fTreeCascVarPt) +
-                                             lVarBBCosPApar[2]*TMath::Exp(lVarBBCosPApar[3]*fTreeCascVarPt) +
-                                             lVarBBCosPApar[4]);
-            if( lCascadeResult->GetCutUseVarBBCosPA() ){
-                //Only use if looser than the non-variable cut (WARNING: BEWARE INVERSE LOGIC)
-                if( lVarBBCosPA > lBBCosPACut ) lBBCosPACut = lVarBBCosPA;
-            }
-            //========================================================================
-
-            if ( lCascadeResult->GetMassHypothesis() == AliCascadeResult::kXiMinus     ){
-                lCharge  = -1;
-                lMass    = fTreeCascVarMassAsXi;
-                lRap     = fTreeCascVarRapXi;
-                lPDGMass = 1.32171;
-                lNegdEdx = fTreeCascVarNegNSigmaPion;
-                lPosdEdx = fTreeCascVarPosNSigmaProton;
-                lBachdEdx= fTreeCascVarBachNSigmaPion;
-                lprpx = fTreeCascVarPosPx;
-                lprpy = fTreeCascVarPosPy;
-                lprpz = fTreeCascVarPosPz;
-            }
-            if ( lCascadeResult->GetMassHypothesis() == AliCascadeResult::kXiPlus      ){
-                lCharge  = +1;
-                lMass    = fTreeCascVarMassAsXi;
-                lRap     = fTreeCascVarRapXi;
-                lPDGMass = 1.32171;
-                lNegdEdx = fTreeCascVarNegNSigmaProton;
-                lPosdEdx = fTreeCascVarPosNSigmaPion;
-                lBachdEdx= fTreeCascVarBachNSigmaPion;
-                lprpx = fTreeCascVarNegPx;
-                lprpy = fTreeCascVarNegPy;
-                lprpz = fTreeCascVarNegPz;
-            }
-            if ( lCascadeResult->GetMassHypothesis() == AliCascadeResult::kOmegaMinus     ){
-                lCharge  = -1;
-                lMass    = fTreeCascVarMassAsOmega;
-                lRap     = fTreeCascVarRapOmega;
-                lPDGMass = 1.67245;
-                lNegdEdx = fTreeCascVarNegNSigmaPion;
-                lPosdEdx = fTreeCascVarPosNSigmaProton;
-                lBachdEdx= fTreeCascVarBachNSigmaKaon;
-                lprpx = fTreeCascVarPosPx;
-                lprpy = fTreeCascVarPosPy;
-                lprpz = fTreeCascVarPosPz;
-            }
-            if ( lCascadeResult->GetMassHypothesis() == AliCascadeResult::kOmegaPlus      ){
-                lCharge  = +1;
-                lMass    = fTreeCascVarMassAsOmega;
-                lRap     = fTreeCascVarRapOmega;
-                lPDGMass = 1.67245;
-                lNegdEdx = fTreeCascVarNegNSigmaProton;
-                lPosdEdx = fTreeCascVarPosNSigmaPion;
-                lBachdEdx= fTreeCascVarBachNSigmaKaon;
-                lprpx = fTreeCascVarNegPx;
-                lprpy = fTreeCascVarNegPy;
-                lprpz = fTreeCascVarNegPz;
-            }
-
-            if (
-                //Check 1: Charge consistent with expectations
-                fTreeCascVarCharge == lCharge &&
-
-                //Check 2: Basic Acceptance cuts
-                lCascadeResult->GetCutMinEtaTracks() < fTreeCascVarPosEta && fTreeCascVarPosEta < lCascadeResult->GetCutMaxEtaTracks() &&
-                lCascadeResult->GetCutMinEtaTracks() < fTreeCascVarNegEta && fTreeCascVarNegEta < lCascadeResult->GetCutMaxEtaTracks() &&
-                lCascadeResult->GetCutMinEtaTracks() < fTreeCascVarBachEta && fTreeCascVarBachEta < lCascadeResult->GetCutMaxEtaTracks() &&
-                lRap > lCascadeResult->GetCutMinRapidity() &&
-                lRap < lCascadeResult->GetCutMaxRapidity() &&
-
-                //Check 3: Topological Variables
-                // - V0 Selections
-                fTreeCascVarDCANegToPrimVtx > lCascadeResult->GetCutDCANegToPV() &&
-                fTreeCascVarDCAPosToPrimVtx > lCascadeResult->GetCutDCAPosToPV() &&
-                fTreeCascVarDCAV0Daughters < lCascadeResult->GetCutDCAV0Daughters() &&
-                fTreeCascVarV0CosPointingAngle > lV0CosPACut &&
-                fTreeCascVarV0Radius > lCascadeResult->GetCutV0Radius() &&
-                // - Cascade Selections
-                fTreeCascVarDCAV0ToPrimVtx > lCascadeResult->GetCutDCAV0ToPV() &&
-                TMath::Abs(fTreeCascVarV0Mass-1.116) < lCascadeResult->GetCutV0Mass() &&
-                fTreeCascVarDCABachToPrimVtx > lCascadeResult->GetCutDCABachToPV() &&
-                fTreeCascVarDCACascDaughters < lCascadeResult->GetCutDCACascDaughters() &&
-                fTreeCascVarCascCosPointingAngle > lCascCosPACut &&
-                fTreeCascVarCascRadius > lCascadeResult->GetCutCascRadius() &&
-
-                // - Implementation of a parametric V0 Mass cut if requested
-                (
-                 ( lCascadeResult->GetCutV0MassSigma() > 50 ) || //anything goes
-                 (TMath::Abs( (fTreeCascVarV0Mass-lExpV0Mass) / lExpV0Sigma ) < lCascadeResult->GetCutV0MassSigma() )
-                ) &&
-
-                // - Miscellaneous
-                fTreeCascVarDistOverTotMom*lPDGMass < lCascadeResult->GetCutProperLifetime() &&
-                fTreeCascVarLeastNbrClusters > lCascadeResult->GetCutLeastNumberOfClusters() &&
-
-                //Check 4: TPC dEdx selections
-                TMath::Abs(lNegdEdx )<lCascadeResult->GetCutTPCdEdx() &&
-                TMath::Abs(lPosdEdx )<lCascadeResult->GetCutTPCdEdx() &&
-                TMath::Abs(lBachdEdx)<lCascadeResult->GetCutTPCdEdx() &&
-
-                //Check 5: Xi rejection for Omega analysis
-                ( ( lCascadeResult->GetMassHypothesis() != AliCascadeResult::kOmegaMinus && lCascadeResult->GetMassHypothesis() != AliCascadeResult::kOmegaPlus  ) || ( TMath::Abs( fTreeCascVarMassAsXi - 1.32171 ) > lCascadeResult->GetCutXiRejection() ) ) &&
-
-                //Check 6: Experimental DCA Bachelor to Baryon cut
-                ( fTreeCascVarDCABachToBaryon > lCascadeResult->GetCutDCABachToBaryon() ) &&
-
-                //Check 7: Experimental Bach Baryon CosPA
-                ( fTreeCascVarWrongCosPA < lBBCosPACut  ) &&
-
-                //Check 8: Min/Max V0 Lifetime cut
-                ( ( fTreeCascVarV0Lifetime > lCascadeResult->GetCutMinV0Lifetime() ) &&
-                ( fTreeCascVarV0Lifetime < lCascadeResult->GetCutMaxV0Lifetime() ||
-                 lCascadeResult->GetCutMaxV0Lifetime() > 1e+3 ) ) &&
-
-                //Check 9: kITSrefit track selection if requested
-                (
-                 ( (fTreeCascVarPosTrackStatus & AliESDtrack::kITSrefit) &&
-                  (fTreeCascVarNegTrackStatus & AliESDtrack::kITSrefit) &&
-                  (fTreeCascVarBachTrackStatus & AliESDtrack::kITSrefit)
-                  )
-                 ||
-                 !lCascadeResult->GetCutUseITSRefitTracks()
-                 ) &&
-
-                //Check 10: Max Chi2/Clusters if not absurd
-                ( lCascadeResult->GetCutMaxChi2PerCluster()>1e+3 ||
-                 fTreeCascVarMaxChi2PerCluster < lCascadeResult->GetCutMaxChi2PerCluster()
-                 )&&
-
-                //Check 11: Min Track Length if positive
-                ( lCascadeResult->GetCutMinTrackLength()<0 || //this is a bit paranoid...
-                 fTreeCascVarMinTrackLength > lCascadeResult->GetCutMinTrackLength()
-                 )
-                ){
-                //This satisfies all my conditionals! Fill histogram
-                histoout -> Fill ( fCentrality, fTreeCascVarPt, lMass );
-            }
-        }
+        //Step 1: Test the candidate against all configurations of the cascade cut table
+        //and fill the histograms of the configurations it passes
+        FillCascadeConfigurations(lV0Pt);
         //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
         // End Superlight adaptive output mode
         //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
@@ -2367,6 +2057,432 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::AddConfiguration( AliCascadeR
     fListCascade->Add(lCascadeResult);
 }
 
+//________________________________________________________________________
+// Superlight mode: cut table evaluation
+// Each helper tests one candidate variable against one column of a cut table
+// for a block of configurations. The loops have no branches and are left to
+// the compiler to vectorize.
+static void PassIfAbove(UChar_t *lPass, const Double_t *lCut, Double_t lValue, Int_t lN)
+{
+    for(Int_t i=0; i<lN; i++) lPass[i] &= (lValue > lCut[i]);
+}
+static void PassIfBelow(UChar_t *lPass, const Double_t *lCut, Double_t lValue, Int_t lN)
+{
+    for(Int_t i=0; i<lN; i++) lPass[i] &= (lValue < lCut[i]);
+}
+static void PassIfEqual(UChar_t *lPass, const Double_t *lCut, Double_t lValue, Int_t lN)
+{
+    for(Int_t i=0; i<lN; i++) lPass[i] &= (lValue == lCut[i]);
+}
+static Bool_t AnyPass(const UChar_t *lPass, Int_t lN)
+{
+    UChar_t lAny = 0;
+    for(Int_t i=0; i<lN; i++) lAny |= lPass[i];
+    return lAny;
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskStrangenessVsMultiplicityRun2::CompileV0CutTable()
+{
+    //Compile the configurations in fListV0 into a columnar cut table, one row per
+    //configuration. Rows are grouped by mass hypothesis, so that within a block
+    //all rows are tested against the same candidate variables.
+    //Cuts which are switched off by a sentinel value are stored as +/- infinity.
+    const Double_t lInf = std::numeric_limits<Double_t>::infinity();
+    const Int_t lNHypo = 3;
+    fNV0Configurations = fListV0 ? fListV0->GetEntries() : 0;
+    fV0CutConfig.clear();
+    fV0CutHypoFirst.assign(lNHypo+1, 0);
+    for(Int_t lHypo=0; lHypo<lNHypo; lHypo++){
+        fV0CutHypoFirst[lHypo] = fV0CutConfig.size();
+        for(Int_t lcfg=0; lcfg<fNV0Configurations; lcfg++){
+            if( ((AliV0Result*) fListV0->At(lcfg))->GetMassHypothesis() == lHypo ) fV0CutConfig.push_back(lcfg);
+        }
+    }
+    fV0CutHypoFirst[lNHypo] = fV0CutConfig.size();
+
+    const Int_t lNRows = fV0CutConfig.size();
+    fV0CutTable.assign(kNV0CutColumns*lNRows, 0.);
+    fV0CutHisto.assign(lNRows, 0x0);
+    fV0CutCosPA.assign(lNRows, 0.);
+    fV0CutPass.assign(lNRows, 0);
+    fV0VarCosPARows.clear();
+    for(Int_t lRow=0; lRow<lNRows; lRow++){
+        AliV0Result *lV0Result = (AliV0Result*) fListV0->At(fV0CutConfig[lRow]);
+        Double_t *lCut = &fV0CutTable[lRow];
+        fV0CutHisto[lRow] = lV0Result->GetHistogram();
+        lCut[kV0UseOnTheFly*lNRows]                  = lV0Result->GetUseOnTheFly();
+        lCut[kV0MinEtaTracks*lNRows]                 = lV0Result->GetCutMinEtaTracks();
+        lCut[kV0MaxEtaTracks*lNRows]                 = lV0Result->GetCutMaxEtaTracks();
+        lCut[kV0MinRapidity*lNRows]                  = lV0Result->GetCutMinRapidity();
+        lCut[kV0MaxRapidity*lNRows]                  = lV0Result->GetCutMaxRapidity();
+        lCut[kV0Radius*lNRows]                       = lV0Result->GetCutV0Radius();
+        lCut[kV0DCANegToPV*lNRows]                   = lV0Result->GetCutDCANegToPV();
+        lCut[kV0DCAPosToPV*lNRows]                   = lV0Result->GetCutDCAPosToPV();
+        lCut[kV0DCAV0Daughters*lNRows]               = lV0Result->GetCutDCAV0Daughters();
+        lCut[kV0CosPA*lNRows]                        = (Float_t) lV0Result->GetCutV0CosPA();
+        lCut[kV0ProperLifetime*lNRows]               = lV0Result->GetCutProperLifetime();
+        lCut[kV0LeastCrossedRows*lNRows]             = lV0Result->GetCutLeastNumberOfCrossedRows();
+        lCut[kV0LeastCrossedRowsOverFindable*lNRows] = lV0Result->GetCutLeastNumberOfCrossedRowsOverFindable();
+        lCut[kV0MinBaryonMomentum*lNRows]            = lV0Result->GetCutMinBaryonMomentum();
+        lCut[kV0TPCdEdx*lNRows]                      = lV0Result->GetCutTPCdEdx();
+        lCut[kV0Armenteros*lNRows]                   = lV0Result->GetCutArmenteros();
+        lCut[kV0ITSRefitTracks*lNRows]               = lV0Result->GetCutUseITSRefitTracks();
+        lCut[kV0MaxChi2PerCluster*lNRows]            = lV0Result->GetCutMaxChi2PerCluster()>1e+3 ? lInf : lV0Result->GetCutMaxChi2PerCluster();
+        lCut[kV0MinTrackLength*lNRows]               = lV0Result->GetCutMinTrackLength()<0 ? -lInf : lV0Result->GetCutMinTrackLength();
+        //Variable V0 CosPA, parameters used in single precision as before
+        lCut[(kV0VarCosPAPar+0)*lNRows] = (Float_t) lV0Result->GetCutVarV0CosPAExp0Const();
+        lCut[(kV0VarCosPAPar+1)*lNRows] = (Float_t) lV0Result->GetCutVarV0CosPAExp0Slope();
+        lCut[(kV0VarCosPAPar+2)*lNRows] = (Float_t) lV0Result->GetCutVarV0CosPAExp1Const();
+        lCut[(kV0VarCosPAPar+3)*lNRows] = (Float_t) lV0Result->GetCutVarV0CosPAExp1Slope();
+        lCut[(kV0VarCosPAPar+4)*lNRows] = (Float_t) lV0Result->GetCutVarV0CosPAConst();
+        if( lV0Result->GetCutUseVarV0CosPA() ) fV0VarCosPARows.push_back(lRow);
+    }
+    AliInfo(Form("V0 cut table: %i configurations (K0Short: %i, Lambda: %i, AntiLambda: %i)", lNRows,
+                 fV0CutHypoFirst[1]-fV0CutHypoFirst[0], fV0CutHypoFirst[2]-fV0CutHypoFirst[1], fV0CutHypoFirst[3]-fV0CutHypoFirst[2]));
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskStrangenessVsMultiplicityRun2::CompileCascadeCutTable()
+{
+    //Compile the configurations in fListCascade into a columnar cut table, one row
+    //per configuration, grouped by mass hypothesis (see CompileV0CutTable)
+    const Double_t lInf = std::numeric_limits<Double_t>::infinity();
+    const Int_t lNHypo = 4;
+    fNCascadeConfigurations = fListCascade ? fListCascade->GetEntries() : 0;
+    fCascCutConfig.clear();
+    fCascCutHypoFirst.assign(lNHypo+1, 0);
+    for(Int_t lHypo=0; lHypo<lNHypo; lHypo++){
+        fCascCutHypoFirst[lHypo] = fCascCutConfig.size();
+        for(Int_t lcfg=0; lcfg<fNCascadeConfigurations; lcfg++){
+            if( ((AliCascadeResult*) fListCascade->At(lcfg))->GetMassHypothesis() == lHypo ) fCascCutConfig.push_back(lcfg);
+        }
+    }
+    fCascCutHypoFirst[lNHypo] = fCascCutConfig.size();
+
+    const Int_t lNRows = fCascCutConfig.size();
+    fCascCutTable.assign(kNCascadeCutColumns*lNRows, 0.);
+    fCascCutHisto.assign(lNRows, 0x0);
+    fCascCutCascCosPA.assign(lNRows, 0.);
+    fCascCutV0CosPA.assign(lNRows, 0.);
+    fCascCutBBCosPA.assign(lNRows, 0.);
+    fCascCutPass.assign(lNRows, 0);
+    fCascVarCascCosPARows.clear();
+    fCascVarV0CosPARows.clear();
+    fCascVarBBCosPARows.clear();
+    for(Int_t lRow=0; lRow<lNRows; lRow++){
+        AliCascadeResult *lCascadeResult = (AliCascadeResult*) fListCascade->At(fCascCutConfig[lRow]);
+        Double_t *lCut = &fCascCutTable[lRow];
+        fCascCutHisto[lRow] = lCascadeResult->GetHistogram();
+        lCut[kCascMinEtaTracks*lNRows]          = lCascadeResult->GetCutMinEtaTracks();
+        lCut[kCascMaxEtaTracks*lNRows]          = lCascadeResult->GetCutMaxEtaTracks();
+        lCut[kCascMinRapidity*lNRows]           = lCascadeResult->GetCutMinRapidity();
+        lCut[kCascMaxRapidity*lNRows]           = lCascadeResult->GetCutMaxRapidity();
+        lCut[kCascDCANegToPV*lNRows]            = lCascadeResult->GetCutDCANegToPV();
+        lCut[kCascDCAPosToPV*lNRows]            = lCascadeResult->GetCutDCAPosToPV();
+        lCut[kCascDCAV0Daughters*lNRows]        = lCascadeResult->GetCutDCAV0Daughters();
+        lCut[kCascV0CosPA*lNRows]               = (Float_t) lCascadeResult->GetCutV0CosPA();
+        lCut[kCascV0Radius*lNRows]              = lCascadeResult->GetCutV0Radius();
+        lCut[kCascDCAV0ToPV*lNRows]             = lCascadeResult->GetCutDCAV0ToPV();
+        lCut[kCascV0Mass*lNRows]                = lCascadeResult->GetCutV0Mass();
+        lCut[kCascDCABachToPV*lNRows]           = lCascadeResult->GetCutDCABachToPV();
+        lCut[kCascDCACascDaughters*lNRows]      = lCascadeResult->GetCutDCACascDaughters();
+        lCut[kCascCascCosPA*lNRows]             = (Float_t) lCascadeResult->GetCutCascCosPA();
+        lCut[kCascCascRadius*lNRows]            = lCascadeResult->GetCutCascRadius();
+        lCut[kCascV0MassSigma*lNRows]           = lCascadeResult->GetCutV0MassSigma()>50 ? lInf : lCascadeResult->GetCutV0MassSigma();
+        lCut[kCascProperLifetime*lNRows]        = lCascadeResult->GetCutProperLifetime();
+        lCut[kCascLeastNumberOfClusters*lNRows] = lCascadeResult->GetCutLeastNumberOfClusters();
+        lCut[kCascTPCdEdx*lNRows]               = lCascadeResult->GetCutTPCdEdx();
+        lCut[kCascXiRejection*lNRows]           = lCascadeResult->GetCutXiRejection();
+        lCut[kCascDCABachToBaryon*lNRows]       = lCascadeResult->GetCutDCABachToBaryon();
+        lCut[kCascBBCosPA*lNRows]               = (Float_t) lCascadeResult->GetCutBachBaryonCosPA();
+        lCut[kCascMinV0Lifetime*lNRows]         = lCascadeResult->GetCutMinV0Lifetime();
+        lCut[kCascMaxV0Lifetime*lNRows]         = lCascadeResult->GetCutMaxV0Lifetime()>1e+3 ? lInf : lCascadeResult->GetCutMaxV0Lifetime();
+        lCut[kCascITSRefitTracks*lNRows]        = lCascadeResult->GetCutUseITSRefitTracks();
+        lCut[kCascMaxChi2PerCluster*lNRows]     = lCascadeResult->GetCutMaxChi2PerCluster()>1e+3 ? lInf : lCascadeResult->GetCutMaxChi2PerCluster();
+        lCut[kCascMinTrackLength*lNRows]        = lCascadeResult->GetCutMinTrackLength()<0 ? -lInf : lCascadeResult->GetCutMinTrackLength();
+        //Variable CosPA cuts, parameters used in single precision as before
+        lCut[(kCascVarCascCosPAPar+0)*lNRows] = (Float_t) lCascadeResult->GetCutVarCascCosPAExp0Const();
+        lCut[(kCascVarCascCosPAPar+1)*lNRows] = (Float_t) lCascadeResult->GetCutVarCascCosPAExp0Slope();
+        lCut[(kCascVarCascCosPAPar+2)*lNRows] = (Float_t) lCascadeResult->GetCutVarCascCosPAExp1Const();
+        lCut[(kCascVarCascCosPAPar+3)*lNRows] = (Float_t) lCascadeResult->GetCutVarCascCosPAExp1Slope();
+        lCut[(kCascVarCascCosPAPar+4)*lNRows] = (Float_t) lCascadeResult->GetCutVarCascCosPAConst();
+        lCut[(kCascVarV0CosPAPar+0)*lNRows]   = (Float_t) lCascadeResult->GetCutVarV0CosPAExp0Const();
+        lCut[(kCascVarV0CosPAPar+1)*lNRows]   = (Float_t) lCascadeResult->GetCutVarV0CosPAExp0Slope();
+        lCut[(kCascVarV0CosPAPar+2)*lNRows]   = (Float_t) lCascadeResult->GetCutVarV0CosPAExp1Const();
+        lCut[(kCascVarV0CosPAPar+3)*lNRows]   = (Float_t) lCascadeResult->GetCutVarV0CosPAExp1Slope();
+        lCut[(kCascVarV0CosPAPar+4)*lNRows]   = (Float_t) lCascadeResult->GetCutVarV0CosPAConst();
+        lCut[(kCascVarBBCosPAPar+0)*lNRows]   = (Float_t) lCascadeResult->GetCutVarBBCosPAExp0Const();
+        lCut[(kCascVarBBCosPAPar+1)*lNRows]   = (Float_t) lCascadeResult->GetCutVarBBCosPAExp0Slope();
+        lCut[(kCascVarBBCosPAPar+2)*lNRows]   = (Float_t) lCascadeResult->GetCutVarBBCosPAExp1Const();
+        lCut[(kCascVarBBCosPAPar+3)*lNRows]   = (Float_t) lCascadeResult->GetCutVarBBCosPAExp1Slope();
+        lCut[(kCascVarBBCosPAPar+4)*lNRows]   = (Float_t) lCascadeResult->GetCutVarBBCosPAConst();
+        if( lCascadeResult->GetCutUseVarCascCosPA() ) fCascVarCascCosPARows.push_back(lRow);
+        if( lCascadeResult->GetCutUseVarV0CosPA()   ) fCascVarV0CosPARows.push_back(lRow);
+        if( lCascadeResult->GetCutUseVarBBCosPA()   ) fCascVarBBCosPARows.push_back(lRow);
+    }
+    AliInfo(Form("Cascade cut table: %i configurations (XiMinus: %i, XiPlus: %i, OmegaMinus: %i, OmegaPlus: %i)", lNRows,
+                 fCascCutHypoFirst[1]-fCascCutHypoFirst[0], fCascCutHypoFirst[2]-fCascCutHypoFirst[1],
+                 fCascCutHypoFirst[3]-fCascCutHypoFirst[2], fCascCutHypoFirst[4]-fCascCutHypoFirst[3]));
+}
+
+//________________________________________________________________________
+// Variable CosPA cut from the 5 parameters of a cut table row, in single precision as before
+static Float_t VariableCosPA(const Double_t *lCut, Int_t lStride, Float_t lPt)
+{
+    Float_t lPar[5];
+    for(Int_t ipar=0; ipar<5; ipar++) lPar[ipar] = lCut[ipar*lStride];
+    return TMath::Cos( lPar[0]*TMath::Exp(lPar[1]*lPt) + lPar[2]*TMath::Exp(lPar[3]*lPt) + lPar[4] );
+}
+
+//________________________________________________________________________
+// Effective CosPA thresholds of a candidate: the variable cut is only used if tighter
+static void FillCosPAThresholds(std::vector<Double_t> &lThreshold, const Double_t *lFixed, const Double_t *lVarPar,
+                                const std::vector<Int_t> &lVarRows, Int_t lNRows, Float_t lPt)
+{
+    for(Int_t lRow=0; lRow<lNRows; lRow++) lThreshold[lRow] = lFixed[lRow];
+    for(size_t i=0; i<lVarRows.size(); i++){
+        Int_t lRow = lVarRows[i];
+        Float_t lVarCosPA = VariableCosPA(lVarPar+lRow, lNRows, lPt);
+        if( lVarCosPA > lThreshold[lRow] ) lThreshold[lRow] = lVarCosPA;
+    }
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskStrangenessVsMultiplicityRun2::FillV0Configurations(Int_t lOnFlyStatus)
+{
+    //Test the current V0 candidate against all the rows of the V0 cut table and fill
+    //the histograms of the configurations it passes. Same selections as the per-configuration
+    //sweep it replaces, evaluated one cut at a time for a whole block of configurations.
+    if( !fListV0 ) return;
+    if( fNV0Configurations != fListV0->GetEntries() ) CompileV0CutTable();
+    const Int_t lNRows = fV0CutConfig.size();
+    if( !lNRows ) return;
+    const Double_t *lCut = &fV0CutTable[0];
+
+    FillCosPAThresholds(fV0CutCosPA, lCut+kV0CosPA*lNRows, lCut+kV0VarCosPAPar*lNRows, fV0VarCosPARows, lNRows, fTreeVariablePt);
+
+    //Candidate variables common to all mass hypotheses
+    const Float_t lMinEta = TMath::Min(fTreeVariableNegEta, fTreeVariablePosEta);
+    const Float_t lMaxEta = TMath::Max(fTreeVariableNegEta, fTreeVariablePosEta);
+    const Bool_t lITSRefit = (fTreeVariableNegTrackStatus & AliESDtrack::kITSrefit) && (fTreeVariablePosTrackStatus & AliESDtrack::kITSrefit);
+    const Bool_t lArmenteros = fTreeVariablePtArmV0*5>TMath::Abs(fTreeVariableAlphaV0);
+
+    for(Int_t lHypo=0; lHypo<3; lHypo++){
+        const Int_t lFirst = fV0CutHypoFirst[lHypo];
+        const Int_t lN = fV0CutHypoFirst[lHypo+1]-lFirst;
+        if( !lN ) continue;
+
+        Float_t lMass = 0;
+        Float_t lRap  = 0;
+        Float_t lPDGMass = -1;
+        Float_t lNegdEdx = 100;
+        Float_t lPosdEdx = 100;
+        Float_t lBaryonMomentum = -0.5;
+        if ( lHypo == AliV0Result::kK0Short     ){
+            lMass    = fTreeVariableInvMassK0s;
+            lRap     = fTreeVariableRapK0Short;
+            lPDGMass = 0.497;
+            lNegdEdx = fTreeVariableNSigmasNegPion;
+            lPosdEdx = fTreeVariableNSigmasPosPion;
+        }
+        if ( lHypo == AliV0Result::kLambda      ){
+            lMass = fTreeVariableInvMassLambda;
+            lRap = fTreeVariableRapLambda;
+            lPDGMass = 1.115683;
+            lNegdEdx = fTreeVariableNSigmasNegPion;
+            lPosdEdx = fTreeVariableNSigmasPosProton;
+            lBaryonMomentum = fTreeVariablePosInnerP;
+        }
+        if ( lHypo == AliV0Result::kAntiLambda  ){
+            lMass = fTreeVariableInvMassAntiLambda;
+            lRap = fTreeVariableRapLambda;
+            lPDGMass = 1.115683;
+            lNegdEdx = fTreeVariableNSigmasNegProton;
+            lPosdEdx = fTreeVariableNSigmasPosPion;
+            lBaryonMomentum = fTreeVariableNegInnerP;
+        }
+
+        UChar_t *lPass = &fV0CutPass[lFirst];
+        for(Int_t i=0; i<lN; i++) lPass[i] = 1;
+
+        //Check 1: Offline Vertexer
+        PassIfEqual(lPass, lCut+kV0UseOnTheFly*lNRows+lFirst, lOnFlyStatus, lN);
+        //Check 2: Basic Acceptance cuts
+        PassIfAbove(lPass, lCut+kV0MinEtaTracks*lNRows+lFirst, lMinEta, lN);
+        PassIfBelow(lPass, lCut+kV0MaxEtaTracks*lNRows+lFirst, lMaxEta, lN);
+        PassIfAbove(lPass, lCut+kV0MinRapidity*lNRows+lFirst, lRap, lN);
+        PassIfBelow(lPass, lCut+kV0MaxRapidity*lNRows+lFirst, lRap, lN);
+        if( !AnyPass(lPass, lN) ) continue;
+        //Check 3: Topological Variables
+        PassIfAbove(lPass, lCut+kV0Radius*lNRows+lFirst, fTreeVariableV0Radius, lN);
+        PassIfAbove(lPass, lCut+kV0DCANegToPV*lNRows+lFirst, fTreeVariableDcaNegToPrimVertex, lN);
+        PassIfAbove(lPass, lCut+kV0DCAPosToPV*lNRows+lFirst, fTreeVariableDcaPosToPrimVertex, lN);
+        PassIfBelow(lPass, lCut+kV0DCAV0Daughters*lNRows+lFirst, fTreeVariableDcaV0Daughters, lN);
+        PassIfAbove(lPass, &fV0CutCosPA[lFirst], fTreeVariableV0CosineOfPointingAngle, lN);
+        PassIfBelow(lPass, lCut+kV0ProperLifetime*lNRows+lFirst, fTreeVariableDistOverTotMom*lPDGMass, lN);
+        PassIfAbove(lPass, lCut+kV0LeastCrossedRows*lNRows+lFirst, fTreeVariableLeastNbrCrossedRows, lN);
+        PassIfAbove(lPass, lCut+kV0LeastCrossedRowsOverFindable*lNRows+lFirst, fTreeVariableLeastRatioCrossedRowsOverFindable, lN);
+        //Check 4: Minimum momentum of baryon daughter
+        if( lHypo != AliV0Result::kK0Short ) PassIfAbove(lPass, lCut+kV0MinBaryonMomentum*lNRows+lFirst, lBaryonMomentum, lN);
+        //Check 5: TPC dEdx selections
+        PassIfBelow(lPass, lCut+kV0TPCdEdx*lNRows+lFirst, TMath::Max(TMath::Abs(lNegdEdx), TMath::Abs(lPosdEdx)), lN);
+        //Check 6: Armenteros-Podolanski space cut (for K0Short analysis)
+        if( lHypo == AliV0Result::kK0Short && !lArmenteros ) PassIfEqual(lPass, lCut+kV0Armenteros*lNRows+lFirst, 0, lN);
+        //Check 7: kITSrefit track selection if requested
+        if( !lITSRefit ) PassIfEqual(lPass, lCut+kV0ITSRefitTracks*lNRows+lFirst, 0, lN);
+        //Check 8: Max Chi2/Clusters if not absurd (+inf if disabled)
+        PassIfBelow(lPass, lCut+kV0MaxChi2PerCluster*lNRows+lFirst, fTreeVariableMaxChi2PerCluster, lN);
+        //Check 9: Min Track Length if positive (-inf if disabled)
+        PassIfAbove(lPass, lCut+kV0MinTrackLength*lNRows+lFirst, fTreeVariableMinTrackLength, lN);
+
+        //This satisfies all my conditionals! Fill histogram
+        for(Int_t i=0; i<lN; i++){
+            if( lPass[i] ) fV0CutHisto[lFirst+i] -> Fill ( fCentrality, fTreeVariablePt, lMass );
+        }
+    }
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskStrangenessVsMultiplicityRun2::FillCascadeConfigurations(Float_t lV0Pt)
+{
+    //Test the current cascade candidate against all the rows of the cascade cut table and
+    //fill the histograms of the configurations it passes (see FillV0Configurations)
+    if( !fListCascade ) return;
+    if( fNCascadeConfigurations != fListCascade->GetEntries() ) CompileCascadeCutTable();
+    const Int_t lNRows = fCascCutConfig.size();
+    if( !lNRows ) return;
+    const Double_t *lCut = &fCascCutTable[0];
+
+    FillCosPAThresholds(fCascCutCascCosPA, lCut+kCascCascCosPA*lNRows, lCut+kCascVarCascCosPAPar*lNRows, fCascVarCascCosPARows, lNRows, fTreeCascVarPt);
+    FillCosPAThresholds(fCascCutV0CosPA, lCut+kCascV0CosPA*lNRows, lCut+kCascVarV0CosPAPar*lNRows, fCascVarV0CosPARows, lNRows, fTreeCascVarPt);
+    //Bach-baryon CosPA: variable cut used if looser (WARNING: BEWARE INVERSE LOGIC)
+    FillCosPAThresholds(fCascCutBBCosPA, lCut+kCascBBCosPA*lNRows, lCut+kCascVarBBCosPAPar*lNRows, fCascVarBBCosPARows, lNRows, fTreeCascVarPt);
+
+    //For parametric V0 Mass selection
+    Float_t lExpV0Mass =
+    fLambdaMassMean[0]+
+    fLambdaMassMean[1]*TMath::Exp(fLambdaMassMean[2]*lV0Pt)+
+    fLambdaMassMean[3]*TMath::Exp(fLambdaMassMean[4]*lV0Pt);
+
+    Float_t lExpV0Sigma =
+    fLambdaMassSigma[0]+fLambdaMassSigma[1]*lV0Pt+
+    fLambdaMassSigma[2]*TMath::Exp(fLambdaMassSigma[3]*lV0Pt);
+
+    //Candidate variables common to all mass hypotheses
+    const Float_t lMinEta = TMath::Min(fTreeCascVarBachEta, TMath::Min(fTreeCascVarNegEta, fTreeCascVarPosEta));
+    const Float_t lMaxEta = TMath::Max(fTreeCascVarBachEta, TMath::Max(fTreeCascVarNegEta, fTreeCascVarPosEta));
+    const Bool_t lITSRefit = (fTreeCascVarPosTrackStatus & AliESDtrack::kITSrefit) &&
+                             (fTreeCascVarNegTrackStatus & AliESDtrack::kITSrefit) &&
+                             (fTreeCascVarBachTrackStatus & AliESDtrack::kITSrefit);
+    const Float_t lV0MassSigma = TMath::Abs( (fTreeCascVarV0Mass-lExpV0Mass) / lExpV0Sigma );
+
+    for(Int_t lHypo=0; lHypo<4; lHypo++){
+        const Int_t lFirst = fCascCutHypoFirst[lHypo];
+        const Int_t lN = fCascCutHypoFirst[lHypo+1]-lFirst;
+        if( !lN ) continue;
+
+        Float_t lMass = 0;
+        Float_t lRap  = 0;
+        Float_t lPDGMass = -1;
+        Float_t lNegdEdx = 100;
+        Float_t lPosdEdx = 100;
+        Float_t lBachdEdx = 100;
+        Short_t  lCharge = -2;
+        if ( lHypo == AliCascadeResult::kXiMinus     ){
+            lCharge  = -1;
+            lMass    = fTreeCascVarMassAsXi;
+            lRap     = fTreeCascVarRapXi;
+            lPDGMass = 1.32171;
+            lNegdEdx = fTreeCascVarNegNSigmaPion;
+            lPosdEdx = fTreeCascVarPosNSigmaProton;
+            lBachdEdx= fTreeCascVarBachNSigmaPion;
+        }
+        if ( lHypo == AliCascadeResult::kXiPlus      ){
+            lCharge  = +1;
+            lMass    = fTreeCascVarMassAsXi;
+            lRap     = fTreeCascVarRapXi;
+            lPDGMass = 1.32171;
+            lNegdEdx = fTreeCascVarNegNSigmaProton;
+            lPosdEdx = fTreeCascVarPosNSigmaPion;
+            lBachdEdx= fTreeCascVarBachNSigmaPion;
+        }
+        if ( lHypo == AliCascadeResult::kOmegaMinus     ){
+            lCharge  = -1;
+            lMass    = fTreeCascVarMassAsOmega;
+            lRap     = fTreeCascVarRapOmega;
+            lPDGMass = 1.67245;
+            lNegdEdx = fTreeCascVarNegNSigmaPion;
+            lPosdEdx = fTreeCascVarPosNSigmaProton;
+            lBachdEdx= fTreeCascVarBachNSigmaKaon;
+        }
+        if ( lHypo == AliCascadeResult::kOmegaPlus      ){
+            lCharge  = +1;
+            lMass    = fTreeCascVarMassAsOmega;
+            lRap     = fTreeCascVarRapOmega;
+            lPDGMass = 1.67245;
+            lNegdEdx = fTreeCascVarNegNSigmaProton;
+            lPosdEdx = fTreeCascVarPosNSigmaPion;
+            lBachdEdx= fTreeCascVarBachNSigmaKaon;
+        }
+
+        //Check 1: Charge consistent with expectations
+        if( fTreeCascVarCharge != lCharge ) continue;
+
+        UChar_t *lPass = &fCascCutPass[lFirst];
+        for(Int_t i=0; i<lN; i++) lPass[i] = 1;
+
+        //Check 2: Basic Acceptance cuts
+        PassIfAbove(lPass, lCut+kCascMinEtaTracks*lNRows+lFirst, lMinEta, lN);
+        PassIfBelow(lPass, lCut+kCascMaxEtaTracks*lNRows+lFirst, lMaxEta, lN);
+        PassIfAbove(lPass, lCut+kCascMinRapidity*lNRows+lFirst, lRap, lN);
+        PassIfBelow(lPass, lCut+kCascMaxRapidity*lNRows+lFirst, lRap, lN);
+        if( !AnyPass(lPass, lN) ) continue;
+        //Check 3: Topological Variables
+        // - V0 Selections
+        PassIfAbove(lPass, lCut+kCascDCANegToPV*lNRows+lFirst, fTreeCascVarDCANegToPrimVtx, lN);
+        PassIfAbove(lPass, lCut+kCascDCAPosToPV*lNRows+lFirst, fTreeCascVarDCAPosToPrimVtx, lN);
+        PassIfBelow(lPass, lCut+kCascDCAV0Daughters*lNRows+lFirst, fTreeCascVarDCAV0Daughters, lN);
+        PassIfAbove(lPass, &fCascCutV0CosPA[lFirst], fTreeCascVarV0CosPointingAngle, lN);
+        PassIfAbove(lPass, lCut+kCascV0Radius*lNRows+lFirst, fTreeCascVarV0Radius, lN);
+        // - Cascade Selections
+        PassIfAbove(lPass, lCut+kCascDCAV0ToPV*lNRows+lFirst, fTreeCascVarDCAV0ToPrimVtx, lN);
+        PassIfBelow(lPass, lCut+kCascV0Mass*lNRows+lFirst, TMath::Abs(fTreeCascVarV0Mass-1.116), lN);
+        PassIfAbove(lPass, lCut+kCascDCABachToPV*lNRows+lFirst, fTreeCascVarDCABachToPrimVtx, lN);
+        PassIfBelow(lPass, lCut+kCascDCACascDaughters*lNRows+lFirst, fTreeCascVarDCACascDaughters, lN);
+        PassIfAbove(lPass, &fCascCutCascCosPA[lFirst], fTreeCascVarCascCosPointingAngle, lN);
+        PassIfAbove(lPass, lCut+kCascCascRadius*lNRows+lFirst, fTreeCascVarCascRadius, lN);
+        // - Implementation of a parametric V0 Mass cut if requested (+inf if disabled)
+        PassIfBelow(lPass, lCut+kCascV0MassSigma*lNRows+lFirst, lV0MassSigma, lN);
+        // - Miscellaneous
+        PassIfBelow(lPass, lCut+kCascProperLifetime*lNRows+lFirst, fTreeCascVarDistOverTotMom*lPDGMass, lN);
+        PassIfAbove(lPass, lCut+kCascLeastNumberOfClusters*lNRows+lFirst, fTreeCascVarLeastNbrClusters, lN);
+        //Check 4: TPC dEdx selections
+        PassIfBelow(lPass, lCut+kCascTPCdEdx*lNRows+lFirst, TMath::Max(TMath::Abs(lBachdEdx), TMath::Max(TMath::Abs(lNegdEdx), TMath::Abs(lPosdEdx))), lN);
+        //Check 5: Xi rejection for Omega analysis
+        if( lHypo == AliCascadeResult::kOmegaMinus || lHypo == AliCascadeResult::kOmegaPlus )
+            PassIfAbove(lPass, lCut+kCascXiRejection*lNRows+lFirst, TMath::Abs( fTreeCascVarMassAsXi - 1.32171 ), lN);
+        //Check 6: Experimental DCA Bachelor to Baryon cut
+        PassIfAbove(lPass, lCut+kCascDCABachToBaryon*lNRows+lFirst, fTreeCascVarDCABachToBaryon, lN);
+        //Check 7: Experimental Bach Baryon CosPA
+        PassIfBelow(lPass, &fCascCutBBCosPA[lFirst], fTreeCascVarWrongCosPA, lN);
+        //Check 8: Min/Max V0 Lifetime cut (+inf if no max)
+        PassIfAbove(lPass, lCut+kCascMinV0Lifetime*lNRows+lFirst, fTreeCascVarV0Lifetime, lN);
+        PassIfBelow(lPass, lCut+kCascMaxV0Lifetime*lNRows+lFirst, fTreeCascVarV0Lifetime, lN);
+        //Check 9: kITSrefit track selection if requested
+        if( !lITSRefit ) PassIfEqual(lPass, lCut+kCascITSRefitTracks*lNRows+lFirst, 0, lN);
+        //Check 10: Max Chi2/Clusters if not absurd (+inf if disabled)
+        PassIfBelow(lPass, lCut+kCascMaxChi2PerCluster*lNRows+lFirst, fTreeCascVarMaxChi2PerCluster, lN);
+        //Check 11: Min Track Length if positive (-inf if disabled)
+        PassIfAbove(lPass, lCut+kCascMinTrackLength*lNRows+lFirst, fTreeCascVarMinTrackLength, lN);
+
+        //This satisfies all my conditionals! Fill histogram
+        for(Int_t i=0; i<lN; i++){
+            if( lPass[i] ) fCascCutHisto[lFirst+i] -> Fill ( fCentrality, fTreeCascVarPt, lMass );
+        }
+    }
+}
+
 //________________________________________________________________________
 void AliAnalysisTaskStrangenessVsMultiplicityRun2::SetupStandardVertexing()
 //Meant to store standard re-vertexing configuration
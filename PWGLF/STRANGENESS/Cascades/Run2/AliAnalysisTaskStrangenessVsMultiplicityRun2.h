@@ -468,11 +468,66 @@ private:
     TH1D *fHistEventCounter; //!
     TH1D *fHistCentrality; //!
 
+//===========================================================================================
+//   Superlight mode: configurations compiled into columnar cut tables
+//===========================================================================================
+    //Columns of the V0 cut table (one row per configuration)
+    enum EV0CutColumn {
+        kV0UseOnTheFly, kV0MinEtaTracks, kV0MaxEtaTracks, kV0MinRapidity, kV0MaxRapidity,
+        kV0Radius, kV0DCANegToPV, kV0DCAPosToPV, kV0DCAV0Daughters, kV0CosPA, kV0ProperLifetime,
+        kV0LeastCrossedRows, kV0LeastCrossedRowsOverFindable, kV0MinBaryonMomentum, kV0TPCdEdx,
+        kV0Armenteros, kV0ITSRefitTracks, kV0MaxChi2PerCluster, kV0MinTrackLength,
+        kV0VarCosPAPar, //5 parameters of the variable V0 CosPA
+        kNV0CutColumns = kV0VarCosPAPar+5
+    };
+    //Columns of the cascade cut table (one row per configuration)
+    enum ECascadeCutColumn {
+        kCascMinEtaTracks, kCascMaxEtaTracks, kCascMinRapidity, kCascMaxRapidity,
+        kCascDCANegToPV, kCascDCAPosToPV, kCascDCAV0Daughters, kCascV0CosPA, kCascV0Radius,
+        kCascDCAV0ToPV, kCascV0Mass, kCascDCABachToPV, kCascDCACascDaughters, kCascCascCosPA,
+        kCascCascRadius, kCascV0MassSigma, kCascProperLifetime, kCascLeastNumberOfClusters,
+        kCascTPCdEdx, kCascXiRejection, kCascDCABachToBaryon, kCascBBCosPA, kCascMinV0Lifetime,
+        kCascMaxV0Lifetime, kCascITSRefitTracks, kCascMaxChi2PerCluster, kCascMinTrackLength,
+        kCascVarCascCosPAPar,                       //5 parameters of the variable cascade CosPA
+        kCascVarV0CosPAPar = kCascVarCascCosPAPar+5, //5 parameters of the variable V0 CosPA
+        kCascVarBBCosPAPar = kCascVarV0CosPAPar+5,   //5 parameters of the variable bach-baryon CosPA
+        kNCascadeCutColumns = kCascVarBBCosPAPar+5
+    };
+
+    void CompileV0CutTable();
+    void CompileCascadeCutTable();
+    void FillV0Configurations(Int_t lOnFlyStatus);
+    void FillCascadeConfigurations(Float_t lV0Pt);
+
+    Int_t fNV0Configurations;      //! configurations compiled in the V0 cut table
+    Int_t fNCascadeConfigurations; //! configurations compiled in the cascade cut table
+
+    std::vector<Int_t>    fV0CutConfig;     //! configuration (index in fListV0) of each row
+    std::vector<Int_t>    fV0CutHypoFirst;  //! first row of each mass hypothesis, plus end
+    std::vector<Double_t> fV0CutTable;      //! thresholds, column-major
+    std::vector<TH3F*>    fV0CutHisto;      //! output histogram of each row
+    std::vector<Int_t>    fV0VarCosPARows;  //! rows using the variable V0 CosPA
+    std::vector<Double_t> fV0CutCosPA;      //! V0 CosPA threshold for the current candidate
+    std::vector<UChar_t>  fV0CutPass;       //! pass mask of the current candidate
+
+    std::vector<Int_t>    fCascCutConfig;         //! configuration (index in fListCascade) of each row
+    std::vector<Int_t>    fCascCutHypoFirst;      //! first row of each mass hypothesis, plus end
+    std::vector<Double_t> fCascCutTable;          //! thresholds, column-major
+    std::vector<TH3F*>    fCascCutHisto;          //! output histogram of each row
+    std::vector<Int_t>    fCascVarCascCosPARows;  //! rows using the variable cascade CosPA
+    std::vector<Int_t>    fCascVarV0CosPARows;    //! rows using the variable V0 CosPA
+    std::vector<Int_t>    fCascVarBBCosPARows;    //! rows using the variable bach-baryon CosPA
+    std::vector<Double_t> fCascCutCascCosPA;      //! cascade CosPA threshold for the current candidate
+    std::vector<Double_t> fCascCutV0CosPA;        //! V0 CosPA threshold for the current candidate
+    std::vector<Double_t> fCascCutBBCosPA;        //! bach-baryon CosPA threshold for the current candidate
+    std::vector<UChar_t>  fCascCutPass;           //! pass mask of the current candidate
+
     AliAnalysisTaskStrangenessVsMultiplicityRun2(const AliAnalysisTaskStrangenessVsMultiplicityRun2&);            // not implemented
     AliAnalysisTaskStrangenessVsMultiplicityRun2& operator=(const AliAnalysisTaskStrangenessVsMultiplicityRun2&); // not implemented
 
-    ClassDef(AliAnalysisTaskStrangenessVsMultiplicityRun2, 2);
+    ClassDef(AliAnalysisTaskStrangenessVsMultiplicityRun2, 3);
     //1: first implementation
+    //3: configurations evaluated through columnar cut tables
 };
 
 #endif
@@ -53,6 +53,13 @@ class AliAODv0;
 #include "TLegend.h"
 #include "TRandom3.h"
 #include "TLorentzVector.h"
+#include "TDatabasePDG.h"
+#include <RConfigure.h>
+#include <RVersion.h>
+#if defined(R__USE_IMT) && ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0)
+#include <ROOT/TSeq.hxx>
+#include <ROOT/TThreadExecutor.hxx>
+#endif
 //#include "AliLog.h"
 
 #include "AliESDEvent.h"
@@ -61,6 +68,7 @@ class AliAODv0;
 #include "AliCascadeVertexer.h"
 #include "AliLightV0vertexer.h"
 #include "AliLightCascadeVertexer.h"
+#include "AliV0PairingPrefilter.h"
 #include "AliESDpid.h"
 #include "AliESDtrack.h"
 #include "AliESDtrackCuts.h"
@@ -109,6 +117,8 @@ fMaxCentrality(90.0),
 fkPreselectDedx ( kTRUE ),
 fkPreselectDedxLambda ( kTRUE ),
 fkExtraCleanup    ( kTRUE ), //extra cleanup: eta, etc
+fkUsePairPrefilter( kTRUE ),
+fNThreads         ( 1 ),
 //________________________________________________
 //Flags for V0 vertexer
 fkRunV0Vertexer (kFALSE),
@@ -143,6 +153,8 @@ fMaxCentrality(90.0),
 fkPreselectDedx ( kTRUE ),
 fkPreselectDedxLambda ( kTRUE ),
 fkExtraCleanup    ( kTRUE ), //extra cleanup: eta, etc
+fkUsePairPrefilter( kTRUE ),
+fNThreads         ( 1 ),
 //________________________________________________
 //Flags for V0 vertexer
 fkRunV0Vertexer (kFALSE),
@@ -453,7 +465,6 @@ Long_t AliAnalysisTaskWeakDecayVertexer::Tracks2V0vertices(AliESDEvent *event) {
     
     Double_t xPrimaryVertex=vtxT3D->GetX();
     Double_t yPrimaryVertex=vtxT3D->GetY();
-    Double_t zPrimaryVertex=vtxT3D->GetZ();
     
     Long_t nentr=event->GetNumberOfTracks();
     Double_t b=event->GetMagneticField();
@@ -485,15 +496,85 @@ Long_t AliAnalysisTaskWeakDecayVertexer::Tracks2V0vertices(AliESDEvent *event) {
     }
     
     
-    for (i=0; i<nneg; i++) {
+    //Geometrical pre-selection of the pairs
+    AliV0PairingPrefilter prefilter;
+    if (fkUsePairPrefilter) {
+        prefilter.SetCuts(fV0VertexerSels[3],fV0VertexerSels[6]);
+        //the z range assumes the vertex stays within the fiducial volume
+        prefilter.SetUseZRange(!fkDoV0Refit);
+        prefilter.Fill(event,neg.GetArray(),nneg,pos.GetArray(),npos,b);
+    }
+    const AliV0PairingPrefilter *pprefilter=fkUsePairPrefilter ? &prefilter : 0x0;
+    
+    //Pairing, in ranges of negative tracks: the V0s of each range are
+    //buffered and added to the event in the order of the serial loop
+    Int_t nranges=1;
+    if (fNThreads > 1) nranges=TMath::Min(4*fNThreads, (Int_t)nneg);
+    std::vector< std::vector<AliESDv0> > v0s(TMath::Max(nranges,1));
+    if (nranges <= 1) {
+        FindV0sInRange(event,neg,0,nneg,pos,npos,pprefilter,v0s[0]);
+    } else {
+#if defined(R__USE_IMT) && ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0)
+        TDatabasePDG::Instance()->GetParticle(kK0Short); //PDG table loaded before the threads start
+        Int_t step=(nneg + nranges - 1)/nranges;
+        ROOT::TThreadExecutor pool(fNThreads);
+        pool.Foreach([&](Int_t irange) {
+            Int_t first=irange*step;
+            FindV0sInRange(event,neg,first,TMath::Min(first + step, (Int_t)nneg),pos,npos,pprefilter,v0s[irange]);
+        }, ROOT::TSeqI(nranges));
+#else
+        FindV0sInRange(event,neg,0,nneg,pos,npos,pprefilter,v0s[0]);
+#endif
+    }
+    
+    for (UInt_t irange=0; irange<v0s.size(); irange++) {
+        for (UInt_t iv0=0; iv0<v0s[irange].size(); iv0++) {
+            event->AddV0(&v0s[irange][iv0]);
+            nvtx++;
+        }
+    }
+    Info("Tracks2V0vertices","Number of reconstructed V0 vertices: %ld",nvtx);
+    return nvtx;
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskWeakDecayVertexer::FindV0sInRange(const AliESDEvent *event, const TArrayI &neg, Int_t first, Int_t last,
+                                                      const TArrayI &pos, Int_t npos, const AliV0PairingPrefilter *prefilter,
+                                                      std::vector<AliESDv0> &v0s) const {
+    //--------------------------------------------------------------------
+    //Pairs negative tracks first..last-1 with the positive tracks,
+    //the V0 candidates are stored in v0s
+    //--------------------------------------------------------------------
+    
+    const AliESDVertex *vtxT3D=event->GetPrimaryVertex();
+    
+    Double_t xPrimaryVertex=vtxT3D->GetX();
+    Double_t yPrimaryVertex=vtxT3D->GetY();
+    Double_t zPrimaryVertex=vtxT3D->GetZ();
+    
+    Double_t b=event->GetMagneticField();
+    
+    std::vector<Int_t> partners;
+    partners.reserve(npos);
+    
+    for (Int_t i=first; i<last; i++) {
         Long_t nidx=neg[i];
         AliESDtrack *ntrk=event->GetTrack(nidx);
         
-        for (Int_t k=0; k<npos; k++) {
-            Int_t pidx=pos[k];
+        if (prefilter) prefilter->GetCompatible(i,partners);
+        else {
+            partners.clear();
+            for (Int_t k=0; k<npos; k++) partners.push_back(k);
+        }
+        
+        for (UInt_t ik=0; ik<partners.size(); ik++) {
+            Int_t pidx=pos[partners[ik]];
             AliESDtrack *ptrk=event->GetTrack(pidx);
             
             //Pre-select dE/dx: only proceed if at least one of these tracks looks like a proton
+            //This runs in the pairing threads: AliPIDResponse is not thread-safe, so if this is
+            //enabled the proton n-sigmas have to be computed for all the selected tracks in the
+            //serial track loop of Tracks2V0vertices and passed here, as for the prefilter
             /*
             if(fkPreselectDedxLambda){
                 Double_t lNSigPproton = TMath::Abs(fPIDResponse->NumberOfSigmasTPC( ptrk, AliPID::kProton ));
@@ -558,13 +639,9 @@ Long_t AliAnalysisTaskWeakDecayVertexer::Tracks2V0vertices(AliESDEvent *event) {
             vertex.SetV0CosineOfPointingAngle(cpa);
             vertex.ChangeMassHypothesis(kK0Short);
             
-            event->AddV0(&vertex);
-            
-            nvtx++;
+            v0s.push_back(vertex);
         }
     }
-    Info("Tracks2V0vertices","Number of reconstructed V0 vertices: %ld",nvtx);
-    return nvtx;
 }
 
 //________________________________________________________________________
@@ -678,23 +755,97 @@ Long_t AliAnalysisTaskWeakDecayVertexer::V0sTracks2CascadeVertices(AliESDEvent *
         trk[ntr++]=i;
     }
     
-    Double_t massLambda=1.11568;
+    //splits the bachelors by charge, with their position and momentum
+    //for the straight-line pre-selection
+    std::vector<Int_t> bach[2];
+    std::vector<Double_t> bachRP[2];
+    for (i=0; i<ntr; i++) {
+        AliESDtrack *btrk=event->GetTrack(trk[i]);
+        Double_t rp[6]; btrk->GetXYZ(rp); btrk->GetPxPyPz(rp+3);
+        if (btrk->GetSign()<=0) { // bachelor's charge: cascades
+            bach[0].push_back(trk[i]);
+            bachRP[0].insert(bachRP[0].end(),rp,rp+6);
+        }
+        if (btrk->GetSign()>=0) { // bachelor's charge: anti-cascades
+            bach[1].push_back(trk[i]);
+            bachRP[1].insert(bachRP[1].end(),rp,rp+6);
+        }
+    }
+    
     Long_t ncasc=0;
     
-    // Looking for the cascades...
-    for (i=0; i<nV0; i++) { //loop on V0s
+    //Looking for the cascades, then for the anti-cascades: in ranges of V0s
+    //whose candidates are added to the event in the order of the serial loop
+    Int_t nranges=1;
+    if (fNThreads > 1) nranges=TMath::Min(4*fNThreads, nV0);
+    if (nranges > 1) TDatabasePDG::Instance()->GetParticle(3312); //PDG table loaded before the threads start
+    for (Int_t anti=0; anti<2; anti++) {
+        std::vector< std::vector<AliESDcascade> > cascades(TMath::Max(nranges,1));
+        if (nranges <= 1) {
+            FindCascadesInRange(event,vtcs,0,nV0,anti,bach[anti],bachRP[anti],cascades[0]);
+        } else {
+#if defined(R__USE_IMT) && ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0)
+            Int_t step=(nV0 + nranges - 1)/nranges;
+            ROOT::TThreadExecutor pool(fNThreads);
+            pool.Foreach([&](Int_t irange) {
+                Int_t first=irange*step;
+                FindCascadesInRange(event,vtcs,first,TMath::Min(first + step, nV0),anti,bach[anti],bachRP[anti],cascades[irange]);
+            }, ROOT::TSeqI(nranges));
+#else
+            FindCascadesInRange(event,vtcs,0,nV0,anti,bach[anti],bachRP[anti],cascades[0]);
+#endif
+        }
+        for (UInt_t irange=0; irange<cascades.size(); irange++) {
+            for (UInt_t icasc=0; icasc<cascades[irange].size(); icasc++) {
+                event->AddCascade(&cascades[irange][icasc]);
+                ncasc++;
+            }
+        }
+    }
+    
+    Info("V0sTracks2CascadeVertices","Number of reconstructed cascades: %ld",ncasc);
+    
+    return ncasc;
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskWeakDecayVertexer::FindCascadesInRange(const AliESDEvent *event, const TObjArray &vtcs, Int_t first, Int_t last,
+                                                           Bool_t anti, const std::vector<Int_t> &bach, const std::vector<Double_t> &bachRP,
+                                                           std::vector<AliESDcascade> &cascades) {
+    //--------------------------------------------------------------------
+    // Combines V0s first..last-1 with the bachelors of the right charge
+    // into cascades (anti=kFALSE) or anti-cascades (anti=kTRUE)
+    //--------------------------------------------------------------------
+    const AliESDVertex *vtxT3D=event->GetPrimaryVertex();
+    
+    Double_t xPrimaryVertex=vtxT3D->GetX();
+    Double_t yPrimaryVertex=vtxT3D->GetY();
+    Double_t zPrimaryVertex=vtxT3D->GetZ();
+    
+    Double_t b=event->GetMagneticField();
+    Double_t massLambda=1.11568;
+    Int_t ntr=bach.size();
+    Int_t lSign=anti ? -1 : 1;
+    
+    for (Int_t i=first; i<last; i++) { //loop on V0s
         AliESDv0 *v=(AliESDv0*)vtcs.UncheckedAt(i);
         AliESDv0 v0(*v);
-        v0.ChangeMassHypothesis(kLambda0); // the v0 must be Lambda
+        v0.ChangeMassHypothesis(anti ? kLambda0Bar : kLambda0); // the v0 must be (anti-)Lambda
         if (TMath::Abs(v0.GetEffMass()-massLambda)>fCascadeVertexerSels[2]) continue;
+        
+        //bachelor and v0's negative (positive) tracks must be different
+        Int_t lSameChargeDaughter=v0.GetIndex(anti ? 1 : 0); //Bo:  consistency 0 for neg, 1 for pos
+        Double_t rpV0[6]; v0.GetXYZ(rpV0[0],rpV0[1],rpV0[2]); v0.GetPxPyPz(rpV0[3],rpV0[4],rpV0[5]);
+        
         for (Int_t j=0; j<ntr; j++) {//loop on tracks
-            Int_t bidx=trk[j];
-            //Bo:   if (bidx==v->GetNindex()) continue; //bachelor and v0's negative tracks must be different
-            if (bidx==v0.GetIndex(0)) continue; //Bo:  consistency 0 for neg
+            Int_t bidx=bach[j];
+            if (bidx==lSameChargeDaughter) continue;
             
-            AliESDtrack *btrk=event->GetTrack(bidx);
+            //straight-line DCA, as in PropagateToDCA, before copying and propagating the track
+            const Double_t *rpB=&bachRP[6*j];
+            if (GetDCALines(rpB,rpB+3,rpV0,rpV0+3) > fCascadeVertexerSels[4]) continue;
             
-            if (btrk->GetSign()>0) continue;  // bachelor's charge
+            AliESDtrack *btrk=event->GetTrack(bidx);
             
             AliESDv0 *pv0=&v0;
             AliExternalTrackParam bt(*btrk), *pbt=&bt;
@@ -722,77 +873,21 @@ Long_t AliAnalysisTaskWeakDecayVertexer::V0sTracks2CascadeVertices(AliESDEvent *
             
             if (cascade.GetCascadeCosineOfPointingAngle(xPrimaryVertex,yPrimaryVertex,zPrimaryVertex) <fCascadeVertexerSels[5]) continue; //condition on the cascade pointing angle
             
-            //Filter masses: anti-cascade hypotheses
-            Double_t lV0quality = 0.;
-            cascade.ChangeMassHypothesis(lV0quality , 3312); // pdg code -3312 = Xi+
-            Double_t lInvMassXi = cascade.GetEffMassXi();
-            cascade.ChangeMassHypothesis(lV0quality , 3334); // pdg code -3312 = Xi+
-            Double_t lInvMassOmega = cascade.GetEffMassXi();
-            
-            //Remove if outside window of interest
-            if(TMath::Abs(lInvMassXi   -1.322)>fMassWindowAroundCascade &&
-               TMath::Abs(lInvMassOmega-1.672)>fMassWindowAroundCascade ) continue;
-            
-            cascade.SetDcaXiDaughters(dca);
-            event->AddCascade(&cascade);
-            ncasc++;
-        } // end loop tracks
-    } // end loop V0s
-    
-    // Looking for the anti-cascades...
-    for (i=0; i<nV0; i++) { //loop on V0s
-        AliESDv0 *v=(AliESDv0*)vtcs.UncheckedAt(i);
-        AliESDv0 v0(*v);
-        v0.ChangeMassHypothesis(kLambda0Bar); //the v0 must be anti-Lambda
-        if (TMath::Abs(v0.GetEffMass()-massLambda)>fCascadeVertexerSels[2]) continue;
-        
-        for (Int_t j=0; j<ntr; j++) {//loop on tracks
-            Int_t bidx=trk[j];
-            if (bidx==v0.GetIndex(1)) continue; //Bo:  consistency 1 for pos
-            
-            AliESDtrack *btrk=event->GetTrack(bidx);
-            
-            if (btrk->GetSign()<0) continue;  // bachelor's charge
-            
-            AliESDv0 *pv0=&v0;
-            AliExternalTrackParam bt(*btrk), *pbt=&bt;
-            
-            Double_t dca=PropagateToDCA(pv0,pbt,b);
-            if (dca > fCascadeVertexerSels[4]) continue;
-            
-            //eta cut - test
-            if (TMath::Abs(pbt->Eta())>0.8) continue;
-            
-            AliESDcascade cascade(*pv0,*pbt,bidx); //constucts a cascade candidate
-            //PH         if (cascade.GetChi2Xi() > fChi2max) continue;
-            
-            Double_t x,y,z; cascade.GetXYZcascade(x,y,z); // Bo: bug correction
-            Double_t r2=x*x + y*y;
-            if (r2 > fCascadeVertexerSels[7]*fCascadeVertexerSels[7]) continue;   // condition on fiducial zone
-            if (r2 < fCascadeVertexerSels[6]*fCascadeVertexerSels[6]) continue;
-            
-            Double_t pxV0,pyV0,pzV0;
-            pv0->GetPxPyPz(pxV0,pyV0,pzV0);
-            if (x*pxV0+y*pyV0+z*pzV0 < 0) continue; //causality
-            
-            Double_t x1,y1,z1; pv0->GetXYZ(x1,y1,z1);
-            if (r2 > (x1*x1+y1*y1)) continue;
-            
-            if (cascade.GetCascadeCosineOfPointingAngle(xPrimaryVertex,yPrimaryVertex,zPrimaryVertex) < fCascadeVertexerSels[5]) continue; //condition on the cascade pointing angle
-            
-            //pre-select on pT
-            Double_t lXiMomX       = 0. , lXiMomY = 0., lXiMomZ = 0.;
-            Double_t lXiTransvMom  = 0. ;
-            cascade.GetPxPyPz( lXiMomX, lXiMomY, lXiMomZ );
-            lXiTransvMom  	= TMath::Sqrt( lXiMomX*lXiMomX   + lXiMomY*lXiMomY );
-            if(lXiTransvMom<fMinPtCascade) continue;
-            if(lXiTransvMom>fMaxPtCascade) continue;
+            //pre-select on pT (anti-cascades only, as in the original vertexer)
+            if (anti) {
+                Double_t lXiMomX       = 0. , lXiMomY = 0., lXiMomZ = 0.;
+                Double_t lXiTransvMom  = 0. ;
+                cascade.GetPxPyPz( lXiMomX, lXiMomY, lXiMomZ );
+                lXiTransvMom  	= TMath::Sqrt( lXiMomX*lXiMomX   + lXiMomY*lXiMomY );
+                if(lXiTransvMom<fMinPtCascade) continue;
+                if(lXiTransvMom>fMaxPtCascade) continue;
+            }
             
-            //Filter masses: anti-cascade hypotheses
+            //Filter masses: (anti-)cascade hypotheses
             Double_t lV0quality = 0.;
-            cascade.ChangeMassHypothesis(lV0quality , -3312); // pdg code -3312 = Xi+
+            cascade.ChangeMassHypothesis(lV0quality , lSign*3312); // pdg code 3312 = Xi-, -3312 = Xi+
             Double_t lInvMassXi = cascade.GetEffMassXi();
-            cascade.ChangeMassHypothesis(lV0quality , -3334); // pdg code -3312 = Xi+
+            cascade.ChangeMassHypothesis(lV0quality , lSign*3334); // pdg code 3334 = Omega-, -3334 = Omega+
             Double_t lInvMassOmega = cascade.GetEffMassXi();
             
             //Remove if outside window of interest
@@ -800,15 +895,9 @@ Long_t AliAnalysisTaskWeakDecayVertexer::V0sTracks2CascadeVertices(AliESDEvent *
                TMath::Abs(lInvMassOmega-1.672)>fMassWindowAroundCascade ) continue;
             
             cascade.SetDcaXiDaughters(dca);
-            event->AddCascade(&cascade);
-            ncasc++;
-            
+            cascades.push_back(cascade);
         } // end loop tracks
     } // end loop V0s
-    
-    Info("V0sTracks2CascadeVertices","Number of reconstructed cascades: %ld",ncasc);
-    
-    return ncasc;
 }
 
 //________________________________________________________________________
@@ -829,6 +918,21 @@ Double_t AliAnalysisTaskWeakDecayVertexer::Det(Double_t a00,Double_t a01,Double_
     return  a00*Det(a11,a12,a21,a22)-a01*Det(a10,a12,a20,a22)+a02*Det(a10,a11,a20,a21);
 }
 
+//________________________________________________________________________
+Double_t AliAnalysisTaskWeakDecayVertexer::GetDCALines(const Double_t *r1, const Double_t *p1,
+                                                       const Double_t *r2, const Double_t *p2) const {
+    //--------------------------------------------------------------------
+    // This function returns the DCA between two straight lines, given
+    // by a point and a direction
+    //--------------------------------------------------------------------
+    Double_t dd= Det(r2[0]-r1[0],r2[1]-r1[1],r2[2]-r1[2],p1[0],p1[1],p1[2],p2[0],p2[1],p2[2]);
+    Double_t ax= Det(p1[1],p1[2],p2[1],p2[2]);
+    Double_t ay=-Det(p1[0],p1[2],p2[0],p2[2]);
+    Double_t az= Det(p1[0],p1[1],p2[0],p2[1]);
+    
+    return TMath::Abs(dd)/TMath::Sqrt(ax*ax + ay*ay + az*az);
+}
+
 //________________________________________________________________________
 Double_t AliAnalysisTaskWeakDecayVertexer::PropagateToDCA(AliESDv0 *v, AliExternalTrackParam *t, Double_t b) {
     //--------------------------------------------------------------------
@@ -848,13 +952,12 @@ Double_t AliAnalysisTaskWeakDecayVertexer::PropagateToDCA(AliESDv0 *v, AliExtern
     
     // calculation dca
     
-    Double_t dd= Det(x2-x1,y2-y1,z2-z1,px1,py1,pz1,px2,py2,pz2);
+    Double_t r2[3]={x2,y2,z2}, p2[3]={px2,py2,pz2};
+    Double_t dca=GetDCALines(r,p,r2,p2);
     Double_t ax= Det(py1,pz1,py2,pz2);
     Double_t ay=-Det(px1,pz1,px2,pz2);
     Double_t az= Det(px1,py1,px2,py2);
     
-    Double_t dca=TMath::Abs(dd)/TMath::Sqrt(ax*ax + ay*ay + az*az);
-    
     //points of the DCA
     Double_t t1 = Det(x2-x1,y2-y1,z2-z1,px2,py2,pz2,ax,ay,az)/
     Det(px1,py1,pz1,px2,py2,pz2,ax,ay,az);
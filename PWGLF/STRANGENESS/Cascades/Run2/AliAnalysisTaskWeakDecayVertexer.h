@@ -28,10 +28,16 @@
 class TList;
 class TH1F;
 
+class TArrayI;
+class TObjArray;
 class AliESDpid;
 class AliESDEvent;
+class AliESDv0;
+class AliESDcascade;
 class AliPhysicsSelection;
+class AliV0PairingPrefilter;
 
+#include <vector>
 #include "AliEventCuts.h"
 
 class AliAnalysisTaskWeakDecayVertexer : public AliAnalysisTaskSE {
@@ -72,6 +78,14 @@ public:
     void SetExtraCleanup ( Bool_t lExtraCleanup = kTRUE) {
         fkExtraCleanup = lExtraCleanup;
     }
+    //Geometrical pre-selection of the V0 daughter pairs
+    void SetUsePairPrefilter ( Bool_t lUsePairPrefilter = kTRUE) {
+        fkUsePairPrefilter = lUsePairPrefilter;
+    }
+    //Threads for the pairing loops (1: serial)
+    void SetNumberOfThreads ( Int_t lNThreads ) {
+        fNThreads = lNThreads;
+    }
 //---------------------------------------------------------------------------------------
     void SetUseExtraEvSels ( Bool_t lUseExtraEvSels = kTRUE) {
         fkDoExtraEvSels = lUseExtraEvSels;
@@ -154,11 +168,20 @@ public:
     Double_t Det(Double_t a00,Double_t a01,Double_t a02,
                  Double_t a10,Double_t a11,Double_t a12,
                  Double_t a20,Double_t a21,Double_t a22) const;
+    Double_t GetDCALines(const Double_t *r1, const Double_t *p1, const Double_t *r2, const Double_t *p2) const;
     Double_t PropagateToDCA(AliESDv0 *vtx,AliExternalTrackParam *trk,Double_t b);
     void CheckChargeV0(AliESDv0 *v0);
 //---------------------------------------------------------------------------------------
 
 private:
+    //Pairing loops over a range of negative tracks / V0s
+    void FindV0sInRange(const AliESDEvent *event, const TArrayI &neg, Int_t first, Int_t last,
+                        const TArrayI &pos, Int_t npos, const AliV0PairingPrefilter *prefilter,
+                        std::vector<AliESDv0> &v0s) const;
+    void FindCascadesInRange(const AliESDEvent *event, const TObjArray &vtcs, Int_t first, Int_t last,
+                             Bool_t anti, const std::vector<Int_t> &bach, const std::vector<Double_t> &bachRP,
+                             std::vector<AliESDcascade> &cascades);
+
     // Note : In ROOT, "//!" means "do not stream the data from Master node to Worker node" ...
     // your data member object is created on the worker nodes and streaming is not needed.
     // http://root.cern.ch/download/doc/11InputOutput.pdf, page 14
@@ -180,6 +203,8 @@ private:
     Bool_t    fkRunCascadeVertexer;      // if true, re-run cascade vertexer
     Bool_t    fkDoV0Refit;              // if true, will invoke AliESDv0::Refit in the vertexing procedure
     Bool_t    fkExtraCleanup;           //if true, perform pre-rejection of useless candidates before going through configs
+    Bool_t    fkUsePairPrefilter;       //if true, skip V0 daughter pairs incompatible with the DCA cut by helix geometry
+    Int_t     fNThreads;                //number of threads for the pairing loops (1: serial)
 
     AliVEvent::EOfflineTriggerTypes fTrigType; // trigger type
 
@@ -208,8 +233,9 @@ private:
     AliAnalysisTaskWeakDecayVertexer(const AliAnalysisTaskWeakDecayVertexer&);            // not implemented
     AliAnalysisTaskWeakDecayVertexer& operator=(const AliAnalysisTaskWeakDecayVertexer&); // not implemented
 
-    ClassDef(AliAnalysisTaskWeakDecayVertexer, 1);
+    ClassDef(AliAnalysisTaskWeakDecayVertexer, 2);
     //1: first implementation
+    //2: pair pre-selection and threads for the pairing loops
 };
 
 #endif
@@ -24,6 +24,17 @@
 //modified by R. Vernet  3/7/2006 : causality
 //modified by I. Belikov 24/11/2006 : static setter for the default cuts
 
+#include <RConfigure.h>
+#include <RVersion.h>
+#include "TArrayI.h"
+#include "TDatabasePDG.h"
+#include "TMath.h"
+#include "TObjArray.h"
+#if defined(R__USE_IMT) && ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0)
+#include <ROOT/TSeq.hxx>
+#include <ROOT/TThreadExecutor.hxx>
+#endif
+
 #include "AliESDEvent.h"
 #include "AliESDcascade.h"
 #include "AliLightCascadeVertexer.h"
@@ -155,29 +166,97 @@ Int_t AliLightCascadeVertexer::V0sTracks2CascadeVertices(AliESDEvent *event) {
        trk[ntr++]=i;
    }   
 
-   Double_t massLambda=1.11568;
+   // splits the bachelors by charge, with their position and momentum
+   // for the straight-line pre-selection
+   std::vector<Int_t> bach[2];
+   std::vector<Double_t> bachRP[2];
+   for (i=0; i<ntr; i++) {
+       AliESDtrack *btrk=event->GetTrack(trk[i]);
+       Double_t rp[6]; btrk->GetXYZ(rp); btrk->GetPxPyPz(rp+3);
+       for (Int_t anti=0; anti<2; anti++) {
+           Bool_t lNegBach=(anti==0)!=fSwitchCharges;
+           if ( lNegBach && btrk->GetSign()>0) continue;  // bachelor's charge
+           if (!lNegBach && btrk->GetSign()<0) continue;  // bachelor's charge
+           bach[anti].push_back(trk[i]);
+           bachRP[anti].insert(bachRP[anti].end(),rp,rp+6);
+       }
+   }
+
    Int_t ncasc=0;
 
-   // Looking for the cascades...
+   // Looking for the cascades, then for the anti-cascades: in ranges of V0s
+   // whose candidates are added to the event in the order of the serial loop
+   Int_t nranges=1;
+   if (fNThreads > 1) nranges=TMath::Min(4*fNThreads, nV0);
+   if (nranges > 1) TDatabasePDG::Instance()->GetParticle(kLambda0); //PDG table loaded before the threads start
+   for (Int_t anti=0; anti<2; anti++) {
+      std::vector< std::vector<AliESDcascade> > cascades(TMath::Max(nranges,1));
+      if (nranges <= 1) {
+         FindCascadesInRange(event,vtcs,0,nV0,anti,bach[anti],bachRP[anti],cascades[0]);
+      } else {
+#if defined(R__USE_IMT) && ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0)
+         Int_t step=(nV0 + nranges - 1)/nranges;
+         ROOT::TThreadExecutor pool(fNThreads);
+         pool.Foreach([&](Int_t irange) {
+            Int_t first=irange*step;
+            FindCascadesInRange(event,vtcs,first,TMath::Min(first + step, nV0),anti,bach[anti],bachRP[anti],cascades[irange]);
+         }, ROOT::TSeqI(nranges));
+#else
+         FindCascadesInRange(event,vtcs,0,nV0,anti,bach[anti],bachRP[anti],cascades[0]);
+#endif
+      }
+      for (UInt_t irange=0; irange<cascades.size(); irange++) {
+         for (UInt_t icasc=0; icasc<cascades[irange].size(); icasc++) {
+            event->AddCascade(&cascades[irange][icasc]);
+            ncasc++;
+         }
+      }
+   }
+
+Info("V0sTracks2CascadeVertices","Number of reconstructed cascades: %d",ncasc);
+
+   return 0;
+}
+
+
+void AliLightCascadeVertexer::FindCascadesInRange(const AliESDEvent *event, const TObjArray &vtcs, Int_t first, Int_t last,
+                                                  Bool_t anti, const std::vector<Int_t> &bach, const std::vector<Double_t> &bachRP,
+                                                  std::vector<AliESDcascade> &cascades) {
+  //--------------------------------------------------------------------
+  // Combines V0s first..last-1 with the bachelors of the right charge
+  // into cascades (anti=kFALSE) or anti-cascades (anti=kTRUE)
+  //--------------------------------------------------------------------
+   const AliESDVertex *vtxT3D=event->GetPrimaryVertex();
+
+   Double_t xPrimaryVertex=vtxT3D->GetX();
+   Double_t yPrimaryVertex=vtxT3D->GetY();
+   Double_t zPrimaryVertex=vtxT3D->GetZ();
+
+   Double_t b=event->GetMagneticField();
+   Double_t massLambda=1.11568;
+   Int_t ntr=bach.size();
 
-   for (i=0; i<nV0; i++) { //loop on V0s
+   for (Int_t i=first; i<last; i++) { //loop on V0s
 
       AliESDv0 *v=(AliESDv0*)vtcs.UncheckedAt(i);
       AliESDv0 v0(*v);
-      v0.ChangeMassHypothesis(kLambda0); // the v0 must be Lambda 
+      v0.ChangeMassHypothesis(anti ? kLambda0Bar : kLambda0); // the v0 must be (anti-)Lambda
       if (TMath::Abs(v0.GetEffMass()-massLambda)>fMassWin) continue; 
 
+      //bachelor and v0's negative (positive) tracks must be different
+      Int_t lSameChargeDaughter=v0.GetIndex(((anti!=0)!=fSwitchCharges) ? 1 : 0); //Bo:  consistency 0 for neg, 1 for pos
+      Double_t rpV0[6]; v0.GetXYZ(rpV0[0],rpV0[1],rpV0[2]); v0.GetPxPyPz(rpV0[3],rpV0[4],rpV0[5]);
+
       for (Int_t j=0; j<ntr; j++) {//loop on tracks
-	 Int_t bidx=trk[j];
- 	 //Bo:   if (bidx==v->GetNindex()) continue; //bachelor and v0's negative tracks must be different
-          if (!fSwitchCharges && bidx==v0.GetIndex(0)) continue; //Bo:  consistency 0 for neg
-          if ( fSwitchCharges && bidx==v0.GetIndex(1)) continue; //Bo:  consistency 0 for neg
+	 Int_t bidx=bach[j];
+          if (bidx==lSameChargeDaughter) continue;
+
+         //straight-line DCA, as in PropagateToDCA, before copying and propagating the track
+         const Double_t *rpB=&bachRP[6*j];
+         if (GetDCALines(rpB,rpB+3,rpV0,rpV0+3) > fDCAmax) continue;
           
           AliESDtrack *btrk=event->GetTrack(bidx);
           
-         if (!fSwitchCharges && btrk->GetSign()>0) continue;  // bachelor's charge
-         if ( fSwitchCharges && btrk->GetSign()<0) continue;  // bachelor's charge
-          
     	 AliESDv0 *pv0=&v0;
          AliExternalTrackParam bt(*btrk), *pbt=&bt;
 
@@ -205,66 +284,9 @@ Int_t AliLightCascadeVertexer::V0sTracks2CascadeVertices(AliESDEvent *event) {
   	 if (cascade.GetCascadeCosineOfPointingAngle(xPrimaryVertex,yPrimaryVertex,zPrimaryVertex) <fCPAmin) continue; //condition on the cascade pointing angle 
 	 
          cascade.SetDcaXiDaughters(dca);
-	 event->AddCascade(&cascade);
-         ncasc++;
-      } // end loop tracks
-   } // end loop V0s
-
-   // Looking for the anti-cascades...
-
-   for (i=0; i<nV0; i++) { //loop on V0s
-      AliESDv0 *v=(AliESDv0*)vtcs.UncheckedAt(i);
-      AliESDv0 v0(*v);
-      v0.ChangeMassHypothesis(kLambda0Bar); //the v0 must be anti-Lambda 
-      if (TMath::Abs(v0.GetEffMass()-massLambda)>fMassWin) continue; 
-
-      for (Int_t j=0; j<ntr; j++) {//loop on tracks
-	 Int_t bidx=trk[j];
- 	 //Bo:   if (bidx==v->GetPindex()) continue; //bachelor and v0's positive tracks must be different
-         if (!fSwitchCharges && bidx==v0.GetIndex(1)) continue; //Bo:  consistency 1 for pos
-         if ( fSwitchCharges && bidx==v0.GetIndex(0)) continue; //Bo:  consistency 1 for pos
-          
-          AliESDtrack *btrk=event->GetTrack(bidx);
-          
-         if (!fSwitchCharges && btrk->GetSign()<0) continue;  // bachelor's charge
-         if ( fSwitchCharges && btrk->GetSign()>0) continue;  // bachelor's charge
-          
-	 AliESDv0 *pv0=&v0;
-         AliExternalTrackParam bt(*btrk), *pbt=&bt;
-
-         Double_t dca=PropagateToDCA(pv0,pbt,b);
-         if (dca > fDCAmax) continue;
-
-          //eta cut - test
-          if (TMath::Abs(pbt->Eta())>fMaxEta) continue;
-          
-         AliESDcascade cascade(*pv0,*pbt,bidx); //constucts a cascade candidate
-	 //PH         if (cascade.GetChi2Xi() > fChi2max) continue;
-
-	 Double_t x,y,z; cascade.GetXYZcascade(x,y,z); // Bo: bug correction
-         Double_t r2=x*x + y*y; 
-         if (r2 > fRmax*fRmax) continue;   // condition on fiducial zone
-         if (r2 < fRmin*fRmin) continue;
-
-	 Double_t pxV0,pyV0,pzV0;
-	 pv0->GetPxPyPz(pxV0,pyV0,pzV0);
-	 if (x*pxV0+y*pyV0+z*pzV0 < 0) continue; //causality
-
-         Double_t x1,y1,z1; pv0->GetXYZ(x1,y1,z1);
-         if (r2 > (x1*x1+y1*y1)) continue;
-
-	 if (cascade.GetCascadeCosineOfPointingAngle(xPrimaryVertex,yPrimaryVertex,zPrimaryVertex) < fCPAmin) continue; //condition on the cascade pointing angle 
-
-         cascade.SetDcaXiDaughters(dca);
-	 event->AddCascade(&cascade);
-         ncasc++;
-
+         cascades.push_back(cascade);
       } // end loop tracks
    } // end loop V0s
-
-Info("V0sTracks2CascadeVertices","Number of reconstructed cascades: %d",ncasc);
-
-   return 0;
 }
 
 
@@ -284,6 +306,20 @@ Double_t AliLightCascadeVertexer::Det(Double_t a00,Double_t a01,Double_t a02,
   return  a00*Det(a11,a12,a21,a22)-a01*Det(a10,a12,a20,a22)+a02*Det(a10,a11,a20,a21);
 }
 
+Double_t AliLightCascadeVertexer::GetDCALines(const Double_t *r1, const Double_t *p1,
+                                              const Double_t *r2, const Double_t *p2) const {
+  //--------------------------------------------------------------------
+  // This function returns the DCA between two straight lines, given
+  // by a point and a direction
+  //--------------------------------------------------------------------
+  Double_t dd= Det(r2[0]-r1[0],r2[1]-r1[1],r2[2]-r1[2],p1[0],p1[1],p1[2],p2[0],p2[1],p2[2]);
+  Double_t ax= Det(p1[1],p1[2],p2[1],p2[2]);
+  Double_t ay=-Det(p1[0],p1[2],p2[0],p2[2]);
+  Double_t az= Det(p1[0],p1[1],p2[0],p2[1]);
+
+  return TMath::Abs(dd)/TMath::Sqrt(ax*ax + ay*ay + az*az);
+}
+
 Double_t AliLightCascadeVertexer::PropagateToDCA(AliESDv0 *v, AliExternalTrackParam *t, Double_t b) {
   //--------------------------------------------------------------------
   // This function returns the DCA between the V0 and the track
@@ -302,13 +338,12 @@ Double_t AliLightCascadeVertexer::PropagateToDCA(AliESDv0 *v, AliExternalTrackPa
  
 // calculation dca
    
-  Double_t dd= Det(x2-x1,y2-y1,z2-z1,px1,py1,pz1,px2,py2,pz2);
+  Double_t r2[3]={x2,y2,z2}, p2[3]={px2,py2,pz2};
+  Double_t dca=GetDCALines(r,p,r2,p2);
   Double_t ax= Det(py1,pz1,py2,pz2);
   Double_t ay=-Det(px1,pz1,px2,pz2);
   Double_t az= Det(px1,py1,px2,py2);
 
-  Double_t dca=TMath::Abs(dd)/TMath::Sqrt(ax*ax + ay*ay + az*az);
-
 //points of the DCA
   Double_t t1 = Det(x2-x1,y2-y1,z2-z1,px2,py2,pz2,ax,ay,az)/
                 Det(px1,py1,pz1,px2,py2,pz2,ax,ay,az);
@@ -9,10 +9,13 @@
 //    Origin: Christian Kuhn, IReS, Strasbourg, christian.kuhn@ires.in2p3.fr
 //------------------------------------------------------------------
 
+#include <vector>
 #include "TObject.h"
 
+class TObjArray;
 class AliESDEvent;
 class AliESDv0;
+class AliESDcascade;
 class AliExternalTrackParam;
 
 //_____________________________________________________________________________
@@ -28,6 +31,7 @@ public:
 	       Double_t a10,Double_t a11,Double_t a12,
 	       Double_t a20,Double_t a21,Double_t a22) const;
 
+  Double_t GetDCALines(const Double_t *r1, const Double_t *p1, const Double_t *r2, const Double_t *p2) const;
   Double_t PropagateToDCA(AliESDv0 *vtx,AliExternalTrackParam *trk,Double_t b);
     void CheckChargeV0(AliESDv0 *v0);
 
@@ -40,7 +44,12 @@ public:
     void SetMinClusters(Int_t lMinClusters);
     void SetSwitchCharges(Bool_t lOption);
     void SetUseOnTheFlyV0 (Bool_t lOption);
+    void SetNumberOfThreads(Int_t lNThreads) { fNThreads = lNThreads; }
 private:
+  void FindCascadesInRange(const AliESDEvent *event, const TObjArray &vtcs, Int_t first, Int_t last,
+                           Bool_t anti, const std::vector<Int_t> &bach, const std::vector<Double_t> &bachRP,
+                           std::vector<AliESDcascade> &cascades);
+
   static
   Double_t fgChi2max;   // maximal allowed chi2 
   static
@@ -71,8 +80,9 @@ private:
     Int_t fMinClusters;  // minimum single-track clusters value (>=)
     Bool_t fSwitchCharges; //switch to change bachelor charge
     Bool_t fUseOnTheFlyV0; //switch to use on-the-fly V0s (HIGHLY EXPERIMENTAL)
+    Int_t fNThreads; //number of threads for the V0-bachelor loop (1: serial)
   
-  ClassDef(AliLightCascadeVertexer,3)  // cascade verterxer 
+  ClassDef(AliLightCascadeVertexer,4)  // cascade verterxer 
 };
 
 inline AliLightCascadeVertexer::AliLightCascadeVertexer() :
@@ -88,7 +98,8 @@ fRmax(fgRmax),
 fMaxEta(fgMaxEta),
 fMinClusters(fgMinClusters),
 fSwitchCharges(fgSwitchCharges),
-fUseOnTheFlyV0(fgUseOnTheFlyV0)
+fUseOnTheFlyV0(fgUseOnTheFlyV0),
+fNThreads(1)
 {
 }
 
@@ -25,9 +25,20 @@
 //          This is still being tested! Use at your own risk!
 //-------------------------------------------------------------------------
 
+#include <RConfigure.h>
+#include <RVersion.h>
+#include "TArrayI.h"
+#include "TDatabasePDG.h"
+#include "TMath.h"
+#if defined(R__USE_IMT) && ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0)
+#include <ROOT/TSeq.hxx>
+#include <ROOT/TThreadExecutor.hxx>
+#endif
+
 #include "AliESDEvent.h"
 #include "AliESDv0.h"
 #include "AliLightV0vertexer.h"
+#include "AliV0PairingPrefilter.h"
 
 ClassImp(AliLightV0vertexer)
 
@@ -53,7 +64,6 @@ Int_t AliLightV0vertexer::Tracks2V0vertices(AliESDEvent *event) {
     
     Double_t xPrimaryVertex=vtxT3D->GetX();
     Double_t yPrimaryVertex=vtxT3D->GetY();
-    Double_t zPrimaryVertex=vtxT3D->GetZ();
     
     Int_t nentr=event->GetNumberOfTracks();
     Double_t b=event->GetMagneticField();
@@ -85,12 +95,81 @@ Int_t AliLightV0vertexer::Tracks2V0vertices(AliESDEvent *event) {
     }
     
     
-    for (i=0; i<nneg; i++) {
+    //Geometrical pre-selection of the pairs
+    AliV0PairingPrefilter prefilter;
+    if (fkUsePairPrefilter) {
+        prefilter.SetCuts(fDCAmax,fRmax);
+        //the z range assumes the vertex stays within the fiducial volume
+        prefilter.SetUseZRange(!fkDoRefit);
+        prefilter.Fill(event,neg.GetArray(),nneg,pos.GetArray(),npos,b);
+    }
+    const AliV0PairingPrefilter *pprefilter=fkUsePairPrefilter ? &prefilter : 0x0;
+    
+    //Pairing, in ranges of negative tracks: the V0s of each range are
+    //buffered and added to the event in the order of the serial loop
+    Int_t nranges=1;
+    if (fNThreads > 1) nranges=TMath::Min(4*fNThreads, nneg);
+    std::vector< std::vector<AliESDv0> > v0s(TMath::Max(nranges,1));
+    if (nranges <= 1) {
+        FindV0sInRange(event,neg,0,nneg,pos,npos,pprefilter,v0s[0]);
+    } else {
+#if defined(R__USE_IMT) && ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0)
+        TDatabasePDG::Instance()->GetParticle(kK0Short); //PDG table loaded before the threads start
+        Int_t step=(nneg + nranges - 1)/nranges;
+        ROOT::TThreadExecutor pool(fNThreads);
+        pool.Foreach([&](Int_t irange) {
+            Int_t first=irange*step;
+            FindV0sInRange(event,neg,first,TMath::Min(first + step, nneg),pos,npos,pprefilter,v0s[irange]);
+        }, ROOT::TSeqI(nranges));
+#else
+        FindV0sInRange(event,neg,0,nneg,pos,npos,pprefilter,v0s[0]);
+#endif
+    }
+    
+    for (UInt_t irange=0; irange<v0s.size(); irange++) {
+        for (UInt_t iv0=0; iv0<v0s[irange].size(); iv0++) {
+            event->AddV0(&v0s[irange][iv0]);
+            nvtx++;
+        }
+    }
+    
+    Info("Tracks2V0vertices","Number of reconstructed V0 vertices: %d",nvtx);
+    
+    return nvtx;
+}
+
+
+void AliLightV0vertexer::FindV0sInRange(const AliESDEvent *event, const TArrayI &neg, Int_t first, Int_t last,
+                                        const TArrayI &pos, Int_t npos, const AliV0PairingPrefilter *prefilter,
+                                        std::vector<AliESDv0> &v0s) const {
+    //--------------------------------------------------------------------
+    //Pairs negative tracks first..last-1 with the positive tracks,
+    //the V0 candidates are stored in v0s
+    //--------------------------------------------------------------------
+    
+    const AliESDVertex *vtxT3D=event->GetPrimaryVertex();
+    
+    Double_t xPrimaryVertex=vtxT3D->GetX();
+    Double_t yPrimaryVertex=vtxT3D->GetY();
+    Double_t zPrimaryVertex=vtxT3D->GetZ();
+    
+    Double_t b=event->GetMagneticField();
+    
+    std::vector<Int_t> partners;
+    partners.reserve(npos);
+    
+    for (Int_t i=first; i<last; i++) {
         Int_t nidx=neg[i];
         AliESDtrack *ntrk=event->GetTrack(nidx);
         
-        for (Int_t k=0; k<npos; k++) {
-            Int_t pidx=pos[k];
+        if (prefilter) prefilter->GetCompatible(i,partners);
+        else {
+            partners.clear();
+            for (Int_t k=0; k<npos; k++) partners.push_back(k);
+        }
+        
+        for (UInt_t ik=0; ik<partners.size(); ik++) {
+            Int_t pidx=pos[partners[ik]];
             AliESDtrack *ptrk=event->GetTrack(pidx);
             
             //Track pre-selection: clusters
@@ -149,27 +228,7 @@ Int_t AliLightV0vertexer::Tracks2V0vertices(AliESDEvent *event) {
             vertex.SetV0CosineOfPointingAngle(cpa);
             vertex.ChangeMassHypothesis(kK0Short);
             
-            event->AddV0(&vertex);
-            
-            nvtx++;
+            v0s.push_back(vertex);
         }
     }
-    
-    Info("Tracks2V0vertices","Number of reconstructed V0 vertices: %d",nvtx);
-    
-    return nvtx;
 }
-
-
-
-
-
-
-
-
-
-
-
-
-
-
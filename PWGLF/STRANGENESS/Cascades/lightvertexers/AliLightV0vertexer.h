@@ -9,10 +9,14 @@
 //   Origin: Iouri Belikov, IReS, Strasbourg, Jouri.Belikov@cern.ch
 //------------------------------------------------------------------
 
+#include <vector>
 #include "TObject.h"
 
 class TTree;
+class TArrayI;
 class AliESDEvent;
+class AliESDv0;
+class AliV0PairingPrefilter;
 
 //_____________________________________________________________________________
 class AliLightV0vertexer : public TObject {
@@ -34,7 +38,16 @@ public:
     //Experimental implementation of V0 refit functionality 
     void SetDoRefit( Bool_t lDoRefit ) { fkDoRefit = lDoRefit; }
     
+    //Geometrical pre-selection of the daughter pairs and threads for the pairing
+    void SetUsePairPrefilter( Bool_t lOption ) { fkUsePairPrefilter = lOption; }
+    void SetNumberOfThreads( Int_t lNThreads ) { fNThreads = lNThreads; }
+    
 private:
+    void FindV0sInRange(const AliESDEvent *event, const TArrayI &neg, Int_t first, Int_t last,
+                        const TArrayI &pos, Int_t npos, const AliV0PairingPrefilter *prefilter,
+                        std::vector<AliESDv0> &v0s) const;
+    
+
     static
     Double_t fgChi2max;      // maximal allowed chi2
     static
@@ -62,8 +75,10 @@ private:
     Double_t fMinClusters;  // minimum single-track clusters value (>=)
     
     Bool_t fkDoRefit; //improve precision with a V0 refit (+ calculate chi2)
+    Bool_t fkUsePairPrefilter; //skip daughter pairs incompatible with fDCAmax by helix geometry
+    Int_t fNThreads; //number of threads for the pairing loop (1: serial)
     
-    ClassDef(AliLightV0vertexer,3)  // V0 verterxer
+    ClassDef(AliLightV0vertexer,4)  // V0 verterxer
 };
 
 inline AliLightV0vertexer::AliLightV0vertexer() :
@@ -77,7 +92,9 @@ fRmin(fgRmin),
 fRmax(fgRmax),
 fMaxEta(fgMaxEta),
 fMinClusters(fgMinClusters),
-fkDoRefit(kTRUE)
+fkDoRefit(kTRUE),
+fkUsePairPrefilter(kTRUE),
+fNThreads(1)
 {
 }
 
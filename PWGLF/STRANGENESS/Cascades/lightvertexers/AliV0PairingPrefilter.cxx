@@ -0,0 +1,199 @@
+/**************************************************************************
+ * Copyright(c) 1998-2019, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+//-------------------------------------------------------------------------
+//         Implementation of the V0 daughter pre-selection class
+//
+//  AliExternalTrackParam::GetDCA returns the covariance-weighted distance
+//        dca^2 = dxy^2 * sqrt(dz2/dy2) + dz^2 * sqrt(dy2/dz2)
+//  with dy2 (dz2) the sum of the sigmaY2 (sigmaZ2) of the two tracks.
+//  The transverse distance between any two points of the helices is at
+//  least the distance between their circles, the longitudinal one at least
+//  the gap between their z ranges: pairs for which these lower bounds
+//  already exceed the DCA cut cannot give a V0 and are skipped.
+//
+//  The z range of a track is the one covered by a half turn (the range of
+//  the local-frame propagation) ending inside the fiducial volume.
+//  Only the V0 position (the midpoint of the daughters) is required to be
+//  in the fiducial volume: a daughter can lie outside by half the
+//  transverse distance of the pair, which is at most fDCAmax/sqrt(w) with
+//  w=sqrt(dz2/dy2). The radius is padded with the bound for the smallest
+//  w of the event.
+//-------------------------------------------------------------------------
+
+#include <algorithm>
+
+#include "TMath.h"
+#include "AliESDEvent.h"
+#include "AliESDtrack.h"
+#include "AliV0PairingPrefilter.h"
+
+ClassImp(AliV0PairingPrefilter)
+
+namespace {
+    const Double_t kMinCurvature = 1e-4; // below (R > 100 m) the track is treated as a straight line
+    const Double_t kTolerance    = 1e-3; // safety margin on the circle distance (cm)
+    const Double_t kMaxPad       = 1e6;  // radius padding without z information (cm), no z range restriction
+}
+
+//_____________________________________________________________________________
+AliV0PairingPrefilter::AliV0PairingPrefilter() :
+TObject(),
+fDCAmax(1.5),
+fRmax(200.),
+fUseZRange(kTRUE),
+fNeg(),
+fPos(),
+fPosIndex(),
+fPosZlow(),
+fMaxPosZwidth(0.),
+fMaxPosSigmaZ2(0.),
+fMinPosSigmaY2(0.)
+{
+}
+
+//_____________________________________________________________________________
+void AliV0PairingPrefilter::FillHelix(const AliESDEvent *event, Int_t idx, Double_t b, Double_t pad, Helix &h) const {
+    //--------------------------------------------------------------------
+    // Transverse circle and reachable z range of track idx,
+    // pad: distance the daughter can lie outside of the fiducial volume
+    //--------------------------------------------------------------------
+    const AliESDtrack *t=event->GetTrack(idx);
+    Double_t r[3]; t->GetXYZ(r);
+    Double_t c=t->GetC(b);
+
+    h.fXc=r[0]; h.fYc=r[1]; h.fR=-1.;
+    if (TMath::Abs(c) > kMinCurvature) {
+        Double_t phi=TMath::ASin(t->GetSnp()) + t->GetAlpha();
+        h.fXc=r[0] - TMath::Sin(phi)/c;
+        h.fYc=r[1] + TMath::Cos(phi)/c;
+        h.fR=1./TMath::Abs(c);
+    }
+
+    //arc length up to a point inside the fiducial volume: at most pi/2 times
+    //the chord for less than half a turn, and at most half a circumference
+    Double_t rRef=TMath::Sqrt(r[0]*r[0] + r[1]*r[1]);
+    Double_t arc=0.5*TMath::Pi()*(rRef + fRmax + pad);
+    if (h.fR > 0. && TMath::Pi()*h.fR < arc) arc=TMath::Pi()*h.fR;
+    Double_t dz=TMath::Abs(t->GetTgl())*arc;
+    h.fZlow=r[2] - dz;
+    h.fZhigh=r[2] + dz;
+
+    h.fSigmaY2=t->GetSigmaY2();
+    h.fSigmaZ2=t->GetSigmaZ2();
+}
+
+//_____________________________________________________________________________
+void AliV0PairingPrefilter::Fill(const AliESDEvent *event, const Int_t *neg, Int_t nneg, const Int_t *pos, Int_t npos, Double_t b) {
+    //--------------------------------------------------------------------
+    // Describe the candidate daughters of this event
+    //--------------------------------------------------------------------
+
+    //smallest weight w=sqrt(dz2/dy2) of any pair: half the transverse
+    //distance of the daughters is at most fDCAmax/(2*sqrt(w))
+    Double_t minSigmaZ2=-1., maxSigmaY2=0.;
+    for (Int_t l=0; l<nneg+npos; l++) {
+        const AliESDtrack *t=event->GetTrack((l<nneg) ? neg[l] : pos[l-nneg]);
+        minSigmaZ2=(minSigmaZ2<0.) ? t->GetSigmaZ2() : TMath::Min(minSigmaZ2,t->GetSigmaZ2());
+        maxSigmaY2=TMath::Max(maxSigmaY2,t->GetSigmaY2());
+    }
+    Double_t pad=fDCAmax;
+    if (nneg+npos>0) {
+        Double_t wMin=(minSigmaZ2>0. && maxSigmaY2>0.) ? TMath::Sqrt(minSigmaZ2/maxSigmaY2) : 0.;
+        if (wMin>0.) pad=TMath::Min(TMath::Max(pad,0.5*fDCAmax/TMath::Sqrt(wMin)),kMaxPad);
+        else pad=kMaxPad;
+    }
+
+    fNeg.resize(nneg);
+    for (Int_t i=0; i<nneg; i++) FillHelix(event,neg[i],b,pad,fNeg[i]);
+
+    std::vector<Helix> lPos(npos);
+    std::vector<Double_t> lZlow(npos);
+    for (Int_t k=0; k<npos; k++) {
+        FillHelix(event,pos[k],b,pad,lPos[k]);
+        lZlow[k]=lPos[k].fZlow;
+    }
+
+    //z buckets: positive tracks sorted by lower z edge
+    fPosIndex.resize(npos);
+    if (npos>0) TMath::Sort(npos,&lZlow[0],&fPosIndex[0],kFALSE);
+    fPos.resize(npos);
+    fPosZlow.resize(npos);
+    fMaxPosZwidth=0.;
+    fMaxPosSigmaZ2=0.;
+    fMinPosSigmaY2=0.;
+    for (Int_t j=0; j<npos; j++) {
+        const Helix &h=lPos[fPosIndex[j]];
+        fPos[j]=h;
+        fPosZlow[j]=h.fZlow;
+        fMaxPosZwidth=TMath::Max(fMaxPosZwidth,h.fZhigh - h.fZlow);
+        fMaxPosSigmaZ2=TMath::Max(fMaxPosSigmaZ2,h.fSigmaZ2);
+        fMinPosSigmaY2=(j==0) ? h.fSigmaY2 : TMath::Min(fMinPosSigmaY2,h.fSigmaY2);
+    }
+}
+
+//_____________________________________________________________________________
+Bool_t AliV0PairingPrefilter::IsCompatible(const Helix &hn, const Helix &hp) const {
+    //--------------------------------------------------------------------
+    // Lower bound of the GetDCA distance of the two helices within the cut
+    //--------------------------------------------------------------------
+    Double_t dy2=hn.fSigmaY2 + hp.fSigmaY2;
+    Double_t dz2=hn.fSigmaZ2 + hp.fSigmaZ2;
+    if (dy2 <= 0. || dz2 <= 0.) return kTRUE;
+    Double_t w=TMath::Sqrt(dz2/dy2);
+
+    Double_t gapXY=0.;
+    if (hn.fR > 0. && hp.fR > 0.) {
+        Double_t dx=hn.fXc - hp.fXc, dy=hn.fYc - hp.fYc;
+        Double_t d=TMath::Sqrt(dx*dx + dy*dy);
+        gapXY=TMath::Max(d - (hn.fR + hp.fR), TMath::Abs(hn.fR - hp.fR) - d) - kTolerance;
+        if (gapXY < 0.) gapXY=0.;
+    }
+
+    Double_t gapZ=0.;
+    if (fUseZRange) {
+        gapZ=TMath::Max(hp.fZlow - hn.fZhigh, hn.fZlow - hp.fZhigh);
+        if (gapZ < 0.) gapZ=0.;
+    }
+
+    return (gapXY*gapXY*w + gapZ*gapZ/w) <= fDCAmax*fDCAmax;
+}
+
+//_____________________________________________________________________________
+Int_t AliV0PairingPrefilter::GetCompatible(Int_t ineg, std::vector<Int_t> &lCompatible) const {
+    //--------------------------------------------------------------------
+    // Positive partners of negative track ineg passing the pre-selection
+    //--------------------------------------------------------------------
+    lCompatible.clear();
+    const Helix &hn=fNeg[ineg];
+    Int_t first=0, last=fPos.size();
+
+    //scan only the z bucket overlapping with the negative track
+    Double_t dy2=hn.fSigmaY2 + fMinPosSigmaY2;
+    Double_t dz2=hn.fSigmaZ2 + fMaxPosSigmaZ2;
+    if (fUseZRange && dy2 > 0. && dz2 > 0.) {
+        Double_t margin=fDCAmax*TMath::Sqrt(TMath::Sqrt(dz2/dy2));
+        first=std::lower_bound(fPosZlow.begin(),fPosZlow.end(),hn.fZlow - margin - fMaxPosZwidth) - fPosZlow.begin();
+        last=std::upper_bound(fPosZlow.begin(),fPosZlow.end(),hn.fZhigh + margin) - fPosZlow.begin();
+    }
+
+    for (Int_t j=first; j<last; j++) {
+        if (IsCompatible(hn,fPos[j])) lCompatible.push_back(fPosIndex[j]);
+    }
+
+    //keep the order of the original pairing loop
+    std::sort(lCompatible.begin(),lCompatible.end());
+    return lCompatible.size();
+}
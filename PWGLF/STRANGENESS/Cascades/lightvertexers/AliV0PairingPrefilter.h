@@ -0,0 +1,64 @@
+#ifndef AliV0PairingPrefilter_H
+#define AliV0PairingPrefilter_H
+/* Copyright(c) 1998-2019, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+//------------------------------------------------------------------
+//              Geometrical pre-selection of V0 daughters
+//
+//   Positive and negative track candidates are described by their
+//   helix: transverse circle and z range reachable within the
+//   fiducial volume. Only pairs whose circles and z ranges are
+//   compatible with the maximal DCA between the daughters are passed
+//   to the full DCA minimisation of AliExternalTrackParam::GetDCA.
+//   Positive tracks are sorted in z so that, for each negative
+//   track, only the overlapping z bucket is scanned.
+//------------------------------------------------------------------
+
+#include <vector>
+#include "TObject.h"
+
+class AliESDEvent;
+
+//_____________________________________________________________________________
+class AliV0PairingPrefilter : public TObject {
+public:
+    AliV0PairingPrefilter();
+    virtual ~AliV0PairingPrefilter() {}
+
+    void SetCuts(Double_t lDCAmax, Double_t lRmax) { fDCAmax = lDCAmax; fRmax = lRmax; }
+    void SetUseZRange(Bool_t lOption = kTRUE) { fUseZRange = lOption; }
+
+    //Describe the helices of the selected negative and positive tracks
+    void Fill(const AliESDEvent *event, const Int_t *neg, Int_t nneg, const Int_t *pos, Int_t npos, Double_t b);
+
+    //Indices (in the positive list, ascending) of the positive tracks compatible
+    //with negative track ineg (index in the negative list)
+    Int_t GetCompatible(Int_t ineg, std::vector<Int_t> &lCompatible) const;
+
+private:
+    struct Helix {
+        Double_t fXc, fYc, fR;     // transverse circle (fR<0: straight line, no circle test)
+        Double_t fZlow, fZhigh;    // z range reachable within the fiducial volume
+        Double_t fSigmaY2, fSigmaZ2; // variances used to weight the DCA
+    };
+
+    void FillHelix(const AliESDEvent *event, Int_t idx, Double_t b, Double_t pad, Helix &h) const;
+    Bool_t IsCompatible(const Helix &hn, const Helix &hp) const;
+
+    Double_t fDCAmax;   // maximal allowed DCA between the daughter tracks
+    Double_t fRmax;     // max radius of the fiducial volume
+    Bool_t fUseZRange;  // use the z range test on top of the transverse one
+
+    std::vector<Helix> fNeg;      //! helices of the negative tracks
+    std::vector<Helix> fPos;      //! helices of the positive tracks, sorted by fZlow
+    std::vector<Int_t> fPosIndex; //! index in the positive list of the sorted positive tracks
+    std::vector<Double_t> fPosZlow; //! sorted fZlow of the positive tracks
+    Double_t fMaxPosZwidth;       //! largest z range of the positive tracks
+    Double_t fMaxPosSigmaZ2;      //! largest sigmaZ2 of the positive tracks
+    Double_t fMinPosSigmaY2;      //! smallest sigmaY2 of the positive tracks
+
+    ClassDef(AliV0PairingPrefilter,1)  // geometrical pre-selection of V0 daughters
+};
+
+#endif
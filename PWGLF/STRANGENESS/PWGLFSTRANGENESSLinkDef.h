@@ -42,6 +42,7 @@
 #pragma link C++ class AliLightCascadeVertexer+;
 #pragma link C++ class AliCascadeVertexerUncheckedCharges+;
 #pragma link C++ class AliV0vertexerUncheckedCharges+;
+#pragma link C++ class AliV0PairingPrefilter+;
 #pragma link C++ class AliVWeakResult+;
 #pragma link C++ class AliV0Result+;
 #pragma link C++ class AliCascadeResult+;
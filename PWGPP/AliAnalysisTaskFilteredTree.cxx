@@ -38,6 +38,7 @@
 #include "TSystem.h"
 #include <TPDGCode.h>
 #include <TDatabasePDG.h>
+#include <cstring>
 
 #include "TChain.h"
 #include "TTreeStream.h"
@@ -86,6 +87,8 @@
 #include "AliPID.h"
 #include "AliPIDResponse.h"
 #include "TVectorD.h"
+#include "TBranchElement.h"
+#include "TObjString.h"
 
 using namespace std;
 
@@ -134,6 +137,13 @@ ClassImp(AliAnalysisTaskFilteredTree)
   , fPtResCentPtTPCITS(0)
   , fCurrentFileName("")
   , fDummyTrack(0)
+  , fOutputMode(kObjectOutput)
+  , fFlatPrecisionBits(0)
+  , fBasketSize(0)
+  , fFlatCompression(-1)
+  , fObjectCompression(-1)
+  , fFlatColumns(0)
+  , fFlatBuffers()
 {
   // Constructor
 
@@ -157,6 +167,7 @@ AliAnalysisTaskFilteredTree::~AliAnalysisTaskFilteredTree()
   delete fFilteredTreeAcceptanceCuts;
   delete fFilteredTreeRecAcceptanceCuts;
   delete fEsdTrackCuts;
+  delete fFlatColumns;
 }
 
 //____________________________________________________________________________
@@ -520,11 +531,19 @@ void AliAnalysisTaskFilteredTree::ProcessCosmics(AliESDEvent *const event, AliES
         "multTPC="<<ntracksTPC<<              //  
         "vertSPD.="<<vertexSPD<<              // primary vertex -SPD
         "vertTPC.="<<vertexTPC<<              // primary vertex -TPC
-        "t0.="<<track0<<                      // first half of comsic trak
-        "t1.="<<track1<<                      // second half of cosmic track
         "friendTrack0.="<<friendTrackStore0<< // friend information first track  + points
-        "friendTrack1.="<<friendTrackStore1<< // frined information first track  + points 
-        "\n";      
+        "friendTrack1.="<<friendTrackStore1;  // frined information first track  + points 
+      if (fOutputMode!=kFlatOutput){
+        (*fTreeSRedirector)<<"CosmicPairs"<<
+          "t0.="<<track0<<                    // first half of comsic trak
+          "t1.="<<track1;                     // second half of cosmic track
+      }
+      if (fOutputMode!=kObjectOutput){
+        StreamFlatESDTrack("CosmicPairs","t0",track0);
+        StreamFlatESDTrack("CosmicPairs","t1",track1);
+      }
+      (*fTreeSRedirector)<<"CosmicPairs"<<"\n";
+      ConfigureOutputTree("CosmicPairs");
     }
   }
 }
@@ -722,9 +741,11 @@ void AliAnalysisTaskFilteredTree::Process(AliESDEvent *const esdEvent, AliMCEven
         "mult="<<mult<<                      // multiplicity of tracks pointing to the primary vertex
         "multSPD="<<multSPD<<                // multiplicity of tracks pointing to the SPD primary vertex
         "multTPC="<<multTPC<<                // multiplicity of tracks pointing to the TPC primary vertex
-        "esdTrack.="<<track<<
-        "centralityF="<<centralityF<<       
-        "\n";
+        "centralityF="<<centralityF;
+      if (fOutputMode!=kFlatOutput) (*fTreeSRedirector)<<"highPt"<<"esdTrack.="<<track;
+      if (fOutputMode!=kObjectOutput) StreamFlatESDTrack("highPt","esdTrack",track);
+      (*fTreeSRedirector)<<"highPt"<<"\n";
+      ConfigureOutputTree("highPt");
     }
   }
 
@@ -773,9 +794,11 @@ void AliAnalysisTaskFilteredTree::ProcessLaser(AliESDEvent *const esdEvent, AliM
         "triggerClass="<<&triggerClass<<        //  trigger
         "Bz="<<bz<<                             //  magnetic field
         "multTPCtracks="<<countLaserTracks<<    //  multiplicity of tracks
-	"track.="<<track<<                      //  track parameters
-        "friendTrack.="<<friendTrack<<          //  friend track information
-        "\n";
+        "friendTrack.="<<friendTrack;           //  friend track information
+      if (fOutputMode!=kFlatOutput) (*fTreeSRedirector)<<"Laser"<<"track.="<<track;   //  track parameters
+      if (fOutputMode!=kObjectOutput) StreamFlatESDTrack("Laser","track",track);
+      (*fTreeSRedirector)<<"Laser"<<"\n";
+      ConfigureOutputTree("Laser");
     }
   }
 }
@@ -1444,7 +1467,6 @@ void AliAnalysisTaskFilteredTree::ProcessAll(AliESDEvent *const esdEvent, AliMCE
             "ntracksTPC="<<ntracksTPC<<               // total number of the TPC tracks which were refitted
             "ntracksITS="<<ntracksITS<<               // total number of the ITS tracks which were refitted
             //
-            "esdTrack.="<<track<<                  // esdTrack as used in the physical analysis
 	    "tofClInfo.="<<&tofClInfo<<           // tof info
 	    //            "friendTrack.="<<friendTrack<<      // esdFriendTrack associated to the esdTrack
 	    "tofNsigma.="<<&tofNsigma<<
@@ -1453,16 +1475,29 @@ void AliAnalysisTaskFilteredTree::ProcessAll(AliESDEvent *const esdEvent, AliMCE
 	    "tpcPID.="<<&tpcPID<<                  // bayesian PID - without priors
 	    
 	    "friendTrack.="<<friendTrackStore<<      // esdFriendTrack associated to the esdTrack 
-            "extTPCInnerC.="<<tpcInnerC<<          // TPC track from the first tracking iteration propagated and updated at vertex 
-            "extInnerParamV.="<<trackInnerV<<      // TPC+TRD  inner param after refit  propagate to vertex 
-            "extInnerParamC.="<<trackInnerC<<      // TPC+TRD  inner param after refit  propagate and updated at vertex 
-            "extInnerParam.="<<trackInnerC2<<      // TPC+TRD  inner param after refit propagate to refernce TPC layer
-            "extOuterITS.="<<outerITSc<<           // ITS outer track propagated to the TPC refernce radius
-            "extInnerParamRef.="<<trackInnerC3<<   // TPC+TRD  inner param after refit propagated to the first TPC reference 
             "chi2TPCInnerC="<<chi2(0,0)<<           // chi2   of tracks ???
             "chi2InnerC="<<chi2trackC(0,0)<<        // chi2s  of tracks TPCinner to the combined
             "chi2OuterITS="<<chi2OuterITS(0,0)<<    // chi2s  of tracks TPC at inner wall to the ITSout
             "centralityF="<<centralityF;
+          if (fOutputMode!=kFlatOutput){
+            (*fTreeSRedirector)<<"highPt"<<
+              "esdTrack.="<<track<<                  // esdTrack as used in the physical analysis
+              "extTPCInnerC.="<<tpcInnerC<<          // TPC track from the first tracking iteration propagated and updated at vertex 
+              "extInnerParamV.="<<trackInnerV<<      // TPC+TRD  inner param after refit  propagate to vertex 
+              "extInnerParamC.="<<trackInnerC<<      // TPC+TRD  inner param after refit  propagate and updated at vertex 
+              "extInnerParam.="<<trackInnerC2<<      // TPC+TRD  inner param after refit propagate to refernce TPC layer
+              "extOuterITS.="<<outerITSc<<           // ITS outer track propagated to the TPC refernce radius
+              "extInnerParamRef.="<<trackInnerC3;    // TPC+TRD  inner param after refit propagated to the first TPC reference 
+          }
+          if (fOutputMode!=kObjectOutput){         // same information as flat numeric branches
+            StreamFlatESDTrack("highPt","esdTrack",track);
+            StreamFlatTrackParam("highPt","extTPCInnerC",tpcInnerC);
+            StreamFlatTrackParam("highPt","extInnerParamV",trackInnerV);
+            StreamFlatTrackParam("highPt","extInnerParamC",trackInnerC);
+            StreamFlatTrackParam("highPt","extInnerParam",trackInnerC2);
+            StreamFlatTrackParam("highPt","extOuterITS",outerITSc);
+            StreamFlatTrackParam("highPt","extInnerParamRef",trackInnerC3);
+          }
           if (mcEvent){
             static AliTrackReference refDummy;
             if (!refITS) refITS = &refDummy;
@@ -1511,6 +1546,7 @@ void AliAnalysisTaskFilteredTree::ProcessAll(AliESDEvent *const esdEvent, AliMCE
           //finish writing the entry
           AliInfo("writing tree highPt");
           (*fTreeSRedirector)<<"highPt"<<"\n";
+          ConfigureOutputTree("highPt");
         }
         AliSysInfo::AddStamp("filteringTask",iTrack,numberOfTracks,numberOfFriendTracks,(friendTrackStore)?0:1);
         delete tpcInnerC;
@@ -1785,15 +1821,18 @@ void AliAnalysisTaskFilteredTree::ProcessMCEff(AliESDEvent *const esdEvent, AliM
           //
           "isAcc0="<<isESDtrackCut<<                // track accepted by ESD track cuts
           "isAcc1="<<isAccCuts<<                    // track accepted by acceptance cuts flag
-          "esdTrack.="<<recTrack<<                  // reconstructed track (only the longest from the loopers)
           "isRec="<<isRec<<                         // track was reconstructed
           "tpcTrackLength="<<tpcTrackLength<<       // track length in the TPC r projection
           "particle.="<<particle<<                  // particle properties
           "particleMother.="<<particleMother<<      // particle mother
           "mech="<<mech<<                           // production mechanizm
           "nRec="<<nRec<<                           // how many times reconstruted
-          "nFakes="<<nFakes<<                       // how many times reconstructed as a fake track
-          "\n";
+          "nFakes="<<nFakes;                        // how many times reconstructed as a fake track
+        // reconstructed track (only the longest from the loopers), flat branches are zero if not reconstructed
+        if (fOutputMode!=kFlatOutput) (*fTreeSRedirector)<<"MCEffTree"<<"esdTrack.="<<recTrack;
+        if (fOutputMode!=kObjectOutput) StreamFlatESDTrack("MCEffTree","esdTrack",recTrack);
+        (*fTreeSRedirector)<<"MCEffTree"<<"\n";
+        ConfigureOutputTree("MCEffTree");
       }
 
       //if(trackIndex <0 && recTrack) delete recTrack; recTrack=0;
@@ -2040,8 +2079,6 @@ void AliAnalysisTaskFilteredTree::ProcessV0(AliESDEvent *const esdEvent, AliMCEv
         "ntracks="<<ntracks<<
         "v0.="<<v0<<
         "kf.="<<&kfparticle<<
-        "track0.="<<track0<<                  // track
-        "track1.="<<track1<<
 	"tofClInfo0.="<<&tofClInfo0<<
 	"tofClInfo1.="<<&tofClInfo1<<
       	"tofNsigma0.="<<&tofNsigma0<<
@@ -2050,8 +2087,18 @@ void AliAnalysisTaskFilteredTree::ProcessV0(AliESDEvent *const esdEvent, AliMCEv
 	"tpcNsigma1.="<<&tpcNsigma1<<
         "friendTrack0.="<<friendTrackStore0<<
         "friendTrack1.="<<friendTrackStore1<<
-        "centralityF="<<centralityF<<
-        "\n";
+        "centralityF="<<centralityF;
+      if (fOutputMode!=kFlatOutput){
+        (*fTreeSRedirector)<<"V0s"<<
+          "track0.="<<track0<<                  // track
+          "track1.="<<track1;
+      }
+      if (fOutputMode!=kObjectOutput){
+        StreamFlatESDTrack("V0s","track0",track0);
+        StreamFlatESDTrack("V0s","track1",track1);
+      }
+      (*fTreeSRedirector)<<"V0s"<<"\n";
+      ConfigureOutputTree("V0s");
     }
   }
 }
@@ -2188,11 +2235,13 @@ void AliAnalysisTaskFilteredTree::ProcessdEdx(AliESDEvent *const esdEvent, AliMC
         "Bz="<<bz<<
         "vtxESD.="<<vtxESD<<                  // 
         "mult="<<mult<<
-        "esdTrack.="<<track<<
         "friendTrack.="<<friendTrack<<
         "tofNsigma.="<<&tofNsigma<<
-        "tpcNsigma.="<<&tpcNsigma<<
-        "\n";
+        "tpcNsigma.="<<&tpcNsigma;
+      if (fOutputMode!=kFlatOutput) (*fTreeSRedirector)<<"dEdx"<<"esdTrack.="<<track;
+      if (fOutputMode!=kObjectOutput) StreamFlatESDTrack("dEdx","esdTrack",track);
+      (*fTreeSRedirector)<<"dEdx"<<"\n";
+      ConfigureOutputTree("dEdx");
     }
   }
 }
@@ -2956,3 +3005,202 @@ void  AliAnalysisTaskFilteredTree::SetDefaultAliasesV0(TTree *tree){
   tree->SetAlias("K0PIDPull","(abs(track0.fTPCsignal/dEdx0DPion-50)+abs(track1.fTPCsignal/dEdx1DPion-50))/5.");
 
 }
+
+//_____________________________________________________________________________
+const TObjArray* AliAnalysisTaskFilteredTree::GetFlatColumns(const char *prefix)
+{
+  //
+  // Column names of the flat branches for a given prefix
+  // Schema is declared once here, the names are built at the first use of the prefix
+  //   columns 0-21  - AliExternalTrackParam: fX, fAlpha, fP[5], fC[15]
+  //   columns 22-   - AliESDtrack scalars, see StreamFlatESDTrack
+  //
+  static const char *kParamColumns[7]={"fX","fAlpha","fP0","fP1","fP2","fP3","fP4"};
+  static const char *kESDColumns[10]={"fStatus","fLabel","fTPCncls","fITSncls","fTPCCrossedRows",
+                                      "fTPCsignal","fTPCsignalN","fTPCchi2","fITSchi2","fD"};
+  if (!fFlatColumns) {
+    fFlatColumns = new TObjArray;
+    fFlatColumns->SetOwner(kTRUE);
+  }
+  TObjArray *columns = (TObjArray*)fFlatColumns->FindObject(prefix);
+  if (columns) return columns;
+  //
+  columns = new TObjArray;
+  columns->SetOwner(kTRUE);
+  columns->SetName(prefix);
+  for (Int_t i=0; i<7; i++) columns->AddLast(new TObjString(TString::Format("%s_%s=",prefix,kParamColumns[i])));
+  for (Int_t i=0; i<15; i++) columns->AddLast(new TObjString(TString::Format("%s_fC%d=",prefix,i)));
+  for (Int_t i=0; i<10; i++) columns->AddLast(new TObjString(TString::Format("%s_%s=",prefix,kESDColumns[i])));
+  columns->AddLast(new TObjString(TString::Format("%s_fZ=",prefix)));
+  fFlatColumns->AddLast(columns);
+  return columns;
+}
+
+//_____________________________________________________________________________
+Float_t AliAnalysisTaskFilteredTree::TruncateFloat(Double_t x) const
+{
+  //
+  // Round to fFlatPrecisionBits bits of the mantissa
+  // the zeroed low bits are removed by the compression
+  //
+  union { Float_t f; UInt_t u; } value;
+  value.f = Float_t(x);
+  if (fFlatPrecisionBits<=0 || fFlatPrecisionBits>=23) return value.f;
+  if (((value.u>>23)&0xff)==0xff) return value.f;    // inf or nan
+  const Int_t shift = 23-fFlatPrecisionBits;
+  value.u += (1u<<(shift-1));                        // round to nearest
+  value.u &= ~((1u<<shift)-1);
+  return value.f;
+}
+
+//_____________________________________________________________________________
+AliAnalysisTaskFilteredTree::FlatTrackBuffer& AliAnalysisTaskFilteredTree::GetFlatBuffer(const char *treeName, const char *prefix)
+{
+  //
+  // Buffer of the flat values for a given tree and prefix, created at the first use
+  // The TTreeStream reads the values at the Fill of the entry, the buffer keeps them alive until then
+  //
+  TString key = TString::Format("%s/%s",treeName,prefix);
+  std::map<TString,FlatTrackBuffer>::iterator it = fFlatBuffers.find(key);
+  if (it!=fFlatBuffers.end()) return it->second;
+  FlatTrackBuffer &buffer = fFlatBuffers[key];
+  buffer.fTree = treeName;
+  buffer.fPrefix = prefix;
+  buffer.fESD = kFALSE;
+  for (Int_t i=0; i<22; i++) buffer.fParam[i] = 0;
+  buffer.fStatus = 0;
+  for (Int_t i=0; i<3; i++) buffer.fInt[i] = 0;
+  for (Int_t i=0; i<7; i++) buffer.fFloat[i] = 0;
+  return buffer;
+}
+
+//_____________________________________________________________________________
+void AliAnalysisTaskFilteredTree::StreamFlatTrackParam(const char *treeName, const char *prefix, const AliExternalTrackParam *param)
+{
+  //
+  // Stream track parameters and covariance as flat Float_t branches prefix_fX, prefix_fAlpha, prefix_fP0-4, prefix_fC0-14
+  // missing parameters are written as zeros (prefix_fX==0)
+  //
+  if (!fTreeSRedirector) return;
+  const TObjArray *columns = GetFlatColumns(prefix);
+  FlatTrackBuffer &buffer = GetFlatBuffer(treeName,prefix);
+  Float_t *values = buffer.fParam;
+  for (Int_t i=0; i<22; i++) values[i] = 0;
+  if (param) {
+    values[0] = TruncateFloat(param->GetX());
+    values[1] = TruncateFloat(param->GetAlpha());
+    const Double_t *p = param->GetParameter();
+    const Double_t *c = param->GetCovariance();
+    for (Int_t i=0; i<5; i++) values[2+i] = TruncateFloat(p[i]);
+    for (Int_t i=0; i<15; i++) values[7+i] = TruncateFloat(c[i]);
+  }
+  TTreeStream &stream = (*fTreeSRedirector)<<treeName;
+  for (Int_t i=0; i<22; i++) stream<<columns->UncheckedAt(i)->GetName()<<values[i];
+}
+
+//_____________________________________________________________________________
+void AliAnalysisTaskFilteredTree::StreamFlatESDTrack(const char *treeName, const char *prefix, const AliESDtrack *track)
+{
+  //
+  // Stream the ESD track as flat branches:
+  //   track parameters (prefix_), TPC inner parameters (prefix_ip_) and the scalars used in the calibration
+  //
+  if (!fTreeSRedirector) return;
+  StreamFlatTrackParam(treeName,prefix,track);
+  StreamFlatTrackParam(treeName,TString::Format("%s_ip",prefix).Data(),(track)?track->GetInnerParam():0);
+  //
+  const TObjArray *columns = GetFlatColumns(prefix);
+  FlatTrackBuffer &buffer = GetFlatBuffer(treeName,prefix);
+  buffer.fESD = kTRUE;
+  buffer.fStatus = 0;                      // full AliESDtrack status, the flags use the high bits
+  for (Int_t i=0; i<3; i++) buffer.fInt[i] = 0;
+  for (Int_t i=0; i<7; i++) buffer.fFloat[i] = 0;
+  if (track) {
+    Float_t dcaR=0, dcaZ=0;
+    track->GetImpactParameters(dcaR,dcaZ);
+    buffer.fStatus = track->GetStatus();
+    buffer.fInt[0] = track->GetLabel();
+    buffer.fInt[1] = track->GetTPCNcls();
+    buffer.fInt[2] = track->GetITSNcls();
+    buffer.fFloat[0] = track->GetTPCCrossedRows();
+    buffer.fFloat[1] = TruncateFloat(track->GetTPCsignal());
+    buffer.fFloat[2] = track->GetTPCsignalN();
+    buffer.fFloat[3] = TruncateFloat(track->GetTPCchi2());
+    buffer.fFloat[4] = TruncateFloat(track->GetITSchi2());
+    buffer.fFloat[5] = TruncateFloat(dcaR);
+    buffer.fFloat[6] = TruncateFloat(dcaZ);
+  }
+  TTreeStream &stream = (*fTreeSRedirector)<<treeName;
+  stream<<columns->UncheckedAt(22)->GetName()<<buffer.fStatus;
+  for (Int_t i=0; i<3; i++) stream<<columns->UncheckedAt(23+i)->GetName()<<buffer.fInt[i];
+  for (Int_t i=0; i<7; i++) stream<<columns->UncheckedAt(26+i)->GetName()<<buffer.fFloat[i];
+}
+
+//_____________________________________________________________________________
+Bool_t AliAnalysisTaskFilteredTree::CheckFlatReadback(const char *treeName)
+{
+  //
+  // Read back the flat branches of the last entry of the tree and compare them
+  // with the buffers they were streamed from, i.e. with the values of the source tracks
+  // Returns kFALSE and reports the first differing branch on mismatch
+  //
+  if (!fTreeSRedirector) return kFALSE;
+  TTree *tree = ((*fTreeSRedirector)<<treeName).GetTree();
+  if (!tree || tree->GetEntries()<=0) return kFALSE;
+  const Long64_t entry = tree->GetEntries()-1;
+  Bool_t isOK = kTRUE;
+  for (std::map<TString,FlatTrackBuffer>::iterator it=fFlatBuffers.begin(); it!=fFlatBuffers.end(); ++it){
+    FlatTrackBuffer &buffer = it->second;
+    if (buffer.fTree!=treeName) continue;
+    const FlatTrackBuffer expected = buffer;
+    const TObjArray *columns = GetFlatColumns(buffer.fPrefix.Data());
+    const Int_t ncolumns = (buffer.fESD) ? 33:22;
+    for (Int_t i=0; i<ncolumns; i++){
+      TString name = columns->UncheckedAt(i)->GetName();
+      name.Remove(TString::kTrailing,'=');
+      TBranch *br = tree->GetBranch(name.Data());
+      if (!br || br->GetEntry(entry)<=0) {
+        AliError(Form("tree %s: branch %s can not be read back",treeName,name.Data()));
+        isOK = kFALSE;
+      }
+    }
+    Bool_t same = (memcmp(expected.fParam,buffer.fParam,sizeof(buffer.fParam))==0);
+    if (buffer.fESD) {
+      same &= (expected.fStatus==buffer.fStatus);
+      same &= (memcmp(expected.fInt,buffer.fInt,sizeof(buffer.fInt))==0);
+      same &= (memcmp(expected.fFloat,buffer.fFloat,sizeof(buffer.fFloat))==0);
+    }
+    if (!same) {
+      AliError(Form("tree %s: flat branches %s_* differ from the streamed track",treeName,buffer.fPrefix.Data()));
+      isOK = kFALSE;
+    }
+    buffer = expected;
+  }
+  return isOK;
+}
+
+//_____________________________________________________________________________
+void AliAnalysisTaskFilteredTree::ConfigureOutputTree(const char *treeName)
+{
+  //
+  // Apply the basket size and the compression settings to the branches of the tree
+  // Branches are created by the TTreeSRedirector with the first entry, so this is done 
+  // right after it, before the first basket is written
+  //   object branches (TBranchElement) - fObjectCompression
+  //   numeric branches                 - fFlatCompression
+  // The flat branches of the first entry are also read back and checked, see CheckFlatReadback
+  //
+  if (!fTreeSRedirector) return;
+  TTree *tree = ((*fTreeSRedirector)<<treeName).GetTree();
+  if (!tree || tree->GetEntries()!=1) return;
+  if (fOutputMode!=kObjectOutput) CheckFlatReadback(treeName);   // first entry of the flat branches
+  if (fBasketSize<=0 && fFlatCompression<0 && fObjectCompression<0) return;
+  //
+  if (fBasketSize>0) tree->SetBasketSize("*",fBasketSize);
+  TObjArray *branches = tree->GetListOfBranches();
+  for (Int_t ibr=0; ibr<branches->GetEntriesFast(); ibr++){
+    TBranch *br = (TBranch*)branches->UncheckedAt(ibr);
+    Int_t settings = (br->InheritsFrom(TBranchElement::Class())) ? fObjectCompression:fFlatCompression;
+    if (settings>=0) br->SetCompressionSettings(settings);
+  }
+}
@@ -31,6 +31,8 @@ class TTreeSRedirector;
 class TParticle;
 class TH3D;
 
+#include <map>
+#include "TString.h"
 #include "AliTriggerAnalysis.h"
 #include "AliAnalysisTaskSE.h"
 
@@ -41,6 +43,11 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
                       kTPCITSAnalysisMode=0,
                       kTPCAnalysisMode=1 };
 
+  // output of the track parameters in the highPt, V0s, dEdx, Laser, MCEffTree and CosmicPairs trees
+  enum EOutputMode { kObjectOutput=0,          // AliESDtrack and AliExternalTrackParam objects (default)
+                     kFlatOutput=1,            // flat numeric branches
+                     kFlatAndObjectOutput=2 }; // both, e.g. for validation
+
   AliAnalysisTaskFilteredTree(const char *name = "AliAnalysisTaskFilteredTree");
   virtual ~AliAnalysisTaskFilteredTree();
   
@@ -115,8 +122,38 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
 
   void FillHistograms(AliESDtrack* const ptrack, AliExternalTrackParam* const ptpcInnerC, Double_t centralityF, Double_t chi2TPCInnerC);
   static void SetDefaultAliasesV0(TTree *treeV0);
+
+  // columnar output
+  void SetOutputMode(EOutputMode mode)          { fOutputMode = mode; }
+  EOutputMode GetOutputMode() const             { return fOutputMode; }
+  void SetFlatFloatPrecision(Int_t nbits)       { fFlatPrecisionBits = nbits; }
+  Int_t GetFlatFloatPrecision() const           { return fFlatPrecisionBits; }
+  void SetOutputBasketSize(Int_t size)          { fBasketSize = size; }
+  void SetFlatCompression(Int_t settings)       { fFlatCompression = settings; }
+  void SetObjectCompression(Int_t settings)     { fObjectCompression = settings; }
+
+  void StreamFlatTrackParam(const char *treeName, const char *prefix, const AliExternalTrackParam *param);
+  void StreamFlatESDTrack(const char *treeName, const char *prefix, const AliESDtrack *track);
+  void ConfigureOutputTree(const char *treeName);
+  Bool_t CheckFlatReadback(const char *treeName);
+  Float_t TruncateFloat(Double_t x) const;
  private:
 
+  // values of the flat branches of one prefix in one tree
+  // TTreeStream keeps the addresses until the entry is filled, so they have to outlive the Stream calls
+  struct FlatTrackBuffer {
+    TString   fTree;          // tree name
+    TString   fPrefix;        // branch name prefix
+    Bool_t    fESD;           // AliESDtrack scalars streamed (StreamFlatESDTrack)
+    Float_t   fParam[22];     // fX, fAlpha, fP[5], fC[15]
+    ULong64_t fStatus;        // track status
+    Int_t     fInt[3];        // label, TPC and ITS clusters
+    Float_t   fFloat[7];      // crossed rows, TPC signal, TPC signalN, TPC chi2, ITS chi2, dcaR, dcaZ
+  };
+
+  const TObjArray* GetFlatColumns(const char *prefix);
+  FlatTrackBuffer& GetFlatBuffer(const char *treeName, const char *prefix);
+
   AliESDEvent *fESD;    //! ESD event
   AliMCEvent *fMC;      //! MC event
   AliESDfriend *fESDfriend; //! ESDfriend event
@@ -168,9 +205,17 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
   TObjString fCurrentFileName; // cached value of current file name
   AliESDtrack* fDummyTrack; //! dummy track for tree init
 
+  EOutputMode fOutputMode;      // output of the track parameters: objects, flat branches or both
+  Int_t fFlatPrecisionBits;     // number of mantissa bits kept in the flat branches (0 or >=23 - full float)
+  Int_t fBasketSize;            // basket size of the output tree branches (0 - ROOT default)
+  Int_t fFlatCompression;       // compression settings of the flat branches (-1 - file default)
+  Int_t fObjectCompression;     // compression settings of the object branches (-1 - file default)
+  TObjArray* fFlatColumns;      //! column names of the flat branches, one array per prefix
+  std::map<TString,FlatTrackBuffer> fFlatBuffers; //! values of the flat branches, one buffer per tree and prefix
+
   AliAnalysisTaskFilteredTree(const AliAnalysisTaskFilteredTree&); // not implemented
   AliAnalysisTaskFilteredTree& operator=(const AliAnalysisTaskFilteredTree&); // not implemented
-  ClassDef(AliAnalysisTaskFilteredTree, 1); // example of analysis
+  ClassDef(AliAnalysisTaskFilteredTree, 2); // example of analysis
 };
 
 #endif
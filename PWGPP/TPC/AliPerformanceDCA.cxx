@@ -173,7 +173,7 @@ void AliPerformanceDCA::ProcessTPC(AliMCEvent* const mcev, AliESDtrack *const es
   if (esdTrack->GetTPCNcls()<fCutsRC->GetMinNClustersTPC()) return; // min. nb. TPC clusters  
  
   Double_t vDCAHisto[5]={dca[0],dca[1],track->Eta(),track->Pt(),track->Phi()};
-  fDCAHisto->Fill(vDCAHisto);
+  FillHisto(fDCAHisto,vDCAHisto);
 
   //
   // Fill rec vs MC information
@@ -214,7 +214,7 @@ void AliPerformanceDCA::ProcessTPCITS(AliMCEvent* const mcev, AliESDtrack *const
   if(esdTrack->GetITSclusters(0)<fCutsRC->GetMinNClustersITS()) return;  // min. nb. ITS clusters
 
   Double_t vDCAHisto[5]={dca[0],dca[1],esdTrack->Eta(),esdTrack->Pt(), esdTrack->Phi()};
-  fDCAHisto->Fill(vDCAHisto);
+  FillHisto(fDCAHisto,vDCAHisto);
 
   //
   // Fill rec vs MC information
@@ -241,6 +241,9 @@ Long64_t AliPerformanceDCA::Merge(TCollection* const list)
   if (list->IsEmpty())
   return 1;
 
+  // bin the buffered points before merging
+  FlushFillBuffers();
+
   TIterator* iter = list->MakeIterator();
   TObject* obj = 0;
 
@@ -250,6 +253,7 @@ Long64_t AliPerformanceDCA::Merge(TCollection* const list)
   {
     AliPerformanceDCA* entry = dynamic_cast<AliPerformanceDCA*>(obj);
     if (entry == 0) continue; 
+    entry->FlushFillBuffers();
 
     fDCAHisto->Add(entry->fDCAHisto);
     count++;
@@ -344,6 +348,7 @@ void AliPerformanceDCA::Analyse()
   // in the analysis folder "folderDCA" 
   //
   
+  FlushFillBuffers();
   TH1::AddDirectory(kFALSE);
   TH1F *h1D=0;
   TH2F *h2D=0;
@@ -248,7 +248,7 @@ void AliPerformanceDEdx::ProcessInnerTPC(AliMCEvent* const mcev, AliESDtrack *co
 
   //Double_t vDeDxHisto[10] = {dedx,phi,y,z,snp,tgl,ncls,p,TPCSignalN,nCrossedRows};
   Double_t vDeDxHisto[10] = {dedx,phi,y,z,snp,tgl,Double_t(ncls),p,Double_t(TPCSignalN),nClsF};
-  fDeDxHisto->Fill(vDeDxHisto); 
+  FillHisto(fDeDxHisto,vDeDxHisto); 
 
   if(!mcev) return;
 }
@@ -279,6 +279,9 @@ Long64_t AliPerformanceDEdx::Merge(TCollection* const list)
 
   if (list->IsEmpty())
   return 1;
+
+  // bin the buffered points before merging
+  FlushFillBuffers();
   
   Bool_t merge = ((fgUseMergeTHnSparse && fgMergeTHnSparse) || (!fgUseMergeTHnSparse && fMergeTHnSparseObj));
 
@@ -293,6 +296,7 @@ Long64_t AliPerformanceDEdx::Merge(TCollection* const list)
   {
     AliPerformanceDEdx* entry = dynamic_cast<AliPerformanceDEdx*>(obj);
     if (entry == 0) continue; 
+    entry->FlushFillBuffers();
     if (merge) {
         if ((fDeDxHisto) && (entry->fDeDxHisto)) { fDeDxHisto->Add(entry->fDeDxHisto); }        
     }
@@ -403,6 +407,7 @@ void AliPerformanceDEdx::Analyse()
   //fai fit con range p(.32,.38) and dEdx(65- 120 or 100) e ripeti cosa fatta per pion e fai trending della media e res, poio la loro differenza
   //fai dedx vs lamda ma for e e pion separati
   //
+  FlushFillBuffers();
   TH1::AddDirectory(kFALSE);
   TH1::SetDefaultSumw2(kFALSE);
   TH1F *h1D=0;
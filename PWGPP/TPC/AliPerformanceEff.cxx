@@ -283,7 +283,7 @@ void AliPerformanceEff::ProcessTPC(AliMCEvent* const mcEvent, AliESDEvent *const
 
     // Fill histograms
     Double_t vEffHisto[9] = {mceta, mcphi, mcpt, static_cast<Double_t>(pid), static_cast<Double_t>(recStatus), static_cast<Double_t>(findable), static_cast<Double_t>(charge), static_cast<Double_t>(nClones), static_cast<Double_t>(nFakes)}; 
-    fEffHisto->Fill(vEffHisto);
+    FillHisto(fEffHisto,vEffHisto);
   }
   if(labelsRec) delete [] labelsRec; labelsRec = 0;
   if(labelsAllRec) delete [] labelsAllRec; labelsAllRec = 0;
@@ -419,7 +419,7 @@ void AliPerformanceEff::ProcessTPCSec(AliMCEvent* const mcEvent, AliESDEvent *co
 	
 	// Fill histograms
 	Double_t vEffSecHisto[12] = { mceta, mcphi, mcpt, static_cast<Double_t>(pid), static_cast<Double_t>(recStatus), static_cast<Double_t>(findable), mcR, mother_phi, mother_eta, static_cast<Double_t>(charge), static_cast<Double_t>(nClones), static_cast<Double_t>(nFakes) }; 
-	  fEffSecHisto->Fill(vEffSecHisto);
+	  FillHisto(fEffSecHisto,vEffSecHisto);
       }
   }
   
@@ -536,7 +536,7 @@ void AliPerformanceEff::ProcessTPCITS(AliMCEvent* const mcEvent, AliESDEvent *co
     
     // Fill histograms
     Double_t vEffHisto[9] = { mceta, mcphi, mcpt, static_cast<Double_t>(pid), static_cast<Double_t>(recStatus), static_cast<Double_t>(findable), static_cast<Double_t>(charge), static_cast<Double_t>(nClones), static_cast<Double_t>(nFakes)}; 
-    fEffHisto->Fill(vEffHisto);
+    FillHisto(fEffHisto,vEffHisto);
   }
 
   if(labelsRecTPCITS) delete [] labelsRecTPCITS; labelsRecTPCITS = 0;
@@ -651,7 +651,7 @@ void AliPerformanceEff::ProcessConstrained(AliMCEvent* const mcEvent, AliESDEven
 
     // Fill histograms
     Double_t vEffHisto[9] = { mceta, mcphi, mcpt, static_cast<Double_t>(pid), static_cast<Double_t>(recStatus), static_cast<Double_t>(findable), static_cast<Double_t>(charge), static_cast<Double_t>(nClones), static_cast<Double_t>(nFakes) }; 
-    fEffHisto->Fill(vEffHisto);
+    FillHisto(fEffHisto,vEffHisto);
   }
 
   if(labelsRecConstrained) delete [] labelsRecConstrained; labelsRecConstrained = 0;
@@ -859,6 +859,9 @@ Long64_t AliPerformanceEff::Merge(TCollection* const list)
   if (list->IsEmpty())
   return 1;
 
+  // bin the buffered points before merging
+  FlushFillBuffers();
+
   TIterator* iter = list->MakeIterator();
   TObject* obj = 0;
 
@@ -869,6 +872,7 @@ Long64_t AliPerformanceEff::Merge(TCollection* const list)
   {
     AliPerformanceEff* entry = dynamic_cast<AliPerformanceEff*>(obj);
     if (entry == 0) continue; 
+    entry->FlushFillBuffers();
   
      fEffHisto->Add(entry->fEffHisto);
      fEffSecHisto->Add(entry->fEffSecHisto);
@@ -884,6 +888,7 @@ void AliPerformanceEff::Analyse()
   // Analyse comparison information and store output histograms
   // in the folder "folderEff" 
   //
+  FlushFillBuffers();
   TH1::AddDirectory(kFALSE);
   TObjArray *aFolderObj = new TObjArray;
   if(!aFolderObj) return;
@@ -0,0 +1,254 @@
+/**************************************************************************
+* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+//------------------------------------------------------------------------------
+// Implementation of AliPerformanceFillBuffer class. It collects the points
+// to be filled in the THnSparse histograms of the AliPerformance* objects
+// and bins them in bulk:
+//  - bin coordinates are computed with precomputed axis transforms,
+//  - points are sorted by bin and each occupied bin is looked up only once,
+//  - optionally the points are filled in a dense THnF (if the number of bins
+//    fits in the memory budget) which is added to the target in Finish().
+//
+// The statistics of the target are the ones THnBase::Fill() would give. For
+// histograms with errors THnBase::Fill() also sums the coordinates of the
+// points, which is only possible through Fill(): these histograms are filled
+// point by point when the buffer is flushed, without the dense backend.
+//
+// The target histogram is complete only after Finish() is called.
+//------------------------------------------------------------------------------
+
+#include "TAxis.h"
+#include "TMath.h"
+#include "THnSparse.h"
+#include "THn.h"
+
+#include "AliLog.h"
+#include "AliPerformanceFillBuffer.h"
+
+ClassImp(AliPerformanceFillBuffer)
+
+//_____________________________________________________________________________
+AliPerformanceFillBuffer::AliPerformanceFillBuffer():
+  TObject(),
+  fHisto(0),
+  fDense(0),
+  fNdim(0),
+  fBufferSize(0),
+  fNPoints(0),
+  fPoints(0),
+  fWeights(0),
+  fCoord(0),
+  fKeys(0),
+  fSortIndex(0),
+  fNbins(0),
+  fXmin(0),
+  fXmax(0),
+  fRange(0),
+  fVariable(0),
+  fStride(0),
+  fUseKeys(kFALSE)
+{
+  // default constructor
+}
+
+//_____________________________________________________________________________
+AliPerformanceFillBuffer::AliPerformanceFillBuffer(THnBase* const histo, Int_t bufferSize, Long64_t denseMemoryBudget):
+  TObject(),
+  fHisto(histo),
+  fDense(0),
+  fNdim(0),
+  fBufferSize(bufferSize),
+  fNPoints(0),
+  fPoints(0),
+  fWeights(0),
+  fCoord(0),
+  fKeys(0),
+  fSortIndex(0),
+  fNbins(0),
+  fXmin(0),
+  fXmax(0),
+  fRange(0),
+  fVariable(0),
+  fStride(0),
+  fUseKeys(kTRUE)
+{
+  // constructor
+  if(!fHisto) return;
+  if(fBufferSize < 1) fBufferSize = 1;
+
+  fNdim = fHisto->GetNdimensions();
+  fPoints = new Double_t[fBufferSize*fNdim];
+  fWeights = new Double_t[fBufferSize];
+  fCoord = new Int_t[fBufferSize*fNdim];
+  fKeys = new Long64_t[fBufferSize];
+  fSortIndex = new Int_t[fBufferSize];
+
+  // axis transforms
+  fNbins = new Int_t[fNdim];
+  fXmin = new Double_t[fNdim];
+  fXmax = new Double_t[fNdim];
+  fRange = new Double_t[fNdim];
+  fVariable = new Bool_t[fNdim];
+  fStride = new Long64_t[fNdim];
+
+  // total number of bins including under- and overflow
+  Double_t nTotBins = 1.;
+  Long64_t stride = 1;
+  for(Int_t i=0; i<fNdim; i++) {
+    TAxis *axis = fHisto->GetAxis(i);
+    fNbins[i] = axis->GetNbins();
+    fXmin[i] = axis->GetXmin();
+    fXmax[i] = axis->GetXmax();
+    fRange[i] = fXmax[i] - fXmin[i];
+    fVariable[i] = (axis->GetXbins()->GetSize() != 0);
+
+    fStride[i] = stride;
+    nTotBins *= (fNbins[i]+2);
+    if(nTotBins > 4e18) fUseKeys = kFALSE;
+    else stride *= (fNbins[i]+2);
+  }
+
+  // dense backend only makes sense for sparse targets without errors
+  if(denseMemoryBudget > 0 && fHisto->InheritsFrom(THnSparse::Class()) && !fHisto->GetCalculateErrors()) {
+    Double_t bytesPerBin = sizeof(Float_t);
+    if(nTotBins*bytesPerBin <= denseMemoryBudget) {
+      fDense = new THnF(Form("%s_dense",fHisto->GetName()),fHisto->GetTitle(),fNdim,fNbins,fXmin,fXmax);
+      for(Int_t i=0; i<fNdim; i++) {
+        if(fVariable[i]) fDense->GetAxis(i)->Set(fNbins[i],fHisto->GetAxis(i)->GetXbins()->GetArray());
+      }
+      AliDebug(AliLog::kInfo, Form("%s: dense fill backend with %.0f bins",fHisto->GetName(),nTotBins));
+    }
+  }
+}
+
+//_____________________________________________________________________________
+AliPerformanceFillBuffer::~AliPerformanceFillBuffer()
+{
+  // destructor, the target histogram is not owned
+  delete fDense;
+  delete [] fPoints;
+  delete [] fWeights;
+  delete [] fCoord;
+  delete [] fKeys;
+  delete [] fSortIndex;
+  delete [] fNbins;
+  delete [] fXmin;
+  delete [] fXmax;
+  delete [] fRange;
+  delete [] fVariable;
+  delete [] fStride;
+}
+
+//_____________________________________________________________________________
+void AliPerformanceFillBuffer::Fill(const Double_t* x, Double_t w)
+{
+  // store point, bin all stored points when the buffer is full
+  if(!fHisto) return;
+
+  Double_t *point = &fPoints[fNPoints*fNdim];
+  for(Int_t i=0; i<fNdim; i++) point[i] = x[i];
+  fWeights[fNPoints] = w;
+  fNPoints++;
+
+  if(fNPoints == fBufferSize) Flush();
+}
+
+//_____________________________________________________________________________
+Int_t AliPerformanceFillBuffer::FindBin(Int_t dim, Double_t x) const
+{
+  // same as TAxis::FindFixBin() with precomputed axis parameters
+  if(fVariable[dim]) return fHisto->GetAxis(dim)->FindFixBin(x);
+  if(x < fXmin[dim]) return 0;
+  if(!(x < fXmax[dim])) return fNbins[dim]+1;
+  return 1 + Int_t(fNbins[dim]*(x-fXmin[dim])/fRange[dim]);
+}
+
+//_____________________________________________________________________________
+void AliPerformanceFillBuffer::Flush()
+{
+  // bin all stored points
+  if(!fHisto || fNPoints == 0) return;
+
+  if(fDense) BinPoints(fDense);
+  else BinPoints(fHisto);
+
+  fNPoints = 0;
+}
+
+//_____________________________________________________________________________
+void AliPerformanceFillBuffer::BinPoints(THnBase* const histo)
+{
+  // compute bin coordinates of all points and fill them in histo
+  if(histo->GetCalculateErrors()) {
+    // THnBase::Fill() also sums w*x and w*x*x of each axis
+    for(Int_t ip=0; ip<fNPoints; ip++) histo->Fill(&fPoints[ip*fNdim],fWeights[ip]);
+    return;
+  }
+
+  for(Int_t ip=0; ip<fNPoints; ip++) {
+    const Double_t *point = &fPoints[ip*fNdim];
+    Int_t *coord = &fCoord[ip*fNdim];
+    for(Int_t i=0; i<fNdim; i++) coord[i] = FindBin(i,point[i]);
+  }
+
+  // dense histogram, bin index is plain arithmetic
+  if(histo == fDense || !fUseKeys) {
+    for(Int_t ip=0; ip<fNPoints; ip++) {
+      histo->FillBin(histo->GetBin(&fCoord[ip*fNdim],kTRUE),fWeights[ip]);
+    }
+    return;
+  }
+
+  // sparse histogram, look up each occupied bin only once
+  for(Int_t ip=0; ip<fNPoints; ip++) {
+    const Int_t *coord = &fCoord[ip*fNdim];
+    fKeys[ip] = 0;
+    for(Int_t i=0; i<fNdim; i++) fKeys[ip] += coord[i]*fStride[i];
+  }
+  TMath::Sort(fNPoints,fKeys,fSortIndex,kFALSE);
+
+  Long64_t lastKey = -1;
+  Long64_t bin = -1;
+  for(Int_t i=0; i<fNPoints; i++) {
+    Int_t ip = fSortIndex[i];
+    if(fKeys[ip] != lastKey) {
+      bin = histo->GetBin(&fCoord[ip*fNdim],kTRUE);
+      lastKey = fKeys[ip];
+    }
+    histo->FillBin(bin,fWeights[ip]);
+  }
+}
+
+//_____________________________________________________________________________
+void AliPerformanceFillBuffer::Finish()
+{
+  // bin all stored points and add the dense histogram to the target,
+  // only non-empty bins are created in the target
+  Flush();
+  if(!fDense || fDense->GetEntries() == 0) return;
+
+  // without errors THnBase::Fill() only counts the entries
+  Double_t entries = fHisto->GetEntries() + fDense->GetEntries();
+  Int_t *coord = fCoord;
+  Long64_t nbins = fDense->GetNbins();
+  for(Long64_t ibin=0; ibin<nbins; ibin++) {
+    Double_t content = fDense->GetBinContent(ibin,coord);
+    if(content == 0.) continue;
+    fHisto->AddBinContent(fHisto->GetBin(coord,kTRUE),content);
+  }
+  fHisto->SetEntries(entries);
+  fDense->Reset();
+}
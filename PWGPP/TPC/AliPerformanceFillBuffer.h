@@ -0,0 +1,65 @@
+#ifndef ALIPERFORMANCEFILLBUFFER_H
+#define ALIPERFORMANCEFILLBUFFER_H
+
+//------------------------------------------------------------------------------
+// Fill buffer for the multi-dimensional histograms of the AliPerformance*
+// objects. N-dimensional points are collected and binned in bulk with
+// precomputed axis transforms; points falling into the same bin are resolved
+// with a single THnSparse bin lookup. Optionally the points are accumulated
+// in a dense THnF, if the total number of bins fits in a given memory budget,
+// and transferred to the target histogram in Finish().
+//------------------------------------------------------------------------------
+
+#include "TObject.h"
+
+class THnBase;
+class THnF;
+
+class AliPerformanceFillBuffer : public TObject {
+public :
+  AliPerformanceFillBuffer();
+  AliPerformanceFillBuffer(THnBase* const histo, Int_t bufferSize=1000, Long64_t denseMemoryBudget=0);
+  virtual ~AliPerformanceFillBuffer();
+
+  // store a point, bin the buffer if it is full
+  void Fill(const Double_t* x, Double_t w=1.);
+
+  // bin all stored points
+  void Flush();
+
+  // bin all stored points and move the dense histogram content to the target
+  void Finish();
+
+  THnBase* GetHisto() const { return fHisto; }
+  Bool_t IsDense() const { return fDense != 0; }
+
+private:
+
+  void BinPoints(THnBase* const histo);
+  Int_t FindBin(Int_t dim, Double_t x) const;
+
+  THnBase*  fHisto;        //! target histogram (not owned)
+  THnF*     fDense;        //! dense histogram with the same binning (owned)
+  Int_t     fNdim;         //! number of dimensions
+  Int_t     fBufferSize;   //! max number of stored points
+  Int_t     fNPoints;      //! number of stored points
+  Double_t* fPoints;       //! stored coordinates
+  Double_t* fWeights;      //! stored weights
+  Int_t*    fCoord;        //! bin coordinates of the stored points
+  Long64_t* fKeys;         //! linearized bin index of the stored points
+  Int_t*    fSortIndex;    //! sorting index of the stored points
+  Int_t*    fNbins;        //! number of bins per axis
+  Double_t* fXmin;         //! lower axis limit
+  Double_t* fXmax;         //! upper axis limit
+  Double_t* fRange;        //! axis range (fixed bin axes)
+  Bool_t*   fVariable;     //! axis with variable bins
+  Long64_t* fStride;       //! stride of the linearized bin index
+  Bool_t    fUseKeys;      //! linearized bin index fits in 64 bits
+
+  AliPerformanceFillBuffer(const AliPerformanceFillBuffer&); // not implemented
+  AliPerformanceFillBuffer& operator=(const AliPerformanceFillBuffer&); // not implemented
+
+  ClassDef(AliPerformanceFillBuffer,1);
+};
+
+#endif
@@ -31,10 +31,12 @@
 #include "TPostScript.h"
 #include "TList.h"
 #include "TMath.h"
+#include "TObjArray.h"
 
 #include "AliLog.h" 
 #include "AliESDVertex.h" 
 #include "AliPerformanceObject.h" 
+#include "AliPerformanceFillBuffer.h" 
 
 using namespace std;
 
@@ -52,7 +54,10 @@ AliPerformanceObject::AliPerformanceObject():
   fHighMultiplicity(kFALSE),
   fUseKinkDaughters(kTRUE),
   fUseCentralityBin(0),
-  fUseTOFBunchCrossing(kTRUE)
+  fUseTOFBunchCrossing(kTRUE),
+  fFillBufferSize(0),
+  fDenseFillMemoryBudget(0),
+  fFillBuffers(0)
 {
   // constructor
 }
@@ -69,7 +74,10 @@ AliPerformanceObject::AliPerformanceObject(const char* name, const char* title,
   fHighMultiplicity(highMult),
   fUseKinkDaughters(kTRUE),
   fUseCentralityBin(0),
-  fUseTOFBunchCrossing(kTRUE)
+  fUseTOFBunchCrossing(kTRUE),
+  fFillBufferSize(0),
+  fDenseFillMemoryBudget(0),
+  fFillBuffers(0)
 {
   // constructor
 }
@@ -77,6 +85,42 @@ AliPerformanceObject::AliPerformanceObject(const char* name, const char* title,
 //_____________________________________________________________________________
 AliPerformanceObject::~AliPerformanceObject(){
   // destructor 
+  if(fFillBuffers) delete fFillBuffers; fFillBuffers=0;
+}
+
+//_____________________________________________________________________________
+void AliPerformanceObject::FillHisto(THnBase* const histo, const Double_t* x, Double_t w) {
+  // fill histogram through its fill buffer
+  // points are binned when the buffer is full or in FlushFillBuffers()
+  if(!histo) return;
+  if(fFillBufferSize <= 0) { histo->Fill(x,w); return; }
+
+  if(!fFillBuffers) {
+    fFillBuffers = new TObjArray;
+    fFillBuffers->SetOwner(kTRUE);
+  }
+
+  AliPerformanceFillBuffer *buffer = 0;
+  for(Int_t i=0; i<fFillBuffers->GetEntriesFast(); i++) {
+    AliPerformanceFillBuffer *b = (AliPerformanceFillBuffer*)fFillBuffers->UncheckedAt(i);
+    if(b->GetHisto() == histo) { buffer = b; break; }
+  }
+  if(!buffer) {
+    buffer = new AliPerformanceFillBuffer(histo,fFillBufferSize,fDenseFillMemoryBudget);
+    fFillBuffers->Add(buffer);
+  }
+
+  buffer->Fill(x,w);
+}
+
+//_____________________________________________________________________________
+void AliPerformanceObject::FlushFillBuffers() {
+  // bin all buffered points into the histograms
+  if(!fFillBuffers) return;
+  for(Int_t i=0; i<fFillBuffers->GetEntriesFast(); i++) {
+    AliPerformanceFillBuffer *buffer = (AliPerformanceFillBuffer*)fFillBuffers->UncheckedAt(i);
+    buffer->Finish();
+  }
 }
 
 //_____________________________________________________________________________
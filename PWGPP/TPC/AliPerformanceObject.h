@@ -14,6 +14,8 @@
 #include "THnSparse.h"
 
 class TTree;
+class TObjArray;
+class THnBase;
 class AliMCEvent;
 class AliESDEvent;
 class AliRecInfoCuts;
@@ -105,8 +107,25 @@ public :
   void SetUseTOFBunchCrossing(Bool_t tofBunching = kTRUE) { fUseTOFBunchCrossing = tofBunching; }
   Bool_t IsUseTOFBunchCrossing() { return fUseTOFBunchCrossing; }
 
+  // buffered filling of THnSparse (0 - fill directly, default)
+  // with buffering the histograms are complete only after FlushFillBuffers(),
+  // which Analyse(), Merge() and AliPerformanceTask::FinishTaskOutput() call
+  void SetFillBufferSize(Int_t size) { fFillBufferSize = size; }
+  Int_t GetFillBufferSize() const { return fFillBufferSize; }
+
+  // memory budget (bytes) to fill in a dense THnF instead of the THnSparse (0 - off)
+  void SetDenseFillMemoryBudget(Long64_t budget) { fDenseFillMemoryBudget = budget; }
+  Long64_t GetDenseFillMemoryBudget() const { return fDenseFillMemoryBudget; }
+
+  // bin all buffered points into the histograms
+  // has to be called before the histograms are used
+  void FlushFillBuffers();
+
 protected: 
 
+  // fill histogram through the fill buffer
+  void FillHisto(THnBase* const histo, const Double_t* x, Double_t w=1.);
+
   void AddProjection(TObjArray* aFolderObj, TString nameSparse, THnSparse *hSparse, Int_t xDim, TString* selString = 0);
   void AddProjection(TObjArray* aFolderObj, TString nameSparse, THnSparse *hSparse, Int_t xDim, Int_t yDim, TString* selString = 0);
   void AddProjection(TObjArray* aFolderObj, TString nameSparse, THnSparse *hSparse, Int_t xDim, Int_t yDim, Int_t zDim, TString* selString = 0);
@@ -137,10 +156,15 @@ protected:
 
   Bool_t fUseTOFBunchCrossing; // use TOFBunchCrossing, default is yes
 
+  Int_t fFillBufferSize; // number of points buffered per histogram before binning
+  Long64_t fDenseFillMemoryBudget; // max memory (bytes) of dense histogram used for filling
+
+  TObjArray* fFillBuffers; //! fill buffers, one per filled histogram
+
   AliPerformanceObject(const AliPerformanceObject&); // not implemented
   AliPerformanceObject& operator=(const AliPerformanceObject&); // not implemented
 
-  ClassDef(AliPerformanceObject,7);
+  ClassDef(AliPerformanceObject,8);
 };
 
 #endif
@@ -23,6 +23,7 @@
 //  Author: Jan.Fiete.Grosse-Oetringhaus@cern.ch
 
 #include "AliMultiplicityCorrection.h"
+#include "AliMultiplicityUnfolder.h"
 
 #include <TFile.h>
 #include <TH1F.h>
@@ -887,17 +888,80 @@ Int_t AliMultiplicityCorrection::ApplyMinuitFit(Int_t inputRange, Bool_t fullPha
   }
   
   // correct for the trigger bias if requested
-  if (eventType > kMB)
+  CorrectTriggerBias(fMultiplicityESDCorrected[correlationID], inputRange, eventType);
+  
+  return resultCode;
+}
+
+//____________________________________________________________________
+void AliMultiplicityCorrection::CorrectTriggerBias(TH1* hist, Int_t inputRange, EventType eventType)
+{
+  //
+  // corrects the unfolded spectrum for the trigger bias for event types beyond kMB
+  //
+
+  if (eventType <= kMB)
+    return;
+
+  Printf("Applying trigger efficiency");
+  TH1* eff = GetTriggerEfficiency(inputRange, eventType);
+  for (Int_t i=1; i<=hist->GetNbinsX(); i++)
   {
-    Printf("Applying trigger efficiency");
-    TH1* eff = GetTriggerEfficiency(inputRange, eventType);
-    for (Int_t i=1; i<=fMultiplicityESDCorrected[correlationID]->GetNbinsX(); i++)
-    {
-      fMultiplicityESDCorrected[correlationID]->SetBinContent(i, fMultiplicityESDCorrected[correlationID]->GetBinContent(i) / eff->GetBinContent(i));
-      fMultiplicityESDCorrected[correlationID]->SetBinError(i, fMultiplicityESDCorrected[correlationID]->GetBinError(i) / eff->GetBinContent(i));
-    }
+    hist->SetBinContent(i, hist->GetBinContent(i) / eff->GetBinContent(i));
+    hist->SetBinError(i, hist->GetBinError(i) / eff->GetBinContent(i));
   }
-  
+}
+
+//____________________________________________________________________
+Int_t AliMultiplicityCorrection::ApplyUnfolder(Int_t inputRange, Bool_t fullPhaseSpace, EventType eventType, AliMultiplicityUnfolder* unfolder, TH1* initialConditions)
+{
+  //
+  // correct spectrum with the given unfolding engine (chi2 minimization or bayesian, see AliMultiplicityUnfolder)
+  // the vertex efficiency is corrected by the engine, the trigger bias afterwards
+  //
+  // returns 0 on success
+  //
+
+  Int_t correlationID = inputRange + ((fullPhaseSpace == kFALSE) ? 0 : 4);
+
+  SetupCurrentHists(inputRange, fullPhaseSpace, (eventType == kTrVtx) ? kTrVtx : kMB);
+
+  if (!unfolder->SetInput(fCurrentCorrelation, fCurrentEfficiency, fCurrentESD))
+    return -1;
+
+  Int_t resultCode = unfolder->Unfold(fMultiplicityESDCorrected[correlationID], initialConditions);
+
+  CorrectTriggerBias(fMultiplicityESDCorrected[correlationID], inputRange, eventType);
+
+  return resultCode;
+}
+
+//____________________________________________________________________
+Int_t AliMultiplicityCorrection::ApplyUnfolderScan(Int_t inputRange, Bool_t fullPhaseSpace, EventType eventType, AliMultiplicityUnfolder* unfolder, Int_t nSettings, const Double_t* settings, TH1** results, TH1* initialConditions)
+{
+  //
+  // correct spectrum with the given unfolding engine for nSettings regularization (chi2) or smoothing (bayesian) weights
+  // the response is set up once, the settings are unfolded concurrently if the engine uses several threads
+  // results[i] are created as clones of the corrected histogram and owned by the caller
+  //
+  // returns the number of unfoldings that did not converge, -1 on error
+  //
+
+  Int_t correlationID = inputRange + ((fullPhaseSpace == kFALSE) ? 0 : 4);
+
+  SetupCurrentHists(inputRange, fullPhaseSpace, (eventType == kTrVtx) ? kTrVtx : kMB);
+
+  if (!unfolder->SetInput(fCurrentCorrelation, fCurrentEfficiency, fCurrentESD))
+    return -1;
+
+  for (Int_t i=0; i<nSettings; i++)
+    results[i] = static_cast<TH1*> (fMultiplicityESDCorrected[correlationID]->Clone(Form("%s_setting%d", fMultiplicityESDCorrected[correlationID]->GetName(), i)));
+
+  Int_t resultCode = unfolder->UnfoldScan(nSettings, settings, results, initialConditions);
+
+  for (Int_t i=0; i<nSettings; i++)
+    CorrectTriggerBias(results[i], inputRange, eventType);
+
   return resultCode;
 }
 
@@ -18,6 +18,7 @@ class TH2F;
 class TH3F;
 class TF1;
 class TCollection;
+class AliMultiplicityUnfolder;
 
 // defined here, because it does not seem possible to predeclare these (or i do not know how)
 // -->
@@ -59,6 +60,9 @@ class AliMultiplicityCorrection : public TNamed {
 
     Int_t ApplyMinuitFit(Int_t inputRange, Bool_t fullPhaseSpace, EventType eventType, Int_t zeroBinEvents, Bool_t check = kFALSE, TH1* initialConditions = 0, Bool_t errorAsBias = kFALSE);
 
+    Int_t ApplyUnfolder(Int_t inputRange, Bool_t fullPhaseSpace, EventType eventType, AliMultiplicityUnfolder* unfolder, TH1* initialConditions = 0);
+    Int_t ApplyUnfolderScan(Int_t inputRange, Bool_t fullPhaseSpace, EventType eventType, AliMultiplicityUnfolder* unfolder, Int_t nSettings, const Double_t* settings, TH1** results, TH1* initialConditions = 0);
+
     void ApplyBayesianMethod(Int_t inputRange, Bool_t fullPhaseSpace, EventType eventType, Float_t regPar = 1, Int_t nIterations = 100, TH1* initialConditions = 0, Int_t determineError = 1);
 
     static TH1* CalculateStdDev(TH1** results, Int_t max);
@@ -119,6 +123,7 @@ class AliMultiplicityCorrection : public TNamed {
 
   protected:
     void SetupCurrentHists(Int_t inputRange, Bool_t fullPhaseSpace, EventType eventType);
+    void CorrectTriggerBias(TH1* hist, Int_t inputRange, EventType eventType);
 
     Float_t BayesCovarianceDerivate(Float_t matrixM[251][251], const TH2* hResponse, Int_t k, Int_t i, Int_t r, Int_t u);
     
@@ -0,0 +1,625 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+/* $Id$ */
+
+// Unfolding engine for multiplicity distributions
+//
+// The response (correlation map, x = generated, y = measured) is normalized to 1 for
+// each generated bin and stored row-wise (one row per measured bin) in compressed
+// sparse form. Folding is one pass over the rows, the gradient of the chi2 is the
+// transposed product accumulated in the same pass.
+//
+// chi2 minimization: the unfolded spectrum is x_j = p_j^2 (positivity), the
+//   function minimized is chi2(measured, R x) + weight * regularization(x) with
+//   kPol0    sum (1 - x_{j-1} / x_j)^2                 (relative first differences)
+//   kPol1    sum ((x_j - 2 x_{j-1} + x_{j-2}) / x_{j-1})^2 (relative second differences)
+//   kEntropy sum q_j ln q_j + ln n, q_j = x_j / sum x  (negative entropy)
+//   The analytic gradient is given to the minimizer.
+// bayesian: iterative unfolding, the result of each iteration (optionally smoothed
+//   over 3 bins) is the prior of the next one.
+//
+// The result is scaled to the integral of the measured spectrum and corrected for
+// the efficiency. UnfoldScan unfolds a batch of regularization weights (chi2) or
+// smoothing weights (bayesian), concurrently if SetNumberOfThreads(n > 1) is used
+// with a thread-safe minimizer (Minuit2, the default).
+
+#include "AliMultiplicityUnfolder.h"
+
+#include <RConfigure.h>
+#include <RVersion.h>
+#include <TH1.h>
+#include <TH2.h>
+#include <TMath.h>
+#include <Math/Factory.h>
+#include <Math/IFunction.h>
+#include <Math/Minimizer.h>
+#if defined(R__USE_IMT) && ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0)
+#include <ROOT/TSeq.hxx>
+#include <ROOT/TThreadExecutor.hxx>
+#endif
+#include <AliLog.h>
+
+#include <cstdio>
+
+ClassImp(AliMultiplicityUnfolder)
+
+namespace {
+  // chi2 of AliMultiplicityUnfolder with its analytic gradient, as seen by the minimizer
+  class AliMultiplicityUnfolderChi2 : public ROOT::Math::IGradientFunctionMultiDim {
+    public:
+      AliMultiplicityUnfolderChi2(const AliMultiplicityUnfolder* unfolder, AliMultiplicityUnfolder::RegularizationType type, Double_t weight) :
+        fUnfolder(unfolder), fType(type), fWeight(weight) {}
+
+      ROOT::Math::IBaseFunctionMultiDim* Clone() const { return new AliMultiplicityUnfolderChi2(fUnfolder, fType, fWeight); }
+      unsigned int NDim() const { return fUnfolder->GetNGenerated(); }
+      void Gradient(const double* x, double* grad) const { fUnfolder->Chi2(x, grad, fType, fWeight); }
+      void FdF(const double* x, double& f, double* grad) const { f = fUnfolder->Chi2(x, grad, fType, fWeight); }
+
+    private:
+      double DoEval(const double* x) const { return fUnfolder->Chi2(x, 0, fType, fWeight); }
+      double DoDerivative(const double* x, unsigned int icoord) const
+      {
+        std::vector<Double_t> grad(NDim());
+        fUnfolder->Chi2(x, &grad[0], fType, fWeight);
+        return grad[icoord];
+      }
+
+      const AliMultiplicityUnfolder* fUnfolder;          // unfolder providing response and measurement
+      AliMultiplicityUnfolder::RegularizationType fType; // regularization
+      Double_t fWeight;                                  // weight of the regularization
+  };
+}
+
+//____________________________________________________________________
+AliMultiplicityUnfolder::AliMultiplicityUnfolder() :
+  TObject(),
+  fMethod(kChi2Minimization),
+  fMaxMeasured(0),
+  fMaxGenerated(0),
+  fRegularization(kPol1),
+  fRegularizationWeight(1),
+  fSkipBinsBegin(0),
+  fMinimumInitialValue(0.1),
+  fMinimizerType("Minuit2"),
+  fMinimizerAlgo("Migrad"),
+  fMaxFunctionCalls(1000000),
+  fBayesianSmoothing(0),
+  fBayesianIterations(100),
+  fNThreads(1),
+  fNMeasured(0),
+  fNGenerated(0),
+  fIntegral(0),
+  fRowFirst(),
+  fColumn(),
+  fValue(),
+  fMeasured(),
+  fWeight(),
+  fEfficiency()
+{
+  //
+  // default constructor
+  //
+}
+
+//____________________________________________________________________
+Bool_t AliMultiplicityUnfolder::SetInput(const TH2* correlation, const TH1* efficiency, const TH1* measured)
+{
+  //
+  // sets up the response matrix, measured spectrum and efficiency
+  // correlation: x = generated, y = measured
+  // efficiency may be 0 (no correction)
+  //
+
+  fNMeasured = 0;
+  fNGenerated = 0;
+
+  if (!correlation || !measured)
+  {
+    AliError("Correlation map and measured spectrum needed");
+    return kFALSE;
+  }
+
+  Int_t nMeasured = correlation->GetNbinsY();
+  Int_t nGenerated = correlation->GetNbinsX();
+  if (fMaxMeasured > 0)
+    nMeasured = TMath::Min(nMeasured, fMaxMeasured);
+  nMeasured = TMath::Min(nMeasured, measured->GetNbinsX());
+  if (fMaxGenerated > 0)
+    nGenerated = TMath::Min(nGenerated, fMaxGenerated);
+
+  // normalization of the generated bins over the full measured axis
+  std::vector<Double_t> columnSum(nGenerated, 0.);
+  for (Int_t j=0; j<nGenerated; ++j)
+    for (Int_t i=1; i<=correlation->GetNbinsY(); ++i)
+      columnSum[j] += correlation->GetBinContent(j+1, i);
+
+  fRowFirst.assign(nMeasured+1, 0);
+  fColumn.clear();
+  fValue.clear();
+  for (Int_t i=0; i<nMeasured; ++i)
+  {
+    for (Int_t j=0; j<nGenerated; ++j)
+    {
+      Double_t content = correlation->GetBinContent(j+1, i+1);
+      if (content <= 0 || columnSum[j] <= 0)
+        continue;
+      fColumn.push_back(j);
+      fValue.push_back(content / columnSum[j]);
+    }
+    fRowFirst[i+1] = fColumn.size();
+  }
+
+  fIntegral = 0;
+  for (Int_t i=1; i<=nMeasured; ++i)
+    fIntegral += measured->GetBinContent(i);
+
+  if (fIntegral <= 0 || fValue.size() == 0)
+  {
+    AliError("Empty measured spectrum or response");
+    return kFALSE;
+  }
+
+  fMeasured.resize(nMeasured);
+  fWeight.resize(nMeasured);
+  for (Int_t i=0; i<nMeasured; ++i)
+  {
+    fMeasured[i] = measured->GetBinContent(i+1) / fIntegral;
+    // empty bins get the error of one entry
+    Double_t error = measured->GetBinError(i+1) / fIntegral;
+    if (error <= 0)
+      error = 1. / fIntegral;
+    fWeight[i] = 1. / (error * error);
+  }
+
+  fEfficiency.assign(nGenerated, 1.);
+  if (efficiency)
+    for (Int_t j=0; j<nGenerated; ++j)
+      fEfficiency[j] = efficiency->GetBinContent(j+1);
+
+  fNMeasured = nMeasured;
+  fNGenerated = nGenerated;
+
+  Printf("AliMultiplicityUnfolder::SetInput: %d measured bins, %d generated bins, %d response entries", fNMeasured, fNGenerated, (Int_t) fValue.size());
+
+  return kTRUE;
+}
+
+//____________________________________________________________________
+void AliMultiplicityUnfolder::Fold(const Double_t* unfolded, Double_t* folded) const
+{
+  //
+  // folds the generated spectrum unfolded with the response
+  //
+
+  for (Int_t i=0; i<fNMeasured; ++i)
+  {
+    Double_t sum = 0;
+    for (Int_t k=fRowFirst[i]; k<fRowFirst[i+1]; ++k)
+      sum += fValue[k] * unfolded[fColumn[k]];
+    folded[i] = sum;
+  }
+}
+
+//____________________________________________________________________
+Double_t AliMultiplicityUnfolder::Chi2(const Double_t* params, Double_t* gradient, RegularizationType type, Double_t weight) const
+{
+  //
+  // chi2 plus weighted regularization for the parameters params (unfolded spectrum = params^2)
+  // fills the gradient with respect to params if gradient is not 0
+  //
+
+  const Int_t n = fNGenerated;
+
+  std::vector<Double_t> x(n);
+  for (Int_t j=0; j<n; ++j)
+    x[j] = params[j] * params[j];
+
+  std::vector<Double_t> gradX;
+  if (gradient)
+    gradX.assign(n, 0.);
+
+  Double_t chi2 = 0;
+  for (Int_t i=0; i<fNMeasured; ++i)
+  {
+    Double_t folded = 0;
+    for (Int_t k=fRowFirst[i]; k<fRowFirst[i+1]; ++k)
+      folded += fValue[k] * x[fColumn[k]];
+
+    Double_t diff = folded - fMeasured[i];
+    chi2 += diff * diff * fWeight[i];
+
+    if (gradient)
+    {
+      Double_t residual = 2 * diff * fWeight[i];
+      for (Int_t k=fRowFirst[i]; k<fRowFirst[i+1]; ++k)
+        gradX[fColumn[k]] += residual * fValue[k];
+    }
+  }
+
+  if (type != kNone && weight != 0)
+  {
+    std::vector<Double_t> gradReg;
+    if (gradient)
+      gradReg.assign(n, 0.);
+
+    chi2 += weight * Regularization(&x[0], (gradient) ? &gradReg[0] : 0, type);
+
+    if (gradient)
+      for (Int_t j=0; j<n; ++j)
+        gradX[j] += weight * gradReg[j];
+  }
+
+  if (gradient)
+    for (Int_t j=0; j<n; ++j)
+      gradient[j] = 2 * params[j] * gradX[j];
+
+  return chi2;
+}
+
+//____________________________________________________________________
+Double_t AliMultiplicityUnfolder::Regularization(const Double_t* x, Double_t* gradient, RegularizationType type) const
+{
+  //
+  // regularization term for the unfolded spectrum x
+  // adds its gradient with respect to x to gradient if not 0
+  //
+
+  const Int_t n = fNGenerated;
+  Double_t reg = 0;
+
+  switch (type)
+  {
+    case kNone:
+      break;
+
+    case kPol0:
+      for (Int_t j=1+fSkipBinsBegin; j<n; ++j)
+      {
+        if (x[j] <= 0)
+          continue;
+        Double_t diff = 1 - x[j-1] / x[j];
+        reg += diff * diff;
+        if (gradient)
+        {
+          gradient[j-1] -= 2 * diff / x[j];
+          gradient[j] += 2 * diff * x[j-1] / (x[j] * x[j]);
+        }
+      }
+      break;
+
+    case kPol1:
+      for (Int_t j=2+fSkipBinsBegin; j<n; ++j)
+      {
+        Double_t middle = x[j-1];
+        if (middle <= 0)
+          continue;
+        Double_t outer = x[j] + x[j-2];
+        Double_t diff = outer / middle - 2;
+        reg += diff * diff;
+        if (gradient)
+        {
+          gradient[j] += 2 * diff / middle;
+          gradient[j-2] += 2 * diff / middle;
+          gradient[j-1] -= 2 * diff * outer / (middle * middle);
+        }
+      }
+      break;
+
+    case kEntropy:
+    {
+      Double_t total = 0;
+      for (Int_t j=fSkipBinsBegin; j<n; ++j)
+        total += x[j];
+      if (total <= 0 || n - fSkipBinsBegin <= 0)
+        break;
+
+      // empty bins are kept at a finite slope
+      const Double_t minQ = 1e-12;
+      Double_t sum = 0;
+      for (Int_t j=fSkipBinsBegin; j<n; ++j)
+      {
+        Double_t q = x[j] / total;
+        if (q > 0)
+          sum += q * TMath::Log(q);
+      }
+      reg = sum + TMath::Log((Double_t) (n - fSkipBinsBegin));
+
+      if (gradient)
+        for (Int_t j=fSkipBinsBegin; j<n; ++j)
+          gradient[j] += (TMath::Log(TMath::Max(x[j] / total, minQ)) - sum) / total;
+      break;
+    }
+  }
+
+  return reg;
+}
+
+//____________________________________________________________________
+ROOT::Math::Minimizer* AliMultiplicityUnfolder::CreateMinimizer() const
+{
+  //
+  // creates and configures the minimizer for the chi2 minimization
+  //
+
+  ROOT::Math::Minimizer* minimizer = ROOT::Math::Factory::CreateMinimizer(fMinimizerType.Data(), fMinimizerAlgo.Data());
+  if (!minimizer)
+  {
+    AliError(Form("Could not create minimizer %s/%s", fMinimizerType.Data(), fMinimizerAlgo.Data()));
+    return 0;
+  }
+
+  minimizer->SetMaxFunctionCalls(fMaxFunctionCalls);
+  minimizer->SetMaxIterations(fMaxFunctionCalls);
+  minimizer->SetPrintLevel(0);
+
+  return minimizer;
+}
+
+//____________________________________________________________________
+void AliMultiplicityUnfolder::GetInitialValues(const TH1* initialConditions, std::vector<Double_t>& start) const
+{
+  //
+  // initial unfolded spectrum, normalized to 1: initialConditions if given, otherwise the measured spectrum
+  // no bin is below fMinimumInitialValue times the flat distribution
+  //
+
+  const Int_t n = fNGenerated;
+  start.assign(n, 0.);
+
+  if (initialConditions)
+  {
+    for (Int_t j=0; j<n; ++j)
+      start[j] = TMath::Max(initialConditions->GetBinContent(j+1), 0.);
+  }
+  else
+  {
+    for (Int_t j=0; j<n && j<fNMeasured; ++j)
+      start[j] = fMeasured[j];
+  }
+
+  Double_t floor = ((fMinimumInitialValue > 0) ? fMinimumInitialValue : 1e-6) / n;
+  for (Int_t pass=0; pass<2; ++pass)
+  {
+    Double_t sum = 0;
+    for (Int_t j=0; j<n; ++j)
+      sum += start[j];
+    for (Int_t j=0; j<n; ++j)
+    {
+      start[j] = (sum > 0) ? start[j] / sum : 1. / n;
+      if (pass == 0)
+        start[j] = TMath::Max(start[j], floor);
+    }
+  }
+}
+
+//____________________________________________________________________
+Int_t AliMultiplicityUnfolder::DoChi2(ROOT::Math::Minimizer* minimizer, Double_t weight, const std::vector<Double_t>& start, std::vector<Double_t>& value, std::vector<Double_t>& error) const
+{
+  //
+  // chi2 minimization with the given regularization weight
+  // returns the status of the minimizer (0 = converged)
+  //
+
+  const Int_t n = fNGenerated;
+
+  AliMultiplicityUnfolderChi2 function(this, fRegularization, weight);
+  minimizer->Clear();
+  minimizer->SetFunction(function);
+
+  char name[16];
+  for (Int_t j=0; j<n; ++j)
+  {
+    Double_t param = TMath::Sqrt(start[j]);
+    snprintf(name, sizeof(name), "p%d", j);
+    minimizer->SetVariable(j, name, param, 0.1 * param + 1e-4);
+  }
+
+  minimizer->Minimize();
+
+  const Double_t* params = minimizer->X();
+  const Double_t* errors = minimizer->Errors();
+
+  value.resize(n);
+  error.assign(n, 0.);
+  for (Int_t j=0; j<n; ++j)
+  {
+    value[j] = params[j] * params[j];
+    if (errors)
+      error[j] = 2 * TMath::Abs(params[j]) * errors[j];
+  }
+
+  return minimizer->Status();
+}
+
+//____________________________________________________________________
+Int_t AliMultiplicityUnfolder::DoBayesian(Double_t smoothing, const std::vector<Double_t>& start, std::vector<Double_t>& value) const
+{
+  //
+  // iterative bayesian unfolding, smoothing is the weight of the 3-bin average in the next prior
+  //
+
+  const Int_t n = fNGenerated;
+
+  // probability of the generated bins to be measured within the used measured bins
+  std::vector<Double_t> measurable(n, 0.);
+  for (UInt_t k=0; k<fValue.size(); ++k)
+    measurable[fColumn[k]] += fValue[k];
+
+  std::vector<Double_t> prior(start);
+  std::vector<Double_t> folded(fNMeasured);
+  std::vector<Double_t> result(n);
+
+  for (Int_t iter=0; iter<fBayesianIterations; ++iter)
+  {
+    Fold(&prior[0], &folded[0]);
+
+    result.assign(n, 0.);
+    for (Int_t i=0; i<fNMeasured; ++i)
+    {
+      if (folded[i] <= 0)
+        continue;
+      Double_t ratio = fMeasured[i] / folded[i];
+      for (Int_t k=fRowFirst[i]; k<fRowFirst[i+1]; ++k)
+        result[fColumn[k]] += fValue[k] * ratio;
+    }
+
+    Double_t sum = 0;
+    for (Int_t j=0; j<n; ++j)
+    {
+      result[j] = (measurable[j] > 0) ? prior[j] * result[j] / measurable[j] : 0;
+      sum += result[j];
+    }
+    if (sum <= 0)
+    {
+      AliError("Bayesian unfolding failed: empty result");
+      value.assign(n, 0.);
+      return -1;
+    }
+
+    for (Int_t j=0; j<n; ++j)
+    {
+      Double_t next = result[j];
+      if (smoothing > 0)
+      {
+        Int_t first = TMath::Max(j-1, 0);
+        Int_t last = TMath::Min(j+1, n-1);
+        Double_t average = 0;
+        for (Int_t l=first; l<=last; ++l)
+          average += result[l];
+        average /= (last - first + 1);
+        next = (1 - smoothing) * result[j] + smoothing * average;
+      }
+      prior[j] = next / sum;
+    }
+  }
+
+  value = prior;
+  return 0;
+}
+
+//____________________________________________________________________
+void AliMultiplicityUnfolder::FillResult(TH1* result, const std::vector<Double_t>& value, const std::vector<Double_t>& error) const
+{
+  //
+  // stores the unfolded spectrum in result, scaled to the measured events and corrected for the efficiency
+  //
+
+  result->Reset();
+
+  for (Int_t j=0; j<fNGenerated; ++j)
+  {
+    if (fEfficiency[j] <= 0)
+      continue;
+
+    Double_t scale = fIntegral / fEfficiency[j];
+    result->SetBinContent(j+1, value[j] * scale);
+    result->SetBinError(j+1, (error.size() > 0) ? error[j] * scale : 0);
+  }
+}
+
+//____________________________________________________________________
+Int_t AliMultiplicityUnfolder::Unfold(TH1* result, const TH1* initialConditions) const
+{
+  //
+  // unfolds with the configured method into result
+  // returns 0 on success
+  //
+
+  Double_t setting = (fMethod == kBayesian) ? fBayesianSmoothing : fRegularizationWeight;
+  return UnfoldScan(1, &setting, &result, initialConditions);
+}
+
+//____________________________________________________________________
+Int_t AliMultiplicityUnfolder::UnfoldScan(Int_t nSettings, const Double_t* settings, TH1** results, const TH1* initialConditions) const
+{
+  //
+  // unfolds the same input for nSettings regularization weights (chi2 minimization) or
+  // smoothing weights (bayesian) into results[i]
+  // the settings are processed concurrently with SetNumberOfThreads(n > 1)
+  // returns the number of unfoldings that did not converge, -1 on error
+  //
+
+  if (fNGenerated == 0)
+  {
+    AliError("No input set, call SetInput first");
+    return -1;
+  }
+
+  const Int_t n = fNGenerated;
+  const Bool_t chi2 = (fMethod == kChi2Minimization);
+
+  std::vector<Double_t> start;
+  GetInitialValues(initialConditions, start);
+
+  std::vector<std::vector<Double_t> > values(nSettings, std::vector<Double_t>(n, 0.));
+  std::vector<std::vector<Double_t> > errors(nSettings);
+  std::vector<Int_t> status(nSettings, 0);
+
+  // minimizers are created upfront, the plugin manager is not thread-safe
+  std::vector<ROOT::Math::Minimizer*> minimizers(nSettings, (ROOT::Math::Minimizer*) 0);
+  if (chi2)
+  {
+    for (Int_t s=0; s<nSettings; ++s)
+    {
+      minimizers[s] = CreateMinimizer();
+      if (!minimizers[s])
+      {
+        for (Int_t t=0; t<s; ++t)
+          delete minimizers[t];
+        return -1;
+      }
+    }
+  }
+
+  // TMinuit works on the global gMinuit
+  Int_t nThreads = TMath::Min(fNThreads, nSettings);
+  if (chi2 && fMinimizerType.BeginsWith("Minuit") && fMinimizerType != "Minuit2")
+    nThreads = 1;
+
+  Bool_t done = kFALSE;
+#if defined(R__USE_IMT) && ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0)
+  if (nThreads > 1)
+  {
+    ROOT::TThreadExecutor pool(nThreads);
+    pool.Foreach([&](Int_t s) {
+      status[s] = (chi2) ? DoChi2(minimizers[s], settings[s], start, values[s], errors[s]) : DoBayesian(settings[s], start, values[s]);
+    }, ROOT::TSeqI(nSettings));
+    done = kTRUE;
+  }
+#endif
+  if (!done)
+  {
+    for (Int_t s=0; s<nSettings; ++s)
+      status[s] = (chi2) ? DoChi2(minimizers[s], settings[s], start, values[s], errors[s]) : DoBayesian(settings[s], start, values[s]);
+  }
+
+  Int_t failed = 0;
+  for (Int_t s=0; s<nSettings; ++s)
+  {
+    delete minimizers[s];
+
+    if (status[s] != 0)
+    {
+      AliWarning(Form("Unfolding with setting %f did not converge (status %d)", settings[s], status[s]));
+      ++failed;
+    }
+
+    if (results[s])
+      FillResult(results[s], values[s], errors[s]);
+  }
+
+  return failed;
+}
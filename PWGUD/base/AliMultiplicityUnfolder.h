@@ -0,0 +1,96 @@
+/* $Id$ */
+
+#ifndef ALIMULTIPLICITYUNFOLDER_H
+#define ALIMULTIPLICITYUNFOLDER_H
+
+#include <vector>
+
+#include "TObject.h"
+#include "TString.h"
+
+//
+// unfolding engine for multiplicity distributions
+// the response matrix is stored row-wise in compressed sparse (CSR) form,
+// folding and the analytic gradient of the chi2 are single passes over it
+// implements chi2 minimization with regularization and iterative bayesian unfolding
+// a batch of regularization settings can be unfolded concurrently
+//
+
+class TH1;
+class TH2;
+
+namespace ROOT {
+  namespace Math {
+    class Minimizer;
+  }
+}
+
+class AliMultiplicityUnfolder : public TObject {
+  public:
+    enum MethodType { kChi2Minimization = 0, kBayesian };
+    enum RegularizationType { kNone = 0, kPol0, kPol1, kEntropy };
+
+    AliMultiplicityUnfolder();
+    virtual ~AliMultiplicityUnfolder() {}
+
+    void SetMethod(MethodType method) { fMethod = method; }
+    void SetNbins(Int_t maxMeasured, Int_t maxGenerated) { fMaxMeasured = maxMeasured; fMaxGenerated = maxGenerated; }
+    void SetChi2Regularization(RegularizationType type, Double_t weight) { fRegularization = type; fRegularizationWeight = weight; }
+    void SetSkipBinsBegin(Int_t bins) { fSkipBinsBegin = bins; }
+    void SetMinimumInitialValue(Double_t value) { fMinimumInitialValue = value; }
+    void SetMinimizer(const char* type, const char* algo = "Migrad") { fMinimizerType = type; fMinimizerAlgo = algo; }
+    void SetMaxFunctionCalls(Int_t calls) { fMaxFunctionCalls = calls; }
+    void SetBayesianParameters(Double_t smoothing, Int_t nIterations) { fBayesianSmoothing = smoothing; fBayesianIterations = nIterations; }
+    void SetNumberOfThreads(Int_t threads) { fNThreads = threads; }
+
+    Bool_t SetInput(const TH2* correlation, const TH1* efficiency, const TH1* measured);
+
+    Int_t Unfold(TH1* result, const TH1* initialConditions = 0) const;
+    Int_t UnfoldScan(Int_t nSettings, const Double_t* settings, TH1** results, const TH1* initialConditions = 0) const;
+
+    void Fold(const Double_t* unfolded, Double_t* folded) const;
+    Double_t Chi2(const Double_t* params, Double_t* gradient, RegularizationType type, Double_t weight) const;
+
+    Int_t GetNMeasured() const { return fNMeasured; }
+    Int_t GetNGenerated() const { return fNGenerated; }
+
+  protected:
+    ROOT::Math::Minimizer* CreateMinimizer() const;
+    void GetInitialValues(const TH1* initialConditions, std::vector<Double_t>& start) const;
+    Int_t DoChi2(ROOT::Math::Minimizer* minimizer, Double_t weight, const std::vector<Double_t>& start, std::vector<Double_t>& value, std::vector<Double_t>& error) const;
+    Int_t DoBayesian(Double_t smoothing, const std::vector<Double_t>& start, std::vector<Double_t>& value) const;
+    Double_t Regularization(const Double_t* x, Double_t* gradient, RegularizationType type) const;
+    void FillResult(TH1* result, const std::vector<Double_t>& value, const std::vector<Double_t>& error) const;
+
+    MethodType fMethod;                       // unfolding method
+    Int_t fMaxMeasured;                       // number of measured bins used (0 = all)
+    Int_t fMaxGenerated;                      // number of generated bins unfolded (0 = all)
+    RegularizationType fRegularization;       // regularization of the chi2 minimization
+    Double_t fRegularizationWeight;           // weight of the regularization term
+    Int_t fSkipBinsBegin;                     // first bins not included in the regularization
+    Double_t fMinimumInitialValue;            // minimum initial value, relative to a flat distribution
+    TString fMinimizerType;                   // minimizer for the chi2 minimization, see ROOT::Math::Factory
+    TString fMinimizerAlgo;                   // algorithm of the minimizer
+    Int_t fMaxFunctionCalls;                  // maximum number of function calls of the minimizer
+    Double_t fBayesianSmoothing;              // weight of the 3-bin smoothing of the prior between bayesian iterations
+    Int_t fBayesianIterations;                // number of bayesian iterations
+    Int_t fNThreads;                          // number of threads used by UnfoldScan
+
+    Int_t fNMeasured;                         //! number of measured bins
+    Int_t fNGenerated;                        //! number of generated bins
+    Double_t fIntegral;                       //! integral of the measured spectrum
+    std::vector<Int_t> fRowFirst;             //! first entry of each measured bin in fColumn, fValue
+    std::vector<Int_t> fColumn;               //! generated bin of the response entries
+    std::vector<Double_t> fValue;             //! response entries, normalized to 1 for each generated bin
+    std::vector<Double_t> fMeasured;          //! measured spectrum normalized to 1
+    std::vector<Double_t> fWeight;            //! inverse variance of fMeasured
+    std::vector<Double_t> fEfficiency;        //! efficiency of the generated bins
+
+ private:
+    AliMultiplicityUnfolder(const AliMultiplicityUnfolder&);
+    AliMultiplicityUnfolder& operator=(const AliMultiplicityUnfolder&);
+
+  ClassDef(AliMultiplicityUnfolder, 1);
+};
+
+#endif
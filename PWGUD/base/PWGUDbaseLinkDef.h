@@ -20,6 +20,7 @@
 #pragma link C++ class AliCorrection+;
 
 #pragma link C++ class AliMultiplicityCorrection+;
+#pragma link C++ class AliMultiplicityUnfolder+;
 
 #pragma link C++ class AliAnalysisTaskdNdetaMC+;
 
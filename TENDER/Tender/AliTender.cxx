@@ -15,8 +15,23 @@
 
 /* $Id$ */
 
+#include <cstdio>
+
+#include <RConfigure.h>
+#include <RVersion.h>
 #include <TChain.h>
 #include <TFile.h>
+#include <TList.h>
+#include <TMath.h>
+#include <TObjString.h>
+#include <TPRegexp.h>
+#include <TROOT.h>
+#include <TSystem.h>
+#include <TThread.h>
+#if defined(R__USE_IMT) && ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0)
+#include <ROOT/TSeq.hxx>
+#include <ROOT/TThreadExecutor.hxx>
+#endif
  
 #include "AliTender.h"
 #include "AliTenderSupply.h"
@@ -41,7 +56,13 @@ AliTender::AliTender():
            fESDhandler(NULL),
            fESD(NULL),
            fSupplies(NULL),
-           fCDBSettings(NULL)
+           fCDBSettings(NULL),
+           fNThreads(1),
+           fMinTracksPerRange(100),
+           fPrefetchStorage(),
+           fPrefetchRun(0),
+           fPrefetchFiles(NULL),
+           fPrefetchThread(NULL)
 {
 // Dummy constructor
 }
@@ -58,7 +79,13 @@ AliTender::AliTender(const char* name):
            fESDhandler(NULL),
            fESD(NULL),
            fSupplies(NULL),
-           fCDBSettings(NULL)
+           fCDBSettings(NULL),
+           fNThreads(1),
+           fMinTracksPerRange(100),
+           fPrefetchStorage(),
+           fPrefetchRun(0),
+           fPrefetchFiles(NULL),
+           fPrefetchThread(NULL)
 {
 // Default constructor
   DefineOutput(1,  AliESDEvent::Class());
@@ -68,6 +95,7 @@ AliTender::AliTender(const char* name):
 AliTender::~AliTender()
 {
 // Destructor
+  StopPrefetch();
   if (fSupplies) {
     fSupplies->Delete();
     delete fSupplies;
@@ -142,6 +170,15 @@ void AliTender::UserCreateOutputObjects()
      fESDhandler->SetUserCallSelectionMask(kTRUE);
      Info("UserCreateOutputObjects","The TENDER will check the event selection. Make sure you add the tender as FIRST wagon!");
   }   
+  if (fNThreads > 1) {
+#if defined(R__USE_IMT) && ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0)
+     if (!ROOT::IsImplicitMTEnabled()) ROOT::EnableImplicitMT(fNThreads);
+     Info("UserCreateOutputObjects","Per-track work of the supplies split over %d threads", fNThreads);
+#else
+     Warning("UserCreateOutputObjects","Parallel track ranges need ROOT >= 6.10 with imt, running serially");
+     fNThreads = 1;
+#endif
+  }
 }
 
 //______________________________________________________________________________
@@ -172,7 +209,12 @@ void AliTender::UserExec(Option_t* option)
   }
   TIter next(fSupplies);
   AliTenderSupply *supply;
-  while ((supply=(AliTenderSupply*)next())) supply->ProcessEvent();
+  while ((supply=(AliTenderSupply*)next())) {
+    supply->ProcessEvent();
+    if (supply->HasTrackRangeWork()) ProcessTrackRanges(supply);
+  }
+  // Calibration of the current run is loaded, look ahead to the next one
+  if (fRunChanged && fPrefetchStorage.Length()) PrefetchNextRun();
   fRunChanged = kFALSE;
 
   if (TObject::TestBit(kCheckEventSelection)) fESDhandler->CheckSelectionMask();
@@ -187,3 +229,136 @@ void AliTender::SetDefaultCDBStorage(const char *dbString)
 // Set default CDB storage
    fDefaultStorage = dbString;
 }
+
+//______________________________________________________________________________
+void AliTender::ProcessTrackRanges(AliTenderSupply *supply)
+{
+// Run the per-track work of a supply over ranges of the ESD tracks. With more
+// than one thread the ranges are processed concurrently, the supply returns
+// only when all of them are done.
+  Int_t ntracks = fESD->GetNumberOfTracks();
+  Int_t nranges = 1;
+  if (fNThreads > 1 && fMinTracksPerRange > 0) nranges = TMath::Min(4*fNThreads, ntracks/fMinTracksPerRange);
+  if (nranges <= 1) {
+    supply->ProcessTrackRange(0, ntracks);
+    return;
+  }
+#if defined(R__USE_IMT) && ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0)
+  Int_t step = (ntracks + nranges - 1)/nranges;
+  ROOT::TThreadExecutor pool;
+  pool.Foreach([supply, ntracks, step](Int_t irange) {
+    Int_t first = irange*step;
+    supply->ProcessTrackRange(first, TMath::Min(first + step, ntracks));
+  }, ROOT::TSeqI(nranges));
+#else
+  supply->ProcessTrackRange(0, ntracks);
+#endif
+}
+
+//______________________________________________________________________________
+void AliTender::PrefetchNextRun()
+{
+// Read in the background the calibration files of the next run of the input
+// chain from the local OCDB snapshot, for the paths declared by the supplies.
+// The CDB manager is not touched: its lookups at the next run change find the
+// files in the page cache instead of waiting for the storage.
+  Int_t run = GetNextRunFromChain();
+  if (run <= 0 || run == fRun || run == fPrefetchRun) return;
+  StopPrefetch();
+  fPrefetchRun = run;
+
+  TString storage = fPrefetchStorage;
+  if (storage.BeginsWith("local://")) storage.Remove(0, 8);
+  gSystem->ExpandPathName(storage);
+
+  TList paths;
+  paths.SetOwner();
+  TIter next(fSupplies);
+  AliTenderSupply *supply;
+  while ((supply=(AliTenderSupply*)next())) supply->GetCDBPaths(paths);
+
+  fPrefetchFiles = new TObjArray();
+  fPrefetchFiles->SetOwner();
+  TIter nextPath(&paths);
+  TObject *path;
+  while ((path=nextPath())) {
+    TString dir = Form("%s/%s", storage.Data(), path->GetName());
+    void *dirp = gSystem->OpenDirectory(dir);
+    if (!dirp) continue;
+    // highest version valid for the run, as selected by a local storage
+    TString file;
+    Int_t fileVersion = -1;
+    const char *entry;
+    while ((entry = gSystem->GetDirEntry(dirp))) {
+      Int_t first, last, version, subVersion;
+      if (sscanf(entry, "Run%d_%d_v%d_s%d.root", &first, &last, &version, &subVersion) != 4) continue;
+      if (run < first || run > last || version <= fileVersion) continue;
+      fileVersion = version;
+      file = Form("%s/%s", dir.Data(), entry);
+    }
+    gSystem->FreeDirectory(dirp);
+    if (fileVersion >= 0 && !fPrefetchFiles->FindObject(file)) fPrefetchFiles->Add(new TObjString(file));
+  }
+  if (!fPrefetchFiles->GetEntriesFast()) return;
+  AliInfo(Form("Prefetching %d calibration files of run %d", fPrefetchFiles->GetEntriesFast(), run));
+  fPrefetchThread = new TThread("AliTenderPrefetch", PrefetchFiles, fPrefetchFiles);
+  fPrefetchThread->Run();
+}
+
+//______________________________________________________________________________
+void AliTender::StopPrefetch()
+{
+// Wait for the prefetch thread and release its file list
+  if (fPrefetchThread) {
+    fPrefetchThread->Join();
+    delete fPrefetchThread;
+    fPrefetchThread = NULL;
+  }
+  if (fPrefetchFiles) {
+    delete fPrefetchFiles;
+    fPrefetchFiles = NULL;
+  }
+}
+
+//______________________________________________________________________________
+Int_t AliTender::GetNextRunFromChain() const
+{
+// Run of the first file after the current one in the input chain which
+// belongs to another run, 0 if there is none
+  TChain *chain = dynamic_cast<TChain*>(AliAnalysisManager::GetAnalysisManager()->GetTree());
+  if (!chain || !chain->GetListOfFiles()) return 0;
+  TObjArray *files = chain->GetListOfFiles();
+  for (Int_t i=chain->GetTreeNumber()+1; i<files->GetEntriesFast(); i++) {
+    Int_t run = GetRunFromFileName(files->At(i)->GetTitle());
+    if (run > 0 && run != fRun) return run;
+  }
+  return 0;
+}
+
+//______________________________________________________________________________
+Int_t AliTender::GetRunFromFileName(const char *fname)
+{
+// Run number from a production path like .../LHC15o/000245145/pass1/...
+  TPRegexp reg("/0*([1-9][0-9]{5})/");
+  TObjArray *match = reg.MatchS(fname);
+  Int_t run = 0;
+  if (match->GetEntriesFast() > 1) run = ((TObjString*)match->At(1))->GetString().Atoi();
+  delete match;
+  return run;
+}
+
+//______________________________________________________________________________
+void *AliTender::PrefetchFiles(void *files)
+{
+// Thread function: read the files once to bring them in the page cache.
+// Plain C I/O only, the file list is not modified while the thread runs.
+  TObjArray *list = (TObjArray*)files;
+  char buffer[65536];
+  for (Int_t i=0; i<list->GetEntriesFast(); i++) {
+    FILE *fp = fopen(list->At(i)->GetName(), "rb");
+    if (!fp) continue;
+    while (fread(buffer, 1, sizeof(buffer), fp) == sizeof(buffer)) {}
+    fclose(fp);
+  }
+  return 0;
+}
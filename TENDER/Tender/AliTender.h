@@ -20,6 +20,7 @@
 // #ifndef ALIESDINPUTHANDLER_H
 // #include "AliESDInputHandler.h"
 // #endif
+class TThread;
 class AliCDBManager;
 class AliESDEvent;
 class AliESDInputHandler;
@@ -43,10 +44,23 @@ private:
   AliESDEvent              *fESD;            //! Pointer to current ESD event
   TObjArray                *fSupplies;       // Array of tender supplies
   TObjArray                *fCDBSettings;    // Array with CDB configuration
+  Int_t                     fNThreads;       // Number of threads for the track-range work of the supplies
+  Int_t                     fMinTracksPerRange; // Minimum number of tracks per range
+  TString                   fPrefetchStorage; // Local OCDB snapshot for the run-change prefetch
+  Int_t                     fPrefetchRun;    //! Run of the prefetched calibration files
+  TObjArray                *fPrefetchFiles;  //! Calibration files being prefetched
+  TThread                  *fPrefetchThread; //! Prefetch thread
   
   AliTender(const AliTender &other);
   AliTender& operator=(const AliTender &other);
 
+  void                      ProcessTrackRanges(AliTenderSupply *supply);
+  void                      PrefetchNextRun();
+  void                      StopPrefetch();
+  Int_t                     GetNextRunFromChain() const;
+  static Int_t              GetRunFromFileName(const char *fname);
+  static void              *PrefetchFiles(void *files);
+
 public:  
   AliTender();
   AliTender(const char *name);
@@ -68,6 +82,19 @@ public:
    */
   void 			    SetHandleOCDB(Bool_t doHandle) { fHandleCDB = doHandle; }
   void SetESDhandler(AliESDInputHandler*esdH) {fESDhandler = esdH;}
+  /**
+   * Number of threads sharing the per-track work of the supplies (default: 1, serial).
+   * Only supplies setting fTrackRangeWork are split, one after the other.
+   * Requires ROOT >= 6.10 built with imt, otherwise the work stays serial.
+   */
+  void                      SetNumberOfThreads(Int_t n) {fNThreads = n;}
+  void                      SetMinTracksPerRange(Int_t n) {fMinTracksPerRange = n;}
+  /**
+   * Prefetch in the background the calibration files of the next run of the chain
+   * from a local OCDB snapshot, for the OCDB paths declared by the supplies
+   * @param[in] snapshot Snapshot folder (local:// or plain path), empty to disable
+   */
+  void                      SetOCDBPrefetch(const char *snapshot) {fPrefetchStorage = snapshot;}
 
   // Run control
   virtual void              ConnectInputData(Option_t *option = "");
@@ -75,6 +102,6 @@ public:
 //  virtual Bool_t            Notify() {return kTRUE;}
   virtual void              UserExec(Option_t *option);
     
-  ClassDef(AliTender,4)  // Class describing the tender car for ESD analysis
+  ClassDef(AliTender,5)  // Class describing the tender car for ESD analysis
 };
 #endif
@@ -23,7 +23,8 @@ ClassImp(AliTenderSupply)
 //______________________________________________________________________________
 AliTenderSupply::AliTenderSupply()
                 :TNamed(),
-                 fTender(NULL)
+                 fTender(NULL),
+                 fTrackRangeWork(kFALSE)
 {
 // Dummy constructor
 }
@@ -31,7 +32,8 @@ AliTenderSupply::AliTenderSupply()
 //______________________________________________________________________________
 AliTenderSupply::AliTenderSupply(const char* name, const AliTender *tender)
                 :TNamed(name, "ESD analysis tender car"),
-                 fTender(tender)
+                 fTender(tender),
+                 fTrackRangeWork(kFALSE)
 {
 // Default constructor
 }
@@ -39,7 +41,8 @@ AliTenderSupply::AliTenderSupply(const char* name, const AliTender *tender)
 //______________________________________________________________________________
 AliTenderSupply::AliTenderSupply(const AliTenderSupply &other)
                 :TNamed(other),
-                 fTender(other.fTender)
+                 fTender(other.fTender),
+                 fTrackRangeWork(kFALSE)
                  
 {
 // Copy constructor
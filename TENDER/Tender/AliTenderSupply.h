@@ -14,12 +14,14 @@
 #include "TNamed.h"
 #endif
 
+class TCollection;
 class AliTender;
 
 class AliTenderSupply : public TNamed {
 
 protected:
   const AliTender          *fTender;         // Tender car
+  Bool_t                    fTrackRangeWork; //! Per-track work left to ProcessTrackRange() in this event
   
 public:  
   AliTenderSupply();
@@ -31,9 +33,17 @@ public:
   // Run control
   virtual void              Init() = 0;
   virtual void              ProcessEvent() = 0;
+  // Track-range control. A supply setting fTrackRangeWork in ProcessEvent()
+  // leaves its per-track work to the tender, which calls ProcessTrackRange()
+  // on disjoint ranges [first,last) of the ESD tracks, possibly concurrently.
+  // Per-event work stays in ProcessEvent().
+  Bool_t                    HasTrackRangeWork() const {return fTrackRangeWork;}
+  virtual void              ProcessTrackRange(Int_t /*first*/, Int_t /*last*/) {}
+  // OCDB paths read by the supply, used by the tender for the run-change prefetch
+  virtual void              GetCDBPaths(TCollection &/*paths*/) const {}
   
   void                      SetTender(const AliTender *tender) {fTender = tender;}
     
-  ClassDef(AliTenderSupply,1)  // Base class for tender user algorithms
+  ClassDef(AliTenderSupply,2)  // Base class for tender user algorithms
 };
 #endif
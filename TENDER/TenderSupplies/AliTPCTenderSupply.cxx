@@ -206,6 +206,17 @@ void AliTPCTenderSupply::ProcessEvent()
   }
 }
 
+//_____________________________________________________
+void AliTPCTenderSupply::GetCDBPaths(TCollection &paths) const
+{
+  //
+  // OCDB objects read at run change
+  //
+  paths.Add(new TObjString("GRP/GRP/Data"));
+  paths.Add(new TObjString("TPC/Calib/TimeGain"));
+  paths.Add(new TObjString("TPC/Calib/PidResponse"));
+}
+
 //_____________________________________________________
 Double_t AliTPCTenderSupply::GetTPCMultiplicityBin()
 {
@@ -21,6 +21,7 @@ class AliGRPObject;
 class TGraphErrors;
 class AliAnalysisManager;
 class TF1;
+class TCollection;
 
 class AliTPCTenderSupply: public AliTenderSupply {
   
@@ -42,6 +43,7 @@ public:
 
   virtual void              Init();
   virtual void              ProcessEvent();
+  virtual void              GetCDBPaths(TCollection &paths) const;
   
 private:
   AliESDpid          *fESDpid;         //! ESD pid object
@@ -35,6 +35,8 @@ ClassImp(AliTrackFixTenderSupply)
 AliTrackFixTenderSupply::AliTrackFixTenderSupply() :
 fDebug(0),
   fBz(0),
+  fVtx(0),
+  fVtxTPC(0),
   fParams(0),
   fOADBObjPath("$OADB/PWGPP/data/CorrPTInv.root"),
   fOADBObjName("CorrPTInv"),
@@ -48,6 +50,8 @@ AliTrackFixTenderSupply::AliTrackFixTenderSupply(const char *name, const AliTend
   AliTenderSupply(name,tender),
   fDebug(0),
   fBz(0),
+  fVtx(0),
+  fVtxTPC(0),
   fParams(0),
   fOADBObjPath("$OADB/PWGPP/data/CorrPTInv.root"),
   fOADBObjName("CorrPTInv"),
@@ -71,29 +75,42 @@ void AliTrackFixTenderSupply::ProcessEvent()
   //
   // Fix track kinematics
   //
+  fTrackRangeWork = kFALSE;
   AliESDEvent *event=fTender->GetEvent();
   if (!event) return;
   //
   if (fTender->RunChanged() && !GetRunCorrections(fTender->GetRun())) return;
+  if (!fParams) return;
   //
-  int nTracks = event->GetNumberOfTracks();
   fBz = event->GetMagneticField();
   if (TMath::Abs(fBz) < kAlmost0Field) return;
   //
-  const AliESDVertex *vtx = 0, *vtxTPC = 0;
-  //
-  vtx = event->GetPrimaryVertexTracks(); // vertex to be used for update via RelateToVertex
-  if (!vtx || vtx->GetStatus()<1) {
-    vtx = event->GetPrimaryVertexSPD();
-    if (vtx && vtx->GetStatus()<1) vtx = 0;
+  fVtx = event->GetPrimaryVertexTracks(); // vertex to be used for update via RelateToVertex
+  if (!fVtx || fVtx->GetStatus()<1) {
+    fVtx = event->GetPrimaryVertexSPD();
+    if (fVtx && fVtx->GetStatus()<1) fVtx = 0;
   }
-  vtxTPC = event->GetPrimaryVertexTPC(); // vertex to be used for update via RelateToVertexTPC
-  if (vtxTPC && vtxTPC->GetStatus()<1) vtxTPC = 0;
-  //  
+  fVtxTPC = event->GetPrimaryVertexTPC(); // vertex to be used for update via RelateToVertexTPC
+  if (fVtxTPC && fVtxTPC->GetStatus()<1) fVtxTPC = 0;
+  //
+  // tracks are corrected independently, leave them to the tender unless
+  // the debug printout is requested
+  if (fDebug>1) ProcessTrackRange(0,event->GetNumberOfTracks());
+  else fTrackRangeWork = kTRUE;
+  //
+}
+
+//_____________________________________________________
+void AliTrackFixTenderSupply::ProcessTrackRange(Int_t first, Int_t last)
+{
+  //
+  // Fix kinematics of the tracks first...last-1
+  //
+  AliESDEvent *event=fTender->GetEvent();
   AliExternalTrackParam* extPar = 0;
   double xOrig = 0;
   double xyzTPCInner[3] = {0,0,0};
-  for (int itr=0;itr<nTracks;itr++) {
+  for (int itr=first;itr<last;itr++) {
     //
     AliESDtrack* trc = event->GetTrack(itr);
     if (!trc->IsOn(AliESDtrack::kTPCin)) continue;
@@ -121,7 +138,7 @@ void AliTrackFixTenderSupply::ProcessEvent()
     if (xIniCor>0) trc->PropagateTo(xIniCor,fBz);
     CorrectTrackPtInv(trc, cormode, sideAfraction, phi);
     if (xIniCor>0) {                             // full update is requested
-      if (vtx) trc->RelateToVertex(vtx, fBz, kVeryBig); // redo DCA if vtx is available
+      if (fVtx) trc->RelateToVertex(fVtx, fBz, kVeryBig); // redo DCA if vtx is available
       else     trc->PropagateTo(xOrig, fBz);            // otherwise bring to original point
     }
     // 
@@ -142,7 +159,7 @@ void AliTrackFixTenderSupply::ProcessEvent()
       if (xIniCor>0) extPar->PropagateTo(xIniCor,fBz);
       CorrectTrackPtInv(extPar,cormode,sideAfraction, phi);
       if (xIniCor>0) {                              // full update is requested
-	if (vtxTPC) trc->RelateToVertexTPC(vtxTPC, fBz, kVeryBig);  // redo DCA if vtx is available
+	if (fVtxTPC) trc->RelateToVertexTPC(fVtxTPC, fBz, kVeryBig);  // redo DCA if vtx is available
 	else        extPar->PropagateTo(xOrig, fBz);                // otherwise bring to original point
       }
       //
@@ -31,6 +31,7 @@ public:
   AliTrackFixTenderSupply(const char *name, const AliTender *tender=NULL);
   virtual ~AliTrackFixTenderSupply();
   virtual  void ProcessEvent();
+  virtual  void ProcessTrackRange(Int_t first, Int_t last);
   virtual  void Init() {}
   //
   Double_t GetSideAFraction(const AliESDtrack* track) const;
@@ -53,12 +54,14 @@ private:
   //
   Int_t             fDebug;                  // Debug level
   Double_t          fBz;                     // mag field from ESD
+  const AliESDVertex* fVtx;                  //! vertex for the update of the main param
+  const AliESDVertex* fVtxTPC;               //! vertex for the update of the TPCinner param
   AliOADBTrackFix*  fParams;                 // parameters for current run
   TString           fOADBObjPath;            // path of file with parameters to use, starting from OADB dir
   TString           fOADBObjName;            // name of the corrections object in the OADB container
   AliOADBContainer* fOADBCont;               // OADB container with parameters collection
   //
-  ClassDef(AliTrackFixTenderSupply, 1);  // track fixing tender task 
+  ClassDef(AliTrackFixTenderSupply, 2);  // track fixing tender task 
 };
 
 
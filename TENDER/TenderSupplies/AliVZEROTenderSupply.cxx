@@ -179,6 +179,19 @@ void AliVZEROTenderSupply::ProcessEvent()
 
 }
 
+//_____________________________________________________
+void AliVZEROTenderSupply::GetCDBPaths(TCollection &paths) const
+{
+  //
+  // OCDB objects read at run change
+  //
+  paths.Add(new TObjString("GRP/Geometry/Data"));
+  paths.Add(new TObjString("VZERO/Calib/Data"));
+  paths.Add(new TObjString("VZERO/Calib/TimeSlewing"));
+  paths.Add(new TObjString("VZERO/Calib/RecoParam"));
+  paths.Add(new TObjString("GRP/Calib/LHCClockPhase"));
+}
+
 //_____________________________________________________
 void AliVZEROTenderSupply::GetPhaseCorrection()
 {
@@ -16,6 +16,7 @@
 #include <AliTenderSupply.h>
 
 class TF1;
+class TCollection;
 class AliVZEROCalibData;
 class AliVZERORecoParam;
 
@@ -29,6 +30,7 @@ public:
 
   virtual void              Init();
   virtual void              ProcessEvent();
+  virtual void              GetCDBPaths(TCollection &paths) const;
   
   void GetPhaseCorrection();
 